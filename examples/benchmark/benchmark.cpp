@@ -0,0 +1,123 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <limits>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Engine for benchmarking. With the base renderer only the Vulkan base renderer is created, which allows many
+ * objects. The forward renderer also creates a descriptor set and uniform buffer per object, with CreateObjects they
+ * are allocated once for the whole batch.
+ */
+class BenchmarkEngine : public vve::Engine {
+
+public:
+	BenchmarkEngine(bool fullRenderer) : vve::Engine("Benchmark", vve::RendererType::RENDERER_TYPE_FORWARD), m_fullRenderer{fullRenderer} {};
+
+protected:
+	void CreateRenderer() override {
+		if( m_fullRenderer ) { vve::Engine::CreateRenderer(); return; }
+		RegisterSystem(std::make_unique<vve::RendererVulkan>( m_rendererVulkanName, *this, m_windowName ) );
+	}
+
+	void CreateGUI() override {};
+
+	bool m_fullRenderer{false};
+};
+
+
+/**
+ * @brief Creates the objects either one by one or with one batch and measures the time
+ */
+class Benchmark : public vve::System {
+
+public:
+	Benchmark( vve::Engine& engine, size_t numObjects, bool batch ) : vve::System("Benchmark", engine ), m_numObjects{numObjects}, m_batch{batch} {
+		m_engine.RegisterCallbacks( {
+			{this, 1000, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} }
+		} );
+	};
+
+	~Benchmark() {};
+
+	inline static std::string sphere_obj  { "assets/standard/sphere.obj" };
+	inline static std::string sphere_mesh { "assets/standard/sphere.obj/sphere" };
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{sphere_obj} );
+		vvh::Color color{ { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.5f, 0.5f, 0.5f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+		std::vector<vve::Engine::ObjectInfo> objects(m_numObjects);
+		for( size_t i = 0; i < m_numObjects; ++i ) {
+			objects[i] = {
+				.m_meshName = vve::MeshName{sphere_mesh},
+				.m_color = color,
+				.m_position = vve::Position{vec3_t{ (real_t)(i % 1000), (real_t)(i / 1000), 0.0f }},
+				.m_scale = vve::Scale{vec3_t{0.01f}}
+			};
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		if( m_batch ) {
+			m_engine.CreateObjects( vve::ParentHandle{}, objects );
+		} else {
+			for( auto& info : objects ) {
+				m_engine.CreateObject( vve::Name{}, vve::ParentHandle{}, info.m_meshName, info.m_color,
+										info.m_position, info.m_rotation, info.m_scale, info.m_uvScale );
+			}
+		}
+		m_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		m_engine.Stop();
+		return false;
+	};
+
+	double m_ms{0.0};
+
+private:
+	size_t m_numObjects;
+	bool m_batch;
+};
+
+
+/**
+ * @brief Create the objects in a new engine, so that no run starts with a warm registry
+ * @param fullRenderer Use the forward renderer instead of the base renderer only
+ * @param numObjects Number of objects
+ * @param batch Create the objects with CreateObjects instead of CreateObject
+ * @return Time in ms
+ */
+auto Run(bool fullRenderer, size_t numObjects, bool batch) -> double {
+	BenchmarkEngine engine{fullRenderer};
+	Benchmark benchmark{engine, numObjects, batch};
+	engine.Run();
+	return benchmark.m_ms;
+}
+
+
+/**
+ * @brief Usage: benchmark [number of objects] [number of objects with the forward renderer] [repetitions]
+ * Single and batch creation are measured alternately, each in a new engine, and the fastest run of each is reported.
+ */
+int main(int argc, char* argv[]) {
+	size_t numObjects = argc > 1 ? std::stoull(argv[1]) : 100000;
+	size_t numForward = argc > 2 ? std::stoull(argv[2]) : 10000;
+	size_t repetitions = argc > 3 ? std::stoull(argv[3]) : 3;
+
+	for( auto [fullRenderer, count] : { std::pair{false, numObjects}, std::pair{true, numForward} } ) {
+		double single = std::numeric_limits<double>::max(), batch = std::numeric_limits<double>::max();
+		for( size_t r = 0; r < repetitions; ++r ) {
+			bool batchFirst = r % 2 == 0;	//alternate the order, so that neither is always measured first
+			double first = Run(fullRenderer, count, batchFirst);
+			double second = Run(fullRenderer, count, !batchFirst);
+			batch = std::min(batch, batchFirst ? first : second);
+			single = std::min(single, batchFirst ? second : first);
+		}
+		auto renderer = fullRenderer ? "forward renderer" : "base renderer";
+		std::cout << std::format("{}, CreateObject  x {}: {:.2f} ms\n", renderer, count, single);
+		std::cout << std::format("{}, CreateObjects x {}: {:.2f} ms\n", renderer, count, batch);
+	}
+	return 0;
+}
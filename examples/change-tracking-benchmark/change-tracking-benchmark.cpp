@@ -0,0 +1,101 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Microbenchmark of change detection. Runs on the CPU only, no window or GPU is created. Many entities
+ * with a world matrix are inserted, each frame a small fraction of them is moved. Two ways of finding the
+ * moved entities for each frame in flight are compared:
+ * - dirty flags: a flag component is Put on each moved entity, and a full view is scanned for set flags
+ * - change tracker: moved entities are touched, and the tracker is asked for entities changed since a frame
+ */
+
+using DirtyFlags = vsty::strong_type_t<std::array<bool, MAX_FRAMES_IN_FLIGHT>, vsty::counter<>>;
+
+
+/**
+ * @brief Usage: change-tracking-benchmark [number of entities] [changed per frame] [frames]
+ */
+int main(int argc, char* argv[]) {
+	size_t numEntities = argc > 1 ? std::stoull(argv[1]) : 100000;
+	size_t numChanged = argc > 2 ? std::stoull(argv[2]) : 100;
+	size_t frames = argc > 3 ? std::stoull(argv[3]) : 200;
+
+	vecs::Registry registry;
+	std::vector<vecs::Handle> handles;
+	handles.reserve(numEntities);
+	for( size_t i = 0; i < numEntities; ++i ) {
+		handles.push_back( registry.Insert(vve::LocalToWorldMatrix{mat4_t{1.0f}}, DirtyFlags{}) );
+	}
+
+	std::default_random_engine rnd{ 12345 };
+	std::uniform_int_distribution<size_t> pick{ 0, numEntities - 1 };
+	std::vector<std::vector<size_t>> moves(frames);
+	for( auto& move : moves ) {
+		move.resize(numChanged);
+		for( auto& index : move ) index = pick(rnd);
+	}
+
+	// Dirty flags, as the deferred renderer did it: Put all flags on change, scan every frame
+	size_t foundDirty = 0;
+	double writeDirtyMs = 0.0, scanDirtyMs = 0.0;
+	for( size_t frame = 0; frame < frames; ++frame ) {
+		auto start = std::chrono::high_resolution_clock::now();
+		std::array<bool, MAX_FRAMES_IN_FLIGHT> dirty;
+		dirty.fill(true);
+		for( auto index : moves[frame] ) {
+			registry.template Get<vve::LocalToWorldMatrix&>(handles[index])()[3].x += 1.0f;
+			registry.Put(handles[index], DirtyFlags{dirty});
+		}
+		auto write = std::chrono::high_resolution_clock::now();
+		size_t slot = frame % MAX_FRAMES_IN_FLIGHT;
+		for( auto [handle, LtoW, flags] : registry.template GetView<vecs::Handle, vve::LocalToWorldMatrix&, DirtyFlags&>() ) {
+			if( !flags()[slot] ) continue;
+			flags()[slot] = false;
+			++foundDirty;
+		}
+		auto scan = std::chrono::high_resolution_clock::now();
+		writeDirtyMs += std::chrono::duration<double, std::milli>(write - start).count();
+		scanDirtyMs += std::chrono::duration<double, std::milli>(scan - write).count();
+	}
+
+	// Change tracker: touch on change, query per frame slot
+	vve::ChangeTracker tracker;
+	std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> updated{};
+	std::vector<vecs::Handle> changed;
+	size_t foundTracker = 0;
+	double writeTrackerMs = 0.0, scanTrackerMs = 0.0;
+	for( size_t frame = 0; frame < frames; ++frame ) {
+		tracker.NextFrame();
+		auto start = std::chrono::high_resolution_clock::now();
+		for( auto index : moves[frame] ) {
+			registry.template Get<vve::LocalToWorldMatrix&>(handles[index])()[3].x += 1.0f;
+			tracker.Touch(handles[index]);
+		}
+		auto write = std::chrono::high_resolution_clock::now();
+		size_t slot = frame % MAX_FRAMES_IN_FLIGHT;
+		tracker.GetChangedSince(updated[slot] + 1, changed);
+		updated[slot] = tracker.GetFrame();
+		foundTracker += changed.size();
+		auto scan = std::chrono::high_resolution_clock::now();
+		writeTrackerMs += std::chrono::duration<double, std::milli>(write - start).count();
+		scanTrackerMs += std::chrono::duration<double, std::milli>(scan - write).count();
+	}
+
+	std::cout << std::format("{} entities, {} changed per frame, {} frames\n", numEntities, numChanged, frames);
+	std::cout << std::format("Dirty flags:    write {:.4f} ms, scan {:.4f} ms per frame, found {}\n",
+		writeDirtyMs / frames, scanDirtyMs / frames, foundDirty);
+	std::cout << std::format("Change tracker: write {:.4f} ms, scan {:.4f} ms per frame, found {}\n",
+		writeTrackerMs / frames, scanTrackerMs / frames, foundTracker);
+	if( foundDirty != foundTracker ) {
+		std::cout << "Results differ: FAILED\n";
+		return 1;
+	}
+	return 0;
+}
+
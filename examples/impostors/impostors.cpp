@@ -0,0 +1,83 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief A field of spheres, distant spheres are drawn as impostors. Shows the drawn triangles and the frame time,
+ * impostors can be switched off by moving the distance slider to the far end.
+ */
+class ImpostorDemo : public vve::System {
+
+public:
+	ImpostorDemo( vve::Engine& engine ) : vve::System("ImpostorDemo", engine ) {
+		m_engine.RegisterCallbacks( {
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
+		} );
+	};
+
+	~ImpostorDemo() {};
+
+	inline static const std::string sphere_obj  { "assets/standard/sphere.obj" };
+	inline static const std::string sphere_mesh { "assets/standard/sphere.obj/sphere" };
+	inline static const int c_rows = 15;
+	inline static const real_t c_spacing = 6.0f;
+	inline static const vec4_t c_color{ 0.8f, 0.5f, 0.2f, 1.0f };
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{sphere_obj} );
+		m_impostors.Bake( vve::MeshName{sphere_mesh}, c_color );
+
+		std::vector<vve::Engine::ObjectInfo> objects;
+		for( int y = 0; y < c_rows; ++y ) {
+			for( int x = 0; x < c_rows; ++x ) {
+				objects.push_back( {
+					.m_meshName = vve::MeshName{sphere_mesh},
+					.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, c_color, {0.0f, 0.0f, 0.0f, 1.0f} },
+					.m_position = vve::Position{ vec3_t{ (x - c_rows / 2) * c_spacing, y * c_spacing, 1.0f } },
+					.m_scale = vve::Scale{ vec3_t{0.01f} }
+				} );
+			}
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, objects);
+
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		auto pos = m_registry.Get<vve::Position&>(parent);
+		pos() = vec3_t{ 0.0f, -5.0f, 3.0f };
+		return false;
+	};
+
+	bool OnRecordNextFrame(Message message) {
+		auto& stats = m_impostors.GetStats();
+		ImGui::Begin("Impostors");
+		if( ImGui::SliderFloat("Distance", &m_distance, 5.0f, 200.0f) ) m_impostors.SetDistance(m_distance);
+		ImGui::Text("Objects: %zu, as impostor: %zu in %zu draws", stats.m_objects, stats.m_impostors, stats.m_draws);
+		ImGui::Text("Triangles full: %zu, drawn: %zu", stats.m_trianglesFull, stats.m_trianglesDrawn);
+		ImGui::Text("Bake: %.3f ms", stats.m_bakeMs);
+		ImGui::Text("Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+		if( ImGui::Button("Save atlas") ) {
+			auto atlas = m_impostors.GetAtlas( vve::MeshName{sphere_mesh} );
+			if( atlas != nullptr ) vve::Impostors::SaveAtlas(*atlas, "impostor_atlas.png");
+		}
+		ImGui::End();
+		return false;
+	}
+
+private:
+	float m_distance{30.0f};
+	vve::Impostors m_impostors{ "Impostors", m_engine, m_distance };
+};
+
+
+
+int main() {
+	vve::Engine engine("My Engine", vve::RendererType::RENDERER_TYPE_FORWARD) ;
+	ImpostorDemo demo{engine};
+	engine.Run();
+
+	return 0;
+}
+
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testscene.h"
+
+
+/**
+ * @brief Incremental scene instantiation. A generated scene with many meshes is created over several frames
+ * within a per frame budget while a loading screen shows the progress. The step times are checked against the
+ * budget by tests/testincrementalloading.cpp.
+ */
+
+
+/**
+ * @brief Shows a loading screen while the scene is created incrementally
+ */
+class IncrementalLoading : public vve::System {
+
+public:
+	IncrementalLoading( vve::Engine& engine, std::filesystem::path file ) : vve::System("Incremental Loading", engine ), m_file{file} {
+		m_engine.RegisterCallbacks( {
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
+		} );
+	};
+
+	~IncrementalLoading() {};
+
+	bool OnLoadLevel( Message message ) {
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		auto pos = m_registry.Get<vve::Position&>(parent);
+		pos() = vec3_t{ 0.0f, -45.0f, 25.0f };
+		Load();
+		return false;
+	};
+
+	void Load() {
+		auto start = std::chrono::high_resolution_clock::now();
+		m_scene = m_engine.CreateSceneIncremental(vve::Name{"Spheres"}, vve::ParentHandle{}, vve::Filename{m_file.string()}, aiProcess_Triangulate);
+		m_importMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	bool OnRecordNextFrame(Message message) {
+		auto& progress = m_engine.GetLoadProgress();
+		ImGui::Begin("Loading");
+		if( progress.IsLoading() ) {
+			ImGui::ProgressBar(progress.Fraction());
+			ImGui::Text("Assets %zu/%zu, nodes %zu/%zu", progress.m_assetsDone, progress.m_assetsTotal, progress.m_nodesDone, progress.m_nodesTotal);
+		} else {
+			ImGui::Text("Scene loaded");
+		}
+		float budget = (float)m_engine.GetLoadBudget();
+		if( ImGui::SliderFloat("Budget ms", &budget, 0.5f, 30.0f) ) m_engine.SetLoadBudget(budget);
+		ImGui::Text("Import: %.2f ms (not sliced)", m_importMs);
+		ImGui::Text("Last step: %.2f ms, max step: %.2f ms, max unit: %.2f ms", progress.m_lastStepMs, progress.m_maxStepMs, progress.m_maxUnitMs);
+		ImGui::Text("Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+		if( !progress.IsLoading() && ImGui::Button("Reload") ) {
+			m_engine.DestroyObject(m_scene);
+			Load();
+		}
+		ImGui::End();
+		return false;
+	}
+
+private:
+	std::filesystem::path m_file;
+	vve::ObjectHandle m_scene{};
+	double m_importMs{0.0};
+};
+
+
+/**
+ * @brief Usage: incremental-loading [objects] [budget ms]
+ */
+int main(int argc, char* argv[]) {
+	size_t objects = argc > 1 ? std::stoull(argv[1]) : 400;
+	double budgetMs = argc > 2 ? std::stod(argv[2]) : 2.0;
+
+	auto file = std::filesystem::temp_directory_path() / "vve-incremental-loading.obj";
+	WriteScene(file, objects, 32);
+
+	vve::Engine engine("My Engine", vve::RendererType::RENDERER_TYPE_FORWARD) ;
+	engine.SetLoadBudget(budgetMs);
+	IncrementalLoading loading{engine, file};
+	engine.Run();
+
+	return 0;
+}
+
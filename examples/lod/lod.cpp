@@ -0,0 +1,140 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <map>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief A field of instanced spheres reaching into the distance. Shows how many triangles are drawn with level
+ * of detail selection compared to full resolution. With a number of frames on the command line, the vertex buffers
+ * are quantized, the camera moves away from the field, and after the frames the example checks that every object
+ * that switched its level was touched in the change tracker and that the levels kept the quantization bounds of
+ * their mesh.
+ */
+class Lod : public vve::System {
+
+public:
+	Lod( vve::Engine& engine, size_t checkFrames ) : vve::System("Lod", engine ), m_checkFrames{checkFrames} {
+		m_engine.RegisterCallbacks( {
+			{this,  -1000, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevelQuantize(message);} },	//before the default level
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this,   1000, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },	//after the level selection
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
+		} );
+	};
+
+	~Lod() {};
+
+	inline static const std::string sphere_obj  { "assets/standard/sphere.obj" };
+	inline static const std::string sphere_mesh { "assets/standard/sphere.obj/sphere" };
+	inline static const int c_rows = 20;
+	inline static const real_t c_spacing = 4.0f;
+
+	bool OnLoadLevelQuantize( Message message ) {
+		auto assets = dynamic_cast<vve::AssetManager*>(m_engine.GetSystem(m_engine.m_assetManagerName));
+		if( m_checkFrames > 0 ) assets->SetVertexQuantization(true);
+		return false;
+	}
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{sphere_obj} );
+
+		std::vector<vve::Engine::ObjectInfo> objects;
+		for( int y = 0; y < c_rows; ++y ) {
+			for( int x = 0; x < c_rows; ++x ) {
+				objects.push_back( {
+					.m_meshName = vve::MeshName{sphere_mesh},
+					.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {0.2f + 0.8f * x / c_rows, 0.2f + 0.8f * y / c_rows, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+					.m_position = vve::Position{ vec3_t{ (x - c_rows / 2) * c_spacing, y * c_spacing * 3.0f, 1.0f } },
+					.m_scale = vve::Scale{ vec3_t{0.01f} }
+				} );
+			}
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, objects);
+
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		auto pos = m_registry.Get<vve::Position&>(parent);
+		pos() = vec3_t{ 0.0f, -5.0f, 3.0f };
+		return false;
+	};
+
+	/**
+	 * @brief In check mode, move the camera back and check the objects whose level of detail changed this frame
+	 */
+	bool OnPrepareNextFrame(Message message) {
+		if( m_checkFrames == 0 ) return false;
+		auto& changes = m_engine.GetChanges();
+		for( auto [handle, mesh, state] : m_registry.GetView<vecs::Handle, vve::MeshHandle&, vve::LodState&>() ) {
+			auto it = m_meshes.find(handle.GetValue());
+			if( it != m_meshes.end() && it->second != mesh()().GetValue() ) {
+				++m_switches;
+				if( changes.GetVersion(handle) != changes.GetFrame() ) ++m_untouched;
+				auto& base = m_registry.Get<vvh::Mesh&>(state().m_base())().m_verticesData;
+				auto& level = m_registry.Get<vvh::Mesh&>(mesh()())().m_verticesData;
+				if( !level.m_quantized || level.getDequantization() != base.getDequantization() ) ++m_wrongBounds;
+			}
+			m_meshes[handle.GetValue()] = mesh()().GetValue();
+		}
+
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		m_registry.Get<vve::Position&>(parent)().y -= c_spacing * 0.5f;
+		if( ++m_frames == m_checkFrames ) m_engine.Stop();
+		return false;
+	}
+
+	/**
+	 * @brief Result of the check mode
+	 * @return True if all switched objects were touched and have the right bounds
+	 */
+	auto Passed() -> bool {
+		std::cout << std::format("{} level switches, {} not touched, {} with wrong bounds\n", m_switches, m_untouched, m_wrongBounds);
+		return m_switches > 0 && m_untouched == 0 && m_wrongBounds == 0;
+	}
+
+	bool OnRecordNextFrame(Message message) {
+		auto& stats = m_lod.GetStats();
+		ImGui::Begin("Level of Detail");
+		if( ImGui::Checkbox("Enabled", &m_enabled) ) m_lod.SetEnabled(m_enabled);
+		ImGui::Text("Objects: %zu", stats.m_objects);
+		ImGui::Text("Triangles full resolution: %zu", stats.m_trianglesFull);
+		ImGui::Text("Triangles drawn: %zu", stats.m_trianglesDrawn);
+		for( size_t i = 0; i < stats.m_objectsPerLevel.size(); ++i ) {
+			ImGui::Text("Level %zu: %zu objects", i, stats.m_objectsPerLevel[i]);
+		}
+		ImGui::Text("Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+		ImGui::End();
+		return false;
+	}
+
+private:
+	vve::LevelOfDetail m_lod{ "Level of Detail", m_engine };
+	bool m_enabled{true};
+	size_t m_checkFrames;							//0 for the interactive demo
+	size_t m_frames{0};
+	std::map<size_t, size_t> m_meshes;				//mesh of each object in the last frame
+	size_t m_switches{0};
+	size_t m_untouched{0};
+	size_t m_wrongBounds{0};
+};
+
+
+
+/**
+ * @brief Usage: lod [frames], without frames the demo runs interactively, with frames it checks the level switches
+ */
+int main(int argc, char* argv[]) {
+	size_t checkFrames = argc > 1 ? std::stoul(argv[1]) : 0;
+	auto type = checkFrames > 0 ? vve::RendererType::RENDERER_TYPE_DEFERRED : vve::RendererType::RENDERER_TYPE_FORWARD;	//the deferred renderer updates changed objects only
+	vve::Engine engine("My Engine", type) ;
+	Lod lod{engine, checkFrames};
+	engine.Run();
+
+	if( checkFrames == 0 ) return 0;
+	bool ok = lod.Passed();
+	std::cout << std::format("Level of detail: {}\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
+
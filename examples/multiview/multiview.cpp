@@ -0,0 +1,126 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Split screen with a picture in picture. The left half shows the main camera, the right half a camera
+ * circling the scene, and an inset shows the scene from above. Per view statistics are shown in a window.
+ * With a frame count as argument the example quits after that many frames and prints the statistics, e.g. for
+ * running it on a software rasterizer.
+ */
+class Multiview : public vve::System {
+
+public:
+	Multiview( vve::Engine& engine, size_t frames ) : vve::System("Multiview", engine ), m_frames{frames} {
+		m_engine.RegisterCallbacks( {
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this,      0, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
+		} );
+	};
+
+	~Multiview() {};
+
+	inline static const std::string cube_obj  { "assets/test/crate0/cube.obj" };
+	inline static const std::string cube_mesh { "assets/test/crate0/cube.obj/cube" };
+	inline static const int c_rows = 15;
+	inline static const real_t c_spacing = 3.0f;
+
+	/**
+	 * @brief Rotation of a node looking from a position to a target, z is up
+	 */
+	static auto LookAt(vec3_t eye, vec3_t target) -> vve::Rotation {
+		return vve::Rotation{ mat3_t{ glm::inverse(glm::lookAt(eye, target, vec3_t{0.0f, 0.0f, 1.0f})) } };
+	}
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{cube_obj} );
+
+		std::vector<vve::Engine::ObjectInfo> objects;
+		for( int y = 0; y < c_rows; ++y ) {
+			for( int x = 0; x < c_rows; ++x ) {
+				objects.push_back( {
+					.m_meshName = vve::MeshName{cube_mesh},
+					.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {0.2f + 0.8f * x / c_rows, 0.2f + 0.8f * y / c_rows, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+					.m_position = vve::Position{ vec3_t{ (x - c_rows / 2) * c_spacing, (y - c_rows / 2) * c_spacing, 0.5f } }
+				} );
+			}
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, objects);
+
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		auto pos = m_registry.Get<vve::Position&>(parent);
+		pos() = vec3_t{ 0.0f, -30.0f, 10.0f };
+
+		auto root = m_engine.GetRootSceneNode();
+		vec3_t orbit{ 30.0f, 0.0f, 8.0f };
+		m_orbitNode = m_engine.CreateSceneNode(vve::Name{"Orbit Camera"}, vve::ParentHandle{root}, vve::Position{orbit}, LookAt(orbit, vec3_t{0.0f}));
+		vec3_t above{ 0.0f, -0.1f, 60.0f };
+		auto aboveNode = m_engine.CreateSceneNode(vve::Name{"Top Camera"}, vve::ParentHandle{root}, vve::Position{above}, LookAt(above, vec3_t{0.0f}));
+
+		m_views.AddView("Main", vve::ObjectHandle{}, vec4_t{0.0f, 0.0f, 0.5f, 1.0f});
+		m_views.AddView("Orbit", m_orbitNode, vec4_t{0.5f, 0.0f, 0.5f, 1.0f});
+		m_views.AddView("Top", aboveNode, vec4_t{0.7f, 0.05f, 0.25f, 0.3f}, vve::Camera{ .m_fov = 60.0f }, true);
+		return false;
+	};
+
+	bool OnUpdate( Message message ) {
+		auto msg = message.template GetData<vve::System::MsgUpdate>();
+		if( !m_orbitNode().IsValid() ) return false;
+		m_angle += (real_t)msg.m_dt * 0.3f;
+		vec3_t eye{ 30.0f * std::cos(m_angle), 30.0f * std::sin(m_angle), 8.0f };
+		m_engine.SetPosition(m_orbitNode, vve::Position{eye});
+		m_engine.SetRotation(m_orbitNode, LookAt(eye, vec3_t{0.0f}));
+		return false;
+	}
+
+	bool OnRecordNextFrame(Message message) {
+		ImGui::Begin("Render Views");
+		for( auto handle : m_views.GetViews() ) {
+			auto view = m_registry.template Get<vve::RenderView&>(handle);
+			auto& stats = view().m_stats;
+			bool enabled = view().m_enabled;
+			if( ImGui::Checkbox(view().m_name.c_str(), &enabled) ) m_views.SetEnabled(handle, enabled);
+			ImGui::SameLine();
+			ImGui::Text("visible %zu/%zu, draw calls %zu, triangles %zu", stats.m_visible, stats.m_objects, stats.m_drawCalls, stats.m_triangles);
+		}
+		ImGui::Text("Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+		ImGui::End();
+
+		if( m_frames > 0 && ++m_frame == m_frames ) {
+			for( auto handle : m_views.GetViews() ) {
+				auto view = m_registry.template Get<vve::RenderView&>(handle);
+				auto& stats = view().m_stats;
+				std::cout << std::format("{}: visible {}/{}, draw calls {}, triangles {}\n", view().m_name,
+					stats.m_visible, stats.m_objects, stats.m_drawCalls, stats.m_triangles);
+			}
+			m_engine.Stop();
+		}
+		return false;
+	}
+
+private:
+	vve::RenderViews m_views{ "Render Views", m_engine };
+	vve::ObjectHandle m_orbitNode{};
+	real_t m_angle{0.0f};
+	size_t m_frames;
+	size_t m_frame{0};
+};
+
+
+
+/**
+ * @brief Usage: multiview [frames]
+ */
+int main(int argc, char* argv[]) {
+	vve::Engine engine("My Engine", vve::RendererType::RENDERER_TYPE_FORWARD) ;
+	Multiview multiview{engine, argc > 1 ? std::stoull(argv[1]) : 0};
+	engine.Run();
+
+	return 0;
+}
+
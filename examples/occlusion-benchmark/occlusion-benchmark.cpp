@@ -0,0 +1,84 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Microbenchmark of the software occlusion buffer. Runs on the CPU only, no window or GPU
+ * is created. A row of walls is placed in front of the camera, and many small boxes are scattered behind and in
+ * front of the walls. The correctness of the buffer is checked by tests/testocclusion.cpp.
+ */
+
+/**
+ * @brief Unit cube mesh centered at the origin
+ */
+struct CubeMesh {
+	std::vector<glm::vec3> m_positions{
+		{-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+		{-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f} };
+	std::vector<uint32_t> m_indices{
+		0, 2, 1, 0, 3, 2,  4, 5, 6, 4, 6, 7,  0, 1, 5, 0, 5, 4,
+		2, 3, 7, 2, 7, 6,  0, 4, 7, 0, 7, 3,  1, 2, 6, 1, 6, 5 };
+	vve::BoundingBox m_bounds{ vec3_t{-0.5f}, vec3_t{0.5f} };
+};
+
+
+auto Transform(vec3_t position, vec3_t scale) -> mat4_t {
+	return glm::scale(glm::translate(mat4_t{1.0f}, position), scale);
+}
+
+
+/**
+ * @brief Usage: occlusion-benchmark [number of boxes] [iterations]
+ */
+int main(int argc, char* argv[]) {
+	size_t numBoxes = argc > 1 ? std::stoull(argv[1]) : 100000;
+	size_t iterations = argc > 2 ? std::stoull(argv[2]) : 100;
+
+	CubeMesh cube;
+	mat4_t proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+	mat4_t view = glm::lookAt(vec3_t{0.0f, 0.0f, 0.0f}, vec3_t{0.0f, 0.0f, -1.0f}, vec3_t{0.0f, 1.0f, 0.0f});
+	mat4_t viewProj = proj * view;
+
+	std::vector<vve::OcclusionBuffer::OccluderMesh> walls;
+	for( int i = -8; i <= 8; ++i ) {
+		walls.push_back( { viewProj * Transform({i * 6.0f, 0.0f, -30.0f}, {5.0f, 20.0f, 0.5f}), &cube.m_positions, &cube.m_indices } );
+	}
+
+	std::default_random_engine rnd{ 12345 };
+	std::uniform_real_distribution<float> unif{ -1.0f, 1.0f };
+	std::vector<vve::OcclusionBuffer::TestBox> boxes(numBoxes);
+	for( auto& box : boxes ) {
+		float z = -5.0f - (unif(rnd) + 1.0f) * 100.0f;
+		box = { viewProj * Transform({unif(rnd) * -z * 0.8f, unif(rnd) * -z * 0.4f, z}, vec3_t{0.5f}), cube.m_bounds };
+	}
+	std::vector<uint8_t> visible(numBoxes);
+
+	std::vector<uint32_t> threadCounts{ 1 };
+	if( std::thread::hardware_concurrency() > 1 ) threadCounts.push_back( std::thread::hardware_concurrency() );
+	for( auto threads : threadCounts ) {
+		vve::JobPool jobPool{ threads };
+		vve::OcclusionBuffer buffer{ 320, 192, &jobPool };
+		double rasterMs = 0.0, testMs = 0.0;
+		size_t triangles = 0, culled = 0;
+		for( size_t it = 0; it < iterations; ++it ) {
+			auto start = std::chrono::high_resolution_clock::now();
+			buffer.Clear();
+			triangles = buffer.Rasterize(walls);
+			auto raster = std::chrono::high_resolution_clock::now();
+			buffer.Test(boxes, visible);
+			auto test = std::chrono::high_resolution_clock::now();
+			rasterMs += std::chrono::duration<double, std::milli>(raster - start).count();
+			testMs += std::chrono::duration<double, std::milli>(test - raster).count();
+		}
+		culled = std::count(visible.begin(), visible.end(), 0);
+		std::cout << std::format("Threads {:2}: rasterize {} triangles {:.3f} ms, test {} boxes {:.3f} ms, culled {}\n",
+			threads, triangles, rasterMs / iterations, numBoxes, testMs / iterations, culled);
+	}
+	return 0;
+}
+
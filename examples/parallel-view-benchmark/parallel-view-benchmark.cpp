@@ -0,0 +1,73 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Scaling benchmark of parallel iteration over registry views. Runs on the CPU only, no window or GPU is
+ * created. For many entities the world matrix and its inverse transpose are computed from position, rotation and
+ * scale, as the scene manager and the renderers do every frame. The loop is run with job pools of 1 to N threads.
+ * ParallelForEach gathers the entries of the view on the calling thread before it cuts them into chunks, the time of
+ * the gather alone is printed too. Correctness of the job pool is checked by tests/testjobpool.cpp.
+ */
+
+using NormalMatrix = vsty::strong_type_t<mat4_t, vsty::counter<>>;
+
+
+/**
+ * @brief Usage: parallel-view-benchmark [number of entities] [iterations]
+ */
+int main(int argc, char* argv[]) {
+	size_t numEntities = argc > 1 ? std::stoull(argv[1]) : 100000;
+	size_t iterations = argc > 2 ? std::stoull(argv[2]) : 50;
+
+	vecs::Registry registry;
+	std::default_random_engine rnd{ 12345 };
+	std::uniform_real_distribution<float> unif{ -100.0f, 100.0f };
+	for( size_t i = 0; i < numEntities; ++i ) {
+		vve::Position position{ vec3_t{unif(rnd), unif(rnd), unif(rnd)} };
+		vve::Rotation rotation{ mat3_t{glm::rotate(mat4_t{1.0f}, unif(rnd), vec3_t{0.0f, 0.0f, 1.0f})} };
+		registry.Insert(position, rotation, vve::Scale{vec3_t{1.0f}}, vve::LocalToWorldMatrix{mat4_t{1.0f}}, NormalMatrix{mat4_t{1.0f}});
+	}
+
+	auto update = [](auto& p, auto& r, auto& s, auto& LtoW, auto& normal) {
+		LtoW() = glm::translate(mat4_t{1.0f}, p()) * mat4_t(r()) * glm::scale(mat4_t{1.0f}, s());
+		normal() = glm::inverse(glm::transpose(LtoW()));
+	};
+
+	std::vector<uint32_t> threadCounts;
+	for( uint32_t threads = 1; threads < std::thread::hardware_concurrency(); threads *= 2 ) threadCounts.push_back(threads);
+	threadCounts.push_back( std::max(1u, std::thread::hardware_concurrency()) );
+
+	double serialMs = 0.0;
+	for( auto threads : threadCounts ) {
+		vve::JobPool pool{ threads };
+		double ms = 0.0;
+		for( size_t it = 0; it < iterations; ++it ) {
+			auto start = std::chrono::high_resolution_clock::now();
+			pool.ParallelForEach(registry.template GetView<vve::Position&, vve::Rotation&, vve::Scale&, vve::LocalToWorldMatrix&, NormalMatrix&>(), update);
+			ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+		ms /= iterations;
+		if( threads == 1 ) serialMs = ms;
+		std::cout << std::format("Threads {:2}: {} entities {:.3f} ms, speedup {:.2f}\n", threads, numEntities, ms, serialMs / ms);
+	}
+
+	// the serial part of ParallelForEach
+	double gatherMs = 0.0;
+	for( size_t it = 0; it < iterations; ++it ) {
+		auto start = std::chrono::high_resolution_clock::now();
+		auto view = registry.template GetView<vve::Position&, vve::Rotation&, vve::Scale&, vve::LocalToWorldMatrix&, NormalMatrix&>();
+		std::vector<std::decay_t<decltype(*view.begin())>> entries;
+		for( auto&& entry : view ) { entries.push_back(entry); }
+		gatherMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+	gatherMs /= iterations;
+	std::cout << std::format("Gather: {} entities {:.3f} ms, {:.1f}% of one thread\n", numEntities, gatherMs, 100.0 * gatherMs / serialMs);
+	return 0;
+}
+
@@ -20,7 +20,6 @@ class MyGame : public vve::System {
 
             m_engine.RegisterCallbacks( { 
                 {this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
-                {this,  10000, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
 			    {this,      0, "SDL_KEY_DOWN", [this](Message& message){ return OnKeyDown(message);} },
                 {this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
             } );
@@ -42,9 +41,8 @@ class MyGame : public vve::System {
             auto pos = body->m_positionW;													// New position of the scene node
 	        auto orient = body->m_orientationLW;											// New orientation of the scende node
 	        body->stepPosition(dt, pos, orient, false);										// Extrapolate
-            auto model = vpe::VPEWorld::Body::computeModel(pos, orient, body->m_scale);
 	        vecs::Handle node = vecs::Handle(reinterpret_cast<size_t>(body->m_owner));		// Owner is a handle to a scene node
-            m_registry.Put(node, vve::Position(vpe::fromPhysics(pos)), vve::Rotation(vpe::fromPhysics(toMat3(orient))));
+            m_transforms->push_back({ vve::ObjectHandle{node}, vec3_t{vpe::fromPhysics(pos)}, quat_t{glm::quat_cast(vpe::fromPhysics(glm::toMat3(orient)))} });
         };
 
         inline static vpe::VPEWorld::callback_erase onErase = [](std::shared_ptr<vpe::VPEWorld::Body> body) {
@@ -91,21 +89,16 @@ class MyGame : public vve::System {
 
 			//m_engine.PlaySound(vve::Filename{"assets/sounds/dance.mp3"}, -1, 50);
 			m_engine.SetVolume(m_volume);
+            m_simulation.Start();
             return false;
         };
     
-        bool OnUpdate( Message& message ) {
-            auto msg = message.template GetData<vve::System::MsgUpdate>();
-            auto dt = msg.m_dt;
-            m_physics.tick(dt);
-            return false;
-        }
-
         bool OnKeyDown(Message message) {
 			auto msg = message.template GetData<MsgKeyDown>();
 			auto key = msg.m_key;
 
             if( key == SDL_SCANCODE_B  ) { 
+                auto lock = m_simulation.Lock();    // The physics world is stepped on the simulation thread
                 static uint64_t body_id{0};
                 auto [pn, rn, sn, LtoPn] = m_registry.template Get<vve::Position&, vve::Rotation&, vve::Scale&, vve::LocalToParentMatrix>(m_cameraNodeHandle);
 		        auto [pc, rc, sc, LtoPc] = m_registry.template Get<vve::Position&, vve::Rotation&, vve::Scale&, vve::LocalToParentMatrix>(m_cameraHandle);	
@@ -142,7 +135,10 @@ class MyGame : public vve::System {
 				body->m_on_move = onMove;
 				body->m_on_erase = onErase;
 
+                std::vector<vve::Engine::TransformInfo> initial;
+                m_transforms = &initial;            // The simulation sets its own output again before the next step
                 onMove(0.0, body);
+                m_engine.SetTransforms(initial);    // The cube starts at the body, not at the origin
 				m_physics.addBody(body);
             }
 
@@ -166,6 +162,9 @@ class MyGame : public vve::System {
 
     private:
     	vpe::VPEWorld m_physics;
+        std::vector<vve::Engine::TransformInfo>* m_transforms{};  // Output of the current simulation step
+        vve::SimulationThread m_simulation{ "MyGame Simulation", m_engine, 1.0 / 60.0, 
+            [this](double dt, std::vector<vve::Engine::TransformInfo>& transforms) { m_transforms = &transforms; m_physics.tick(dt); } };
 
         vecs::Handle m_handlePlane{};
         vecs::Handle m_handleCube{};
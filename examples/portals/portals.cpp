@@ -0,0 +1,107 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief A grid of rooms connected by doorways. Each room is a portal cell, only objects in rooms that can be
+ * seen through the doorways are drawn.
+ */
+class Portals : public vve::System {
+
+public:
+	Portals( vve::Engine& engine ) : vve::System("Portals", engine ) {
+		m_engine.RegisterCallbacks( {
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
+		} );
+	};
+
+	~Portals() {};
+
+	inline static const std::string sphere_obj  { "assets/standard/sphere.obj" };
+	inline static const std::string sphere_mesh { "assets/standard/sphere.obj/sphere" };
+	inline static const int c_rooms = 4;				//the level has c_rooms x c_rooms rooms
+	inline static const int c_objectsPerRoom = 8;
+	inline static const real_t c_roomSize = 10.0f;
+	inline static const real_t c_roomHeight = 4.0f;
+	inline static const real_t c_doorWidth = 2.0f;
+	inline static const real_t c_doorHeight = 3.0f;
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{sphere_obj} );
+
+		// cells and doorways in the middle of the shared walls
+		for( int y = 0; y < c_rooms; ++y ) {
+			for( int x = 0; x < c_rooms; ++x ) {
+				m_portals.AddCell( vec3_t{x * c_roomSize, y * c_roomSize, 0.0f}, vec3_t{(x + 1) * c_roomSize, (y + 1) * c_roomSize, c_roomHeight} );
+			}
+		}
+		real_t d = (c_roomSize - c_doorWidth) / 2.0f;
+		for( int y = 0; y < c_rooms; ++y ) {
+			for( int x = 0; x < c_rooms; ++x ) {
+				uint32_t cell = y * c_rooms + x;
+				real_t wx = (x + 1) * c_roomSize, wy = (y + 1) * c_roomSize;
+				if( x + 1 < c_rooms ) {
+					m_portals.AddPortal(cell, cell + 1, { vec3_t{wx, y * c_roomSize + d, 0.0f}, vec3_t{wx, wy - d, 0.0f},
+														  vec3_t{wx, wy - d, c_doorHeight}, vec3_t{wx, y * c_roomSize + d, c_doorHeight} } );
+				}
+				if( y + 1 < c_rooms ) {
+					m_portals.AddPortal(cell, cell + c_rooms, { vec3_t{x * c_roomSize + d, wy, 0.0f}, vec3_t{wx - d, wy, 0.0f},
+																vec3_t{wx - d, wy, c_doorHeight}, vec3_t{x * c_roomSize + d, wy, c_doorHeight} } );
+				}
+			}
+		}
+
+		// objects in the rooms
+		std::default_random_engine rnd{ 12345 };
+		std::uniform_real_distribution<float> unif{ 0.0f, 1.0f };
+		std::vector<vve::Engine::ObjectInfo> objects;
+		for( int y = 0; y < c_rooms; ++y ) {
+			for( int x = 0; x < c_rooms; ++x ) {
+				for( int i = 0; i < c_objectsPerRoom; ++i ) {
+					objects.push_back( {
+						.m_meshName = vve::MeshName{sphere_mesh},
+						.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {unif(rnd), unif(rnd), unif(rnd), 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+						.m_position = vve::Position{ vec3_t{ (x + 0.1f + 0.8f * unif(rnd)) * c_roomSize, (y + 0.1f + 0.8f * unif(rnd)) * c_roomSize, 0.5f + unif(rnd) * 2.0f } },
+						.m_scale = vve::Scale{ vec3_t{0.01f} }
+					} );
+				}
+			}
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, objects);
+		m_portals.AssignObjects();
+
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		auto pos = m_registry.Get<vve::Position&>(parent);
+		pos() = vec3_t{ c_roomSize / 2.0f, c_roomSize / 2.0f, 1.5f };
+		return false;
+	};
+
+	bool OnRecordNextFrame(Message message) {
+		auto& stats = m_portals.GetStats();
+		ImGui::Begin("Portal Culling");
+		ImGui::Text("Cells visible: %zu of %d", stats.m_cellsVisible, c_rooms * c_rooms);
+		ImGui::Text("Objects visible: %zu, culled: %zu", stats.m_objectsVisible, stats.m_objectsCulled);
+		ImGui::Text("Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+		ImGui::End();
+		return false;
+	}
+
+private:
+	vve::PortalCulling m_portals{ "Portal Culling", m_engine };
+};
+
+
+
+int main() {
+	vve::Engine engine("My Engine", vve::RendererType::RENDERER_TYPE_FORWARD) ;
+	Portals portals{engine};
+	engine.Run();
+
+	return 0;
+}
+
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <fstream>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Flies the camera across a large generated world that is streamed in by a world partition.
+ */
+class Streaming : public vve::System {
+
+public:
+	Streaming( vve::Engine& engine ) : vve::System("Streaming", engine ) {
+		GenerateWorld();
+		m_engine.RegisterCallbacks( {
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this,  10000, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} }
+		} );
+	};
+
+	~Streaming() {};
+
+	inline static const std::string sphere_obj  { "assets/standard/sphere.obj" };
+	inline static const std::string sphere_mesh { "assets/standard/sphere.obj/sphere" };
+	inline static const int c_worldCells = 64;			//the world has c_worldCells x c_worldCells cells
+	inline static const int c_objectsPerCell = 16;
+	inline static const real_t c_cellSize = 20.0f;
+	inline static const real_t c_speed = 15.0f;
+
+	void GetCamera() {
+		if(m_cameraNodeHandle.IsValid() == false) {
+			auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+			m_cameraNodeHandle = parent;
+		};
+	}
+
+	/**
+	 * @brief Write the cell files of the test world, unless they exist already
+	 */
+	void GenerateWorld() {
+		std::filesystem::create_directories(m_directory);
+		if( std::filesystem::exists(vve::WorldPartition::CellFile(m_directory, c_worldCells - 1, c_worldCells - 1)) ) return;
+
+		std::default_random_engine rnd{ 12345 };
+		std::uniform_real_distribution<float> unif{ 0.0f, 1.0f };
+		for( int y = 0; y < c_worldCells; ++y ) {
+			for( int x = 0; x < c_worldCells; ++x ) {
+				std::ofstream out{ vve::WorldPartition::CellFile(m_directory, x, y) };
+				for( int i = 0; i < c_objectsPerCell; ++i ) {
+					out << sphere_mesh << " " << unif(rnd) << " " << unif(rnd) << " " << unif(rnd) << " "
+						<< (x + unif(rnd)) * c_cellSize << " " << (y + unif(rnd)) * c_cellSize << " " << unif(rnd) * 2.0f << " " << 0.01f << "\n";
+				}
+			}
+		}
+	}
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{sphere_obj} );
+		GetCamera();
+		auto pos = m_registry.Get<vve::Position&>(m_cameraNodeHandle);
+		pos() = vec3_t{ c_cellSize, c_cellSize * c_worldCells / 2.0f, 3.0f };
+		return false;
+	};
+
+	bool OnUpdate( Message& message ) {
+		auto msg = message.template GetData<vve::System::MsgUpdate>();
+		auto pos = m_registry.Get<vve::Position&>(m_cameraNodeHandle);
+		pos().x += c_speed * (real_t)msg.m_dt;
+		if( pos().x > c_cellSize * (c_worldCells - 1) ) pos().x = c_cellSize;
+		return false;
+	}
+
+	bool OnRecordNextFrame(Message message) {
+		auto& stats = m_partition.GetStats();
+		ImGui::Begin("World Partition");
+		ImGui::Text("Cells resident: %zu, pending: %zu", stats.m_cellsResident, stats.m_cellsPending);
+		ImGui::Text("Cells loaded: %zu, evicted: %zu", stats.m_cellsLoaded, stats.m_cellsEvicted);
+		ImGui::Text("Objects: %zu", stats.m_objects);
+		ImGui::Text("Cell content: %.1f KB", stats.m_bytesContent / 1024.0);
+		ImGui::Text("Streaming: %.3f ms (max %.3f ms)", stats.m_lastFrameMs, stats.m_maxFrameMs);
+		ImGui::Text("Frame: %.3f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+		ImGui::End();
+		return false;
+	}
+
+private:
+	std::filesystem::path m_directory{ std::filesystem::temp_directory_path() / "vve-streaming-world" };
+	vve::WorldPartition m_partition{ "Streaming World Partition", m_engine, m_directory, c_cellSize, 2, 2.0 };
+	vecs::Handle m_cameraNodeHandle{};
+};
+
+
+
+int main() {
+	vve::Engine engine("My Engine", vve::RendererType::RENDERER_TYPE_FORWARD) ;
+	Streaming streaming{engine};
+	engine.Run();
+
+	return 0;
+}
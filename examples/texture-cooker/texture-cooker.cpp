@@ -0,0 +1,40 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Offline texture cooker. Each given image file is cooked into a KTX2 file next to it, the usage is guessed
+ * from the file name. The asset manager loads the cooked file instead of the image. Runs on the CPU only.
+ */
+
+
+/**
+ * @brief Usage: texture-cooker [--hq] image files..., e.g. texture-cooker assets/textures/brick_normal.png
+ */
+int main(int argc, char* argv[]) {
+	std::vector<std::filesystem::path> files;
+	bool highQuality = false;
+	for( int i = 1; i < argc; ++i ) {
+		if( std::string{argv[i]} == "--hq" ) highQuality = true;
+		else files.push_back(argv[i]);
+	}
+	if( files.empty() ) {
+		std::cout << "Usage: texture-cooker [--hq] image files...\n";
+		return 1;
+	}
+
+	bool ok = true;
+	for( auto& file : files ) {
+		vve::CookOptions options{ vve::TextureCooker::GuessUsage(file), highQuality };
+		auto target = vve::TextureCooker::CookedPath(file);
+		bool cooked = vve::TextureCooker::CookFile(file, target, options);
+		std::cout << std::format("{} -> {}: {}\n", file.string(), target.string(), cooked ? "ok" : "FAILED");
+		ok = ok && cooked;
+	}
+	return ok ? 0 : 1;
+}
+
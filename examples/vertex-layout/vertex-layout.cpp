@@ -0,0 +1,153 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <chrono>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Separate versus interleaved vertex streams. A grid of objects sharing one mesh is rendered with the forward
+ * renderer, once with one vertex buffer binding per attribute stream and once with a single interleaved stream.
+ * For both layouts the CPU time of recording the objects and the GPU time of a frame are measured. The GPU time
+ * is taken from the submit of the frame until the queue is idle, so it is dominated by vertex fetch when the mesh
+ * is dense. Needs a Vulkan device, e.g. lavapipe.
+ */
+
+
+/**
+ * @brief Measurements of one layout
+ */
+struct Timing {
+	double m_recordMs{0.0};		//average CPU time of the forward renderer recording
+	double m_gpuMs{0.0};		//average GPU time from submit to idle
+	size_t m_bindings{0};		//vertex buffer bindings per frame
+	size_t m_vertexBytes{0};	//size of the mesh vertex buffer
+};
+
+
+/**
+ * @brief Creates the objects and measures recording and GPU time over a number of frames
+ */
+class LayoutBenchmark : public vve::System {
+
+	using clock = std::chrono::high_resolution_clock;
+
+public:
+	LayoutBenchmark( vve::Engine& engine, std::filesystem::path file, size_t rows, bool interleave )
+		: vve::System("Vertex Layout Benchmark", engine ), m_file{file}, m_rows{rows}, m_interleave{interleave} {
+		m_engine.RegisterCallbacks( {
+			{this, -1000, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },	//before the default level
+			{this,  1999, "RECORD_NEXT_FRAME", [this](Message& message){ m_recordStart = clock::now(); return false;} },
+			{this,  2001, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordEnd(message);} },
+			{this, -1000, "RENDER_NEXT_FRAME", [this](Message& message){ m_renderStart = clock::now(); return false;} },
+			{this,  1000, "RENDER_NEXT_FRAME", [this](Message& message){ return OnRenderEnd(message);} },
+			{this,     0, "FRAME_END", [this](Message& message){ return OnFrameEnd(message);} }
+		} );
+	};
+
+	~LayoutBenchmark() {};
+
+	inline static const int c_warmup = 10;		//frames before measuring
+	inline static const int c_frames = 200;		//measured frames
+
+	bool OnLoadLevel( Message message ) {
+		auto assets = dynamic_cast<vve::AssetManager*>(m_engine.GetSystem(m_engine.m_assetManagerName));
+		assets->SetVertexInterleaving(m_interleave);
+		m_engine.LoadScene( vve::Filename{m_file.string()} );
+
+		// the densest mesh of the file
+		std::string meshName;
+		for( auto [name, mesh] : m_registry.GetView<vve::Name, vvh::Mesh&>() ) {
+			if( !name().starts_with(m_file.string()) ) continue;
+			if( mesh().m_verticesData.getSize() > m_timing.m_vertexBytes ) {
+				m_timing.m_vertexBytes = (size_t)mesh().m_verticesData.getSize();
+				m_streams = mesh().m_verticesData.getOffsets().size();
+				meshName = name();
+			}
+		}
+
+		std::vector<vve::Engine::ObjectInfo> objects;
+		for( size_t y = 0; y < m_rows; ++y ) {
+			for( size_t x = 0; x < m_rows; ++x ) {
+				objects.push_back( {
+					.m_meshName = vve::MeshName{meshName},
+					.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {0.2f + 0.8f * x / m_rows, 0.2f + 0.8f * y / m_rows, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+					.m_position = vve::Position{ vec3_t{ ((real_t)x - m_rows / 2.0f) * 0.5f, ((real_t)y - m_rows / 2.0f) * 0.5f, 0.0f } },
+					.m_scale = vve::Scale{ vec3_t{0.002f} }
+				} );
+			}
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, objects);
+		return false;
+	}
+
+	bool OnRecordEnd( Message message ) {
+		if( m_frames >= c_warmup ) m_record += std::chrono::duration<double, std::milli>(clock::now() - m_recordStart).count();
+		return false;
+	}
+
+	bool OnRenderEnd( Message message ) {
+		auto state = std::get<1>(vve::Renderer::GetState(m_registry));
+		vkQueueWaitIdle(state().m_graphicsQueue);
+		if( m_frames >= c_warmup ) m_gpu += std::chrono::duration<double, std::milli>(clock::now() - m_renderStart).count();
+		return false;
+	}
+
+	bool OnFrameEnd( Message message ) {
+		if( ++m_frames < c_warmup + c_frames ) return false;
+		m_timing.m_recordMs = m_record / c_frames;
+		m_timing.m_gpuMs = m_gpu / c_frames;
+		m_timing.m_bindings = m_rows * m_rows * m_streams;
+		m_engine.Stop();
+		return false;
+	}
+
+	Timing m_timing{};
+
+private:
+	std::filesystem::path m_file;
+	size_t m_rows;
+	bool m_interleave;
+	size_t m_streams{0};
+	int m_frames{0};
+	double m_record{0.0};
+	double m_gpu{0.0};
+	clock::time_point m_recordStart{};
+	clock::time_point m_renderStart{};
+};
+
+
+/**
+ * @brief Run the benchmark for one layout in a new engine
+ * @param file The model file
+ * @param rows Objects per row of the grid
+ * @param interleave Use interleaved vertex buffers
+ * @return The measurements
+ */
+auto Run(std::filesystem::path file, size_t rows, bool interleave) -> Timing {
+	vve::Engine engine("Vertex Layout", vve::RendererType::RENDERER_TYPE_FORWARD);
+	LayoutBenchmark benchmark{engine, file, rows, interleave};
+	engine.Run();
+	return benchmark.m_timing;
+}
+
+
+/**
+ * @brief Usage: vertex-layout [model file] [objects per row], e.g. vertex-layout assets/viking_room/viking_room.obj 20
+ */
+int main(int argc, char* argv[]) {
+	std::filesystem::path file = argc > 1 ? argv[1] : "assets/standard/sphere.obj";
+	size_t rows = argc > 2 ? std::stoull(argv[2]) : 20;
+
+	auto split = Run(file, rows, false);
+	auto interleaved = Run(file, rows, true);
+
+	std::cout << std::format("{} x {} objects of {} ({} bytes of vertices)\n", rows, rows, file.string(), split.m_vertexBytes);
+	std::cout << std::format("{:<12} {:>10} {:>10} {:>18}\n", "Layout", "record ms", "GPU ms", "bindings / frame");
+	for( auto [name, timing] : { std::pair{"separate", split}, std::pair{"interleaved", interleaved} } ) {
+		std::cout << std::format("{:<12} {:>10.3f} {:>10.3f} {:>18}\n", name, timing.m_recordMs, timing.m_gpuMs, timing.m_bindings);
+	}
+	return 0;
+}
@@ -19,6 +19,101 @@ namespace vve {
          */
         virtual ~AssetManager();
 
+		inline static const std::string c_placeholderMesh { "VVE Placeholder Mesh" };		//used by objects of async scenes and of reloading assets until their mesh is created
+		inline static const std::string c_placeholderTexture { "VVE Placeholder Texture" };
+		inline static const uint32_t c_cacheVersion = 3;	//change when the mesh cache format or the conversion changes
+
+		/**
+		 * @brief Time of one scene import, from the mesh cache (warm) or through Assimp (cold)
+		 */
+		struct ImportTime {
+			std::string m_scene;
+			bool m_cached{false};				//read from the mesh cache
+			double m_ms{0.0};
+			double m_acmrBefore{0.0};			//vertex cache statistics of all meshes before and after optimization,
+			double m_acmrAfter{0.0};			//only known for imports through Assimp
+			double m_atvrBefore{0.0};
+			double m_atvrAfter{0.0};
+		};
+
+		/**
+		 * @brief Memory of the meshes and textures loaded from scene files, see SetMemoryBudget
+		 */
+		struct Residency {
+			size_t m_assets{0};					//resident meshes and textures
+			size_t m_referenced{0};				//resident assets used by at least one object
+			size_t m_cpuBytes{0};				//vertex and index data kept on the CPU
+			size_t m_gpuBytes{0};				//vertex, index and texture data on the GPU
+			size_t m_evicted{0};				//evictions so far
+			size_t m_reloaded{0};				//reloads of evicted assets so far
+		};
+
+		/**
+		 * @brief Set the directory of the mesh cache, an empty path disables the cache
+		 * @param directory The directory, it is created when the first scene is cached
+		 */
+		void SetCacheDirectory(std::filesystem::path directory) { m_cacheDirectory = directory; }
+
+		/**
+		 * @brief Get the directory of the mesh cache
+		 * @return The directory, empty if the cache is disabled
+		 */
+		auto GetCacheDirectory() const -> const std::filesystem::path& { return m_cacheDirectory; }
+
+		/**
+		 * @brief Turn the optimization of imported meshes for vertex cache, overdraw and vertex fetch on or off
+		 * @param optimize true to optimize, the default
+		 */
+		void SetMeshOptimization(bool optimize) { m_optimizeMeshes = optimize; }
+
+		/**
+		 * @brief Turn quantized vertex buffers for loaded meshes on or off, see vvh::VertexData
+		 * @param quantize true to quantize, off by default
+		 */
+		void SetVertexQuantization(bool quantize) { m_quantizeVertices = quantize; }
+
+		/**
+		 * @brief Turn interleaved vertex buffers for loaded meshes on or off, see vvh::VertexData. Meshes whose
+		 * streams have different lengths keep separate streams.
+		 * @param interleave true to interleave, off by default
+		 */
+		void SetVertexInterleaving(bool interleave) { m_interleaveVertices = interleave; }
+
+		/**
+		 * @brief Turn 16 bit index buffers for loaded meshes with at most 65536 vertices on or off, see vvh::Mesh
+		 * @param small true to choose the index width per mesh, on by default
+		 */
+		void SetSmallIndices(bool small) { m_smallIndices = small; }
+
+		/**
+		 * @brief Generate levels of detail for the meshes of imported scenes, see LevelOfDetail. They are generated on
+		 * the job pool while importing and stored in the mesh cache. Set by the LevelOfDetail system, off by default.
+		 * @param levels Maximum number of coarser levels per mesh, 0 for none
+		 * @param minTriangles Meshes with fewer triangles get no levels
+		 */
+		void SetLevelsOfDetail(uint32_t levels, size_t minTriangles) { m_lodLevels = levels; m_lodMinTriangles = minTriangles; }
+
+		/**
+		 * @brief Set the memory budget of the meshes and textures loaded from scene files. When it is exceeded,
+		 * assets no object uses are evicted, least recently used first, and reloaded from the mesh cache or their
+		 * cooked texture when an object uses them again. Assets in use are never evicted.
+		 * @param cpuBytes Budget for vertex and index data on the CPU, 0 for no limit
+		 * @param gpuBytes Budget for vertex, index and texture data on the GPU, 0 for no limit
+		 */
+		void SetMemoryBudget(size_t cpuBytes, size_t gpuBytes) { m_cpuBudget = cpuBytes; m_gpuBudget = gpuBytes; }
+
+		/**
+		 * @brief Get the memory of the meshes and textures loaded from scene files
+		 * @return Current memory and eviction counts
+		 */
+		auto GetResidency() const -> Residency;
+
+		/**
+		 * @brief Get the times of all scene imports so far, in the order they finished
+		 * @return The import times
+		 */
+		auto GetImportTimes() const -> const std::vector<ImportTime>& { return m_importTimes; }
+
     private:
 		/**
 		 * @brief Handle scene creation message
@@ -27,6 +122,13 @@ namespace vve {
 		 */
 		bool OnSceneCreate(Message& message);
 
+		/**
+		 * @brief Continue incremental imports within the budget of the load step
+		 * @param message Load step message
+		 * @return false to continue message propagation
+		 */
+		bool OnLoadStep(Message& message);
+
 		/**
 		 * @brief Handle scene load message
 		 * @param message Message containing scene load data
@@ -48,6 +150,13 @@ namespace vve {
 		 */
 		bool OnObjectCreate(Message message);
 
+		/**
+		 * @brief Handle batch object creation message
+		 * @param message Message containing the object handles
+		 * @return True if message was handled
+		 */
+		bool OnObjectsCreate(Message message);
+
 		/**
 		 * @brief Handle texture creation message
 		 * @param message Message containing texture creation data
@@ -62,6 +171,34 @@ namespace vve {
 		 */
 		bool OnTextureRelease(Message message);
 
+		/**
+		 * @brief Release the mesh and texture of a destroyed object
+		 * @param message Message containing the object handle
+		 * @return false to continue message propagation
+		 */
+		bool OnObjectDestroy(Message message);
+
+		/**
+		 * @brief Forget the memory of a destroyed mesh or texture
+		 * @param message Mesh or texture destroy message
+		 * @return false to continue message propagation
+		 */
+		bool OnAssetDestroy(Message message);
+
+		/**
+		 * @brief Count the frame and evict unused assets if the budget is exceeded
+		 * @param message Frame end message
+		 * @return false to continue message propagation
+		 */
+		bool OnFrameEnd(Message message);
+
+		/**
+		 * @brief Add prefabs, the file name map and pending imports to a memory report
+		 * @param message Memory report message
+		 * @return false to continue message propagation
+		 */
+		bool OnMemoryReport(Message message);
+
 		/**
 		 * @brief Handle play sound message
 		 * @param message Message containing sound playback data
@@ -70,22 +207,296 @@ namespace vve {
 		bool OnPlaySound(Message& message);
 
 		/**
-		 * @brief Load texture data from file
+		 * @brief Load texture data from file, or from its cooked KTX2 file
 		 * @param handle Handle to the texture to load
 		 * @return Pointer to loaded texture data
 		 */
 		auto LoadTexture(TextureHandle handle) -> stbi_uc*;
 
 		/**
-		 * @brief Load a scene from file
+		 * @brief Load a diffuse texture of a scene
+		 * @param filepath Path of the scene file
+		 * @param fileName File name of the texture
+		 */
+		void SceneLoadTexture(const std::filesystem::path& filepath, const std::string& fileName);
+
+		/**
+		 * @brief Convert an Assimp mesh, does not use the registry and can run on a worker thread
+		 * @param mesh The mesh
+		 * @return The converted mesh
+		 */
+		static auto ConvertMesh(aiMesh* mesh) -> vvh::Mesh;
+
+		/**
+		 * @brief Get the prefab of a scene file, importing the file on first use
 		 * @param sceneName Filename of the scene
-		 * @param scene Pointer to the Assimp scene structure
-		 * @return True if scene was loaded successfully
+		 * @param flags Assimp post processing flags
+		 * @param mode Blocking, or create meshes and textures in later load steps, or import on a worker thread
+		 * @return Pointer to the prefab, or nullptr if the file could not be imported. An async prefab is empty
+		 * and loading until the import is done.
+		 */
+		auto LoadPrefab(Filename sceneName, aiPostProcessSteps flags, LoadMode mode = LoadMode::LOAD_MODE_BLOCKING) -> const Prefab*;
+
+		/**
+		 * @brief Recursively add the nodes of an Assimp scene hierarchy to a prefab
+		 * @param node Current node being processed
+		 * @param parent Index of the parent node in the prefab, -1 for the root
+		 * @param filepath Path to the model file
+		 * @param scene Pointer to the Assimp scene data
+		 * @param id Reference to unique node ID counter
+		 * @param prefab The prefab that receives the nodes
 		 */
-		bool SceneLoad(Filename sceneName, const C_STRUCT aiScene* scene);
+		static void PrefabAddNode(aiNode* node, int32_t parent, std::filesystem::path& filepath, const aiScene* scene, uint64_t& id, Prefab& prefab);
 
 	private:
+		/**
+		 * @brief A converted mesh of a scene, waiting to be created
+		 */
+		struct ImportedMesh {
+			std::filesystem::path m_scene;
+			std::string m_name;
+			vvh::Mesh m_mesh;
+			aiPostProcessSteps m_flags{};				//import flags of the scene, to reload the mesh
+			std::vector<vvh::Mesh> m_lods;				//coarser levels of detail, level 1 first
+		};
+
+		/**
+		 * @brief Result of importing a scene, does not use the registry
+		 */
+		struct ImportResult {
+			Prefab m_prefab;
+			std::vector<ImportedMesh> m_meshes;
+			std::vector<std::string> m_textures;		//file names of the diffuse textures
+			std::string m_error;						//empty if the import succeeded
+			ImportTime m_time;
+		};
+
+		/**
+		 * @brief A scene whose textures and meshes are created incrementally
+		 */
+		struct PendingImport {
+			Filename m_sceneName;
+			std::vector<ImportedMesh> m_meshes;
+			std::vector<std::string> m_textures;
+			size_t m_nextTexture{0};
+			size_t m_nextMesh{0};
+		};
+
+		/**
+		 * @brief A scene imported on a worker thread
+		 */
+		struct AsyncImport {
+			Filename m_sceneName;
+			std::string m_key;							//key of the prefab in the cache
+			Prefab* m_prefab;							//the cached prefab, filled when the import is done
+			std::future<ImportResult> m_future;
+		};
+
+		/**
+		 * @brief A scene imported again on a worker thread, to reload evicted meshes
+		 */
+		struct AsyncReload {
+			std::filesystem::path m_scene;
+			aiPostProcessSteps m_flags{};
+			std::vector<std::string> m_meshes;			//evicted meshes waiting for the import
+			std::future<ImportResult> m_future;
+		};
+
+		/**
+		 * @brief A texture waiting for or being decoded on a worker thread
+		 */
+		struct AsyncTexture {
+			std::filesystem::path m_scene;
+			std::string m_name;
+			std::future<vvh::Image> m_future;			//invalid while waiting for a worker
+		};
+
+		/**
+		 * @brief Reference count and memory of a mesh or texture. Assets loaded from a scene file remember the file,
+		 * so they can be reloaded after they were evicted.
+		 */
+		struct Asset {
+			std::filesystem::path m_scene;				//empty if the asset was not loaded from a scene file
+			aiPostProcessSteps m_flags{};
+			bool m_mesh{false};
+			bool m_resident{false};
+			size_t m_refs{0};							//objects using the asset
+			uint64_t m_lastUse{0};						//frame in which the asset was created or last released
+			size_t m_cpuBytes{0};
+			size_t m_gpuBytes{0};
+		};
+
+		/**
+		 * @brief Create a converted mesh and its levels of detail and announce them, skipped if a mesh with the same name exists
+		 * @param mesh The mesh
+		 * @return Handle of the mesh, invalid if it was skipped
+		 */
+		auto SceneLoadMesh(ImportedMesh&& mesh) -> vecs::Handle;
+
+		/**
+		 * @brief Create a decoded texture of a scene and announce it
+		 * @param scene Path of the scene file
+		 * @param name File name of the texture
+		 * @param image The decoded texture
+		 * @return Handle of the texture
+		 */
+		auto SceneAddTexture(const std::filesystem::path& scene, const std::string& name, vvh::Image&& image) -> TextureHandle;
+
+		/**
+		 * @brief Remember the memory of an asset loaded from a scene file
+		 * @param name Name of the asset
+		 * @param scene Path of the scene file
+		 * @param flags Import flags of the scene
+		 * @param mesh true for a mesh, false for a texture
+		 * @param cpuBytes Memory on the CPU
+		 * @param gpuBytes Memory on the GPU
+		 */
+		void MakeResident(const std::string& name, const std::filesystem::path& scene, aiPostProcessSteps flags, bool mesh, size_t cpuBytes, size_t gpuBytes);
+
+		/**
+		 * @brief Count an object using an asset, and reload the asset if it was evicted
+		 * @param name Name of the asset
+		 */
+		void AcquireAsset(const std::string& name);
+
+		/**
+		 * @brief Count an object no longer using an asset
+		 * @param name Name of the asset
+		 */
+		void ReleaseAsset(const std::string& name);
+
+		/**
+		 * @brief Start reloading an evicted asset on a worker thread, objects get the placeholder until it is created
+		 * @param name Name of the asset
+		 */
+		void ReloadAsset(const std::string& name);
+
+		/**
+		 * @brief Evict unused assets, least recently used first, until the memory is within the budget
+		 */
+		void EvictAssets();
+
+		/**
+		 * @brief Import a scene, convert its meshes and collect its textures. Reads the mesh cache if it has
+		 * the scene, otherwise imports with Assimp and writes the cache. Can run on a worker thread.
+		 * @param sceneName Filename of the scene
+		 * @param flags Assimp post processing flags
+		 * @param cacheDirectory Directory of the mesh cache, empty to disable the cache
+		 * @param optimize Optimize the meshes with the MeshOptimizer
+		 * @param lodLevels Maximum number of levels of detail per mesh, 0 for none
+		 * @param lodMinTriangles Meshes with fewer triangles get no levels of detail
+		 * @param jobPool Threads for converting the meshes
+		 * @return Prefab, meshes and texture names of the scene
+		 */
+		static auto ImportScene(Filename sceneName, aiPostProcessSteps flags, std::filesystem::path cacheDirectory, bool optimize,
+			uint32_t lodLevels, size_t lodMinTriangles, JobPool& jobPool) -> ImportResult;
+
+		/**
+		 * @brief Hash the content of a scene file, its material or buffer file with the same stem, the import flags
+		 * and the cache version
+		 * @param sceneName Filename of the scene
+		 * @param flags Assimp post processing flags
+		 * @param optimize The meshes are optimized
+		 * @param lodLevels Maximum number of levels of detail per mesh
+		 * @param lodMinTriangles Meshes with fewer triangles get no levels of detail
+		 * @return The hash, 0 if the file could not be read
+		 */
+		static auto SceneHash(Filename sceneName, aiPostProcessSteps flags, bool optimize, uint32_t lodLevels, size_t lodMinTriangles) -> uint64_t;
+
+		/**
+		 * @brief Read a scene from the mesh cache
+		 * @param file The cache file
+		 * @param sceneName Filename of the scene
+		 * @param hash Hash of the scene
+		 * @return The scene, or nullopt if the file does not exist or does not match
+		 */
+		static auto ReadCache(const std::filesystem::path& file, Filename sceneName, uint64_t hash) -> std::optional<ImportResult>;
+
+		/**
+		 * @brief Write a scene to the mesh cache, through a temporary file that is renamed when complete
+		 * @param file The cache file
+		 * @param hash Hash of the scene
+		 * @param result The imported scene
+		 * @return true if the file was written
+		 */
+		static auto WriteCache(const std::filesystem::path& file, uint64_t hash, const ImportResult& result) -> bool;
+
+		/**
+		 * @brief Remember and print the time of an import
+		 * @param time The import time
+		 */
+		void ReportImport(const ImportTime& time);
+
+		/**
+		 * @brief Decode a texture file, or read its cooked KTX2 file if there is one. Can run on a worker thread.
+		 * @param fileName File name of the texture
+		 * @return The image with its pixels allocated with malloc, m_pixels is nullptr if the file could not be read
+		 */
+		static auto DecodeTexture(std::string fileName) -> vvh::Image;
+
+		/**
+		 * @brief Take the results of finished imports and reloads and start texture decodes
+		 */
+		void PollAsync();
+
+		/**
+		 * @brief Create one converted mesh or decoded texture and hand it to the renderers
+		 * @return false if no asset is ready
+		 */
+		auto CreateAsyncAsset() -> bool;
+
+		/**
+		 * @brief Create the placeholder mesh and texture if they do not exist
+		 */
+		void CreatePlaceholders();
+
+		/**
+		 * @brief Get the handle of a mesh or texture for an object. If the asset is still loading, the object
+		 * gets the placeholder and is remembered
+		 * @param oHandle The object
+		 * @param name Name of the asset
+		 * @param placeholder Handle of the placeholder
+		 * @return Handle of the asset or of the placeholder
+		 */
+		auto ResolveAsset(ObjectHandle oHandle, const std::string& name, vecs::Handle placeholder) -> vecs::Handle;
+
+		/**
+		 * @brief Replace the placeholder by a created asset in all objects waiting for it
+		 * @param name Name of the asset
+		 * @param handle Handle of the asset
+		 */
+		void ReplacePlaceholders(const std::string& name, vecs::Handle handle);
+
 		std::unordered_multimap<std::filesystem::path, std::string> m_fileNameMap; //from path to string
+		std::unordered_map<std::string, Prefab> m_prefabs; //from path and import flags to prefab, node based -> pointers are stable
+		std::deque<PendingImport> m_pendingImports;
+		std::deque<AsyncImport> m_asyncImports;
+		std::vector<decltype(m_prefabs)::node_type> m_failedPrefabs; //removed from the cache, kept until the scene manager saw them
+		std::deque<AsyncReload> m_asyncReloads;
+		std::deque<ImportedMesh> m_asyncMeshes;
+		std::deque<AsyncTexture> m_asyncTextures;
+		std::unordered_map<std::string, std::vector<ObjectHandle>> m_waiting; //asset name to objects using a placeholder
+		MeshHandle m_placeholderMesh{};
+		TextureHandle m_placeholderTexture{};
+		size_t m_maxDecodes{ std::max(1u, std::thread::hardware_concurrency() / 2) }; //textures decoded at the same time
+		size_t m_loadTotal{0}; //units of the pending imports
+		size_t m_loadDone{0};
+		std::filesystem::path m_cacheDirectory{ std::filesystem::temp_directory_path() / "vve-mesh-cache" };
+		std::vector<ImportTime> m_importTimes;
+		bool m_optimizeMeshes{true};
+		bool m_quantizeVertices{false};
+		bool m_interleaveVertices{false};
+		bool m_smallIndices{true};
+		uint32_t m_lodLevels{0};
+		size_t m_lodMinTriangles{0};
+		std::unordered_map<std::string, Asset> m_assets;	//asset name to reference count and memory
+		size_t m_cpuBudget{0};			//0 for no limit
+		size_t m_gpuBudget{0};
+		size_t m_cpuBytes{0};			//memory of the resident assets loaded from scene files
+		size_t m_gpuBytes{0};
+		size_t m_evicted{0};
+		size_t m_reloaded{0};
+		uint64_t m_frame{0};
     };
 
 };  // namespace vve
@@ -0,0 +1,94 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Change tracking for registry entities. Writers touch an entity when they change it, this stores the
+	 * number of the frame as version of the entity and appends the entity to a log sorted by frame. Readers ask for
+	 * all entities changed since a frame, which only visits the log entries of these frames, so unchanged entities
+	 * are never scanned and nothing is written into the registry. The log keeps a limited number of frames; readers
+	 * that fall further behind are told to rescan everything.
+     */
+    class ChangeTracker {
+
+    public:
+        /**
+         * @brief Constructor for the ChangeTracker class
+         * @param history Number of frames kept in the log
+         */
+        ChangeTracker(uint64_t history = 16);
+
+        /**
+         * @brief Destructor for the ChangeTracker class
+         */
+        ~ChangeTracker() = default;
+
+		/**
+		 * @brief Start a new frame, drops log entries older than the history
+		 */
+		void NextFrame();
+
+		/**
+		 * @brief Get the number of the current frame, the first frame is 1
+		 * @return The frame number
+		 */
+		auto GetFrame() const -> uint64_t { return m_frame; }
+
+		/**
+		 * @brief Mark an entity as changed in the current frame
+		 * @param handle The entity
+		 */
+		void Touch(vecs::Handle handle);
+
+		/**
+		 * @brief Forget an entity, e.g. when it is erased from the registry
+		 * @param handle The entity
+		 */
+		void Erase(vecs::Handle handle);
+
+		/**
+		 * @brief Get the frame an entity was last changed in
+		 * @param handle The entity
+		 * @return The frame number, or 0 if the entity has not been changed
+		 */
+		auto GetVersion(vecs::Handle handle) const -> uint64_t;
+
+		/**
+		 * @brief Get the entities changed in a frame or later, each entity is returned once
+		 * @param frame The first frame to look at
+		 * @param changed Receives the changed entities, the vector is cleared first
+		 * @return False if the log does not reach back to the frame, the caller must then treat all entities as changed
+		 */
+		auto GetChangedSince(uint64_t frame, std::vector<vecs::Handle>& changed) const -> bool;
+
+		/**
+		 * @brief Get the number of entries in the log
+		 * @return Number of entries
+		 */
+		auto GetLogSize() const -> size_t { return m_log.size() - m_first; }
+
+		/**
+		 * @brief Get the CPU memory of the log and the versions
+		 * @return Number of bytes
+		 */
+		auto GetMemoryBytes() const -> size_t;
+
+    private:
+		struct Change {
+			uint64_t m_frame;
+			vecs::Handle m_handle;
+		};
+
+		uint64_t m_history;
+		uint64_t m_frame{1};
+		uint64_t m_oldest{0};										//log is complete from this frame on
+		std::vector<Change> m_log;									//sorted by frame, entries before m_first are dropped
+		size_t m_first{0};
+		std::unordered_map<size_t, uint64_t> m_versions;			//handle value to frame of last change
+    };
+
+};  // namespace vve
+
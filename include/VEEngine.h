@@ -5,6 +5,28 @@ namespace vve {
 
 	struct Camera;
 
+	/**
+	 * @brief Progress of incremental loading, e.g. for a loading screen. Counters are reset when all pending
+	 * work is done.
+	 */
+	struct LoadProgress {
+		size_t m_assetsDone{0};			//imports, materials, meshes and textures done
+		size_t m_assetsTotal{0};
+		size_t m_nodesDone{0};			//scene nodes instantiated
+		size_t m_nodesTotal{0};
+		size_t m_units{0};				//units of work done in the last step
+		double m_lastStepMs{0.0};		//time of the last step that did work
+		double m_maxStepMs{0.0};		//maximum step time since loading started
+		double m_maxUnitMs{0.0};		//maximum time of a single unit, a step can exceed the budget by this much
+		/** @brief True while there is pending work */
+		auto IsLoading() const -> bool { return m_assetsDone < m_assetsTotal || m_nodesDone < m_nodesTotal; }
+		/** @brief Fraction of the pending work that is done, 1 if nothing is pending */
+		auto Fraction() const -> float {
+			size_t total = m_assetsTotal + m_nodesTotal;
+			return total == 0 ? 1.0f : (float)(m_assetsDone + m_nodesDone) / (float)total;
+		}
+	};
+
     /**
      * @enum RendererType
      * @brief Specifies the type of renderer to use for the engine.
@@ -12,7 +34,8 @@ namespace vve {
     enum class RendererType {
         RENDERER_TYPE_FORWARD,
         RENDERER_TYPE_DEFERRED,
-        RENDERER_TYPE_RAYTRACING
+        RENDERER_TYPE_RAYTRACING,
+        RENDERER_TYPE_NULL			///< no window and no GPU work, for servers and tests
     };
 
 	/**
@@ -55,6 +78,7 @@ namespace vve {
 		const std::string m_rendererForwardName = "VVE Renderer Forward";
 		const std::string m_rendererDeferredName = "VVE Renderer Deferred";
 		const std::string m_rendererImguiName = "VVE Renderer Imgui";
+		const std::string m_rendererNullName = "VVE Renderer Null";
 		const std::string m_guiName = "VVE GUI";
 
 		/**
@@ -135,6 +159,21 @@ namespace vve {
 		 * @return Reference to the registry.
 		 */
 		auto GetRegistry() -> auto& { return m_registry; }
+		/**
+		 * @brief Gets the change tracker of the registry.
+		 * @return Reference to the change tracker.
+		 */
+		auto GetChanges() -> ChangeTracker& { return m_changes; }
+		/**
+		 * @brief Gets the job pool for parallel loops.
+		 * @return Reference to the job pool.
+		 */
+		auto GetJobPool() -> JobPool& { return m_jobPool; }
+		/**
+		 * @brief Gets the buffers for recording structural registry changes from worker threads.
+		 * @return Reference to the entity commands.
+		 */
+		auto GetEntityCommands() -> EntityCommands& { return m_entityCommands; }
 		/**
 		 * @brief Gets the current engine state.
 		 * @return EngineState struct with current state information.
@@ -248,6 +287,28 @@ namespace vve {
 							Position position = Position{vec3_t{0.0f}}, Rotation rotation = Rotation{mat3_t{1.0f}},
 							Scale scale = Scale{vec3_t{1.0f}}, UVScale uvScale = UVScale{vec2_t{1.0f}}) -> ObjectHandle;
 
+		/**
+		 * @struct ObjectInfo
+		 * @brief Describes one object for CreateObjects. If the texture name is empty, the color is used.
+		 */
+		struct ObjectInfo {
+			MeshName 	m_meshName{};
+			TextureName m_textureName{};
+			vvh::Color 	m_color{};
+			Position 	m_position{vec3_t{0.0f}};
+			Rotation 	m_rotation{mat3_t{1.0f}};
+			Scale 		m_scale{vec3_t{1.0f}};
+			UVScale 	m_uvScale{vec2_t{1.0f}};
+		};
+
+		/**
+		 * @brief Creates many objects at once and sends a single OBJECTS_CREATE message for the whole batch.
+		 * @param parent Parent handle for all objects.
+		 * @param objects Descriptions of the objects to create.
+		 * @return Handles to the created objects, in the same order as the descriptions.
+		 */
+		auto CreateObjects(ParentHandle parent, std::span<const ObjectInfo> objects) -> std::vector<ObjectHandle>;
+
 		/**
 		 * @brief Creates a scene from a file.
 		 * @param name Name of the scene.
@@ -263,6 +324,72 @@ namespace vve {
 							Position position = Position{vec3_t{0.0f}}, Rotation rotation = Rotation{mat3_t{1.0f}},
 							Scale scale = Scale{vec3_t{1.0f}}) -> ObjectHandle;
 
+		/**
+		 * @brief Creates a scene from a file without blocking. The file is imported right away, meshes, textures
+		 * and nodes are then created over the next frames within the load budget, see SetLoadBudget().
+		 * @param name Name of the scene.
+		 * @param parent Parent handle for the scene.
+		 * @param filename Filename of the scene to load.
+		 * @param flags Assimp post-processing flags.
+		 * @param position Position of the scene (default: origin).
+		 * @param rotation Rotation of the scene (default: identity).
+		 * @param scale Scale of the scene (default: unit scale).
+		 * @return Handle to the scene root, its children appear over the next frames.
+		 */
+		auto CreateSceneIncremental( Name name, ParentHandle parent, const Filename& filename, aiPostProcessSteps flags,
+							Position position = Position{vec3_t{0.0f}}, Rotation rotation = Rotation{mat3_t{1.0f}},
+							Scale scale = Scale{vec3_t{1.0f}}) -> ObjectHandle;
+
+		/**
+		 * @brief Creates a scene from a file in the background. The file is imported and its meshes and textures
+		 * are decoded on worker threads, several scenes can be imported in parallel. Nodes are created within the
+		 * load budget once the import is done. Objects use placeholder meshes and textures until their assets
+		 * are ready, the assets are then handed to the renderers within the load budget.
+		 * @param name Name of the scene.
+		 * @param parent Parent handle for the scene.
+		 * @param filename Filename of the scene to load.
+		 * @param flags Assimp post-processing flags.
+		 * @param position Position of the scene (default: origin).
+		 * @param rotation Rotation of the scene (default: identity).
+		 * @param scale Scale of the scene (default: unit scale).
+		 * @return Handle to the scene root, its children appear in later frames.
+		 */
+		auto CreateSceneAsync( Name name, ParentHandle parent, const Filename& filename, aiPostProcessSteps flags,
+							Position position = Position{vec3_t{0.0f}}, Rotation rotation = Rotation{mat3_t{1.0f}},
+							Scale scale = Scale{vec3_t{1.0f}}) -> ObjectHandle;
+
+		/**
+		 * @brief Uses the same time step for every frame instead of the measured frame time, e.g. for
+		 * reproducible tests with the null renderer.
+		 * @param dt Time step in seconds, 0 to use the measured frame time.
+		 */
+		void SetFixedTimestep(double dt) { m_fixedDt = dt; }
+
+		/**
+		 * @brief Sets the time spent on incremental loading per frame.
+		 * @param budgetMs Budget in milliseconds, at least one unit of work is done per frame.
+		 */
+		void SetLoadBudget(double budgetMs) { m_loadBudgetMs = budgetMs; }
+
+		/**
+		 * @brief Gets the time spent on incremental loading per frame.
+		 * @return Budget in milliseconds.
+		 */
+		auto GetLoadBudget() -> double { return m_loadBudgetMs; }
+
+		/**
+		 * @brief Gets the progress of incremental loading.
+		 * @return Progress counters and step times.
+		 */
+		auto GetLoadProgress() -> const LoadProgress& { return m_loadProgress; }
+
+		/**
+		 * @brief Continues incremental loading within the load budget. Called by Step(), can be called
+		 * directly when the engine runs without a window.
+		 * @return Progress after the step.
+		 */
+		auto LoadStep() -> const LoadProgress&;
+
 		/**
 		 * @brief Destroys an object.
 		 * @param handle Handle to the object to destroy.
@@ -396,6 +523,40 @@ namespace vve {
 		 */
 		void SetUVScale(ObjectHandle handle, UVScale uvScale);
 
+		//Bulk transform write-back, e.g. from physics, animation or crowd simulations
+		/**
+		 * @struct TransformInfo
+		 * @brief New local position and orientation of an object.
+		 */
+		struct TransformInfo {
+			ObjectHandle m_handle{};
+			vec3_t 		 m_position{0.0f};
+			quat_t 		 m_orientation{1.0f, 0.0f, 0.0f, 0.0f};
+		};
+
+		/**
+		 * @struct WorldMatrixInfo
+		 * @brief New local to world matrix of an object, must not contain shear.
+		 */
+		struct WorldMatrixInfo {
+			ObjectHandle m_handle{};
+			mat4_t 		 m_matrix{1.0f};
+		};
+
+		/**
+		 * @brief Writes positions and orientations of many objects. Objects that no longer exist are skipped.
+		 * @param transforms Contiguous array of handles, positions and orientations.
+		 */
+		void SetTransforms(std::span<const TransformInfo> transforms);
+		/**
+		 * @brief Writes local to world matrices of many objects. Objects that no longer exist are skipped.
+		 * The scene manager keeps the matrices and ignores position, rotation and scale, until SetTransforms is called.
+		 * It updates the children, sends OBJECT_CHANGED and updates cameras in the same frame, if this is called in
+		 * UPDATE, since the scene manager runs last there.
+		 * @param matrices Contiguous array of handles and world matrices.
+		 */
+		void SetWorldMatrices(std::span<const WorldMatrixInfo> matrices);
+
 		//Create assets
 		/**
 		 * @brief Destroys a mesh.
@@ -439,6 +600,12 @@ namespace vve {
 		 * @brief Creates the GUI system (virtual, can be overridden).
 		 */
 		virtual void CreateGUI();
+		/**
+		 * @brief Adds the handle map, message callbacks and change tracking to a memory report.
+		 * @param message Memory report message.
+		 * @return false to continue message propagation.
+		 */
+		bool OnMemoryReport(Message& message);
 
 		std::unordered_map<std::string, std::unique_ptr<System>> m_systems{};
 
@@ -451,8 +618,14 @@ namespace vve {
 		bool m_shadowsEnabled{ true };
 
 		std::chrono::time_point<std::chrono::high_resolution_clock> m_last;
+		double m_fixedDt{0.0}; //if > 0 used instead of the measured frame time
 
 		vecs::Registry m_registry; //VECS lives here
+		ChangeTracker m_changes{}; //entities changed per frame
+		JobPool m_jobPool{}; //worker threads for parallel loops
+		EntityCommands m_entityCommands{}; //structural changes recorded by worker threads
+		double m_loadBudgetMs{4.0}; //incremental loading time per frame
+		LoadProgress m_loadProgress{};
 		std::unordered_map<std::string, vecs::Handle> m_handleMap; //from string to handle
 
 		using PriorityMap = std::multimap<int, MessageCallback>;
@@ -0,0 +1,166 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Deferred structural changes of the registry. Worker threads cannot insert or erase entities, or put
+	 * new component types, while the main thread uses the registry. Instead each worker records these operations
+	 * into its own buffer, and the engine plays all buffers back at the start of the next frame, before any
+	 * system runs. Buffers are played back in ascending order of their keys, and the commands of a buffer in the
+	 * order they were recorded, so the result does not depend on thread scheduling. Object create and destroy
+	 * messages are sent during playback.
+	 *
+	 * A buffer must be recorded by one thread at a time. Recording must be finished before the next frame starts,
+	 * references to buffers are not valid after playback.
+     */
+    class EntityCommands {
+
+    public:
+		/**
+		 * @brief Commands recorded by one thread
+		 */
+		class Buffer {
+
+		public:
+			/**
+			 * @brief Entity inserted or object created by an earlier command of the same buffer
+			 */
+			struct Pending { size_t m_index; };
+
+			/**
+			 * @brief Insert an entity with components
+			 * @param components The components
+			 * @return The pending entity
+			 */
+			template<typename... Ts>
+			auto Insert(Ts&&... components) -> Pending {
+				m_commands.push_back( [...components = std::forward<Ts>(components)](auto& engine, auto& created) {
+					created.push_back( engine.GetRegistry().Insert(components...) );
+				});
+				return Pending{ m_numCreated++ };
+			}
+
+			/**
+			 * @brief Put a component on an entity, skipped if the entity does not exist any more
+			 * @param handle The entity
+			 * @param component The component
+			 */
+			template<typename T>
+			void Put(vecs::Handle handle, T&& component) {
+				m_commands.push_back( [handle, component = std::forward<T>(component)](auto& engine, auto& created) {
+					if( engine.GetRegistry().Exists(handle) ) engine.GetRegistry().Put(handle, component);
+				});
+			}
+
+			/**
+			 * @brief Put a component on a pending entity
+			 * @param pending The pending entity
+			 * @param component The component
+			 */
+			template<typename T>
+			void Put(Pending pending, T&& component) {
+				m_commands.push_back( [pending, component = std::forward<T>(component)](auto& engine, auto& created) {
+					auto handle = created[pending.m_index];
+					if( engine.GetRegistry().Exists(handle) ) engine.GetRegistry().Put(handle, component);
+				});
+			}
+
+			/**
+			 * @brief Erase an entity, skipped if the entity does not exist any more
+			 * @param handle The entity
+			 */
+			void Erase(vecs::Handle handle);
+
+			/**
+			 * @brief Erase a pending entity
+			 * @param pending The pending entity
+			 */
+			void Erase(Pending pending);
+
+			/**
+			 * @brief Create an object with a mesh and color, see Engine::CreateObject
+			 * @return The pending object
+			 */
+			auto CreateObject(Name name, ParentHandle parent, const MeshName& meshName, vvh::Color color,
+							Position position = Position{vec3_t{0.0f}}, Rotation rotation = Rotation{mat3_t{1.0f}},
+							Scale scale = Scale{vec3_t{1.0f}}, UVScale uvScale = UVScale{vec2_t{1.0f}}) -> Pending;
+
+			/**
+			 * @brief Create an object with a mesh and texture, see Engine::CreateObject
+			 * @return The pending object
+			 */
+			auto CreateObject(Name name, ParentHandle parent, const MeshName& meshName, const TextureName& textureName,
+							Position position = Position{vec3_t{0.0f}}, Rotation rotation = Rotation{mat3_t{1.0f}},
+							Scale scale = Scale{vec3_t{1.0f}}, UVScale uvScale = UVScale{vec2_t{1.0f}}) -> Pending;
+
+			/**
+			 * @brief Destroy an object, skipped if the object does not exist any more
+			 * @param handle The object
+			 */
+			void DestroyObject(ObjectHandle handle);
+
+			/**
+			 * @brief Destroy a pending object
+			 * @param pending The pending object
+			 */
+			void DestroyObject(Pending pending);
+
+			/**
+			 * @brief Get the number of recorded commands
+			 * @return Number of commands
+			 */
+			auto Size() const -> size_t { return m_commands.size(); }
+
+		private:
+			friend class EntityCommands;
+			// Commands take the engine as auto&, so that they compile before the engine class is complete
+			using Command = std::function<void(Engine&, std::vector<vecs::Handle>&)>;
+
+			std::vector<Command> m_commands;
+			size_t m_numCreated{0};
+		};
+
+		/**
+		 * @brief Statistics of the last playback
+		 */
+		struct Stats {
+			size_t m_buffers{0};
+			size_t m_commands{0};
+			double m_playbackMs{0.0};
+		};
+
+        /**
+         * @brief Constructor for the EntityCommands class
+         */
+        EntityCommands() = default;
+
+		/**
+		 * @brief Get the buffer with a key, it is created if needed. Can be called from any thread.
+		 * @param key Key of the buffer, defines the playback order. Each recording thread should use its own key.
+		 * @return The buffer
+		 */
+		auto GetBuffer(uint64_t key) -> Buffer&;
+
+		/**
+		 * @brief Play back all buffers and remove them. Called by the engine on the main thread.
+		 * @param engine The engine
+		 */
+		void Playback(Engine& engine);
+
+		/**
+		 * @brief Get the statistics of the last playback
+		 * @return Playback statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+    private:
+		std::mutex m_mutex;
+		std::map<uint64_t, Buffer> m_buffers;		//sorted by key
+		Stats m_stats{};
+    };
+
+};  // namespace vve
+
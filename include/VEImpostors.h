@@ -0,0 +1,155 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Impostor of an object, stored with the object
+	 */
+	struct Impostor {
+		bool m_active{false};			//true if the billboard is drawn instead of the object
+	};
+
+	/**
+	 * @brief Multi-view impostor atlas of a mesh. The mesh is rendered orthographically from a number of directions
+	 * around the up (z) axis, each view into its own cell of a single row atlas. For each view a convex polygon
+	 * enclosing the silhouette is stored, it is used as billboard geometry so that no transparency is needed.
+	 */
+	struct ImpostorAtlas {
+		uint32_t m_views{0};
+		uint32_t m_resolution{0};						//edge length of a cell in pixels
+		std::vector<uint8_t> m_pixels;					//RGBA, width m_views * m_resolution, height m_resolution
+		std::vector<std::vector<glm::vec2>> m_hulls;	//silhouette polygon per view, in [-1,1]^2 of the cell
+		vec3_t m_center;								//bounding sphere of the mesh in model space
+		real_t m_radius;
+	};
+
+    /**
+     * @brief Replaces distant objects with camera facing billboards. Atlases are baked on the CPU, so baking does
+	 * not need a GPU and can run in CI. Beyond a distance the object is hidden and a billboard showing the view
+	 * closest to the camera direction is drawn instead. The billboards of an atlas are written into one dynamic
+	 * mesh every frame, so all impostors of an atlas are a single draw.
+     */
+    class Impostors : public System {
+
+    public:
+		static const uint32_t c_cardSides = 16;	//number of sides of the billboard polygons
+
+		/**
+		 * @brief Statistics of the last frame, for objects having an impostor
+		 */
+		struct Stats {
+			size_t m_objects{0};
+			size_t m_impostors{0};				//objects drawn as impostor
+			size_t m_draws{0};					//draws for the impostors, one per atlas that has impostors
+			size_t m_trianglesFull{0};			//triangles if all objects were drawn as meshes
+			size_t m_trianglesDrawn{0};
+			double m_bakeMs{0.0};				//total time spent baking atlases
+		};
+
+        /**
+         * @brief Constructor for the Impostors class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param distance Objects farther away than this are drawn as impostors
+         * @param views Number of views per atlas
+         * @param resolution Edge length of a view in pixels
+         */
+        Impostors(std::string systemName, Engine& engine, real_t distance = 50.0, uint32_t views = 8, uint32_t resolution = 64);
+
+        /**
+         * @brief Destructor for the Impostors class
+         */
+        virtual ~Impostors();
+
+		/**
+		 * @brief Bake the atlas of a mesh and create its billboard batch and texture. Objects using the mesh
+		 * get impostors from now on.
+		 * @param meshName Name of the mesh, the mesh must be loaded
+		 * @param diffuse Color used if the mesh has no vertex colors
+		 * @return True if the atlas was baked
+		 */
+		auto Bake(const MeshName& meshName, vec4_t diffuse) -> bool;
+
+		/**
+		 * @brief Set the distance beyond which impostors are drawn
+		 * @param distance The distance
+		 */
+		void SetDistance(real_t distance) { m_distance = distance; }
+
+		/**
+		 * @brief Get the statistics of the last frame
+		 * @return Impostor statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+		/**
+		 * @brief Get a baked atlas
+		 * @param meshName Name of the mesh
+		 * @return Pointer to the atlas, or nullptr if the mesh has not been baked
+		 */
+		auto GetAtlas(const MeshName& meshName) -> const ImpostorAtlas*;
+
+		/**
+		 * @brief Render the atlas of a mesh on the CPU
+		 * @param mesh The mesh
+		 * @param diffuse Color used if the mesh has no vertex colors
+		 * @param views Number of views
+		 * @param resolution Edge length of a view in pixels
+		 * @return The atlas
+		 */
+		static auto BakeAtlas(const vvh::Mesh& mesh, vec4_t diffuse, uint32_t views, uint32_t resolution) -> ImpostorAtlas;
+
+		/**
+		 * @brief Write an atlas to a PNG file
+		 * @param atlas The atlas
+		 * @param path Path of the file
+		 * @return True if the file was written
+		 */
+		static auto SaveAtlas(const ImpostorAtlas& atlas, const std::filesystem::path& path) -> bool;
+
+    private:
+		struct Entry {
+			ImpostorAtlas m_atlas;
+			std::vector<vvh::Mesh> m_cards;			//billboard per view, copied into the batch
+			MeshHandle m_batch;						//dynamic mesh with the billboards of all impostors
+			ObjectHandle m_object;					//object drawing the batch
+			TextureHandle m_texture;
+			size_t m_triangles;						//triangles of the mesh
+		};
+
+		/**
+		 * @brief Switch objects between mesh and billboard, and write the billboards into the batches
+		 * @param message Update message
+		 * @return false to continue message propagation
+		 */
+		bool OnUpdate(Message message);
+
+		/**
+		 * @brief Append a billboard to a batch
+		 * @param batch The batch mesh
+		 * @param card The billboard
+		 * @param transform Places the billboard in the world
+		 */
+		static void AppendCard(vvh::Mesh& batch, const vvh::Mesh& card, const mat4_t& transform);
+
+		/**
+		 * @brief Create the billboard mesh of a view
+		 * @param atlas The atlas
+		 * @param view Index of the view
+		 * @return The billboard mesh
+		 */
+		static auto CreateCard(const ImpostorAtlas& atlas, uint32_t view) -> vvh::Mesh;
+
+		real_t m_distance;
+		real_t m_hysteresis{0.05};
+		uint32_t m_views;
+		uint32_t m_resolution;
+		std::unordered_map<std::string, Entry> m_entries;		//key is the mesh name
+		Stats m_stats{};
+    };
+
+};  // namespace vve
+
@@ -6,17 +6,30 @@
 #include <cstdint>
 #include <variant>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <future>
 #include <functional>
 #include <typeindex>
 #include <typeinfo>
 #include <type_traits>
 #include <unordered_set>
+#include <unordered_map>
+#include <map>
+#include <queue>
+#include <deque>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <tuple>
 #include <filesystem>
 #include <chrono>
 #include <any>
+#include <optional>
 #include <algorithm>
 #include <iterator>
 #include <ranges>
+#include <span>
 
 #include <assimp/cimport.h>
 #include <assimp/Importer.hpp>
@@ -84,6 +97,8 @@ namespace vve {
 	class RendererForward11;
 	class RendererShadow11;
 	class RendererVulkan;
+	class RendererNull;
+	class WindowNull;
 	class RendererDeferred;
 	template<typename Derived>
 	class RendererDeferredCommon;	// Base class for 1.1 and 1.3 RenDef
@@ -92,6 +107,25 @@ namespace vve {
    	class SceneManager;
    	class AssetManager;
 	class SoundManager;
+	class SimulationThread;
+	class WorldPartition;
+	class PortalCulling;
+	class OcclusionBuffer;
+	class OcclusionCulling;
+	class LevelOfDetail;
+	class Impostors;
+	class ChangeTracker;
+	class JobPool;
+	class EntityCommands;
+	struct RenderView;
+	class RenderViews;
+	struct Prefab;
+	struct LoadProgress;
+	struct MemoryReport;
+	class MemoryStats;
+	class TextureCooker;
+	class MeshOptimizer;
+	struct MeshStats;
 
 	//Names
 	using Name = vsty::strong_type_t<std::string, vsty::counter<>>;
@@ -133,30 +167,40 @@ namespace vve {
 	using LocalToWorldMatrix = vsty::strong_type_t<mat4_t, vsty::counter<>, MaxtrixDefaultValue>;
 	using ViewMatrix = vsty::strong_type_t<mat4_t, vsty::counter<>, MaxtrixDefaultValue>;
 	using ProjectionMatrix = vsty::strong_type_t<mat4_t, vsty::counter<>, MaxtrixDefaultValue>;
+	using DirectWorldMatrix = vsty::strong_type_t<bool, vsty::counter<>>; //local to parent matrix is written by SetWorldMatrices, position, rotation and scale are ignored
 
 	//Scene
 	using Children = vsty::strong_type_t<std::vector<vecs::Handle>, vsty::counter<>>;
+	using PortalCellId = vsty::strong_type_t<uint32_t, vsty::counter<>>; //cell of an object for portal culling
+	using Occluder = vsty::strong_type_t<bool, vsty::counter<>>; //force an object to be or not to be an occluder
+	using Occluded = vsty::strong_type_t<bool, vsty::counter<>>; //result of occlusion culling
+	using Hidden = vsty::strong_type_t<bool, vsty::counter<>>; //object is not drawn, e.g. replaced by an impostor
+	using ShadowCaster = vsty::strong_type_t<bool, vsty::counter<>>; //false if the object is not drawn into shadow maps, e.g. an impostor billboard
+	using ViewMask = vsty::strong_type_t<uint32_t, vsty::counter<>>; //bit i is set if the object is inside the frustum of render view i
 
 	//Lights
 	using PointLight = vsty::strong_type_t<vvh::LightParams, vsty::counter<>>;
 	using DirectionalLight = vsty::strong_type_t<vvh::LightParams, vsty::counter<>>;
 	using SpotLight = vsty::strong_type_t<vvh::LightParams, vsty::counter<>>;
 
-	using Dirty = vsty::strong_type_t<std::array<bool, MAX_FRAMES_IN_FLIGHT>, vsty::counter<>>;
-
 }
 
 #include "VESystem.h"
+#include "VEChangeTracker.h"
+#include "VEJobPool.h"
+#include "VEEntityCommands.h"
 #include "VEEngine.h"
 #include "VEGUI.h"
 #include "VEWindow.h"
 #include "VEWindowSDL.h"
+#include "VEWindowNull.h"
 #include "VERenderer.h"
 #include "VERendererImgui.h"
 #include "VERendererForward.h"
 #include "VERendererForward11.h"
 #include "VERendererShadow11.h"
 #include "VERendererVulkan.h"
+#include "VERendererNull.h"
 #include "VERendererDeferred.h"
 #include "VERendererDeferredCommon.h"
 #include "VERendererDeferred11.h"
@@ -165,3 +209,13 @@ namespace vve {
 #include "VEAssetManager.h"
 //#include "VESoundManagerSDL2.h"
 #include "VESoundManagerSDL3.h"
+#include "VESimulationThread.h"
+#include "VEWorldPartition.h"
+#include "VEPortalCulling.h"
+#include "VEOcclusionCulling.h"
+#include "VELevelOfDetail.h"
+#include "VEImpostors.h"
+#include "VERenderViews.h"
+#include "VEMemoryStats.h"
+#include "VETextureCooker.h"
+#include "VEMeshOptimizer.h"
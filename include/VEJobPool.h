@@ -0,0 +1,98 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Pool of worker threads for data parallel loops. A loop is cut into chunks, the workers and the calling
+	 * thread take chunks until all are done, so a call returns only when the whole loop has run. A thread pool of
+	 * N threads has N-1 workers, the caller is the N-th thread.
+	 *
+	 * ParallelForEach runs a function for each entry of a registry view. Each entity is visited exactly once, so
+	 * writing the view components of the visited entity is race free. Reading other entities and components is
+	 * allowed, structural changes (Insert, Put of new component types, Erase) are not.
+     */
+    class JobPool {
+
+    public:
+        /**
+         * @brief Constructor for the JobPool class
+         * @param numThreads Number of threads including the caller, 0 means one per hardware thread
+         */
+        JobPool(uint32_t numThreads = 0);
+
+        /**
+         * @brief Destructor for the JobPool class, stops the workers
+         */
+        ~JobPool();
+
+		/**
+		 * @brief Get the number of threads including the caller
+		 * @return Number of threads
+		 */
+		auto GetNumThreads() const -> uint32_t { return (uint32_t)m_workers.size() + 1; }
+
+		/**
+		 * @brief Run a function on chunks of an index range in parallel and wait until all chunks are done
+		 * @param count Number of indices
+		 * @param chunkSize Number of indices per chunk
+		 * @param func Function called with the begin and end index of a chunk
+		 */
+		void ParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& func);
+
+		/**
+		 * @brief Run a function for each entry of a registry view in parallel. The entries are gathered first, then
+		 * cut into chunks. The gather runs on the calling thread because views can only be walked from the start,
+		 * it copies handles and component references but no component data. parallel-view-benchmark prints its
+		 * time next to the time of the loop, a gather costing a noticeable share of the loop limits the speedup.
+		 * @param view The view, e.g. from m_registry.GetView<vecs::Handle, LocalToWorldMatrix&>()
+		 * @param func Function called with the components of an entry
+		 * @param chunkSize Number of entries per chunk
+		 */
+		template<typename View, typename Func>
+		void ParallelForEach(View&& view, Func&& func, size_t chunkSize = 256) {
+			std::vector<std::decay_t<decltype(*view.begin())>> entries;
+			for( auto&& entry : view ) { entries.push_back(entry); }
+			ParallelFor(entries.size(), chunkSize, [&](size_t begin, size_t end) {
+				for( size_t i = begin; i < end; ++i ) { std::apply(func, entries[i]); }
+			});
+		}
+
+    private:
+		/**
+		 * @brief State of one ParallelFor call, shared with the workers. Workers may pick up the loop after it
+		 * finished, they then find no chunk left and do not touch the function.
+		 */
+		struct Loop {
+			const std::function<void(size_t, size_t)>* m_func;
+			size_t m_count;
+			size_t m_chunkSize;
+			size_t m_numChunks;
+			std::atomic<size_t> m_next{0};				//next chunk to take
+			std::atomic<size_t> m_done{0};				//number of finished chunks
+			std::exception_ptr m_exception{nullptr};	//first exception thrown by a chunk
+			std::mutex m_mutex;
+		};
+
+		/**
+		 * @brief Take chunks of a loop until none is left
+		 * @param loop The loop
+		 */
+		static void RunChunks(Loop& loop);
+
+		/**
+		 * @brief Main function of a worker thread
+		 * @param stop Stop token of the thread
+		 */
+		void Run(std::stop_token stop);
+
+		std::vector<std::jthread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable_any m_condition;
+		std::queue<std::shared_ptr<Loop>> m_loops;
+    };
+
+};  // namespace vve
+
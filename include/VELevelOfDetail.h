@@ -0,0 +1,129 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Levels of detail of a mesh, stored with the full resolution mesh
+	 */
+	struct MeshLods {
+		std::vector<MeshHandle> m_levels;		//level 0 is the full resolution mesh
+		std::vector<size_t> m_triangles;		//number of triangles per level
+		vec3_t m_center;						//bounding sphere in model space
+		real_t m_radius;
+	};
+
+	/**
+	 * @brief Current level of detail of an object
+	 */
+	struct LodState {
+		MeshHandle m_base;						//full resolution mesh
+		uint32_t m_level{0};
+	};
+
+    /**
+     * @brief Level of detail. The asset manager generates coarser levels of the meshes of imported scenes by
+	 * quadric error edge collapse on its job pool, each level having about half the triangles of the previous one,
+	 * and stores them in the mesh cache. Every frame the projected size of each object is computed, and the
+	 * MeshHandle of the object is switched to the matching level. Hysteresis around the thresholds avoids popping
+	 * back and forth.
+     */
+    class LevelOfDetail : public System {
+
+    public:
+		/**
+		 * @brief Statistics of the last frame, for objects whose mesh has levels of detail
+		 */
+		struct Stats {
+			size_t m_objects{0};
+			size_t m_trianglesFull{0};				//triangles at full resolution
+			size_t m_trianglesDrawn{0};				//triangles of the selected levels
+			std::vector<size_t> m_objectsPerLevel;
+		};
+
+        /**
+         * @brief Constructor for the LevelOfDetail class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param thresholds Projected size (fraction of the screen height) below which the next level is used
+         * @param hysteresis Relative band around the thresholds in which the level is not changed
+         * @param minTriangles Meshes with fewer triangles get no levels of detail
+         */
+        LevelOfDetail(std::string systemName, Engine& engine, std::vector<real_t> thresholds = {0.25, 0.12, 0.05}, real_t hysteresis = 0.1, size_t minTriangles = 128);
+
+        /**
+         * @brief Destructor for the LevelOfDetail class
+         */
+        virtual ~LevelOfDetail();
+
+		/**
+		 * @brief Turn level selection on or off, when off all objects use full resolution
+		 * @param enabled True to enable level selection
+		 */
+		void SetEnabled(bool enabled) { m_enabled = enabled; }
+
+		/**
+		 * @brief Get the statistics of the last frame
+		 * @return LOD statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+		/**
+		 * @brief Simplify a mesh by quadric error edge collapse. Vertices on borders and attribute seams are not moved.
+		 * @param mesh The mesh to simplify
+		 * @param targetTriangles Number of triangles to reduce to
+		 * @return The simplified mesh, having the same vertex attributes and quantization bounds
+		 */
+		static auto Simplify(const vvh::Mesh& mesh, size_t targetTriangles) -> vvh::Mesh;
+
+		/**
+		 * @brief Generate the coarser levels of a mesh. Does not use the registry and can run on a worker thread.
+		 * @param mesh The full resolution mesh
+		 * @param levels Maximum number of coarser levels
+		 * @param minTriangles Meshes with fewer triangles get no levels
+		 * @return The coarser levels, level 1 first
+		 */
+		static auto GenerateLevels(const vvh::Mesh& mesh, uint32_t levels, size_t minTriangles) -> std::vector<vvh::Mesh>;
+
+    private:
+		/**
+		 * @brief Tell the asset manager how many levels to generate for imported meshes
+		 * @param message Init message
+		 * @return false to continue message propagation
+		 */
+		bool OnInit(Message message);
+
+		/**
+		 * @brief Destroy the levels of detail of a destroyed mesh
+		 * @param message Mesh destroy message
+		 * @return false to continue message propagation
+		 */
+		bool OnMeshDestroy(Message message);
+
+		/**
+		 * @brief Select the level of each object
+		 * @param message Prepare next frame message
+		 * @return false to continue message propagation
+		 */
+		bool OnPrepareNextFrame(Message message);
+
+		/**
+		 * @brief Select a level from the projected size
+		 * @param size Projected size as fraction of the screen height
+		 * @param level Current level
+		 * @param numLevels Number of levels of the mesh
+		 * @return New level
+		 */
+		auto SelectLevel(real_t size, uint32_t level, uint32_t numLevels) -> uint32_t;
+
+		std::vector<real_t> m_thresholds;
+		real_t m_hysteresis;
+		size_t m_minTriangles;
+		bool m_enabled{true};
+		Stats m_stats{};
+    };
+
+};  // namespace vve
+
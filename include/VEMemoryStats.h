@@ -0,0 +1,177 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief CPU memory in use, broken down three ways: per component type in the registry, per asset category,
+	 * and per subsystem for memory owned by systems outside the registry. Asset categories are a second view of
+	 * component memory, e.g. mesh vertices are also part of the vvh::Mesh component, so the totals of the three
+	 * lists must not be added up.
+	 */
+	struct MemoryReport {
+		/**
+		 * @brief Memory of one component type, asset category or subsystem
+		 */
+		struct Entry {
+			std::string m_name;
+			size_t m_count{0};				//components, assets or entries
+			size_t m_bytes{0};				//value sizes plus owned heap memory
+		};
+
+		std::vector<Entry> m_components;
+		std::vector<Entry> m_assets;
+		std::vector<Entry> m_systems;
+
+		/**
+		 * @brief Add to an entry, the entry is created if it does not exist
+		 * @param entries The list to add to
+		 * @param name Name of the entry
+		 * @param count Number of items
+		 * @param bytes Number of bytes
+		 */
+		static void Add(std::vector<Entry>& entries, const std::string& name, size_t count, size_t bytes);
+
+		/**
+		 * @brief Find an entry
+		 * @param entries The list to search
+		 * @param name Name of the entry
+		 * @return The entry, or nullptr if there is none
+		 */
+		static auto Find(const std::vector<Entry>& entries, const std::string& name) -> const Entry*;
+
+		/**
+		 * @brief Sum the bytes of a list
+		 * @param entries The list
+		 * @return Number of bytes
+		 */
+		static auto Total(const std::vector<Entry>& entries) -> size_t;
+
+		/**
+		 * @brief Write the report as CSV with the columns category, name, count, bytes
+		 * @param file Path of the file
+		 * @return true if the file was written
+		 */
+		auto Write(const std::filesystem::path& file) const -> bool;
+
+		/**
+		 * @brief Heap memory of a string, 0 if the string is stored inside the object
+		 * @param str The string, e.g. std::string or the native string of a path
+		 * @return Number of bytes
+		 */
+		template<typename S>
+		static auto StringBytes(const S& str) -> size_t {
+			auto data = (const char*)str.data();
+			bool local = data >= (const char*)&str && data < (const char*)(&str + 1);
+			return local ? 0 : (str.capacity() + 1) * sizeof(typename S::value_type);
+		}
+
+		/**
+		 * @brief Heap memory of a vector, not including memory owned by its elements
+		 * @param vec The vector
+		 * @return Number of bytes
+		 */
+		template<typename V>
+		static auto VectorBytes(const V& vec) -> size_t { return vec.capacity() * sizeof(typename V::value_type); }
+
+		/**
+		 * @brief Estimated heap memory of a node based hash map or set, not including memory owned by its elements.
+		 * Each node is assumed to hold the value and one pointer.
+		 * @param map The map or set
+		 * @return Number of bytes
+		 */
+		template<typename M>
+		static auto HashMapBytes(const M& map) -> size_t {
+			return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(typename M::value_type) + sizeof(void*));
+		}
+
+		/**
+		 * @brief Estimated heap memory of a tree based map or set, not including memory owned by its elements.
+		 * Each node is assumed to hold the value, three pointers and a color.
+		 * @param map The map or set
+		 * @return Number of bytes
+		 */
+		template<typename M>
+		static auto TreeMapBytes(const M& map) -> size_t { return map.size() * (sizeof(typename M::value_type) + 4 * sizeof(void*)); }
+	};
+
+    /**
+     * @brief Memory accounting. Collects a MemoryReport on request: components are counted by walking the registry,
+	 * the size of a component is the size of its value plus the heap memory it owns. The storage overhead of the
+	 * registry itself is not visible and not included. Then a MEMORY_REPORT message is sent, systems answer with the
+	 * memory of their own containers. The report can be shown in an ImGui window and written to a file.
+     */
+    class MemoryStats : public System {
+
+    public:
+        /**
+         * @brief Constructor for the MemoryStats class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param showWindow Show the report in an ImGui window
+         * @param refreshFrames The window collects a new report every this many frames
+         */
+        MemoryStats(std::string systemName, Engine& engine, bool showWindow = true, uint32_t refreshFrames = 30);
+
+        /**
+         * @brief Destructor for the MemoryStats class
+         */
+        virtual ~MemoryStats();
+
+		/**
+		 * @brief Collect the memory currently in use
+		 * @return The report
+		 */
+		auto Collect() -> MemoryReport;
+
+		/**
+		 * @brief Collect a report and write it to a file
+		 * @param file Path of the file
+		 * @return true if the file was written
+		 */
+		auto Dump(const std::filesystem::path& file) -> bool;
+
+		/**
+		 * @brief Show or hide the ImGui window
+		 * @param show true to show the window
+		 */
+		void ShowWindow(bool show) { m_showWindow = show; }
+
+    private:
+		/**
+		 * @brief Show the last report in an ImGui window
+		 * @param message Record next frame message
+		 * @return false to continue message propagation
+		 */
+		bool OnRecordNextFrame(Message message);
+
+		/**
+		 * @brief Add the components of a type to a report
+		 * @tparam T Component type
+		 * @param report The report
+		 * @param name Name of the component type
+		 * @param heap Returns the heap memory owned by a component
+		 */
+		template<typename T>
+		void CountComponents(MemoryReport& report, const std::string& name, auto heap);
+
+		/**
+		 * @brief Add the components of a type that owns no heap memory to a report
+		 * @tparam T Component type
+		 * @param report The report
+		 * @param name Name of the component type
+		 */
+		template<typename T>
+		void CountComponents(MemoryReport& report, const std::string& name);
+
+		bool m_showWindow;
+		uint32_t m_refreshFrames;
+		uint32_t m_frame{0};
+		MemoryReport m_report{};
+		std::string m_dumpFile{"memory.csv"};
+    };
+
+};  // namespace vve
+
@@ -0,0 +1,96 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Vertex cache statistics of an index buffer, simulated with a FIFO post transform cache
+	 */
+	struct MeshStats {
+		size_t m_triangles{0};
+		size_t m_vertices{0};			//vertices referenced by the indices
+		size_t m_transformed{0};		//cache misses, each one runs the vertex shader
+
+		/**
+		 * @brief Average cache miss ratio, vertex shader runs per triangle, between 0.5 and 3
+		 * @return The ACMR, 0 if there are no triangles
+		 */
+		auto ACMR() const -> double { return m_triangles > 0 ? (double)m_transformed / m_triangles : 0.0; }
+
+		/**
+		 * @brief Average transform to vertex ratio, vertex shader runs per vertex, 1 is optimal
+		 * @return The ATVR, 0 if there are no vertices
+		 */
+		auto ATVR() const -> double { return m_vertices > 0 ? (double)m_transformed / m_vertices : 0.0; }
+
+		/**
+		 * @brief Add the statistics of another mesh
+		 * @param other The other statistics
+		 * @return This
+		 */
+		auto operator+=(const MeshStats& other) -> MeshStats& {
+			m_triangles += other.m_triangles;
+			m_vertices += other.m_vertices;
+			m_transformed += other.m_transformed;
+			return *this;
+		}
+	};
+
+    /**
+     * @brief Optimizes meshes for the GPU when they are imported. Three passes run in this order:
+	 * - Vertex cache: triangles are reordered with Forsyth's linear speed algorithm, so that vertices are reused
+	 *   while they are still in the post transform cache.
+	 * - Overdraw: the cache ordered triangles are cut into clusters where the cache order starts over, and where
+	 *   cutting does not cost more than a threshold of cache efficiency. Clusters facing away from the center of the
+	 *   mesh are drawn first, since they are likely to occlude the rest.
+	 * - Vertex fetch: vertices are renumbered in the order of first use, so vertex fetches walk the streams
+	 *   linearly. Vertices no triangle uses are removed.
+	 * Runs on the CPU only and does not use the registry, so it can be called from worker threads.
+     */
+    class MeshOptimizer {
+
+    public:
+		static const uint32_t c_cacheSize = 16;				//entries of the simulated post transform cache
+		inline static const float c_overdrawThreshold = 1.05f;	//allowed loss of cache efficiency for overdraw clusters
+
+		/**
+		 * @brief Run all passes on a mesh
+		 * @param mesh The mesh, its indices and vertex streams are changed
+		 */
+		static void Optimize(vvh::Mesh& mesh);
+
+		/**
+		 * @brief Reorder triangles for the post transform vertex cache
+		 * @param indices Triangle list, reordered in place
+		 * @param vertexCount Number of vertices
+		 */
+		static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+		/**
+		 * @brief Reorder clusters of cache ordered triangles to reduce overdraw
+		 * @param indices Triangle list in vertex cache order, reordered in place
+		 * @param positions Positions of the vertices
+		 * @param threshold Allowed loss of cache efficiency, e.g. 1.05 allows the ACMR to grow by 5%
+		 */
+		static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold = c_overdrawThreshold);
+
+		/**
+		 * @brief Renumber the vertices in the order the indices use them and drop unused vertices
+		 * @param mesh The mesh, its indices and vertex streams are changed
+		 */
+		static void OptimizeVertexFetch(vvh::Mesh& mesh);
+
+		/**
+		 * @brief Simulate a FIFO post transform cache
+		 * @param indices Triangle list
+		 * @param vertexCount Number of vertices
+		 * @param cacheSize Number of cache entries
+		 * @return Triangles, referenced vertices and cache misses
+		 */
+		static auto Analyze(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = c_cacheSize) -> MeshStats;
+	};
+
+};  // namespace vve
+
@@ -0,0 +1,241 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Axis aligned bounding box of a mesh in model space
+	 */
+	struct BoundingBox {
+		vec3_t m_min;
+		vec3_t m_max;
+	};
+
+	/**
+	 * @brief Low resolution masked software occlusion buffer. The screen is divided into tiles of 8x8 pixels. Instead
+	 * of a depth per pixel, each tile stores a 64 bit coverage mask and two depths: the reference depth bounds the
+	 * whole tile, the working depth bounds the pixels set in the mask. Occluder triangles compute their coverage of a
+	 * tile row by row with bit operations, eight pixels at a time, and are merged into the two layers. When the mask
+	 * becomes full, the working layer replaces the reference layer. Screen space bounding rectangles of boxes are
+	 * tested against the tile depths first and against the masks only where needed, never against single pixels.
+	 * Rasterization and testing are split across the threads of a job pool. This class does not use the registry or the GPU.
+	 */
+	class OcclusionBuffer {
+
+	public:
+		static const int c_tileSize = 8;	//edge length of a tile in pixels, one bit per pixel of a 64 bit mask
+
+		/**
+		 * @brief An occluder mesh
+		 */
+		struct OccluderMesh {
+			mat4_t m_modelViewProj;							//model view projection matrix
+			const std::vector<glm::vec3>* m_positions;		//vertex positions in model space
+			const std::vector<uint32_t>* m_indices;			//triangle list
+		};
+
+		/**
+		 * @brief A box to test for visibility
+		 */
+		struct TestBox {
+			mat4_t m_modelViewProj;							//model view projection matrix
+			BoundingBox m_bounds;							//bounding box in model space
+		};
+
+		/**
+		 * @brief Constructor for the OcclusionBuffer class
+		 * @param width Width in pixels, rounded up to a multiple of the tile size
+		 * @param height Height in pixels, rounded up to a multiple of the tile size
+		 * @param jobPool Threads for rasterizing and testing, nullptr runs everything on the calling thread
+		 */
+		OcclusionBuffer(uint32_t width = 320, uint32_t height = 192, JobPool* jobPool = nullptr);
+
+		/**
+		 * @brief Reset all depths to the far plane
+		 */
+		void Clear();
+
+		/**
+		 * @brief Rasterize occluders into the buffer. Triangles crossing the near plane are skipped.
+		 * @param occluders The occluder meshes
+		 * @return Number of triangles rasterized
+		 */
+		auto Rasterize(std::span<const OccluderMesh> occluders) -> size_t;
+
+		/**
+		 * @brief Test a single box against the buffer
+		 * @param box The box
+		 * @return True if the box may be visible, false if it is occluded
+		 */
+		auto IsVisible(const TestBox& box) -> bool;
+
+		/**
+		 * @brief Test boxes against the buffer in parallel
+		 * @param boxes The boxes
+		 * @param visible Result per box, 1 if the box may be visible, 0 if it is occluded
+		 */
+		void Test(std::span<const TestBox> boxes, std::span<uint8_t> visible);
+
+		/**
+		 * @brief Get the fraction of the screen covered by the screen rectangle of a box
+		 * @param box The box
+		 * @return Covered fraction of the screen, 0 if the box crosses the near plane
+		 */
+		auto ScreenCoverage(const TestBox& box) -> real_t;
+
+		/**
+		 * @brief Get the depth bound of each pixel, e.g. for debug display
+		 * @return Working depth for pixels in the mask of their tile, reference depth for the others, row by row
+		 */
+		auto GetDepth() -> std::vector<float>;
+
+		auto GetWidth() -> uint32_t { return m_width; }
+		auto GetHeight() -> uint32_t { return m_height; }
+
+	private:
+		struct Triangle {
+			std::array<glm::vec3, 3> m_v;		//pixel x, pixel y, depth
+		};
+
+		struct Tile {
+			uint64_t m_mask;					//pixels covered by the working layer, bit y * c_tileSize + x
+			float m_zWork;						//farthest depth of the working layer
+			float m_zRef;						//farthest depth of the whole tile
+		};
+
+		struct ScreenRect {
+			int m_x0, m_y0, m_x1, m_y1;		//inclusive pixel range
+			float m_minDepth;
+		};
+
+		/**
+		 * @brief Project a box to the screen
+		 * @param box The box
+		 * @param rect Resulting pixel rectangle and nearest depth
+		 * @return False if the box crosses the near plane or is off screen
+		 */
+		auto ProjectBox(const TestBox& box, ScreenRect& rect) -> bool;
+
+		/**
+		 * @brief Merge the coverage of a triangle into a tile
+		 * @param tile The tile
+		 * @param mask Pixels of the tile covered by the triangle
+		 * @param z Farthest depth of the triangle in the tile
+		 */
+		static void Merge(Tile& tile, uint64_t mask, float z);
+
+		/**
+		 * @brief Get the mask of a pixel rectangle inside a tile
+		 * @param x0 First column in the tile
+		 * @param x1 Last column in the tile
+		 * @param y0 First row in the tile
+		 * @param y1 Last row in the tile
+		 * @return Mask with the bits of the rectangle set
+		 */
+		static auto RectMask(int x0, int x1, int y0, int y1) -> uint64_t;
+
+		/**
+		 * @brief Rasterize triangles into a horizontal band of tile rows
+		 * @param triangles Triangles in screen space
+		 * @param y0 First pixel row of the band
+		 * @param y1 One past the last pixel row of the band
+		 */
+		void RasterizeBand(std::span<const Triangle> triangles, int y0, int y1);
+
+		/**
+		 * @brief Split a range into one chunk per thread and run them on the job pool
+		 * @param count Size of the range
+		 * @param func Function called with the begin and end of each chunk
+		 */
+		void ParallelFor(size_t count, const std::function<void(size_t, size_t)>& func);
+
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_tilesX;
+		uint32_t m_tilesY;
+		JobPool* m_jobPool;
+		std::vector<Tile> m_tiles;
+		std::vector<Triangle> m_triangles;
+	};
+
+
+    /**
+     * @brief Software occlusion culling. Each frame large objects on screen, or objects flagged with
+	 * Occluder{true}, are rasterized into an OcclusionBuffer. Then the bounding boxes of all objects are tested
+	 * against it, and the result is stored in the Occluded component, which the renderers check before recording.
+     */
+    class OcclusionCulling : public System {
+
+    public:
+		/**
+		 * @brief Culling statistics of the last frame
+		 */
+		struct Stats {
+			size_t m_occluders{0};
+			size_t m_triangles{0};			//occluder triangles rasterized
+			size_t m_objectsTested{0};
+			size_t m_objectsCulled{0};
+			double m_rasterMs{0.0};
+			double m_testMs{0.0};
+		};
+
+        /**
+         * @brief Constructor for the OcclusionCulling class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param width Width of the depth buffer
+         * @param height Height of the depth buffer
+         * @param occluderCoverage Objects covering at least this fraction of the screen become occluders
+         * @param maxOccluders Maximum number of occluders per frame, the largest are used
+         */
+        OcclusionCulling(std::string systemName, Engine& engine, uint32_t width = 320, uint32_t height = 192, real_t occluderCoverage = 0.05, size_t maxOccluders = 64);
+
+        /**
+         * @brief Destructor for the OcclusionCulling class
+         */
+        virtual ~OcclusionCulling();
+
+		/**
+		 * @brief Turn culling on or off, when off no object is marked occluded
+		 * @param enabled True to enable culling
+		 */
+		void SetEnabled(bool enabled) { m_enabled = enabled; }
+
+		/**
+		 * @brief Get the statistics of the last frame
+		 * @return Culling statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+		/**
+		 * @brief Get the depth buffer, e.g. for debug display
+		 * @return The occlusion buffer
+		 */
+		auto GetBuffer() -> OcclusionBuffer& { return m_buffer; }
+
+    private:
+		/**
+		 * @brief Rasterize the occluders and test all objects
+		 * @param message Prepare next frame message
+		 * @return false to continue message propagation
+		 */
+		bool OnPrepareNextFrame(Message message);
+
+		/**
+		 * @brief Compute the bounding box of a mesh
+		 * @param mesh The mesh
+		 * @return Bounding box of the vertex positions
+		 */
+		static auto ComputeBounds(const vvh::Mesh& mesh) -> BoundingBox;
+
+		OcclusionBuffer m_buffer;
+		real_t m_occluderCoverage;
+		size_t m_maxOccluders;
+		bool m_enabled{true};
+		Stats m_stats{};
+    };
+
+};  // namespace vve
+
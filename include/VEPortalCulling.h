@@ -0,0 +1,126 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Cells that are visible in the current frame, shared with the renderers through the registry
+	 */
+	struct PortalVisibility {
+		std::vector<uint8_t> m_visibleCells;	//1 if the cell is visible
+		bool m_enabled{false};					//false if the camera is outside all cells -> everything is visible
+	};
+
+    /**
+     * @brief Cell and portal visibility for indoor scenes. The scene is divided into axis aligned cells that are
+     * connected by portals. Every frame the portals are clipped recursively against the camera frustum, starting
+     * in the camera cell. Objects carry a PortalCellId, the renderers skip objects in cells that are not visible.
+     */
+    class PortalCulling : public System {
+
+    public:
+		/**
+		 * @brief Culling statistics of the last frame
+		 */
+		struct Stats {
+			size_t m_cellsVisible{0};
+			size_t m_objectsVisible{0};
+			size_t m_objectsCulled{0};
+		};
+
+        /**
+         * @brief Constructor for the PortalCulling class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         */
+        PortalCulling(std::string systemName, Engine& engine);
+
+        /**
+         * @brief Destructor for the PortalCulling class
+         */
+        virtual ~PortalCulling();
+
+		/**
+		 * @brief Add a cell
+		 * @param min Minimum corner of the cell in world space
+		 * @param max Maximum corner of the cell in world space
+		 * @return Id of the new cell
+		 */
+		auto AddCell(vec3_t min, vec3_t max) -> uint32_t;
+
+		/**
+		 * @brief Add a portal between two cells, portals can be seen through in both directions
+		 * @param cell0 Id of the first cell
+		 * @param cell1 Id of the second cell
+		 * @param corners Corners of the portal polygon in world space
+		 */
+		void AddPortal(uint32_t cell0, uint32_t cell1, std::array<vec3_t, 4> corners);
+
+		/**
+		 * @brief Assign all objects with a mesh to the cell containing their world position. Objects outside of
+		 * all cells are always drawn. Call this after objects were created or moved between cells.
+		 */
+		void AssignObjects();
+
+		/**
+		 * @brief Get the statistics of the last frame
+		 * @return Culling statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+    private:
+		struct Cell {
+			vec3_t m_min;
+			vec3_t m_max;
+			std::vector<uint32_t> m_portals;
+		};
+
+		struct Portal {
+			std::array<uint32_t, 2> m_cells;
+			std::array<vec3_t, 4> m_corners;
+		};
+
+		/**
+		 * @brief Compute the visible cells for the current camera
+		 * @param message Prepare next frame message
+		 * @return false to continue message propagation
+		 */
+		bool OnPrepareNextFrame(Message message);
+
+		/**
+		 * @brief Find the cell containing a point
+		 * @param point Point in world space
+		 * @return Id of the cell, or -1 if the point is outside all cells
+		 */
+		auto FindCell(vec3_t point) -> int;
+
+		/**
+		 * @brief Mark a cell visible and continue through its portals
+		 * @param cell Id of the cell
+		 * @param rect Screen rectangle (min x, min y, max x, max y) in NDC through which the cell is seen
+		 * @param viewProj View projection matrix of the camera
+		 * @param visible Visibility per cell
+		 * @param depth Recursion depth
+		 */
+		void VisitCell(uint32_t cell, vec4_t rect, const mat4_t& viewProj, std::vector<uint8_t>& visible, uint32_t depth);
+
+		/**
+		 * @brief Project a portal to the screen and clip it against a rectangle
+		 * @param portal The portal
+		 * @param viewProj View projection matrix of the camera
+		 * @param rect Screen rectangle in NDC to clip against
+		 * @param clipped Resulting screen rectangle
+		 * @return True if the clipped rectangle is not empty
+		 */
+		auto ClipPortal(const Portal& portal, const mat4_t& viewProj, const vec4_t& rect, vec4_t& clipped) -> bool;
+
+		std::vector<Cell> m_cells;
+		std::vector<Portal> m_portals;
+		vecs::Handle m_visibilityHandle{};
+		Stats m_stats{};
+    };
+
+};  // namespace vve
+
@@ -0,0 +1,123 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief A view rendered into a rectangle of the window, e.g. one half of a split screen or a picture in
+	 * picture. Stored as entity, renderers draw all enabled views in the order of their index.
+	 */
+	struct RenderView {
+		/**
+		 * @brief Statistics of the last frame
+		 */
+		struct Stats {
+			size_t m_objects{0};				//objects tested
+			size_t m_visible{0};				//objects inside the frustum
+			size_t m_drawCalls{0};
+			size_t m_triangles{0};
+		};
+
+		std::string m_name;
+		uint32_t m_index{0};					//bit in ViewMask, also the drawing order
+		ObjectHandle m_node{};					//scene node giving the camera pose, invalid for the main camera
+		Camera m_camera{};						//projection, the aspect is taken from the viewport
+		vec4_t m_viewport{0.0f, 0.0f, 1.0f, 1.0f};	//x, y, width, height as fraction of the window
+		bool m_clear{false};					//clear color and depth of the viewport before drawing
+		bool m_enabled{true};
+		mat4_t m_view{1.0f};						//set every frame by RenderViews
+		mat4_t m_proj{1.0f};
+		vec3_t m_position{0.0f};
+		Stats m_stats{};
+	};
+
+    /**
+     * @brief Manages render views and culls objects against the frusta of all views. The world bounding sphere
+	 * of each object is computed once and shared by all views. Views seeing through the same frustum, e.g. the
+	 * same camera shown in two places, share the plane tests as well. The result is a ViewMask per object.
+	 * Only the forward renderer draws views, and only into viewports of the window, there are no offscreen targets.
+     */
+    class RenderViews : public System {
+
+    public:
+		static const uint32_t c_maxViews = 32;		//bits of ViewMask
+
+        /**
+         * @brief Constructor for the RenderViews class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         */
+        RenderViews(std::string systemName, Engine& engine);
+
+        /**
+         * @brief Destructor for the RenderViews class, removes all views
+         */
+        virtual ~RenderViews();
+
+		/**
+		 * @brief Add a view
+		 * @param name Name of the view
+		 * @param node Scene node giving the camera pose, invalid for the main camera
+		 * @param viewport x, y, width, height as fraction of the window
+		 * @param camera Projection parameters, the aspect is taken from the viewport
+		 * @param clear Clear the viewport before drawing, e.g. for a picture in picture
+		 * @return Handle of the view entity
+		 */
+		auto AddView(std::string name, ObjectHandle node, vec4_t viewport, Camera camera = {}, bool clear = false) -> vecs::Handle;
+
+		/**
+		 * @brief Remove a view
+		 * @param handle Handle of the view entity
+		 */
+		void RemoveView(vecs::Handle handle);
+
+		/**
+		 * @brief Turn a view on or off
+		 * @param handle Handle of the view entity
+		 * @param enabled True to draw the view
+		 */
+		void SetEnabled(vecs::Handle handle, bool enabled);
+
+		/**
+		 * @brief Get the views
+		 * @return Handles of the view entities
+		 */
+		auto GetViews() -> const std::vector<vecs::Handle>& { return m_views; }
+
+    private:
+		/**
+		 * @brief Compute the matrices of all views and cull objects
+		 * @param message Prepare next frame message
+		 * @return false to continue message propagation
+		 */
+		bool OnPrepareNextFrame(Message message);
+
+		/**
+		 * @brief Add the bounding sphere cache to a memory report
+		 * @param message Memory report message
+		 * @return false to continue message propagation
+		 */
+		bool OnMemoryReport(Message message);
+
+		/**
+		 * @brief Remove the bounding sphere of a destroyed mesh
+		 * @param message Mesh destroy message
+		 * @return false to continue message propagation
+		 */
+		bool OnMeshDestroy(Message message);
+
+		/**
+		 * @brief Get the bounding sphere of a mesh in model space
+		 * @param mesh Handle of the mesh
+		 * @return Center and radius
+		 */
+		auto MeshSphere(MeshHandle mesh) -> vec4_t;
+
+		std::vector<vecs::Handle> m_views;
+		std::unordered_map<size_t, vec4_t> m_meshSpheres;		//mesh handle value to bounding sphere
+    };
+
+};  // namespace vve
+
@@ -51,6 +51,14 @@ namespace vve {
     class Renderer : public System {
         friend class Engine;
 
+		/**
+		 * @brief Uniform buffers shared by a batch of objects, each object uses a range of them
+		 */
+		struct UniformBlock {
+			vvh::Buffer m_buffers;
+			size_t m_users{0};		//ranges not released yet
+		};
+
     public:
         /**
          * @brief Constructor for Renderer
@@ -74,18 +82,79 @@ namespace vve {
 		bool OnInit(Message message);
 		void SubmitCommandBuffer( VkCommandBuffer commandBuffer );
 		void getBindingDescription( std::string type, std::string C, int &binding, int stride, auto& bdesc );
-		auto getBindingDescriptions(std::string type) -> std::vector<VkVertexInputBindingDescription>;
+		auto getBindingDescriptions(std::string type, std::string layout = "") -> std::vector<VkVertexInputBindingDescription>;
 		void addAttributeDescription( std::string type, std::string C, int& binding, int& location, VkFormat format, auto& attd );
-        auto getAttributeDescriptions(std::string type) -> std::vector<VkVertexInputAttributeDescription>;
+        auto getAttributeDescriptions(std::string type, std::string layout = "") -> std::vector<VkVertexInputAttributeDescription>;
+
+		/**
+		 * @brief Check whether an object is hidden or culled by occlusion or portal culling
+		 * @param handle Handle of the object
+		 * @param occlusion If false, occlusion from the camera is ignored
+		 * @return True if the object should be drawn
+		 */
+		auto IsVisible(vecs::Handle handle, bool occlusion = true) -> bool;
+
+		/**
+		 * @brief Check whether an object is drawn in a render view. Views of the main camera use all culling results,
+		 * other views only their frustum, since occlusion and portal culling are done for the main camera.
+		 * @param handle Handle of the object
+		 * @param view The render view
+		 * @return True if the object should be drawn in the view
+		 */
+		auto IsVisibleInView(vecs::Handle handle, const RenderView& view) -> bool;
+
+		/**
+		 * @brief Get the enabled render views in drawing order
+		 * @return Handles of the view entities, empty if there are no views
+		 */
+		auto GetRenderViews() -> std::vector<vecs::Handle>;
 
 		template<typename T> 
 		auto RegisterLight(float type, std::vector<vvh::Light>& lights, int& i) -> int;
 
+		/**
+		 * @brief Create the uniform buffers of a batch of objects as ranges of one buffer per frame in flight
+		 * @param sizes Size of the uniform buffer of each object
+		 * @param buffers Receives one range per size
+		 */
+		void CreateObjectBuffers(const std::vector<VkDeviceSize>& sizes, std::vector<vvh::Buffer>& buffers);
+
+		/**
+		 * @brief Release the uniform buffer of an object. Shared buffers are destroyed with their last range.
+		 * @param buffer The buffer or range, it is empty afterwards
+		 */
+		void DestroyObjectBuffer(vvh::Buffer& buffer);
+
+		/**
+		 * @brief Allocate the descriptor sets of a batch of objects with one call. If the object pool is full, a
+		 * larger pool is added, so any batch size can be allocated.
+		 * @param layouts Layout of each descriptor set
+		 * @param descriptorSets Receives one descriptor set per layout
+		 */
+		void CreateObjectDescriptorSets(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<vvh::DescriptorSet>& descriptorSets);
+
+		/**
+		 * @brief Free the descriptor set of an object in the pool it was allocated from
+		 * @param descriptorSet The descriptor set, it is empty afterwards
+		 */
+		void FreeObjectDescriptorSet(vvh::DescriptorSet& descriptorSet);
+
+		/**
+		 * @brief Destroy the shared uniform buffers and the object descriptor pools when quitting
+		 */
+		void DestroyObjectResources();
+
 		std::string 				m_windowName;
 		vecs::Ref<WindowState> 		m_windowState{};
 		vecs::Ref<WindowSDLState> 	m_windowSDLState{};
 		vecs::Handle 				m_vulkanStateHandle{};
 		vecs::Ref<VulkanState> 		m_vkState{};
+		vecs::Handle 				m_portalVisibilityHandle{};
+
+		static constexpr uint32_t c_objectPoolSize = 1000;			//descriptor sets in the first object pool
+		std::map<VkBuffer, UniformBlock> m_uniformBlocks;			//by the buffer of the first frame in flight
+		std::vector<VkDescriptorPool> m_objectDescriptorPools;		//sets are allocated from the last one
+		uint32_t m_objectPoolSize{0};								//descriptor sets of the last pool
     };
 
 };   // namespace vve
\ No newline at end of file
@@ -17,6 +17,8 @@ namespace vve {
 			std::string m_type;
 			VkDescriptorSetLayout m_descriptorSetLayoutPerObject{ VK_NULL_HANDLE };
 			vvh::Pipeline m_graphicsPipeline{};
+			std::filesystem::path m_shader;
+			std::string m_layout;		// streams of the interleaved vertices, empty for separate streams
 		};
 
 		struct alignas(16) PushConstantsLight {
@@ -46,6 +48,10 @@ namespace vve {
 		bool OnPrepareNextFrame(const Message& message);
 		bool OnRecordNextFrame(const Message& message);
 		bool OnObjectCreate(Message& message);
+		bool OnObjectsCreate(Message& message);
+		bool OnObjectsAssetsChanged(Message& message);
+		void CreateObjectResources(std::span<const ObjectHandle> objects);
+		void UpdateObjectUniformBuffer(const vecs::Handle& oHandle);
 		bool OnObjectDestroy(Message& message);
 		bool OnWindowSize(const Message& message);
 		bool OnQuit(const Message& message);
@@ -55,7 +61,8 @@ namespace vve {
 		void CreateDeferredResources();
 		void DestroyDeferredResources();
 		auto getPipelineType(const ObjectHandle& handle, const vvh::VertexData& vertexData) const -> const std::string;
-		auto getPipelinePerType(const std::string& type) const -> const PipelinePerType*;
+		auto getPipelinePerType(const std::string& type) -> const PipelinePerType*;
+		auto CreateGeometryPipelineVariant(const std::filesystem::path& shader, int pri, const std::string& type, const std::string& layout = "") -> PipelinePerType*;
 		void UpdateLightStorageBuffer();
 		void UpdateShadowResources();
 
@@ -97,13 +104,16 @@ namespace vve {
 		vvh::DescriptorSet m_descriptorSetsComposition{};
 		vvh::DescriptorSet m_descriptorSetShadow{};
 
-		std::map<int, PipelinePerType> m_geomPipesPerType;
+		std::multimap<int, PipelinePerType> m_geomPipesPerType;	// by shader priority
+		const VkRenderPass* m_geometryRenderPass{ nullptr };
 		std::array<vvh::Pipeline, 2> m_lightingPipeline{};
 
 		std::array<VkCommandPool, MAX_FRAMES_IN_FLIGHT> m_commandPools{};
 
 		glm::ivec3 m_numberLightsPerType{ 0, 0, 0 };
 		bool m_lightsChanged{ true };
+		std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> m_updatedFrame{};	// frame in which the object uniform buffers of a slot were written
+		std::vector<vecs::Handle> m_changedObjects;
 	};
 
 }	// namespace vve
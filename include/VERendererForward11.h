@@ -19,6 +19,17 @@ namespace vve
 			std::string m_type;
 			VkDescriptorSetLayout m_descriptorSetLayoutPerObject;
 	    	vvh::Pipeline m_graphicsPipeline;
+			std::filesystem::path m_shader;
+			std::string m_layout;		//streams of the interleaved vertices, empty for separate streams
+		};
+
+		/**
+		 * @brief Camera uniform buffer and descriptor set of a render view
+		 */
+		struct ViewResources {
+			vvh::Buffer m_uniformBuffers;
+			vvh::DescriptorSet m_descriptorSet{0};
+			bool m_created{false};
 		};
 
     public:
@@ -39,9 +50,16 @@ namespace vve
         bool OnPrepareNextFrame(Message message);
         bool OnRecordNextFrame(Message message);
 		bool OnObjectCreate( Message message );
+		bool OnObjectsCreate( Message message );
+		bool OnObjectsAssetsChanged( Message message );
+		void CreateObjectResources( std::span<const ObjectHandle> objects );
 		bool OnObjectDestroy( Message message );
         bool OnQuit(Message message);
 		void CreatePipelines();
+		PipelinePerType* CreatePipeline(const std::filesystem::path& shader, int pri, std::string type, std::string layout = "");
+		void CreateViewResources(uint32_t index);
+		void RecordObjects(VkCommandBuffer cmdBuffer, vvh::DescriptorSet& descriptorSetPerFrame, 
+			const std::vector<VkViewport>& viewports, const std::vector<VkRect2D>& scissors, RenderView* view);
 
 		PipelinePerType* getPipelinePerType(std::string type);
 		std::string getPipelineType(ObjectHandle handle, vvh::VertexData &vertexData);
@@ -51,7 +69,8 @@ namespace vve
 		vvh::Buffer m_storageBuffersLights;
 		VkDescriptorSetLayout m_descriptorSetLayoutPerFrame;
 		vvh::DescriptorSet m_descriptorSetPerFrame{0};
-		std::map<int, PipelinePerType> m_pipelinesPerType;
+		std::multimap<int, PipelinePerType> m_pipelinesPerType;	//by shader priority
+		std::vector<ViewResources> m_viewResources;		//per render view index
 	    VkRenderPass m_renderPassClear;
 	    VkRenderPass m_renderPass;
 	    VkDescriptorPool m_descriptorPool;    
@@ -0,0 +1,76 @@
+#pragma once
+
+
+namespace vve {
+
+    /**
+     * @brief Renderer that issues no GPU work. It consumes the same messages as the Vulkan renderers and keeps
+     * track of meshes, textures and objects, and counts what would have been drawn. No Vulkan instance or device
+     * is created, so the engine loop runs on machines without a GPU, e.g. servers and CI workers. ImGui frames are
+     * built but not drawn, so game code may use ImGui as usual.
+     */
+    class RendererNull : public Renderer {
+
+    public:
+		/**
+		 * @brief Bookkeeping of resources and statistics of the last frame
+		 */
+		struct Stats {
+			size_t m_frames{0};				//frames recorded
+			size_t m_meshes{0};
+			size_t m_textures{0};
+			size_t m_objects{0};			//objects with a mesh
+			size_t m_bufferBytes{0};		//vertex and index data a GPU renderer would upload
+			size_t m_textureBytes{0};		//texel data a GPU renderer would upload
+			size_t m_drawCalls{0};			//draw calls of the last frame, summed over all render views
+			size_t m_triangles{0};
+		};
+
+        /**
+         * @brief Constructor for the null renderer
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param windowName Name of the associated window
+         */
+        RendererNull(std::string systemName, Engine& engine, std::string windowName);
+        /**
+         * @brief Destructor for the null renderer
+         */
+        virtual ~RendererNull();
+
+		/**
+		 * @brief Get the bookkeeping and statistics
+		 * @return The statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+    private:
+        bool OnInit(Message message);
+        bool OnPrepareNextFrame(Message message);
+        bool OnRecordNextFrame(Message message);
+		bool OnTextureCreate(Message message);
+		bool OnTextureDestroy(Message message);
+		bool OnMeshCreate(Message message);
+		bool OnMeshDestroy(Message message);
+		bool OnObjectCreate(Message message);
+		bool OnObjectsCreate(Message message);
+		bool OnObjectDestroy(Message message);
+		bool OnMemoryReport(Message message);
+        bool OnQuit(Message message);
+
+		/**
+		 * @brief Count the draw calls and triangles of the visible objects
+		 * @param view Render view, or nullptr if there are no views
+		 * @param drawCalls Receives the number of draw calls
+		 * @param triangles Receives the number of triangles
+		 */
+		void CountObjects(const RenderView* view, size_t& drawCalls, size_t& triangles);
+
+		Stats m_stats{};
+		std::unordered_map<size_t, size_t> m_meshBytes;		//mesh handle value to buffer bytes
+		std::unordered_map<size_t, size_t> m_textureBytes;	//texture handle value to texel bytes
+		std::unordered_set<size_t> m_objects;				//handle values of objects with a mesh
+    };
+
+};   // namespace vve
+
@@ -66,6 +66,9 @@ namespace vve
 		bool OnPrepareNextFrame(const Message& message);
 		bool OnRecordNextFrame(const Message& message);
 		bool OnObjectCreate(Message& message);
+		bool OnObjectsCreate(Message& message);
+		bool OnObjectsAssetsChanged(Message& message);
+		void CreateObjectResources(std::span<const ObjectHandle> objects);
 		bool OnObjectDestroy(Message& message);
 		bool OnObjectChanged(Message& message);
 		bool OnQuit(const Message& message);
@@ -80,6 +83,8 @@ namespace vve
 		void DestroyShadowMap();
 		void RenderShadowMap();
 		void RenderObjectPosition(const VkCommandBuffer& cmdBuffer, uint32_t& layer);
+		void CreateShadowPipeline(const std::string& type, const std::string& layout, vvh::Pipeline& pipeline);
+		auto getShadowPipeline(const vvh::VertexData& vertexData) -> const vvh::Pipeline&;
 		void RenderPointLightShadow(const VkCommandBuffer& cmdBuffer, uint32_t& layer, const float& near = 1.0f, const float& far = 25.0f);
 		void RenderDirectLightShadow(const VkCommandBuffer& cmdBuffer, uint32_t& layer, const float& near = 1.0f, const float& far = 25.0f);
 		void RenderSpotLightShadow(const VkCommandBuffer& cmdBuffer, uint32_t& layer, const float& near = 1.0f, const float& far = 25.0f);
@@ -90,13 +95,13 @@ namespace vve
 		std::vector<VkImageView> m_layerViews{ VK_NULL_HANDLE };
 		std::vector<VkFramebuffer> m_shadowFrameBuffers{ VK_NULL_HANDLE };
 
-	    VkDescriptorPool m_descriptorPool{ VK_NULL_HANDLE };
 		VkDescriptorSetLayout m_descriptorSetLayoutPerObject{ VK_NULL_HANDLE };
 
 		std::vector<VkCommandPool> m_commandPools{ VK_NULL_HANDLE };
 		std::vector<VkCommandBuffer> m_commandBuffers{ VK_NULL_HANDLE };
 
 		vvh::Pipeline m_shadowPipeline{};
+		std::map<std::string, vvh::Pipeline> m_shadowPipelineVariants;	// for quantized and interleaved positions, by vertex layout
 
 		vecs::Handle m_shadowImageHandle;
 
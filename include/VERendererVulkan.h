@@ -7,6 +7,20 @@ namespace vve {
 	//-------------------------------------------------------------------------------------------------------
 	// Vulkan Renderer
 
+	/**
+	 * @brief Pixels of a texture in a staging buffer, copied to the image and mipmapped in the next frame
+	 */
+	struct TextureUpload {
+		VkImage m_image;
+		VkBuffer m_buffer;
+		VmaAllocation m_allocation;
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_levels;						//levels in the buffer
+		uint32_t m_mipLevels;					//levels of the image, the levels after m_levels are blitted
+		std::vector<VkDeviceSize> m_offsets;	//offset of each level in the buffer
+	};
+
     /**
      * @brief Basic Vulkan renderer implementation
      */
@@ -38,6 +52,34 @@ namespace vve {
 		bool OnTextureDestroy( Message message );
 		bool OnMeshCreate( Message message );
 		bool OnMeshDestroy( Message message );
+		void WriteDynamicMeshes();
+
+		/**
+		 * @brief Decode a block compressed texture to RGBA8 on the CPU, for devices that cannot sample its format
+		 * @param texture The texture, its pixels are replaced
+		 * @return false if the texture could not be decoded
+		 */
+		auto DecompressTexture( vvh::Image& texture ) -> bool;
+
+		/**
+		 * @brief Check if mips of a format can be generated with linear blits
+		 * @param format The format
+		 * @return true if the format supports linear filtering and blits from and to optimal images
+		 */
+		auto CanGenerateMips( VkFormat format ) -> bool;
+
+		/**
+		 * @brief Record the copies and mip blits of all textures created since the last frame. Barriers of all
+		 * textures are batched, one barrier command per mip level.
+		 * @param commandBuffer The command buffer of the frame, outside a render pass
+		 */
+		void RecordTextureUploads( VkCommandBuffer commandBuffer );
+
+		/**
+		 * @brief Destroy the staging buffers of uploads
+		 * @param uploads The uploads, cleared
+		 */
+		void DestroyTextureUploads( std::vector<TextureUpload>& uploads );
 
         bool OnQuit(Message message);
 
@@ -74,6 +116,9 @@ namespace vve {
         std::vector<VkSemaphore> m_renderFinishedSemaphores;
 	    std::vector<vvh::Semaphores> m_intermediateSemaphores;
 		std::vector<VkFence> m_fences;
+		std::vector<TextureUpload> m_textureUploads;	//recorded in the next frame
+		std::array<std::vector<TextureUpload>, MAX_FRAMES_IN_FLIGHT> m_uploadsInFlight; //staging buffers freed when the frame is done
+		std::vector<vecs::Handle> m_dynamicMeshes;		//meshes whose buffers are written every frame
     };
 };   // namespace vve
 
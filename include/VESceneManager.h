@@ -22,6 +22,30 @@ namespace vve {
 	};
 
 	//-------------------------------------------------------------------------------------------------------
+	//Prefab
+
+	/**
+	 * @brief Immutable template of an imported model. Nodes are stored in depth first order, so a parent
+	 * always comes before its children. Instances clone the nodes, only the instance root transform differs.
+	 */
+	struct Prefab {
+		struct Node {
+			std::string m_name{};
+			int32_t m_parent{-1}; 					//index of the parent node, -1 is the instance root
+			vec3_t m_position{0.0f};
+			mat3_t m_rotation{1.0f};
+			vec3_t m_scale{1.0f};
+			std::string m_meshName{};				//empty if the node has no mesh
+			std::string m_textureName{};			//empty if the node has no diffuse texture
+			std::optional<vvh::Color> m_color{};
+			std::optional<vvh::Material> m_material{};
+		};
+		std::vector<Node> m_nodes;
+		bool m_loading{false};						//still imported on a worker thread, the nodes are added when done
+		bool m_failed{false};						//the import on the worker thread failed, the prefab is no longer cached
+	};
+
+	//-------------------------------------------------------------------------------------------------------
 
     /**
      * @brief Manages the scene graph and scene nodes
@@ -54,7 +78,11 @@ namespace vve {
 		bool OnUpdate(Message message);
 		bool OnSceneCreate(Message message);
 		bool OnObjectCreate(Message message);
-		void ProcessNode(aiNode* node, ParentHandle parent, std::filesystem::path& filepath, const aiScene* scene, uint64_t& id);
+		bool OnObjectsCreate(Message message);
+		void InstantiatePrefab(const Prefab& prefab, ObjectHandle root);
+		void InstantiateNode(const Prefab::Node& node, ObjectHandle root, std::vector<vecs::Handle>& handles);
+		bool OnLoadStep(Message message);
+		bool OnMemoryReport(Message message);
 		bool OnObjectSetParent(Message message);
 		void SetParent(ObjectHandle object, ParentHandle parent);
 		bool OnObjectDestroy(Message message);
@@ -64,6 +92,37 @@ namespace vve {
 		ObjectHandle m_cameraNodeHandle;
 		ObjectHandle m_worldHandle;
 		ObjectHandle m_rootHandle;
+
+		/**
+		 * @brief A scene whose nodes are cloned incrementally
+		 */
+		struct PendingScene {
+			const Prefab* m_prefab;
+			ObjectHandle m_root;
+			bool m_waitForAssets{true};				//false if objects may use placeholders
+			bool m_counted{false};					//nodes are included in m_loadTotal, once the prefab is loaded
+			std::vector<vecs::Handle> m_handles{};	//nodes cloned so far
+		};
+		std::deque<PendingScene> m_pendingScenes;
+		size_t m_loadTotal{0}; //nodes of the pending scenes
+		size_t m_loadDone{0};
+
+		/**
+		 * @brief Components of a scene node, gathered on the main thread before the parallel transform update
+		 */
+		struct TransformNode {
+			vecs::Handle m_handle;
+			const vec3_t* m_position;
+			const mat3_t* m_rotation;
+			const vec3_t* m_scale;
+			mat4_t* m_LtoP;
+			mat4_t* m_LtoW;
+			bool m_direct;		//local to parent matrix written by SetWorldMatrices
+			size_t m_parent;	//index of the parent node, or std::numeric_limits<size_t>::max() below the root
+			size_t m_end;		//one past the last node of the subtree
+		};
+		std::vector<TransformNode> m_transformNodes; //all nodes below the root in depth first order, kept to reuse the memory
+		std::vector<size_t> m_transformRoots;		 //index of each child of the root
     };
 
 };  // namespace vve
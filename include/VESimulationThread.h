@@ -0,0 +1,101 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Runs a simulation (physics, animation, crowds) at a fixed rate on its own thread. Each step publishes
+     * the transforms of the simulated objects into a double buffer. On UPDATE the render side interpolates between
+     * the last two published states and writes the result into the registry, so simulation rate and frame rate
+	 * are independent.
+     */
+    class SimulationThread : public System {
+
+    public:
+		/**
+		 * @brief Callback that advances the simulation by one fixed step. It runs on the simulation thread and must
+		 * not access the registry, only its own state. Transforms of all simulated objects are appended to the vector.
+		 */
+		using SimulateCallback = std::function<void(double dt, std::vector<Engine::TransformInfo>& transforms)>;
+
+        /**
+         * @brief Constructor for the SimulationThread class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param stepSize Fixed simulation step in seconds
+         * @param callback Function advancing the simulation by one step
+         */
+        SimulationThread(std::string systemName, Engine& engine, double stepSize, SimulateCallback callback);
+
+        /**
+         * @brief Destructor for the SimulationThread class, stops the thread
+         */
+        virtual ~SimulationThread();
+
+		/**
+		 * @brief Start the simulation thread
+		 */
+		void Start();
+
+		/**
+		 * @brief Stop the simulation thread and wait for it to finish
+		 */
+		void Stop();
+
+		/**
+		 * @brief Lock the simulation state, e.g. for adding bodies from the main thread. The simulation does not step while the lock is held.
+		 * @return Lock on the simulation mutex
+		 */
+		auto Lock() -> std::unique_lock<std::mutex> { return std::unique_lock<std::mutex>{m_simulationMutex}; }
+
+		/**
+		 * @brief Get the number of simulation steps done so far
+		 * @return Number of steps
+		 */
+		auto GetNumberSteps() -> uint64_t { return m_numberSteps.load(); }
+
+    private:
+		/**
+		 * @brief One published simulation state
+		 */
+		struct State {
+			std::vector<Engine::TransformInfo> m_transforms;
+			std::unordered_map<size_t, size_t> m_index;		//handle value to index in m_transforms
+			std::chrono::high_resolution_clock::time_point m_time{};
+		};
+
+		/**
+		 * @brief Interpolate the published states and write them to the registry
+		 * @param message Update message
+		 * @return false to continue message propagation
+		 */
+		bool OnUpdate(Message message);
+
+		/**
+		 * @brief Stop the thread on quit
+		 * @param message Quit message
+		 * @return false to continue message propagation
+		 */
+		bool OnQuit(Message message);
+
+		/**
+		 * @brief Main loop of the simulation thread
+		 * @param stop Stop token of the thread
+		 */
+		void Run(std::stop_token stop);
+
+		double m_stepSize;
+		SimulateCallback m_callback;
+		std::mutex m_simulationMutex;				//held while the simulation steps
+		std::mutex m_publishMutex;					//protects the published states
+		std::array<State, 2> m_published{};			//previous and current state
+		State m_working{};							//filled by the simulation thread
+		std::vector<Engine::TransformInfo> m_interpolated;
+		std::atomic<uint64_t> m_numberSteps{0};
+		std::jthread m_thread;						//last member -> joined before the other members are destroyed
+    };
+
+};  // namespace vve
+
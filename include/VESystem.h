@@ -41,13 +41,17 @@ namespace vve {
 		//---------------------
 		"SCENE_LOAD",	
 		"SCENE_CREATE",	
+		"LOAD_STEP",	//continue incremental loading within a time budget
 		"OBJECT_CREATE",	
+		"OBJECTS_CREATE",	
+		"OBJECTS_ASSETS_CHANGED",	//mesh or texture handles of objects were replaced, e.g. a placeholder by the loaded asset
 		"OBJECT_DESTROY",
 		"OBJECT_SET_PARENT",	
 		"TEXTURE_CREATE",  
 		"TEXTURE_DESTROY", 
 		"MESH_CREATE",	
 		"MESH_DESTROY",	
+		"MEMORY_REPORT",	//systems add their memory to a report
         "DELETED", //React to something being deleted
         "LAST", //
 		//---------------------
@@ -56,6 +60,15 @@ namespace vve {
     };
 
 
+    /**
+     * @brief How a scene is created from a file
+     */
+    enum class LoadMode : int {
+        LOAD_MODE_BLOCKING,			///< import, assets and nodes in the current frame
+        LOAD_MODE_INCREMENTAL,		///< import now, assets and nodes over the next frames within the load budget
+        LOAD_MODE_ASYNC				///< import and decode on worker threads, objects show placeholders until their assets are ready
+    };
+
     /**
      * @brief Base class for all engine systems
      *
@@ -157,12 +170,23 @@ namespace vve {
 
 	    /** @brief Message for creating a scene */
 	    struct MsgSceneCreate : public MsgBase {
-			MsgSceneCreate(ObjectHandle object, ParentHandle parent, Filename sceneName, aiPostProcessSteps ai_flags=aiProcess_Triangulate);
+			MsgSceneCreate(ObjectHandle object, ParentHandle parent, Filename sceneName, aiPostProcessSteps ai_flags=aiProcess_Triangulate, LoadMode mode=LoadMode::LOAD_MODE_BLOCKING);
 			ObjectHandle m_object{};
 			ParentHandle m_parent{};
 			Filename m_sceneName;
 			aiPostProcessSteps m_ai_flags;
-			const C_STRUCT aiScene* m_scene{};
+			LoadMode m_mode; //incremental and async scenes are completed in LOAD_STEP messages
+			const Prefab* m_prefab{}; //set by the asset manager, template the scene manager clones
+		};
+
+	    /** @brief Message for continuing incremental loading, handlers do units of work until the budget is used up */
+	    struct MsgLoadStep : public MsgBase {
+			MsgLoadStep(double budgetMs, LoadProgress* progress);
+			/** @brief Time since the step started in milliseconds */
+			auto ElapsedMs() -> double { return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count(); }
+			double m_budgetMs;
+			LoadProgress* m_progress; //handlers report their progress here
+			std::chrono::high_resolution_clock::time_point m_start;
 		};
 
 	    /** @brief Message for creating an object */
@@ -173,6 +197,20 @@ namespace vve {
 			System* m_sender{};
 		};
 
+	    /** @brief Message for creating a batch of objects, the handles must stay alive until SendMsg returns */
+	    struct MsgObjectsCreate : public MsgBase {
+			MsgObjectsCreate(std::span<const ObjectHandle> objects, ParentHandle parent, System* sender=nullptr);
+			std::span<const ObjectHandle> m_objects{};
+			ParentHandle m_parent{};
+			System* m_sender{};
+		};
+
+	    /** @brief Message for replaced mesh or texture handles of objects, renderers rebuild the resources of the objects */
+	    struct MsgObjectsAssetsChanged : public MsgBase {
+			MsgObjectsAssetsChanged(std::span<const ObjectHandle> objects);
+			std::span<const ObjectHandle> m_objects{};
+		};
+
 		/** @brief Message for setting object parent */
 		struct MsgObjectSetParent : public MsgBase { MsgObjectSetParent( ObjectHandle object, ParentHandle Parent); ObjectHandle m_object; ParentHandle m_parent;};
 		/** @brief Message for destroying an object */
@@ -188,6 +226,8 @@ namespace vve {
 	    struct MsgMeshCreate : public MsgBase { MsgMeshCreate( MeshHandle handle); MeshHandle m_handle; };
 	    /** @brief Message for mesh destruction */
 	    struct MsgMeshDestroy : public MsgBase { MsgMeshDestroy(MeshHandle handle); MeshHandle m_handle; };
+	    /** @brief Message for collecting memory statistics, handlers add the memory of their containers to the report */
+	    struct MsgMemoryReport : public MsgBase { MsgMemoryReport(MemoryReport* report); MemoryReport* m_report; };
 		/** @brief Message for deleted resources */
 		struct MsgDeleted : public MsgBase { MsgDeleted(double dt ); void* m_ptr; uint64_t m_id; };
 
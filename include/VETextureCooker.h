@@ -0,0 +1,209 @@
+#pragma once
+#include <filesystem>
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief What a texture is used for, decides the mip filter, the color space and the block format
+	 */
+	enum class TextureUsage {
+		TEXTURE_USAGE_COLOR,		//sRGB color, BC1 if opaque, else BC3, BC7 in high quality
+		TEXTURE_USAGE_LINEAR,		//linear color or packed data, e.g. occlusion/roughness/metallic, same formats as color
+		TEXTURE_USAGE_NORMAL,		//tangent space normal map, x and y in BC5, z is reconstructed in the shader
+		TEXTURE_USAGE_MASK			//one channel, e.g. roughness, metallic or height, BC4
+	};
+
+	/**
+	 * @brief Options of cooking one texture
+	 */
+	struct CookOptions {
+		TextureUsage m_usage{TextureUsage::TEXTURE_USAGE_COLOR};
+		bool m_highQuality{false};		//BC7 instead of BC1/BC3 for color
+		uint32_t m_channel{0};			//channel used by a mask, 0 to 3
+		bool m_mips{true};				//generate the full mip chain
+	};
+
+	/**
+	 * @brief A cooked texture: the blocks of all mip levels of one 2D image
+	 */
+	struct CookedTexture {
+		VkFormat m_format{VK_FORMAT_UNDEFINED};
+		uint32_t m_width{0};
+		uint32_t m_height{0};
+		std::vector<std::vector<uint8_t>> m_levels;	//data of each mip level, level 0 first
+	};
+
+	/**
+	 * @brief One uncompressed mip level, 8 bit RGBA, encoded in the color space of the usage
+	 */
+	struct MipLevel {
+		uint32_t m_width{0};
+		uint32_t m_height{0};
+		std::vector<uint8_t> m_pixels;
+	};
+
+    /**
+     * @brief Offline texture cooker. Generates mip chains, encodes them as BC1, BC3, BC4, BC5 or BC7 depending on the
+	 * usage of the texture and writes them as KTX2 files, which the asset manager uploads without decoding. Runs on
+	 * the CPU only and does not use the registry, so it can be called from tools and worker threads.
+	 *
+	 * Mips are box filtered with exact coverage weights, so odd sizes are handled. Colors are filtered in linear
+	 * space and with premultiplied alpha, normals are renormalized after filtering.
+     */
+    class TextureCooker {
+
+    public:
+		inline static const std::string c_extension { ".ktx2" };
+
+		/**
+		 * @brief Generate the mip chain of an image
+		 * @param rgba The pixels, 8 bit RGBA
+		 * @param width Width of the image
+		 * @param height Height of the image
+		 * @param usage Usage of the texture, decides how texels are filtered
+		 * @param mips Generate all levels down to 1x1, otherwise only level 0
+		 * @return The levels, level 0 first
+		 */
+		static auto GenerateMips(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, bool mips = true) -> std::vector<MipLevel>;
+
+		/**
+		 * @brief Cook an image: generate its mips and encode them
+		 * @param rgba The pixels, 8 bit RGBA
+		 * @param width Width of the image
+		 * @param height Height of the image
+		 * @param options Usage and quality
+		 * @return The cooked texture
+		 */
+		static auto Cook(const uint8_t* rgba, uint32_t width, uint32_t height, CookOptions options) -> CookedTexture;
+
+		/**
+		 * @brief Cook an image file into a KTX2 file
+		 * @param source The image file, any format stb_image reads
+		 * @param target The KTX2 file
+		 * @param options Usage and quality
+		 * @return true if the file was written
+		 */
+		static auto CookFile(const std::filesystem::path& source, const std::filesystem::path& target, CookOptions options) -> bool;
+
+		/**
+		 * @brief Path of the cooked file of an image, the image path with the extension .ktx2
+		 * @param source The image file
+		 * @return The path of the cooked file
+		 */
+		static auto CookedPath(const std::filesystem::path& source) -> std::filesystem::path;
+
+		/**
+		 * @brief Guess the usage of a texture from its file name, e.g. "brick_normal.png" is a normal map
+		 * @param file The image file
+		 * @return The usage
+		 */
+		static auto GuessUsage(const std::filesystem::path& file) -> TextureUsage;
+
+		/**
+		 * @brief Write a cooked texture as KTX2 file without supercompression
+		 * @param file Path of the file
+		 * @param texture The texture
+		 * @return true if the file was written
+		 */
+		static auto WriteKtx2(const std::filesystem::path& file, const CookedTexture& texture) -> bool;
+
+		/**
+		 * @brief Read a KTX2 file with one 2D image and no supercompression
+		 * @param file Path of the file
+		 * @return The texture, or nullopt if the file cannot be read or uses other features
+		 */
+		static auto ReadKtx2(const std::filesystem::path& file) -> std::optional<CookedTexture>;
+
+		/**
+		 * @brief Decode a mip level to 8 bit RGBA, e.g. for devices without BC support. BC7 is only decoded in
+		 * mode 6, which is the mode the cooker writes.
+		 * @param texture The texture
+		 * @param level The mip level
+		 * @return The pixels, empty if the format or a BC7 mode is not supported
+		 */
+		static auto Decode(const CookedTexture& texture, uint32_t level) -> std::vector<uint8_t>;
+
+		/**
+		 * @brief Size of a texel block of a format the cooker reads or writes
+		 * @param format The format
+		 * @return Bytes of a 4x4 block, or of a texel for uncompressed formats, 0 if the format is not supported
+		 */
+		static auto BlockBytes(VkFormat format) -> uint32_t;
+
+		/**
+		 * @brief Check if a format is block compressed
+		 * @param format The format
+		 * @return true for BC formats
+		 */
+		static auto IsCompressed(VkFormat format) -> bool;
+
+		/**
+		 * @brief Bytes of a mip level
+		 * @param format The format
+		 * @param width Width of the level
+		 * @param height Height of the level
+		 * @return Number of bytes
+		 */
+		static auto LevelBytes(VkFormat format, uint32_t width, uint32_t height) -> size_t;
+
+	private:
+		/**
+		 * @brief Encode a 4x4 block of RGBA texels as BC1 color block, always in four color mode
+		 * @param texels 16 texels, 8 bit RGBA
+		 * @param out 8 bytes
+		 */
+		static void EncodeBC1(const uint8_t* texels, uint8_t* out);
+
+		/**
+		 * @brief Encode one channel of a 4x4 block as BC4 block, also used for the alpha of BC3 and for BC5
+		 * @param texels 16 texels, 8 bit RGBA
+		 * @param channel The channel
+		 * @param out 8 bytes
+		 */
+		static void EncodeBC4(const uint8_t* texels, uint32_t channel, uint8_t* out);
+
+		/**
+		 * @brief Encode a 4x4 block as BC7 mode 6 block: one subset, RGBA endpoints and 4 bit indices
+		 * @param texels 16 texels, 8 bit RGBA
+		 * @param out 16 bytes
+		 */
+		static void EncodeBC7(const uint8_t* texels, uint8_t* out);
+
+		/**
+		 * @brief Decode a BC1 color block
+		 * @param block 8 bytes
+		 * @param texels 16 texels, 8 bit RGBA
+		 * @param fourColors Always use four colors, as in BC3
+		 */
+		static void DecodeBC1(const uint8_t* block, uint8_t* texels, bool fourColors);
+
+		/**
+		 * @brief Decode a BC4 block into one channel
+		 * @param block 8 bytes
+		 * @param texels 16 texels, 8 bit RGBA
+		 * @param channel The channel
+		 */
+		static void DecodeBC4(const uint8_t* block, uint8_t* texels, uint32_t channel);
+
+		/**
+		 * @brief Decode a BC7 mode 6 block
+		 * @param block 16 bytes
+		 * @param texels 16 texels, 8 bit RGBA
+		 * @return false if the block uses another mode
+		 */
+		static auto DecodeBC7(const uint8_t* block, uint8_t* texels) -> bool;
+
+		/**
+		 * @brief Choose the format of a cooked texture
+		 * @param options Usage and quality
+		 * @param opaque All texels of level 0 have alpha 255
+		 * @return The format
+		 */
+		static auto ChooseFormat(CookOptions options, bool opaque) -> VkFormat;
+	};
+
+};  // namespace vve
+
@@ -0,0 +1,32 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+	// Null Window
+
+    /**
+     * @brief Window without a display, only holds the window state. Used with the null renderer to run the
+     * engine loop on machines without a display or GPU. No input events are produced.
+     */
+    class WindowNull : public Window {
+
+    public:
+        /**
+         * @brief Constructor for the null window
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param windowTitle Title of the window
+         * @param width Window width reported to other systems
+         * @param height Window height reported to other systems
+         */
+        WindowNull(std::string systemName, Engine& engine, std::string windowTitle, int width, int height );
+        /**
+         * @brief Destructor for the null window
+         */
+        virtual ~WindowNull();
+    };
+
+};  // namespace vve
+
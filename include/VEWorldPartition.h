@@ -0,0 +1,116 @@
+#pragma once
+
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+
+    /**
+     * @brief Streams a world that is split into square grid cells on the xy-plane. Each cell is stored in its own file
+     * in a directory. Cells within a radius around the camera are loaded asynchronously and instantiated within a time
+     * budget per frame, cells outside the radius are evicted.
+     *
+     * Cell files are named cell_<x>_<y>.cell and contain one object per line:
+     * <mesh name> <diffuse r> <diffuse g> <diffuse b> <x> <y> <z> <scale>
+     */
+    class WorldPartition : public System {
+
+    public:
+		/**
+		 * @brief Streaming statistics
+		 */
+		struct Stats {
+			size_t m_cellsResident{0};		//cells that are fully instantiated
+			size_t m_cellsPending{0};		//cells being loaded or instantiated
+			size_t m_objects{0};			//objects currently in the scene
+			size_t m_bytesContent{0};		//CPU memory of the loaded cell content
+			size_t m_cellsLoaded{0};		//total number of cells loaded so far
+			size_t m_cellsEvicted{0};		//total number of cells evicted so far
+			double m_lastFrameMs{0.0};		//streaming time spent in the last frame
+			double m_maxFrameMs{0.0};		//maximum streaming time spent in a frame
+		};
+
+        /**
+         * @brief Constructor for the WorldPartition class
+         * @param systemName Name of the system
+         * @param engine Reference to the engine
+         * @param directory Directory containing the cell files
+         * @param cellSize Edge length of a cell
+         * @param radius Cells within this many cells of the camera cell are kept resident
+         * @param budgetMs Time budget for instantiating objects per frame in milliseconds
+         */
+        WorldPartition(std::string systemName, Engine& engine, std::filesystem::path directory, real_t cellSize, int radius, double budgetMs = 2.0);
+
+        /**
+         * @brief Destructor for the WorldPartition class
+         */
+        virtual ~WorldPartition();
+
+		/**
+		 * @brief Get the streaming statistics
+		 * @return Current statistics
+		 */
+		auto GetStats() -> const Stats& { return m_stats; }
+
+		/**
+		 * @brief Get the file name of a cell
+		 * @param directory Directory containing the cell files
+		 * @param x Cell x coordinate
+		 * @param y Cell y coordinate
+		 * @return Path of the cell file
+		 */
+		static auto CellFile(const std::filesystem::path& directory, int x, int y) -> std::filesystem::path;
+
+    private:
+		enum class CellState : int {
+			CELL_LOADING,
+			CELL_INSTANTIATING,
+			CELL_RESIDENT,
+		};
+
+		struct Cell {
+			CellState m_state{CellState::CELL_LOADING};
+			std::future<std::vector<Engine::ObjectInfo>> m_future;
+			std::vector<Engine::ObjectInfo> m_content;
+			size_t m_next{0};				//next object of the content to instantiate
+			ObjectHandle m_node{};			//parent node of all cell objects
+		};
+
+		/**
+		 * @brief Load and evict cells around the camera, instantiate pending cells within the budget
+		 * @param message Update message
+		 * @return false to continue message propagation
+		 */
+		bool OnUpdate(Message message);
+
+		/**
+		 * @brief Add the loaded cell content to a memory report
+		 * @param message Memory report message
+		 * @return false to continue message propagation
+		 */
+		bool OnMemoryReport(Message message);
+
+		/**
+		 * @brief Read a cell file, runs on a worker thread
+		 * @param file Path of the cell file
+		 * @return Objects of the cell, empty if the file does not exist
+		 */
+		static auto LoadCell(std::filesystem::path file) -> std::vector<Engine::ObjectInfo>;
+
+		/**
+		 * @brief Remove a cell and its objects from the scene
+		 * @param cell The cell to evict
+		 */
+		void EvictCell(Cell& cell);
+
+		std::filesystem::path m_directory;
+		real_t m_cellSize;
+		int m_radius;
+		double m_budgetMs;
+		std::map<std::pair<int, int>, Cell> m_cells;
+		std::vector<std::future<std::vector<Engine::ObjectInfo>>> m_discarded; //loads of cells evicted before they finished
+		Stats m_stats{};
+    };
+
+};  // namespace vve
+
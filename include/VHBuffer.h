@@ -74,6 +74,55 @@ namespace vvh {
 		}
 	}
 
+	//---------------------------------------------------------------------------------------------
+
+	struct BufCreateBufferRangesInfo {
+		const VkDevice& m_device;
+		const VmaAllocator& m_vmaAllocator;
+		const VkBufferUsageFlags& m_usageFlags;
+		const VkDeviceSize& m_alignment;
+		const std::vector<VkDeviceSize>& m_sizes;
+		Buffer& m_buffer;
+		std::vector<Buffer>& m_ranges;
+	};
+
+	/**
+	 * @brief Create one mapped buffer per frame in flight that holds many ranges, e.g. the uniform buffers of a batch
+	 * of objects. The ranges start at multiples of the alignment and do not own memory, only m_buffer must be destroyed.
+	 */
+	template<typename T = BufCreateBufferRangesInfo>
+	inline void BufCreateBufferRanges(T&& info) {
+		VkDeviceSize alignment = std::max(info.m_alignment, (VkDeviceSize)1);
+		std::vector<VkDeviceSize> offsets;
+		offsets.reserve(info.m_sizes.size());
+		VkDeviceSize size = 0;
+		for( auto rangeSize : info.m_sizes ) {
+			offsets.push_back(size);
+			size += (rangeSize + alignment - 1) / alignment * alignment;
+		}
+
+		BufCreateBuffers({
+			.m_device = info.m_device,
+			.m_vmaAllocator = info.m_vmaAllocator,
+			.m_usageFlags = info.m_usageFlags,
+			.m_size = std::max(size, alignment),
+			.m_buffer = info.m_buffer
+			});
+
+		info.m_ranges.resize(info.m_sizes.size());
+		for (size_t r = 0; r < info.m_sizes.size(); r++) {
+			auto& range = info.m_ranges[r];
+			range.m_bufferSize = info.m_sizes[r];
+			range.m_offset = offsets[r];
+			range.m_uniformBuffers = info.m_buffer.m_uniformBuffers;
+			range.m_uniformBuffersAllocation.clear();
+			range.m_uniformBuffersMapped.resize(MAX_FRAMES_IN_FLIGHT);
+			for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+				range.m_uniformBuffersMapped[i] = (char*)info.m_buffer.m_uniformBuffersMapped[i] + offsets[r];
+			}
+		}
+	}
+
 	//---------------------------------------------------------------------------------------------
 	struct BufDestroyBufferinfo {
 		const VkDevice& m_device;
@@ -97,7 +146,7 @@ namespace vvh {
 
 	template<typename T = BufDestroyBuffer2Info>
 	inline void BufDestroyBuffer2(T&& info) {
-		for (size_t i = 0; i < info.m_buffers.m_uniformBuffers.size(); i++) {
+		for (size_t i = 0; i < info.m_buffers.m_uniformBuffersAllocation.size(); i++) {	//ranges of shared buffers own nothing
 			vmaDestroyBuffer(info.m_vmaAllocator, info.m_buffers.m_uniformBuffers[i], info.m_buffers.m_uniformBuffersAllocation[i]);
 		}
 	}
@@ -282,7 +331,7 @@ namespace vvh {
 	template<typename T = BufCreateIndexBufferinfo>
 	void BufCreateIndexBuffer(T&& info) {
 
-		VkDeviceSize bufferSize = sizeof(info.m_mesh.m_indices[0]) * info.m_mesh.m_indices.size();
+		VkDeviceSize bufferSize = info.m_mesh.getIndexSize();
 
 		VkBuffer stagingBuffer;
 		VmaAllocation stagingBufferAllocation;
@@ -298,7 +347,7 @@ namespace vvh {
 			.m_allocationInfo = &allocInfo
 			});
 
-		memcpy(allocInfo.pMappedData, info.m_mesh.m_indices.data(), bufferSize);
+		info.m_mesh.copyIndices(allocInfo.pMappedData);
 
 		BufCreateBuffer({
 			.m_vmaAllocator = info.m_vmaAllocator,
@@ -315,5 +364,73 @@ namespace vvh {
 		BufDestroyBuffer({ info.m_device, info.m_vmaAllocator, stagingBuffer, stagingBufferAllocation });
 	}
 
+	//---------------------------------------------------------------------------------------------
+
+	struct BufCreateDynamicMeshBuffersInfo {
+		const VmaAllocator& m_vmaAllocator;
+		Mesh& m_mesh;
+	};
+
+	/**
+	 * @brief Create host visible vertex and index buffers for a mesh whose data changes every frame. Each buffer has one
+	 * region per frame in flight, the region is at least twice as large as before so that growing meshes are rarely recreated.
+	 * The buffers stay mapped, write them with BufWriteDynamicMesh().
+	 */
+	template<typename T = BufCreateDynamicMeshBuffersInfo>
+	void BufCreateDynamicMeshBuffers(T&& info) {
+		auto regionSize = [](VkDeviceSize old, VkDeviceSize needed) {
+			VkDeviceSize size = std::max({ 2 * old, needed, (VkDeviceSize)1024 });
+			return (size + 255) & ~(VkDeviceSize)255;	//keeps the offsets of the regions aligned
+		};
+		auto& mesh = info.m_mesh;
+		mesh.m_vertexRegion = regionSize(mesh.m_vertexRegion, mesh.m_verticesData.getSize());
+		mesh.m_indexRegion = regionSize(mesh.m_indexRegion, mesh.getIndexSize());
+
+		VmaAllocationInfo allocInfo;
+		BufCreateBuffer({
+			.m_vmaAllocator = info.m_vmaAllocator,
+			.m_size = mesh.m_vertexRegion * MAX_FRAMES_IN_FLIGHT,
+			.m_usageFlags = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			.m_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			.m_vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+			.m_buffer = mesh.m_vertexBuffer,
+			.m_allocation = mesh.m_vertexBufferAllocation,
+			.m_allocationInfo = &allocInfo
+			});
+		mesh.m_vertexBufferMapped = allocInfo.pMappedData;
+
+		BufCreateBuffer({
+			.m_vmaAllocator = info.m_vmaAllocator,
+			.m_size = mesh.m_indexRegion * MAX_FRAMES_IN_FLIGHT,
+			.m_usageFlags = VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+			.m_properties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			.m_vmaFlags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+			.m_buffer = mesh.m_indexBuffer,
+			.m_allocation = mesh.m_indexBufferAllocation,
+			.m_allocationInfo = &allocInfo
+			});
+		mesh.m_indexBufferMapped = allocInfo.pMappedData;
+	}
+
+	//---------------------------------------------------------------------------------------------
+
+	struct BufWriteDynamicMeshInfo {
+		Mesh& m_mesh;
+		const uint32_t& m_currentFrame;
+	};
+
+	/**
+	 * @brief Copy the vertices and indices of a dynamic mesh to the region of a frame in flight
+	 * @return False if the data does not fit into the region, the buffers must be created again
+	 */
+	template<typename T = BufWriteDynamicMeshInfo>
+	bool BufWriteDynamicMesh(T&& info) {
+		auto& mesh = info.m_mesh;
+		if (mesh.m_verticesData.getSize() > mesh.m_vertexRegion || mesh.getIndexSize() > mesh.m_indexRegion) return false;
+		mesh.m_verticesData.copyData((char*)mesh.m_vertexBufferMapped + info.m_currentFrame * mesh.m_vertexRegion);
+		mesh.copyIndices((char*)mesh.m_indexBufferMapped + info.m_currentFrame * mesh.m_indexRegion);
+		return true;
+	}
+
 
 }; // namespace vh
\ No newline at end of file
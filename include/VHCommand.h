@@ -247,11 +247,21 @@ namespace vvh {
 	template<typename T = ComRecordObjectInfo>
 	inline void ComRecordObject(T&& info) {
 
-		auto offsets = info.m_mesh.m_verticesData.getOffsets(info.m_type);
-		std::vector<VkBuffer> vertexBuffers(offsets.size(), info.m_mesh.m_vertexBuffer);
-		vkCmdBindVertexBuffers(info.m_commandBuffer, 0, (uint32_t)offsets.size(), vertexBuffers.data(), offsets.data());
+		// dynamic meshes are written to a region of the buffers per frame in flight
+		VkDeviceSize vertexRegion = info.m_mesh.m_dynamic ? info.m_currentFrame * info.m_mesh.m_vertexRegion : 0;
+		VkDeviceSize indexRegion = info.m_mesh.m_dynamic ? info.m_currentFrame * info.m_mesh.m_indexRegion : 0;
+
+		if (info.m_mesh.m_verticesData.m_interleaved) {
+			VkDeviceSize offset = vertexRegion;	// one stream of whole vertices
+			vkCmdBindVertexBuffers(info.m_commandBuffer, 0, 1, &info.m_mesh.m_vertexBuffer, &offset);
+		} else {
+			auto offsets = info.m_mesh.m_verticesData.getOffsets(info.m_type);
+			for (auto& offset : offsets) offset += vertexRegion;
+			std::vector<VkBuffer> vertexBuffers(offsets.size(), info.m_mesh.m_vertexBuffer);
+			vkCmdBindVertexBuffers(info.m_commandBuffer, 0, (uint32_t)offsets.size(), vertexBuffers.data(), offsets.data());
+		}
 
-		vkCmdBindIndexBuffer(info.m_commandBuffer, info.m_mesh.m_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+		vkCmdBindIndexBuffer(info.m_commandBuffer, info.m_mesh.m_indexBuffer, indexRegion, info.m_mesh.m_indexType);
 
 		for (auto& descriptorSet : info.m_descriptorSets) {
 			vkCmdBindDescriptorSets(info.m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, info.m_graphicsPipeline.m_pipelineLayout,
@@ -510,6 +510,9 @@ namespace vvh {
 		if (supportedFeatures2.features.imageCubeArray) {
 			deviceFeatures.imageCubeArray = VK_TRUE;	// TODO: check if needed later
 		}
+		if (supportedFeatures2.features.textureCompressionBC) {
+			deviceFeatures.textureCompressionBC = VK_TRUE;	// cooked textures
+		}
 
 		// Combines all enabled features with pNext
 		VkPhysicalDeviceFeatures2  deviceFeatures2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
@@ -609,6 +612,9 @@ namespace vvh {
 		if (supportedFeatures2.features.imageCubeArray) {
 			deviceFeatures.imageCubeArray = VK_TRUE;	// TODO: Put into 1.1
 		}
+		if (supportedFeatures2.features.textureCompressionBC) {
+			deviceFeatures.textureCompressionBC = VK_TRUE;	// cooked textures
+		}
 
 		// Combines all enabled features with pNext
 		VkPhysicalDeviceFeatures2  deviceFeatures2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
@@ -296,6 +296,7 @@ namespace vvh {
 		samplerInfo.compareEnable = VK_FALSE;
 		samplerInfo.compareOp = VK_COMPARE_OP_ALWAYS;
 		samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+		samplerInfo.maxLod = (float)info.m_texture.m_mipLevels;
 
 		if (vkCreateSampler(info.m_device, &samplerInfo, nullptr, &info.m_texture.m_mapSampler) != VK_SUCCESS) {
 			throw std::runtime_error("failed to create texture sampler!");
@@ -413,11 +414,13 @@ namespace vvh {
 
 	template<typename T = ImgCreateTextureImageViewinfo>
 	inline void ImgCreateTextureImageView(T&& info) {
-		info.m_texture.m_mapImageView = ImgCreateImageView2({
+		info.m_texture.m_mapImageView = ImgCreateImageView({
 			.m_device = info.m_device,
 			.m_image = info.m_texture.m_mapImage,
-			.m_format = VK_FORMAT_R8G8B8A8_SRGB,
-			.m_aspects = VK_IMAGE_ASPECT_COLOR_BIT
+			.m_format = info.m_texture.m_format,
+			.m_aspects = VK_IMAGE_ASPECT_COLOR_BIT,
+			.m_layers = 1,
+			.m_mipLevels = info.m_texture.m_mipLevels
 			});
 	}
 
@@ -522,6 +525,8 @@ namespace vvh {
 
 	template<typename T = ImgCreateTextureImageInfo>
 	inline void ImgCreateTextureImage(T&& info) {
+		auto& texture = info.m_texture;
+		int mipLevels = (int)texture.m_mipLevels;
 
 		VkBuffer stagingBuffer;
 		VmaAllocation stagingBufferAllocation;
@@ -539,47 +544,63 @@ namespace vvh {
 
 		memcpy(allocInfo.pMappedData, info.m_pixels, info.m_size);
 
-		ImgCreateImage2({
-			info.m_physicalDevice,
-			info.m_device,
-			info.m_vmaAllocator,
-			(uint32_t)info.m_width,
-			(uint32_t)info.m_height,
-			VK_FORMAT_R8G8B8A8_SRGB,
-			VK_IMAGE_TILING_OPTIMAL,
-			VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-			VK_IMAGE_LAYOUT_UNDEFINED,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			info.m_texture.m_mapImage,
-			info.m_texture.m_mapImageAllocation
+		ImgCreateImage({
+			.m_physicalDevice = info.m_physicalDevice,
+			.m_device = info.m_device,
+			.m_vmaAllocator = info.m_vmaAllocator,
+			.m_width = (uint32_t)info.m_width,
+			.m_height = (uint32_t)info.m_height,
+			.m_depth = 1,
+			.m_layers = 1,
+			.m_mipLevels = texture.m_mipLevels,
+			.m_format = texture.m_format,
+			.m_tiling = VK_IMAGE_TILING_OPTIMAL,
+			.m_usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			.m_imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			.m_properties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			.m_image = texture.m_mapImage,
+			.m_imageAllocation = texture.m_mapImageAllocation
 			});
 
-		ImgTransitionImageLayout2({
+		ImgTransitionImageLayout({
 			info.m_device,
 			info.m_graphicsQueue,
 			info.m_commandPool,
-			info.m_texture.m_mapImage,
-			VK_FORMAT_R8G8B8A8_SRGB,
+			texture.m_mapImage,
+			texture.m_format,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			mipLevels,
+			1,
 			VK_IMAGE_LAYOUT_UNDEFINED,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL
 			});
 
-		BufCopyBufferToImage({
-			.m_device = info.m_device,
-			.m_graphicsQueue = info.m_graphicsQueue,
-			.m_commandPool = info.m_commandPool,
-			.m_buffer = stagingBuffer,
-			.m_image = info.m_texture.m_mapImage,
-			.m_width = static_cast<uint32_t>(info.m_width),
-			.m_height = static_cast<uint32_t>(info.m_height)
-			});
+		// one region per mip level, block compressed levels are tightly packed blocks
+		std::vector<VkBufferImageCopy> regions;
+		for (uint32_t level = 0; level < texture.m_mipLevels; ++level) {
+			VkBufferImageCopy region{};
+			region.bufferOffset = level < texture.m_mipOffsets.size() ? texture.m_mipOffsets[level] : 0;
+			region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			region.imageSubresource.mipLevel = level;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount = 1;
+			region.imageOffset = { 0, 0, 0 };
+			region.imageExtent = { std::max(1u, (uint32_t)info.m_width >> level), std::max(1u, (uint32_t)info.m_height >> level), 1 };
+			regions.push_back(region);
+		}
+		VkCommandBuffer commandBuffer = ComBeginSingleTimeCommands(info);
+		vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, texture.m_mapImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.size(), regions.data());
+		ComEndSingleTimeCommands({ info.m_device, info.m_graphicsQueue, info.m_commandPool, commandBuffer });
 
-		ImgTransitionImageLayout2({
+		ImgTransitionImageLayout({
 			info.m_device,
 			info.m_graphicsQueue,
 			info.m_commandPool,
-			info.m_texture.m_mapImage,
-			VK_FORMAT_R8G8B8A8_SRGB,
+			texture.m_mapImage,
+			texture.m_format,
+			VK_IMAGE_ASPECT_COLOR_BIT,
+			mipLevels,
+			1,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
 			});
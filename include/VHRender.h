@@ -328,6 +328,48 @@ namespace vvh {
         if (vkAllocateDescriptorSets(info.m_device, &allocInfo, info.m_descriptorSet.m_descriptorSetPerFrameInFlight.data()) != VK_SUCCESS) {
             throw std::runtime_error("failed to allocate descriptor sets!");
         }
+        info.m_descriptorSet.m_descriptorPool = info.m_descriptorPool;
+    }
+
+    //---------------------------------------------------------------------------------------------
+
+    struct RenCreateDescriptorSetsInfo {
+        const VkDevice& m_device;
+        const std::vector<VkDescriptorSetLayout>& m_descriptorSetLayouts;
+        const VkDescriptorPool& m_descriptorPool;
+        std::vector<DescriptorSet>& m_descriptorSets;
+    };
+
+    /**
+     * @brief Allocate the sets of many descriptor sets, one per layout and frame in flight, with a single call.
+     * @return VK_ERROR_OUT_OF_POOL_MEMORY or VK_ERROR_FRAGMENTED_POOL if the pool is full, then nothing is allocated
+     */
+    template<typename T = RenCreateDescriptorSetsInfo>
+    inline auto RenCreateDescriptorSets(T&& info) -> VkResult {
+        std::vector<VkDescriptorSetLayout> layouts;
+        layouts.reserve(info.m_descriptorSetLayouts.size() * MAX_FRAMES_IN_FLIGHT);
+        for (auto layout : info.m_descriptorSetLayouts) { layouts.insert(layouts.end(), MAX_FRAMES_IN_FLIGHT, layout); }
+        std::vector<VkDescriptorSet> sets(layouts.size());
+        if (layouts.empty()) return VK_SUCCESS;
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = info.m_descriptorPool;
+        allocInfo.descriptorSetCount = (uint32_t)layouts.size();
+        allocInfo.pSetLayouts = layouts.data();
+        VkResult result = vkAllocateDescriptorSets(info.m_device, &allocInfo, sets.data());
+        if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) return result;
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate descriptor sets!");
+        }
+
+        info.m_descriptorSets.resize(info.m_descriptorSetLayouts.size());
+        for (size_t i = 0; i < info.m_descriptorSets.size(); ++i) {
+            auto& descriptorSet = info.m_descriptorSets[i];
+            descriptorSet.m_descriptorSetPerFrameInFlight.assign(sets.begin() + i * MAX_FRAMES_IN_FLIGHT, sets.begin() + (i + 1) * MAX_FRAMES_IN_FLIGHT);
+            descriptorSet.m_descriptorPool = info.m_descriptorPool;
+        }
+        return VK_SUCCESS;
     }
 
     //---------------------------------------------------------------------------------------------
@@ -347,7 +389,7 @@ namespace vvh {
         for (auto& ds : info.m_descriptorSet.m_descriptorSetPerFrameInFlight) {
             VkDescriptorBufferInfo bufferInfo{};
             bufferInfo.buffer = info.m_uniformBuffers.m_uniformBuffers[i++];
-            bufferInfo.offset = 0;
+            bufferInfo.offset = info.m_uniformBuffers.m_offset;
             bufferInfo.range = info.m_size;
 
             VkWriteDescriptorSet descriptorWrites{};
@@ -213,6 +213,9 @@ namespace vvh {
 		VmaAllocation   m_mapImageAllocation;
 		VkImageView     m_mapImageView;
 		VkSampler       m_mapSampler;
+		VkFormat		m_format{ VK_FORMAT_R8G8B8A8_SRGB };
+		uint32_t		m_mipLevels{ 1 };
+		std::vector<VkDeviceSize> m_mipOffsets{};	//offset of each mip level in m_pixels, empty if there is only level 0
 	};
 
 	struct Buffer {
@@ -220,11 +223,13 @@ namespace vvh {
 		std::vector<VkBuffer>       m_uniformBuffers;
 		std::vector<VmaAllocation>  m_uniformBuffersAllocation;
 		std::vector<void*>          m_uniformBuffersMapped;
+		VkDeviceSize 				m_offset{ 0 };		//start of the range in shared buffers, these have no allocations
 	};
 
 	struct DescriptorSet {
 		int m_set{ 0 };
 		std::vector<VkDescriptorSet> m_descriptorSetPerFrameInFlight;
+		VkDescriptorPool m_descriptorPool{ VK_NULL_HANDLE };	//pool the sets were allocated from
 	};
 
 	struct SwapChain {
@@ -263,6 +268,16 @@ namespace vvh {
 	 * T...Vertex data contains tangents
 	 * C...Vertex data contains colors
 	 * U...Vertex data contains texture UV coordinates
+	 * Q...Vertex data is quantized on the GPU
+	 * I...Vertex data is interleaved in one stream on the GPU
+	 *
+	 * The streams are always kept as floats on the CPU. If the data is quantized, the vertex buffer gets packed
+	 * attributes instead, which the input assembler converts back to floats:
+	 * positions as 16 bit snorm relative to the bounds of the mesh, normals, tangents and colors as 8 bit snorm/unorm,
+	 * and texture coordinates as half floats. The shaders see the positions in [-1,1], so the model matrix must be
+	 * multiplied with getDequantization().
+	 * If the data is interleaved, the vertex buffer holds one stream of whole vertices with the attributes in PNUCT
+	 * order, so a draw binds a single vertex buffer.
 	 */
 	struct VertexData {
 
@@ -272,12 +287,23 @@ namespace vvh {
 		static const int size_col = sizeof(glm::vec4);
 		static const int size_tan = sizeof(glm::vec3);
 
+		static const int size_pos_q = 4 * sizeof(int16_t);	//R16G16B16A16_SNORM
+		static const int size_nor_q = 4 * sizeof(int8_t);	//R8G8B8A8_SNORM
+		static const int size_tex_q = 2 * sizeof(uint16_t);	//R16G16_SFLOAT
+		static const int size_col_q = 4 * sizeof(uint8_t);	//R8G8B8A8_UNORM
+		static const int size_tan_q = 4 * sizeof(int8_t);	//R8G8B8A8_SNORM
+
 		std::vector<glm::vec3> m_positions;
 		std::vector<glm::vec3> m_normals;
 		std::vector<glm::vec2> m_texCoords;
 		std::vector<glm::vec4> m_colors;
 		std::vector<glm::vec3> m_tangents;
 
+		bool m_quantized{false};
+		bool m_interleaved{false};
+		glm::vec3 m_boundsMin{0.0f};
+		glm::vec3 m_boundsMax{0.0f};
+
 		/**
 		 * @brief Get vertex data type string (e.g., "PNUC")
 		 * @return String describing which attributes are present
@@ -289,76 +315,238 @@ namespace vvh {
 			if (m_texCoords.size() > 0) name = name + "U";
 			if (m_colors.size() > 0)    name = name + "C";
 			if (m_tangents.size() > 0)  name = name + "T";
+			if (m_quantized)            name = name + "Q";
+			if (m_interleaved)          name = name + "I";
 			return name;
 		}
 
+		/**
+		 * @brief Get the attribute streams of a type string, without the flags
+		 * @param type Type string, e.g. "PNUTQI"
+		 * @return The letters of PNUCT in the type, e.g. "PNUT"
+		 */
+		static std::string getStreams(const std::string& type) {
+			std::string streams;
+			for (char c : std::string{ "PNUCT" }) if (type.find(c) != std::string::npos) streams += c;
+			return streams;
+		}
+
+		/**
+		 * @brief Use quantized attributes in the vertex buffer, the position bounds are computed from the positions
+		 */
+		void quantize() {
+			if (m_positions.empty()) return;
+			m_boundsMin = m_boundsMax = m_positions[0];
+			for (auto& p : m_positions) { m_boundsMin = glm::min(m_boundsMin, p); m_boundsMax = glm::max(m_boundsMax, p); }
+			m_quantized = true;
+		}
+
+		/**
+		 * @brief Matrix that maps quantized positions in [-1,1] back to the bounds of the mesh
+		 * @return The dequantization matrix, identity if the data is not quantized
+		 */
+		glm::mat4 getDequantization() const {
+			if (!m_quantized) return glm::mat4{ 1.0f };
+			glm::vec3 extent = glm::max((m_boundsMax - m_boundsMin) * 0.5f, glm::vec3{ 1.0e-6f });
+			return glm::scale(glm::translate(glm::mat4{ 1.0f }, (m_boundsMin + m_boundsMax) * 0.5f), extent);
+		}
+
+		/**
+		 * @brief Use one interleaved stream in the vertex buffer. Only possible if all streams have the same length.
+		 * @return true if the data is interleaved now
+		 */
+		bool interleave() {
+			for (char c : std::string{ "NUCT" }) {
+				if (getCount(c) > 0 && getCount(c) != m_positions.size()) return false;
+			}
+			m_interleaved = !m_positions.empty();
+			return m_interleaved;
+		}
+
+		/**
+		 * @brief Size of one attribute in the vertex buffer
+		 * @param c Stream letter, one of PNUCT
+		 * @param quantized Size of the quantized attribute
+		 * @return Size in bytes
+		 */
+		static size_t getAttributeSize(char c, bool quantized) {
+			switch (c) {
+				case 'P': return quantized ? size_pos_q : size_pos;
+				case 'N': return quantized ? size_nor_q : size_nor;
+				case 'U': return quantized ? size_tex_q : size_tex;
+				case 'C': return quantized ? size_col_q : size_col;
+				case 'T': return quantized ? size_tan_q : size_tan;
+			}
+			return 0;
+		}
+
+		/**
+		 * @brief Size of one vertex of a stream in the vertex buffer
+		 * @param c Stream letter, one of PNUCT
+		 * @return Size in bytes
+		 */
+		size_t getStride(char c) const { return getAttributeSize(c, m_quantized); }
+
+		/**
+		 * @brief Size of a whole vertex in the interleaved stream
+		 * @return Size in bytes
+		 */
+		size_t getVertexStride() const {
+			size_t stride = 0;
+			for (char c : std::string{ "PNUCT" }) if (getCount(c) > 0) stride += getStride(c);
+			return stride;
+		}
+
+		/**
+		 * @brief Number of vertices of a stream
+		 * @param c Stream letter, one of PNUCT
+		 * @return Number of vertices, 0 if the stream is empty
+		 */
+		size_t getCount(char c) const {
+			switch (c) {
+				case 'P': return m_positions.size();
+				case 'N': return m_normals.size();
+				case 'U': return m_texCoords.size();
+				case 'C': return m_colors.size();
+				case 'T': return m_tangents.size();
+			}
+			return 0;
+		}
+
 		VkDeviceSize getSize() const {
-			return 	m_positions.size() * sizeof(glm::vec3) +
-				m_normals.size() * sizeof(glm::vec3) +
-				m_texCoords.size() * sizeof(glm::vec2) +
-				m_colors.size() * sizeof(glm::vec4) +
-				m_tangents.size() * sizeof(glm::vec3);
+			VkDeviceSize size = 0;
+			for (char c : std::string{ "PNUCT" }) size += getCount(c) * getStride(c);
+			return size;
 		}
 
 		VkDeviceSize getSize(std::string type) const {
-			return 	type.find("P") != std::string::npos ? m_positions.size() * sizeof(glm::vec3) : 0 +
-				type.find("N") != std::string::npos ? m_normals.size() * sizeof(glm::vec3) : 0 +
-				type.find("U") != std::string::npos ? m_texCoords.size() * sizeof(glm::vec2) : 0 +
-				type.find("C") != std::string::npos ? m_colors.size() * sizeof(glm::vec4) : 0 +
-				type.find("T") != std::string::npos ? m_tangents.size() * sizeof(glm::vec3) : 0;
+			if (m_interleaved) return getSize();
+			VkDeviceSize size = 0;
+			for (char c : std::string{ "PNUCT" }) if (type.find(c) != std::string::npos) size += getCount(c) * getStride(c);
+			return size;
 		}
 
 		std::vector<VkDeviceSize> getOffsets() const {
+			if (m_interleaved) return { 0 };
 			size_t offset = 0;
 			std::vector<VkDeviceSize> offsets{};
-			if (size_t size = m_positions.size() * size_pos; size > 0) { offsets.push_back(offset); offset += size; }
-			if (size_t size = m_normals.size() * size_nor; size > 0) { offsets.push_back(offset); offset += size; }
-			if (size_t size = m_texCoords.size() * size_tex; size > 0) { offsets.push_back(offset); offset += size; }
-			if (size_t size = m_colors.size() * size_col; size > 0) { offsets.push_back(offset); offset += size; }
-			if (size_t size = m_tangents.size() * size_tan; size > 0) { offsets.push_back(offset); offset += size; }
+			for (char c : std::string{ "PNUCT" }) {
+				if (size_t size = getCount(c) * getStride(c); size > 0) { offsets.push_back(offset); offset += size; }
+			}
 			return offsets;
 		}
 
 		std::vector<VkDeviceSize> getOffsets(std::string type) const {
+			if (m_interleaved) return { 0 };
 			size_t offset = 0;
 			std::vector<VkDeviceSize> offsets{};
-			if (type.find("P") != std::string::npos) { offsets.push_back(offset); offset += m_positions.size() * size_pos; }
-			if (type.find("N") != std::string::npos) { offsets.push_back(offset); offset += m_normals.size() * size_nor; }
-			if (type.find("U") != std::string::npos) { offsets.push_back(offset); offset += m_texCoords.size() * size_tex; }
-			if (type.find("C") != std::string::npos) { offsets.push_back(offset); offset += m_colors.size() * size_col; }
-			if (type.find("T") != std::string::npos) { offsets.push_back(offset); offset += m_tangents.size() * size_tan; }
+			for (char c : std::string{ "PNUCT" }) {
+				if (type.find(c) != std::string::npos) { offsets.push_back(offset); offset += getCount(c) * getStride(c); }
+			}
 			return offsets;
 		}
 
+		/**
+		 * @brief Write one stream to the vertex buffer, packed if the data is quantized
+		 * @param c Stream letter, one of PNUCT
+		 * @param data Destination
+		 * @return Number of bytes written
+		 */
+		size_t copyStream(char c, void* data) const {
+			size_t size = getCount(c) * getStride(c);
+			if (!m_quantized) {
+				switch (c) {
+					case 'P': memcpy(data, m_positions.data(), size); break;
+					case 'N': memcpy(data, m_normals.data(), size); break;
+					case 'U': memcpy(data, m_texCoords.data(), size); break;
+					case 'C': memcpy(data, m_colors.data(), size); break;
+					case 'T': memcpy(data, m_tangents.data(), size); break;
+				}
+				return size;
+			}
+			auto packed64 = (uint64_t*)data;
+			auto packed32 = (uint32_t*)data;
+			auto direction = [](glm::vec3 v) { float l = glm::length(v); return glm::vec4{ l > 0.0f ? v / l : v, 0.0f }; };
+			switch (c) {
+				case 'P': {
+					glm::mat4 toUnit = glm::inverse(getDequantization());
+					for (size_t i = 0; i < m_positions.size(); ++i)
+						packed64[i] = glm::packSnorm4x16(glm::vec4{ glm::vec3{ toUnit * glm::vec4{ m_positions[i], 1.0f } }, 1.0f });
+					break;
+				}
+				case 'N': for (size_t i = 0; i < m_normals.size(); ++i) packed32[i] = glm::packSnorm4x8(direction(m_normals[i])); break;
+				case 'U': for (size_t i = 0; i < m_texCoords.size(); ++i) packed32[i] = glm::packHalf2x16(m_texCoords[i]); break;
+				case 'C': for (size_t i = 0; i < m_colors.size(); ++i) packed32[i] = glm::packUnorm4x8(m_colors[i]); break;
+				case 'T': for (size_t i = 0; i < m_tangents.size(); ++i) packed32[i] = glm::packSnorm4x8(direction(m_tangents[i])); break;
+			}
+			return size;
+		}
+
 		void copyData(void* data) {
-			size_t offset = 0, size = 0;
-			size = m_positions.size() * size_pos; memcpy(data, m_positions.data(), size);                 offset += size;
-			size = m_normals.size() * size_nor; memcpy((char*)data + offset, m_normals.data(), size);   offset += size;
-			size = m_texCoords.size() * size_tex; memcpy((char*)data + offset, m_texCoords.data(), size); offset += size;
-			size = m_colors.size() * size_col; memcpy((char*)data + offset, m_colors.data(), size);    offset += size;
-			size = m_tangents.size() * size_tan; memcpy((char*)data + offset, m_tangents.data(), size);  offset += size;
+			size_t offset = 0;
+			if (m_interleaved) {
+				size_t vertexStride = getVertexStride();
+				std::vector<char> stream;
+				for (char c : std::string{ "PNUCT" }) {
+					size_t stride = getStride(c);
+					if (getCount(c) == 0) continue;
+					stream.resize(getCount(c) * stride);
+					copyStream(c, stream.data());
+					for (size_t i = 0; i < getCount(c); ++i) memcpy((char*)data + i * vertexStride + offset, stream.data() + i * stride, stride);
+					offset += stride;
+				}
+				return;
+			}
+			for (char c : std::string{ "PNUCT" }) offset += copyStream(c, (char*)data + offset);
 		}
 
 		void copyData(void* data, std::string type) {
-			size_t offset = 0, size = 0;
-			if (type.find("P") != std::string::npos) { size = m_positions.size() * size_pos; memcpy(data, m_positions.data(), size); offset += size; }
-			if (type.find("N") != std::string::npos) { size = m_normals.size() * size_nor; memcpy((char*)data + offset, m_normals.data(), size); offset += size; }
-			if (type.find("U") != std::string::npos) { size = m_texCoords.size() * size_tex; memcpy((char*)data + offset, m_texCoords.data(), size); offset += size; }
-			if (type.find("C") != std::string::npos) { size = m_colors.size() * size_col; memcpy((char*)data + offset, m_colors.data(), size); offset += size; }
-			if (type.find("T") != std::string::npos) { size = m_tangents.size() * size_tan; memcpy((char*)data + offset, m_tangents.data(), size); offset += size; }
+			if (m_interleaved) { copyData(data); return; }
+			size_t offset = 0;
+			for (char c : std::string{ "PNUCT" }) if (type.find(c) != std::string::npos) offset += copyStream(c, (char*)data + offset);
 		}
 	};
 
+
 	/**
 	 * @brief Mesh data with vertices, indices, and Vulkan buffers
 	 */
 	struct Mesh {
 		VertexData				m_verticesData;
 		std::vector<uint32_t>   m_indices;
+		VkIndexType				m_indexType{ VK_INDEX_TYPE_UINT32 };	//width of the index buffer, the CPU copy is always 32 bit
 		VkBuffer                m_vertexBuffer;
 		VmaAllocation           m_vertexBufferAllocation;
 		VkBuffer                m_indexBuffer;
 		VmaAllocation           m_indexBufferAllocation;
+		bool					m_dynamic{ false };				//host visible buffers with one region per frame in flight, the CPU data is copied every frame
+		VkDeviceSize			m_vertexRegion{ 0 };			//dynamic meshes: size of a region of the vertex and index buffer
+		VkDeviceSize			m_indexRegion{ 0 };
+		void*					m_vertexBufferMapped{ nullptr };
+		void*					m_indexBufferMapped{ nullptr };
+
+		/**
+		 * @brief Use 16 bit indices if every vertex can be addressed with them, otherwise 32 bit indices
+		 * @return The chosen index type
+		 */
+		VkIndexType chooseIndexType() {
+			m_indexType = m_verticesData.m_positions.size() <= 65536 ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+			return m_indexType;
+		}
+
+		size_t getIndexStride() const { return m_indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t); }
+
+		VkDeviceSize getIndexSize() const { return m_indices.size() * getIndexStride(); }
+
+		/**
+		 * @brief Write the indices to the index buffer with the width of the index type
+		 * @param data Destination, getIndexSize() bytes
+		 */
+		void copyIndices(void* data) const {
+			if (m_indexType == VK_INDEX_TYPE_UINT32) { memcpy(data, m_indices.data(), getIndexSize()); return; }
+			auto packed = (uint16_t*)data;
+			for (size_t i = 0; i < m_indices.size(); ++i) packed[i] = (uint16_t)m_indices[i];
+		}
 	};
 
 
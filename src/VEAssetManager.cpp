@@ -1,3 +1,6 @@
+#include <fstream>
+#include <sstream>
+#include <cstring>
 
 #include "VHInclude.h"
 #include "VEInclude.h"
@@ -16,18 +19,29 @@ namespace vve {
 		engine.RegisterCallbacks( { 
 			{this,                               0, "SCENE_LOAD", [this](Message& message){ return OnSceneLoad(message);} },
 			{this,                               0, "SCENE_CREATE", [this](Message& message){ return OnSceneCreate(message);} },
-			{this, std::numeric_limits<int>::max(), "SCENE_CREATE", [this](Message& message){ return OnSceneCreate(message);} },
+			{this,                               0, "LOAD_STEP", [this](Message& message){ return OnLoadStep(message);} },
 			{this,                               0, "OBJECT_CREATE", [this](Message& message){ return OnObjectCreate(message);} },
+			{this,                               0, "OBJECTS_CREATE", [this](Message& message){ return OnObjectsCreate(message);} },
 			{this, 								 0, "TEXTURE_CREATE", [this](Message& message){ return OnTextureCreate(message);} },
 			{this, std::numeric_limits<int>::max(), "TEXTURE_CREATE", [this](Message& message){ return OnTextureRelease(message);} },
+			{this,                               0, "OBJECT_DESTROY", [this](Message& message){ return OnObjectDestroy(message);} },
+			{this,                            -100, "MESH_DESTROY", [this](Message& message){ return OnAssetDestroy(message);} },
+			{this,                            -100, "TEXTURE_DESTROY", [this](Message& message){ return OnAssetDestroy(message);} },
+			{this,                               0, "FRAME_END", [this](Message& message){ return OnFrameEnd(message);} },
+			{this,                               0, "MEMORY_REPORT", [this](Message& message){ return OnMemoryReport(message);} },
 			{this, 								 0, "PLAY_SOUND", [this](Message& message){ return OnPlaySound(message);} },
 		} );
 	}
 
 	/**
-	 * @brief Destructor for the AssetManager class
+	 * @brief Destructor for the AssetManager class. Waits for running imports and decodes and frees decoded pixels
+	 * that were not handed to the renderers.
 	 */
-    AssetManager::~AssetManager() {}
+    AssetManager::~AssetManager() {
+		for( auto& texture : m_asyncTextures ) {
+			if( texture.m_future.valid() ) stbi_image_free(texture.m_future.get().m_pixels);
+		}
+	}
 
 	/**
 	 * @brief Handle scene creation message
@@ -36,17 +50,8 @@ namespace vve {
 	 */
 	bool AssetManager::OnSceneCreate( Message& message ) {
 		auto& msg = message.template GetData<MsgSceneCreate>();
-		auto flags = msg.m_ai_flags;
-		auto phase = message.GetPhase(); //called in 2 phases, 0 and std::numeric_limits<int>::max()
-
-		if( phase < std::numeric_limits<int>::max() ) { //first phase?  
-			msg.m_scene = aiImportFile(msg.m_sceneName().c_str(),  aiProcessPreset_TargetRealtime_Fast | aiProcess_FlipUVs | flags); //need this for scenemanager to create nodes
-			if (!msg.m_scene || msg.m_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !msg.m_scene->mRootNode) {std::cerr << "Assimp Error: " << aiGetErrorString() << std::endl;}
-			else if( !m_fileNameMap.contains(msg.m_sceneName())) { SceneLoad(msg.m_sceneName, msg.m_scene); }
-			return false;
-		}
-		aiReleaseImport(msg.m_scene); //last phase -> release the scene
-		return true;
+		msg.m_prefab = LoadPrefab(msg.m_sceneName, msg.m_ai_flags, msg.m_mode); //need this for scenemanager to create nodes
+		return false;
 	}
 
 	/**
@@ -56,109 +61,832 @@ namespace vve {
 	 */
     bool AssetManager::OnSceneLoad(Message& message) {
 		auto& msg = message.template GetData<MsgSceneLoad>();
-		auto flags = msg.m_ai_flags;
-		const aiScene * scene = aiImportFile(msg.m_sceneName().c_str(),  aiProcessPreset_TargetRealtime_Fast | aiProcess_FlipUVs | flags); //need this for scenemanager to create nodes
-		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {std::cerr << "Assimp Error: " << aiGetErrorString() << std::endl;}
-		else if( !m_fileNameMap.contains(msg.m_sceneName())) { SceneLoad(msg.m_sceneName, scene); }
-		aiReleaseImport(scene);
+		LoadPrefab(msg.m_sceneName, msg.m_ai_flags);
 		return true; //the message is consumed -> no more processing allowed
 	}
 
 	/**
-	 * @brief Load a scene from file
+	 * @brief Get the prefab of a scene file. The file is imported only the first time it is requested 
+	 * with a given set of flags, later requests return the cached template.
 	 * @param sceneName Filename of the scene
-	 * @param scene Pointer to the Assimp scene structure
-	 * @return True if scene was loaded successfully
+	 * @param flags Assimp post processing flags
+	 * @param mode Blocking, or create meshes and textures in later load steps, or import on a worker thread
+	 * @return Pointer to the prefab, or nullptr if the file could not be imported. An async prefab is empty
+	 * and loading until the import is done. If the async import fails, the prefab is marked as failed and 
+	 * removed from the cache, so a later request imports the file again.
 	 */
-	bool AssetManager::SceneLoad(Filename sceneName, const C_STRUCT aiScene* scene) {
+	auto AssetManager::LoadPrefab(Filename sceneName, aiPostProcessSteps flags, LoadMode mode) -> const Prefab* {
+		std::string key = sceneName() + "#" + std::to_string(flags);
+		if( auto it = m_prefabs.find(key); it != m_prefabs.end() ) return &it->second;
+
+		if( mode == LoadMode::LOAD_MODE_ASYNC ) {
+			CreatePlaceholders();
+			auto& prefab = m_prefabs[key];
+			prefab.m_loading = true;
+			m_asyncImports.push_back( { sceneName, key, &prefab, std::async(std::launch::async, &AssetManager::ImportScene, sceneName, flags, m_cacheDirectory, m_optimizeMeshes,
+				m_lodLevels, m_lodMinTriangles, std::ref(m_engine.GetJobPool())) } );
+			++m_loadTotal;
+			return &prefab;
+		}
+
+		auto result = ImportScene(sceneName, flags, m_cacheDirectory, m_optimizeMeshes, m_lodLevels, m_lodMinTriangles, m_engine.GetJobPool());
+		if( !result.m_error.empty() ) {
+			std::cerr << "Assimp Error: " << result.m_error << std::endl;
+			return nullptr;
+		}
+		ReportImport(result.m_time);
+
 		std::filesystem::path filepath = sceneName();
+		bool pending = std::ranges::any_of(m_pendingImports, [&](auto& import) { return import.m_sceneName() == sceneName(); });
+		bool loaded = m_fileNameMap.contains(sceneName()) || pending;
+		if( !loaded && mode == LoadMode::LOAD_MODE_INCREMENTAL && result.m_textures.size() + result.m_meshes.size() > 0 ) {
+			m_loadTotal += result.m_textures.size() + result.m_meshes.size();
+			m_pendingImports.push_back( { sceneName, std::move(result.m_meshes), std::move(result.m_textures) } );
+		} else if( !loaded && mode == LoadMode::LOAD_MODE_BLOCKING ) {
+			for( auto& texture : result.m_textures ) { SceneLoadTexture(filepath, texture); }
+			for( auto& mesh : result.m_meshes ) { SceneLoadMesh(std::move(mesh)); }
+		}
+		return &(m_prefabs[key] = std::move(result.m_prefab));
+	}
+
+	/**
+	 * @brief Recursively adds the nodes of an Assimp scene hierarchy to a prefab
+	 * @param node Current node being processed
+	 * @param parent Index of the parent node in the prefab, -1 for the root
+	 * @param filepath Path to the model file
+	 * @param scene Pointer to the Assimp scene data
+	 * @param id Reference to unique node ID counter
+	 * @param prefab The prefab that receives the nodes
+	 */
+	void AssetManager::PrefabAddNode(aiNode* node, int32_t parent, std::filesystem::path& filepath, const aiScene* scene, uint64_t& id, Prefab& prefab) {
 		auto directory = filepath.parent_path();
 
-		// Process materials
-		for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
-		    aiMaterial* material = scene->mMaterials[i];
+		auto transform = node->mTransformation;
+		aiVector3D scaling, position;
+    	aiQuaternion rotation;
+    	transform.Decompose(scaling, rotation, position);
+		aiMatrix3x3 rotMat = rotation.GetMatrix();
+
+		Prefab::Node pNode{
+			.m_name = node->mName.C_Str()[0] != 0 ? std::string{node->mName.C_Str()} : "Node" + std::to_string(id++),
+			.m_parent = parent,
+			.m_position = vec3_t{ position.x, position.y, position.z },
+			.m_rotation = mat3_t(rotMat.a1, rotMat.a2, rotMat.a3, rotMat.b1, rotMat.b2, rotMat.b3, rotMat.c1, rotMat.c2, rotMat.c3),
+			.m_scale = vec3_t{ scaling.x, scaling.y, scaling.z }
+		};
+
+		if ( node->mNumMeshes > 0) {
+		    auto mesh = scene->mMeshes[node->mMeshes[0]];
+			pNode.m_meshName = filepath.string() + "/" + mesh->mName.C_Str();
+			
+			auto material = scene->mMaterials[mesh->mMaterialIndex];
+		    aiString texturePath;
+		    if (material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS) {
+				pNode.m_textureName = directory.string() + "/" + std::string{texturePath.C_Str()};
+			}
+
+			vvh::Color color;
+			bool hasColor = false;
+			aiColor4D ambientColor;
+			if (AI_SUCCESS == material->Get(AI_MATKEY_COLOR_AMBIENT, ambientColor)) {
+				hasColor = true;
+				color.m_ambientColor = to_vec4(ambientColor);
+			}
+			aiColor4D diffuseColor;
+			if (AI_SUCCESS == material->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColor)) {
+				hasColor = true;
+				color.m_diffuseColor = to_vec4(diffuseColor);
+			}
+			if( hasColor ) { pNode.m_color = color; }
+
+			// Material: Metallic, Rougness
+			vvh::Material mat;
+			bool hasMat = false;
+			aiColor4D metallicFactor;
+			if (AI_SUCCESS == material->Get(AI_MATKEY_METALLIC_FACTOR, metallicFactor)) {
+				hasMat = true;
+				mat.m_material[0] = metallicFactor.r;
+			}
+			aiColor4D rougnessFactor;
+			if (AI_SUCCESS == material->Get(AI_MATKEY_ROUGHNESS_FACTOR, rougnessFactor)) {
+				hasMat = true;
+				mat.m_material[1] = rougnessFactor.r;
+			}
+			if (hasMat) { pNode.m_material = mat; }
+		}
+
+		int32_t index = (int32_t)prefab.m_nodes.size();
+		prefab.m_nodes.push_back(std::move(pNode));
+		for (unsigned int i = 0; i < node->mNumChildren; i++) {
+			PrefabAddNode(node->mChildren[i], index, filepath, scene, id, prefab);
+		}
+	}
+
+	/**
+	 * @brief Load a diffuse texture of a scene and announce it
+	 * @param filepath Path of the scene file
+	 * @param fileName File name of the texture
+	 */
+	void AssetManager::SceneLoadTexture(const std::filesystem::path& filepath, const std::string& fileName) {
+        std::cout << "Diffuse Texture: " << fileName << std::endl;	
+		auto tHandle = TextureHandle{m_registry.Insert(Name{fileName})};
+		auto pixels = LoadTexture(tHandle);
+		if( pixels != nullptr) {
+			MakeResident(fileName, filepath, {}, false, 0, (size_t)m_registry.Get<vvh::Image&>(tHandle)().m_size);
+			m_engine.SendMsg( MsgTextureCreate{tHandle, this } );
+		}
+		m_fileNameMap.insert( std::make_pair(filepath, (Name{fileName})) );
+	}
 
-		    aiString name;
-		    if (material->Get(AI_MATKEY_NAME, name) == AI_SUCCESS) {
-		        std::cout << "Material: " << name.C_Str() << std::endl;
-		    }
+	/**
+	 * @brief Create a converted mesh and announce it, skipped if a mesh with the same name exists. Its levels of
+	 * detail are created as meshes of their own, named <mesh name>/lod<level>, keep the quantization bounds of the
+	 * mesh, and are listed in the MeshLods of the mesh. Their memory is counted with the mesh.
+	 * @param mesh The mesh
+	 * @return Handle of the mesh, invalid if it was skipped
+	 */
+	auto AssetManager::SceneLoadMesh(ImportedMesh&& mesh) -> vecs::Handle {
+		Name name{mesh.m_name};
+	    std::cout << "Mesh " << name() << " has " << mesh.m_mesh.m_verticesData.m_positions.size() << " vertices." << std::endl;
+		if( m_engine.ContainsHandle(name) && m_engine.GetHandle(name).IsValid() ) return {};
 
-		    aiColor3D color;
-		    if (material->Get(AI_MATKEY_COLOR_AMBIENT, color) == AI_SUCCESS) {
-		        std::cout << "Ambient Color: " << color.r << ", " << color.g << ", " << color.b << std::endl;
-		    }
-		    if (material->Get(AI_MATKEY_COLOR_DIFFUSE, color) == AI_SUCCESS) {
-		        std::cout << "Diffuse Color: " << color.r << ", " << color.g << ", " << color.b << std::endl;
-		    }
-			if (material->Get(AI_MATKEY_METALLIC_FACTOR, color) == AI_SUCCESS) {
-				std::cout << "Metallic Factor: " << color.r << ", ";
+		if( m_quantizeVertices ) mesh.m_mesh.m_verticesData.quantize();
+		size_t cpuBytes = 0, gpuBytes = 0;
+		auto prepare = [&](vvh::Mesh& level) {
+			auto& data = level.m_verticesData;
+			if( m_quantizeVertices ) {	//levels keep the bounds of the mesh, so objects keep their dequantization when the level changes
+				data.m_quantized = true;
+				data.m_boundsMin = mesh.m_mesh.m_verticesData.m_boundsMin;
+				data.m_boundsMax = mesh.m_mesh.m_verticesData.m_boundsMax;
 			}
-			if (material->Get(AI_MATKEY_ROUGHNESS_FACTOR, color) == AI_SUCCESS) {
-				std::cout << "Roughness Factor: " << color.r << std::endl;
+			if( m_interleaveVertices ) data.interleave();
+			if( m_smallIndices ) level.chooseIndexType();
+			cpuBytes += MemoryReport::VectorBytes(level.m_indices) + MemoryReport::VectorBytes(data.m_positions) + MemoryReport::VectorBytes(data.m_normals)
+				+ MemoryReport::VectorBytes(data.m_texCoords) + MemoryReport::VectorBytes(data.m_colors) + MemoryReport::VectorBytes(data.m_tangents);
+			gpuBytes += (size_t)data.getSize() + (size_t)level.getIndexSize();
+		};
+		prepare(mesh.m_mesh);
+		for( auto& lod : mesh.m_lods ) { prepare(lod); }
+
+		MeshLods lods{ {}, { mesh.m_mesh.m_indices.size() / 3 } };
+		vec3_t lo{ std::numeric_limits<real_t>::max() }, hi{ std::numeric_limits<real_t>::lowest() };
+		for( auto& p : mesh.m_mesh.m_verticesData.m_positions ) { lo = glm::min(lo, vec3_t{p}); hi = glm::max(hi, vec3_t{p}); }
+		lods.m_center = (lo + hi) * (real_t)0.5;
+		lods.m_radius = glm::length(hi - lods.m_center);
+
+		auto gHandle = m_registry.Insert( name, std::move(mesh.m_mesh) );
+		m_engine.SetHandle(name, gHandle);
+		m_fileNameMap.insert( std::make_pair(mesh.m_scene, name) );
+		MakeResident(name(), mesh.m_scene, mesh.m_flags, true, cpuBytes, gpuBytes);
+		m_engine.SendMsg( MsgMeshCreate{MeshHandle{gHandle}} );
+		if( mesh.m_lods.empty() ) return gHandle;
+
+		lods.m_levels.push_back(MeshHandle{gHandle});
+		for( size_t level = 0; level < mesh.m_lods.size(); ++level ) {
+			Name lodName{ name() + "/lod" + std::to_string(level + 1) };
+			lods.m_triangles.push_back(mesh.m_lods[level].m_indices.size() / 3);
+			auto lHandle = m_registry.Insert(lodName, std::move(mesh.m_lods[level]));
+			m_engine.SetHandle(lodName, lHandle);
+			m_engine.SendMsg( MsgMeshCreate{MeshHandle{lHandle}} );
+			lods.m_levels.push_back(MeshHandle{lHandle});
+		}
+		m_registry.Put(gHandle, lods);
+		return gHandle;
+	}
+
+	/**
+	 * @brief Create a decoded texture of a scene and announce it
+	 * @param scene Path of the scene file
+	 * @param name File name of the texture
+	 * @param image The decoded texture, its pixels are freed when the renderers uploaded them
+	 * @return Handle of the texture
+	 */
+	auto AssetManager::SceneAddTexture(const std::filesystem::path& scene, const std::string& name, vvh::Image&& image) -> TextureHandle {
+		size_t gpuBytes = (size_t)image.m_size;
+		auto tHandle = TextureHandle{m_registry.Insert(Name{name}, std::move(image))};
+		m_engine.SetHandle(name, tHandle);
+		m_fileNameMap.insert( std::make_pair(scene, Name{name}) );
+		MakeResident(name, scene, {}, false, 0, gpuBytes);
+		m_engine.SendMsg( MsgTextureCreate{tHandle, this } );
+		return tHandle;
+	}
+
+	/**
+	 * @brief Convert an Assimp mesh, does not use the registry and can run on a worker thread
+	 * @param mesh The mesh
+	 * @return The converted mesh
+	 */
+	auto AssetManager::ConvertMesh(aiMesh* mesh) -> vvh::Mesh {
+		assert(mesh->HasPositions() && mesh->HasNormals());
+
+		vvh::Mesh VVEMesh{};
+	    for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
+	        aiVector3D vertex = mesh->mVertices[j];
+			VVEMesh.m_verticesData.m_positions.push_back({vertex.x, vertex.y, vertex.z});
+		
+			if (mesh->HasNormals()) {
+	            aiVector3D normal = mesh->mNormals[j];
+				VVEMesh.m_verticesData.m_normals.push_back({normal.x, normal.y, normal.z});
 			}
 
+			if( mesh->HasTangentsAndBitangents() ) {
+				aiVector3D tangent = mesh->mTangents[j];
+				VVEMesh.m_verticesData.m_tangents.push_back({tangent.x, tangent.y, tangent.z});
+			}
+
+			if (mesh->HasTextureCoords(0)) { 
+		        aiVector3D texCoord = mesh->mTextureCoords[0][j];
+				VVEMesh.m_verticesData.m_texCoords.push_back({texCoord.x, texCoord.y});
+			}
+
+			if (mesh->HasVertexColors(0)) { 
+			    aiColor4D color = mesh->mColors[0][j];
+				VVEMesh.m_verticesData.m_colors.push_back({color.r, color.g, color.b, color.a});
+			}
+	    }
+
+		for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+	        aiFace& face = mesh->mFaces[i];
+    		// Ensure it's a triangle
+    		if (face.mNumIndices == 3) {
+        		VVEMesh.m_indices.push_back(face.mIndices[0]);
+        		VVEMesh.m_indices.push_back(face.mIndices[1]);
+        		VVEMesh.m_indices.push_back(face.mIndices[2]);
+    		}
+		}
+		return VVEMesh;
+	}
+
+	/**
+	 * @brief Import a scene, convert its meshes and collect its textures. Meshes and textures used by several
+	 * nodes are returned once. Reads the mesh cache if it has the scene, otherwise imports with Assimp and
+	 * writes the cache. Does not use the registry and can run on a worker thread. Meshes are converted, optimized
+	 * and simplified to their levels of detail in parallel on the job pool, the cache stores the optimized meshes
+	 * with their levels.
+	 * @param sceneName Filename of the scene
+	 * @param flags Assimp post processing flags
+	 * @param cacheDirectory Directory of the mesh cache, empty to disable the cache
+	 * @param optimize Optimize the meshes with the MeshOptimizer
+	 * @param lodLevels Maximum number of levels of detail per mesh, 0 for none
+	 * @param lodMinTriangles Meshes with fewer triangles get no levels of detail
+	 * @param jobPool Threads for converting the meshes
+	 * @return Prefab, meshes and texture names of the scene
+	 */
+	auto AssetManager::ImportScene(Filename sceneName, aiPostProcessSteps flags, std::filesystem::path cacheDirectory, bool optimize,
+		uint32_t lodLevels, size_t lodMinTriangles, JobPool& jobPool) -> ImportResult {
+		auto start = std::chrono::high_resolution_clock::now();
+		auto elapsedMs = [&]() { return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count(); };
+
+		uint64_t hash = cacheDirectory.empty() ? 0 : SceneHash(sceneName, flags, optimize, lodLevels, lodMinTriangles);
+		std::filesystem::path cacheFile{};
+		if( hash != 0 ) {
+			std::ostringstream name;
+			name << std::hex << std::setw(16) << std::setfill('0') << hash << ".vvemesh";
+			cacheFile = cacheDirectory / name.str();
+			if( auto cached = ReadCache(cacheFile, sceneName, hash); cached.has_value() ) {
+				cached->m_time = { sceneName(), true, elapsedMs() };
+				for( auto& mesh : cached->m_meshes ) { mesh.m_flags = flags; }
+				return std::move(cached.value());
+			}
+		}
+
+		ImportResult result{};
+		const aiScene * scene = aiImportFile(sceneName().c_str(),  aiProcessPreset_TargetRealtime_Fast | aiProcess_FlipUVs | flags);
+		if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+			result.m_error = aiGetErrorString();
+			aiReleaseImport(scene);
+			return result;
+		}
+		std::filesystem::path filepath = sceneName();
+		uint64_t id = 1;
+		PrefabAddNode(scene->mRootNode, -1, filepath, scene, id, result.m_prefab);
+
+		for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
 		    aiString texturePath;
-		    if (material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS) {
-				auto texturePathStr = directory.string() + "/" + std::string{texturePath.C_Str()};
-		        std::cout << "Diffuse Texture: " << texturePathStr << std::endl;	
-				
-				auto tHandle = TextureHandle{m_registry.Insert(Name{texturePathStr})};
-				auto pixels = LoadTexture(tHandle);
-				if( pixels != nullptr) m_engine.SendMsg( MsgTextureCreate{tHandle, this } );
-				m_fileNameMap.insert( std::make_pair(filepath, (Name{texturePathStr})) );
-		    }
-		}
-
-		// Process meshes
-		for (unsigned int i = 0; i <scene->mNumMeshes; i++) {
-		    aiMesh* mesh = scene->mMeshes[i];
-			assert(mesh->HasPositions() && mesh->HasNormals());
-
-			Name name{ (filepath.string() + "/" + mesh->mName.C_Str())};
-		    std::cout << "Mesh " << i << " " << name() << " has " << mesh->mNumVertices << " vertices." << std::endl;
-			if( m_engine.ContainsHandle(name) ) continue;
-
-			vvh::Mesh VVEMesh{};
-		    for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
-		        aiVector3D vertex = mesh->mVertices[j];
-				VVEMesh.m_verticesData.m_positions.push_back({vertex.x, vertex.y, vertex.z});
-			
-				if (mesh->HasNormals()) {
-		            aiVector3D normal = mesh->mNormals[j];
-					VVEMesh.m_verticesData.m_normals.push_back({normal.x, normal.y, normal.z});
-				}
+		    if (scene->mMaterials[i]->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) != AI_SUCCESS) continue;
+			auto name = filepath.parent_path().string() + "/" + std::string{texturePath.C_Str()};
+			if( std::ranges::find(result.m_textures, name) == result.m_textures.end() ) result.m_textures.push_back(name);
+		}
+		std::vector<aiMesh*> meshes;
+		for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+			auto mesh = scene->mMeshes[i];
+			auto name = filepath.string() + "/" + mesh->mName.C_Str();
+			if( std::ranges::any_of(result.m_meshes, [&](auto& m) { return m.m_name == name; }) ) continue;
+			result.m_meshes.push_back( { filepath, name, {}, flags } );
+			meshes.push_back(mesh);
+		}
 
-				if( mesh->HasTangentsAndBitangents() ) {
-					aiVector3D tangent = mesh->mTangents[j];
-					VVEMesh.m_verticesData.m_tangents.push_back({tangent.x, tangent.y, tangent.z});
-				}
+		std::vector<std::pair<MeshStats, MeshStats>> stats(meshes.size());
+		jobPool.ParallelFor(meshes.size(), 1, [&](size_t begin, size_t end) {
+			for( size_t i = begin; i < end; ++i ) {
+				auto& mesh = result.m_meshes[i].m_mesh;
+				mesh = ConvertMesh(meshes[i]);
+				stats[i].first = MeshOptimizer::Analyze(mesh.m_indices, mesh.m_verticesData.m_positions.size());
+				if( optimize ) MeshOptimizer::Optimize(mesh);
+				stats[i].second = MeshOptimizer::Analyze(mesh.m_indices, mesh.m_verticesData.m_positions.size());
+				if( lodLevels > 0 ) result.m_meshes[i].m_lods = LevelOfDetail::GenerateLevels(mesh, lodLevels, lodMinTriangles);
+			}
+		});
+		aiReleaseImport(scene);
+
+		if( hash != 0 && !WriteCache(cacheFile, hash, result) ) {
+			std::cerr << "Mesh cache: could not write " << cacheFile.string() << std::endl;
+		}
+		MeshStats before{}, after{};
+		for( auto& [b, a] : stats ) { before += b; after += a; }
+		result.m_time = { sceneName(), false, elapsedMs(), before.ACMR(), after.ACMR(), before.ATVR(), after.ATVR() };
+		return result;
+	}
 
-				if (mesh->HasTextureCoords(0)) { 
-			        aiVector3D texCoord = mesh->mTextureCoords[0][j];
-					VVEMesh.m_verticesData.m_texCoords.push_back({texCoord.x, texCoord.y});
+	/**
+	 * @brief Hash the content of a scene file, its material or buffer file with the same stem, the import flags
+	 * the mesh optimization, the levels of detail and the cache version with 64 bit FNV-1a. Any change of the source
+	 * or the flags leads to a new cache file.
+	 * @param sceneName Filename of the scene
+	 * @param flags Assimp post processing flags
+	 * @param optimize The meshes are optimized
+	 * @param lodLevels Maximum number of levels of detail per mesh
+	 * @param lodMinTriangles Meshes with fewer triangles get no levels of detail
+	 * @return The hash, 0 if the file could not be read
+	 */
+	auto AssetManager::SceneHash(Filename sceneName, aiPostProcessSteps flags, bool optimize, uint32_t lodLevels, size_t lodMinTriangles) -> uint64_t {
+		uint64_t hash = 14695981039346656037ull;
+		auto add = [&](const char* data, size_t size) {
+			for( size_t i = 0; i < size; ++i ) { hash = (hash ^ (uint8_t)data[i]) * 1099511628211ull; }
+		};
+		uint32_t header[6] = { c_cacheVersion, (uint32_t)flags, (uint32_t)sizeof(real_t), (uint32_t)optimize,	//nodes are stored in the precision of the build
+			lodLevels, (uint32_t)lodMinTriangles };
+		add((const char*)header, sizeof(header));
+
+		std::filesystem::path path = sceneName();
+		std::vector<std::filesystem::path> files{ path };
+		for( auto extension : { ".mtl", ".bin" } ) {
+			auto companion = std::filesystem::path{path}.replace_extension(extension);
+			if( companion != path && std::filesystem::exists(companion) ) files.push_back(companion);
+		}
+		std::vector<char> buffer(1 << 16);
+		for( auto& file : files ) {
+			std::ifstream in(file, std::ios::binary);
+			if( !in ) return 0;
+			while( in.read(buffer.data(), buffer.size()) || in.gcount() > 0 ) { add(buffer.data(), (size_t)in.gcount()); }
+		}
+		return hash == 0 ? 1 : hash;
+	}
+
+	/**
+	 * @brief Read a scene from the mesh cache. The file is read with one call and parsed from memory, every
+	 * length is checked against the size of the file.
+	 * @param file The cache file
+	 * @param sceneName Filename of the scene
+	 * @param hash Hash of the scene
+	 * @return The scene, or nullopt if the file does not exist or does not match
+	 */
+	auto AssetManager::ReadCache(const std::filesystem::path& file, Filename sceneName, uint64_t hash) -> std::optional<ImportResult> {
+		std::ifstream in(file, std::ios::binary | std::ios::ate);
+		if( !in ) return std::nullopt;
+		std::vector<char> data((size_t)in.tellg());
+		in.seekg(0);
+		if( !in.read(data.data(), data.size()) ) return std::nullopt;
+
+		size_t pos = 0;
+		bool ok = true;
+		auto read = [&](void* dst, size_t bytes) {
+			if( !ok || bytes > data.size() - pos ) { ok = false; return; }
+			std::memcpy(dst, data.data() + pos, bytes);
+			pos += bytes;
+		};
+		auto readString = [&](std::string& str) {
+			uint32_t size = 0;
+			read(&size, sizeof(size));
+			if( !ok || size > data.size() - pos ) { ok = false; return; }
+			str.assign(data.data() + pos, size);
+			pos += size;
+		};
+		auto readVector = [&]<typename V>(V& vec) {
+			uint64_t size = 0;
+			read(&size, sizeof(size));
+			if( !ok || size > (data.size() - pos) / sizeof(typename V::value_type) ) { ok = false; return; }
+			vec.resize(size);
+			read(vec.data(), size * sizeof(typename V::value_type));
+		};
+		auto readOptional = [&]<typename T>(std::optional<T>& value) {
+			uint8_t has = 0;
+			read(&has, sizeof(has));
+			if( ok && has ) { value = T{}; read(&value.value(), sizeof(T)); }
+		};
+
+		char magic[4]{};
+		uint32_t version = 0;
+		uint64_t fileHash = 0;
+		read(magic, sizeof(magic));
+		read(&version, sizeof(version));
+		read(&fileHash, sizeof(fileHash));
+		if( !ok || std::memcmp(magic, "VVEM", 4) != 0 || version != c_cacheVersion || fileHash != hash ) return std::nullopt;
+
+		ImportResult result{};
+		std::filesystem::path filepath = sceneName();
+		uint32_t count = 0;
+		read(&count, sizeof(count));
+		for( uint32_t i = 0; ok && i < count; ++i ) {
+			Prefab::Node node{};
+			readString(node.m_name);
+			read(&node.m_parent, sizeof(node.m_parent));
+			read(&node.m_position, sizeof(node.m_position));
+			read(&node.m_rotation, sizeof(node.m_rotation));
+			read(&node.m_scale, sizeof(node.m_scale));
+			readString(node.m_meshName);
+			readString(node.m_textureName);
+			readOptional(node.m_color);
+			readOptional(node.m_material);
+			result.m_prefab.m_nodes.push_back(std::move(node));
+		}
+		read(&count, sizeof(count));
+		auto readMesh = [&](vvh::Mesh& mesh) {
+			readVector(mesh.m_verticesData.m_positions);
+			readVector(mesh.m_verticesData.m_normals);
+			readVector(mesh.m_verticesData.m_texCoords);
+			readVector(mesh.m_verticesData.m_colors);
+			readVector(mesh.m_verticesData.m_tangents);
+			readVector(mesh.m_indices);
+		};
+		for( uint32_t i = 0; ok && i < count; ++i ) {
+			ImportedMesh mesh{ filepath };
+			readString(mesh.m_name);
+			readMesh(mesh.m_mesh);
+			uint32_t levels = 0;
+			read(&levels, sizeof(levels));
+			for( uint32_t level = 0; ok && level < levels; ++level ) { readMesh(mesh.m_lods.emplace_back()); }
+			result.m_meshes.push_back(std::move(mesh));
+		}
+		read(&count, sizeof(count));
+		for( uint32_t i = 0; ok && i < count; ++i ) {
+			readString(result.m_textures.emplace_back());
+		}
+		if( !ok || pos != data.size() ) return std::nullopt;
+		return result;
+	}
+
+	/**
+	 * @brief Write a scene to the mesh cache, through a temporary file that is renamed when complete, so a
+	 * reader never sees a partial file
+	 * @param file The cache file
+	 * @param hash Hash of the scene
+	 * @param result The imported scene
+	 * @return true if the file was written
+	 */
+	auto AssetManager::WriteCache(const std::filesystem::path& file, uint64_t hash, const ImportResult& result) -> bool {
+		std::error_code ec;
+		std::filesystem::create_directories(file.parent_path(), ec);
+		auto temp = file;
+		temp += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+		{
+			std::ofstream out(temp, std::ios::binary);
+			if( !out ) return false;
+			auto write = [&](const void* src, size_t bytes) { out.write((const char*)src, bytes); };
+			auto writeString = [&](const std::string& str) {
+				uint32_t size = (uint32_t)str.size();
+				write(&size, sizeof(size));
+				write(str.data(), size);
+			};
+			auto writeVector = [&](const auto& vec) {
+				uint64_t size = vec.size();
+				write(&size, sizeof(size));
+				write(vec.data(), size * sizeof(vec[0]));
+			};
+			auto writeOptional = [&](const auto& value) {
+				uint8_t has = value.has_value() ? 1 : 0;
+				write(&has, sizeof(has));
+				if( has ) write(&value.value(), sizeof(value.value()));
+			};
+
+			uint32_t version = c_cacheVersion;
+			write("VVEM", 4);
+			write(&version, sizeof(version));
+			write(&hash, sizeof(hash));
+			uint32_t count = (uint32_t)result.m_prefab.m_nodes.size();
+			write(&count, sizeof(count));
+			for( auto& node : result.m_prefab.m_nodes ) {
+				writeString(node.m_name);
+				write(&node.m_parent, sizeof(node.m_parent));
+				write(&node.m_position, sizeof(node.m_position));
+				write(&node.m_rotation, sizeof(node.m_rotation));
+				write(&node.m_scale, sizeof(node.m_scale));
+				writeString(node.m_meshName);
+				writeString(node.m_textureName);
+				writeOptional(node.m_color);
+				writeOptional(node.m_material);
+			}
+			count = (uint32_t)result.m_meshes.size();
+			write(&count, sizeof(count));
+			auto writeMesh = [&](const vvh::Mesh& mesh) {
+				writeVector(mesh.m_verticesData.m_positions);
+				writeVector(mesh.m_verticesData.m_normals);
+				writeVector(mesh.m_verticesData.m_texCoords);
+				writeVector(mesh.m_verticesData.m_colors);
+				writeVector(mesh.m_verticesData.m_tangents);
+				writeVector(mesh.m_indices);
+			};
+			for( auto& mesh : result.m_meshes ) {
+				writeString(mesh.m_name);
+				writeMesh(mesh.m_mesh);
+				uint32_t levels = (uint32_t)mesh.m_lods.size();
+				write(&levels, sizeof(levels));
+				for( auto& lod : mesh.m_lods ) { writeMesh(lod); }
+			}
+			count = (uint32_t)result.m_textures.size();
+			write(&count, sizeof(count));
+			for( auto& texture : result.m_textures ) { writeString(texture); }
+			if( !out.good() ) {
+				out.close();
+				std::filesystem::remove(temp, ec);
+				return false;
+			}
+		}
+		std::filesystem::rename(temp, file, ec);
+		if( ec ) std::filesystem::remove(temp, ec);
+		return !ec;
+	}
+
+	/**
+	 * @brief Remember and print the time of an import, and the vertex cache statistics of an Assimp import
+	 * @param time The import time
+	 */
+	void AssetManager::ReportImport(const ImportTime& time) {
+		std::cout << "Scene " << time.m_scene << (time.m_cached ? " loaded from mesh cache in " : " imported in ") << time.m_ms << " ms" << std::endl;
+		if( !time.m_cached && time.m_acmrBefore > 0.0 ) {
+			std::cout << "  ACMR " << time.m_acmrBefore << " -> " << time.m_acmrAfter << ", ATVR " << time.m_atvrBefore << " -> " << time.m_atvrAfter << std::endl;
+		}
+		m_importTimes.push_back(time);
+	}
+
+	/**
+	 * @brief Decode a texture file, or read its cooked KTX2 file if there is one. A cooked file next to the texture
+	 * is used if it is not older than the texture, its mip levels are uploaded as they are. Can run on a worker thread.
+	 * @param fileName File name of the texture
+	 * @return The image with its pixels allocated with malloc, m_pixels is nullptr if the file could not be read
+	 */
+	auto AssetManager::DecodeTexture(std::string fileName) -> vvh::Image {
+		vvh::Image image{};
+		image.m_layers = 1;
+		std::filesystem::path source{fileName};
+		auto cooked = source.extension() == TextureCooker::c_extension ? source : TextureCooker::CookedPath(source);
+		std::error_code ec;
+		bool fresh = std::filesystem::exists(cooked, ec) && ( cooked == source || !std::filesystem::exists(source, ec)
+			|| std::filesystem::last_write_time(cooked, ec) >= std::filesystem::last_write_time(source, ec) );
+		if( fresh ) {
+			if( auto texture = TextureCooker::ReadKtx2(cooked) ) {
+				for( auto& level : texture->m_levels ) {
+					image.m_mipOffsets.push_back(image.m_size);
+					image.m_size += level.size();
+				}
+				image.m_pixels = malloc(image.m_size); //freed with stbi_image_free like decoded textures
+				for( size_t i = 0; i < texture->m_levels.size(); ++i ) {
+					memcpy((uint8_t*)image.m_pixels + image.m_mipOffsets[i], texture->m_levels[i].data(), texture->m_levels[i].size());
 				}
+				image.m_width = (int)texture->m_width;
+				image.m_height = (int)texture->m_height;
+				image.m_format = texture->m_format;
+				image.m_mipLevels = (uint32_t)texture->m_levels.size();
+				return image;
+			}
+			std::cerr << "Cooked texture " << cooked.string() << " could not be read!" << std::endl;
+			image.m_size = 0;
+			image.m_mipOffsets.clear();
+		}
+
+		int texChannels;
+		image.m_pixels = stbi_load(fileName.c_str(), &image.m_width, &image.m_height, &texChannels, STBI_rgb_alpha);
+		image.m_size = (VkDeviceSize)image.m_width * image.m_height * 4;
+		return image;
+	}
+
+	/**
+	 * @brief Take the results of finished imports and reloads and start texture decodes. The nodes are moved into
+	 * the cached prefab, meshes and textures that do not exist yet are queued and their names remembered, so objects
+	 * created from the prefab get placeholders until they are ready. A failed prefab is taken out of the cache, like
+	 * in the blocking path, but kept alive until the next load step, in which the scene manager drops its scenes.
+	 * Of a reloaded scene only the evicted meshes that were asked for are queued, meshes that could not be reloaded
+	 * keep their placeholder.
+	 */
+	void AssetManager::PollAsync() {
+		m_failedPrefabs.clear();
+		auto ready = [](auto& future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; };
+		auto queue = [&](const std::string& name) {
+			if( m_waiting.contains(name) || (m_engine.ContainsHandle(name) && m_engine.GetHandle(name).IsValid()) ) return false;
+			m_waiting[name];
+			++m_loadTotal;
+			return true;
+		};
+
+		for( auto it = m_asyncImports.begin(); it != m_asyncImports.end(); ) {
+			if( !ready(it->m_future) ) { ++it; continue; }
+			auto result = it->m_future.get();
+			it->m_prefab->m_loading = false;
+			if( !result.m_error.empty() ) {
+				std::cerr << "Assimp Error: " << result.m_error << std::endl;
+				it->m_prefab->m_failed = true;
+				m_failedPrefabs.push_back(m_prefabs.extract(it->m_key));
+				++m_loadDone;
+				it = m_asyncImports.erase(it);
+				continue;
+			}
+			ReportImport(result.m_time);
+			it->m_prefab->m_nodes = std::move(result.m_prefab.m_nodes);
+
+			std::filesystem::path filepath = it->m_sceneName();
+			for( auto& mesh : result.m_meshes ) {
+				if( queue(mesh.m_name) ) m_asyncMeshes.push_back(std::move(mesh));
+			}
+			for( auto& texture : result.m_textures ) {
+				if( queue(texture) ) m_asyncTextures.push_back( { filepath, texture } );
+			}
+			++m_loadDone;
+			it = m_asyncImports.erase(it);
+		}
+
+		for( auto it = m_asyncReloads.begin(); it != m_asyncReloads.end(); ) {
+			if( !ready(it->m_future) ) { ++it; continue; }
+			auto result = it->m_future.get();
+			if( !result.m_error.empty() ) std::cerr << "Assimp Error: " << result.m_error << std::endl;
+			else ReportImport(result.m_time);
+			for( auto& mesh : result.m_meshes ) {
+				if( std::erase(it->m_meshes, mesh.m_name) > 0 ) m_asyncMeshes.push_back(std::move(mesh));
+			}
+			for( auto& name : it->m_meshes ) {
+				std::cerr << "Mesh " << name << " could not be reloaded!" << std::endl;
+				m_waiting.erase(name);
+				++m_loadDone;
+			}
+			it = m_asyncReloads.erase(it);
+		}
+
+		size_t decoding = std::ranges::count_if(m_asyncTextures, [](auto& texture) { return texture.m_future.valid(); });
+		for( auto& texture : m_asyncTextures ) {
+			if( decoding >= m_maxDecodes ) break;
+			if( texture.m_future.valid() ) continue;
+			texture.m_future = std::async(std::launch::async, &AssetManager::DecodeTexture, texture.m_name);
+			++decoding;
+		}
+	}
+
+	/**
+	 * @brief Create one converted mesh or decoded texture and hand it to the renderers, which upload it now.
+	 * Meshes come first, they are ready as soon as the import is done. A texture that could not be decoded
+	 * keeps its placeholder. Assets that were evicted before count as reloaded.
+	 * @return false if no asset is ready
+	 */
+	auto AssetManager::CreateAsyncAsset() -> bool {
+		auto evicted = [&](const std::string& name) {
+			auto it = m_assets.find(name);
+			return it != m_assets.end() && !it->second.m_resident && !it->second.m_scene.empty();
+		};
+
+		if( !m_asyncMeshes.empty() ) {
+			auto mesh = std::move(m_asyncMeshes.front());
+			m_asyncMeshes.pop_front();
+			auto name = mesh.m_name;
+			bool reload = evicted(name);
+			auto gHandle = SceneLoadMesh(std::move(mesh));
+			if( gHandle.IsValid() ) ReplacePlaceholders(name, gHandle);
+			else m_waiting.erase(name);
+			if( gHandle.IsValid() && reload ) ++m_reloaded;
+			return true;
+		}
+
+		auto texture = std::ranges::find_if(m_asyncTextures, [](auto& texture) {
+			return texture.m_future.valid() && texture.m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		});
+		if( texture == m_asyncTextures.end() ) return false;
+		auto decoded = texture->m_future.get();
+		if( decoded.m_pixels == nullptr ) {
+			std::cerr << "Texture " << texture->m_name << " could not be loaded!" << std::endl;
+			m_waiting.erase(texture->m_name);
+		} else {
+			if( evicted(texture->m_name) ) ++m_reloaded;
+			auto tHandle = SceneAddTexture(texture->m_scene, texture->m_name, std::move(decoded));
+			ReplacePlaceholders(texture->m_name, tHandle);
+		}
+		m_asyncTextures.erase(texture);
+		return true;
+	}
+
+	/**
+	 * @brief Create the placeholder mesh and texture if they do not exist. The mesh is a unit cube, the texture
+	 * a grey 2x2 checker board.
+	 */
+	void AssetManager::CreatePlaceholders() {
+		if( m_placeholderMesh().IsValid() ) return;
 
-				if (mesh->HasVertexColors(0)) { 
-				    aiColor4D color = mesh->mColors[0][j];
-					VVEMesh.m_verticesData.m_colors.push_back({color.r, color.g, color.b, color.a});
+		vvh::Mesh mesh{};
+		for( int axis = 0; axis < 3; ++axis ) {
+			for( float sign : { -1.0f, 1.0f } ) {
+				glm::vec3 n{0.0f}, u{0.0f};
+				n[axis] = sign;
+				u[(axis + 1) % 3] = 1.0f;
+				glm::vec3 v = glm::cross(n, u);
+				uint32_t base = (uint32_t)mesh.m_verticesData.m_positions.size();
+				for( auto [s, t] : { std::pair{0.0f, 0.0f}, std::pair{1.0f, 0.0f}, std::pair{1.0f, 1.0f}, std::pair{0.0f, 1.0f} } ) {
+					mesh.m_verticesData.m_positions.push_back( 0.5f * (n + (2.0f * s - 1.0f) * u + (2.0f * t - 1.0f) * v) );
+					mesh.m_verticesData.m_normals.push_back( n );
+					mesh.m_verticesData.m_texCoords.push_back( glm::vec2{s, t} );
 				}
-		    }
+				for( uint32_t i : { 0u, 1u, 2u, 0u, 2u, 3u } ) { mesh.m_indices.push_back(base + i); }
+			}
+		}
+		mesh.chooseIndexType();
+		auto gHandle = m_registry.Insert( Name{c_placeholderMesh}, std::move(mesh) );
+		m_engine.SetHandle(c_placeholderMesh, gHandle);
+		m_engine.SendMsg( MsgMeshCreate{MeshHandle{gHandle}} );
+		m_placeholderMesh = MeshHandle{gHandle};
+
+		auto pixels = (stbi_uc*)malloc(2 * 2 * 4); //freed with stbi_image_free like decoded textures
+		for( int i = 0; i < 4; ++i ) {
+			stbi_uc grey = (i == 0 || i == 3) ? 96 : 160;
+			pixels[4 * i] = pixels[4 * i + 1] = pixels[4 * i + 2] = grey;
+			pixels[4 * i + 3] = 255;
+		}
+		auto tHandle = TextureHandle{m_registry.Insert(Name{c_placeholderTexture}, vvh::Image{2, 2, 1, 2 * 2 * 4, pixels})};
+		m_engine.SetHandle(c_placeholderTexture, tHandle);
+		m_engine.SendMsg( MsgTextureCreate{tHandle, this } );
+		m_placeholderTexture = tHandle;
+	}
+
+	/**
+	 * @brief Get the handle of a mesh or texture for an object. If the asset is still loading, the object
+	 * gets the placeholder and is remembered
+	 * @param oHandle The object
+	 * @param name Name of the asset
+	 * @param placeholder Handle of the placeholder
+	 * @return Handle of the asset or of the placeholder
+	 */
+	auto AssetManager::ResolveAsset(ObjectHandle oHandle, const std::string& name, vecs::Handle placeholder) -> vecs::Handle {
+		auto it = m_waiting.find(name);
+		if( it == m_waiting.end() ) return m_engine.GetHandle(name);
+		it->second.push_back(oHandle);
+		return placeholder;
+	}
 
-			for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-		        aiFace& face = mesh->mFaces[i];
-        		// Ensure it's a triangle
-        		if (face.mNumIndices == 3) {
-            		VVEMesh.m_indices.push_back(face.mIndices[0]);
-            		VVEMesh.m_indices.push_back(face.mIndices[1]);
-            		VVEMesh.m_indices.push_back(face.mIndices[2]);
-        		}
+	/**
+	 * @brief Replace the placeholder by a created asset in all objects waiting for it, and tell the renderers
+	 * @param name Name of the asset
+	 * @param handle Handle of the asset
+	 */
+	void AssetManager::ReplacePlaceholders(const std::string& name, vecs::Handle handle) {
+		auto it = m_waiting.find(name);
+		if( it == m_waiting.end() ) return;
+		std::vector<ObjectHandle> changed;
+		for( auto& oHandle : it->second ) {
+			if( !m_registry.Exists(oHandle) ) continue; //destroyed while loading
+			if( m_registry.Has<MeshName>(oHandle) && m_registry.Get<MeshName>(oHandle)() == name ) {
+				m_registry.Put( oHandle, MeshHandle{handle} );
+				changed.push_back(oHandle);
 			}
+			if( m_registry.Has<TextureName>(oHandle) && m_registry.Get<TextureName>(oHandle)() == name ) {
+				m_registry.Put( oHandle, TextureHandle{handle} );
+				changed.push_back(oHandle);
+			}
+		}
+		m_waiting.erase(it);
+		if( !changed.empty() ) m_engine.SendMsg( MsgObjectsAssetsChanged{changed} );
+	}
 
-			auto gHandle = m_registry.Insert( name, VVEMesh );
-			m_engine.SetHandle(name, gHandle);
-			m_fileNameMap.insert( std::make_pair(filepath, name) );
-			m_engine.SendMsg( MsgMeshCreate{MeshHandle{gHandle}} );
+	/**
+	 * @brief Continue incremental imports, one texture or mesh per unit of work, until the budget is used up.
+	 * Then create meshes and textures of async imports and reloads that are ready, one per unit of work. Nothing
+	 * waits for a worker thread, assets that are not ready are created in a later step. If the new assets exceed
+	 * the memory budget, unused assets are evicted right away instead of at the end of the frame.
+	 * @param message Load step message
+	 * @return false to continue message propagation
+	 */
+	bool AssetManager::OnLoadStep(Message& message) {
+		auto& msg = message.template GetData<MsgLoadStep>();
+		auto& progress = *msg.m_progress;
+		PollAsync();
+		while( (!m_pendingImports.empty() || !m_asyncMeshes.empty() || !m_asyncTextures.empty())
+				&& (progress.m_units == 0 || msg.ElapsedMs() < msg.m_budgetMs) ) {
+			double start = msg.ElapsedMs();
+			if( !m_pendingImports.empty() ) {
+				auto& import = m_pendingImports.front();
+				std::filesystem::path filepath = import.m_sceneName();
+				if( import.m_nextTexture < import.m_textures.size() ) {
+					SceneLoadTexture(filepath, import.m_textures[import.m_nextTexture++]);
+				} else if( import.m_nextMesh < import.m_meshes.size() ) {
+					SceneLoadMesh(std::move(import.m_meshes[import.m_nextMesh++]));
+				}
+				if( import.m_nextTexture == import.m_textures.size() && import.m_nextMesh == import.m_meshes.size() ) {
+					m_pendingImports.pop_front();
+				}
+			} else if( !CreateAsyncAsset() ) {
+				break;
+			}
+			progress.m_maxUnitMs = std::max(progress.m_maxUnitMs, msg.ElapsedMs() - start);
+			++progress.m_units;
+			++m_loadDone;
 		}
+		if( progress.m_units > 0 ) EvictAssets();
+		if( m_pendingImports.empty() && m_asyncImports.empty() && m_asyncReloads.empty() && m_asyncMeshes.empty() && m_asyncTextures.empty() ) { m_loadDone = m_loadTotal = 0; }
+		progress.m_assetsDone = m_loadDone;
+		progress.m_assetsTotal = m_loadTotal;
 		return false;
 	}
 
@@ -171,11 +899,44 @@ namespace vve {
 		auto msg = message.template GetData<MsgObjectCreate>();
 		if( m_registry.Has<MeshName>(msg.m_object) ) {
 			auto meshName = m_registry.Get<MeshName>(msg.m_object);
-			m_registry.Put(	msg.m_object, MeshHandle{ m_engine.GetHandle(meshName) } );
+			AcquireAsset(meshName());
+			m_registry.Put(	msg.m_object, MeshHandle{ ResolveAsset(msg.m_object, meshName(), m_placeholderMesh()) } );
 		}
 		if( m_registry.Has<TextureName>(msg.m_object) ) {
 			auto textureName = m_registry.Get<TextureName>(msg.m_object);
-			m_registry.Put(	msg.m_object, TextureHandle{m_engine.GetHandle(textureName)} );
+			AcquireAsset(textureName());
+			m_registry.Put(	msg.m_object, TextureHandle{ ResolveAsset(msg.m_object, textureName(), m_placeholderTexture()) } );
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Handle batch object creation message. Mesh and texture names are looked up only once per unique name,
+	 * except for assets that are still loading, which remember each object. Each object counts as a reference.
+	 * @param message Message containing the object handles
+	 * @return True if message was handled
+	 */
+    bool AssetManager::OnObjectsCreate(Message message) {
+		auto msg = message.template GetData<MsgObjectsCreate>();
+		std::unordered_map<std::string, vecs::Handle> handles;
+		auto resolve = [&](ObjectHandle oHandle, const std::string& name, vecs::Handle placeholder) {
+			if( m_waiting.contains(name) ) return ResolveAsset(oHandle, name, placeholder);
+			auto it = handles.find(name);
+			if( it == handles.end() ) { it = handles.emplace(name, m_engine.GetHandle(name)).first; }
+			return it->second;
+		};
+
+		for( auto& oHandle : msg.m_objects ) {
+			if( m_registry.Has<MeshName>(oHandle) ) {
+				auto meshName = m_registry.Get<MeshName>(oHandle);
+				AcquireAsset(meshName());
+				m_registry.Put(	oHandle, MeshHandle{ resolve(oHandle, meshName(), m_placeholderMesh()) } );
+			}
+			if( m_registry.Has<TextureName>(oHandle) ) {
+				auto textureName = m_registry.Get<TextureName>(oHandle);
+				AcquireAsset(textureName());
+				m_registry.Put(	oHandle, TextureHandle{ resolve(oHandle, textureName(), m_placeholderTexture()) } );
+			}
 		}
 		return false;
 	}
@@ -201,9 +962,222 @@ namespace vve {
 		auto msg = message.template GetData<MsgTextureCreate>();
 		auto texture = m_registry.template Get<vvh::Image&>(msg.m_handle);
 		stbi_image_free(texture().m_pixels); //last thing release resources
+		texture().m_pixels = nullptr;
 		return true;
 	}
 
+	/**
+	 * @brief Release the mesh and texture of a destroyed object. Runs before the object is erased.
+	 * @param message Message containing the object handle
+	 * @return false to continue message propagation
+	 */
+	bool AssetManager::OnObjectDestroy(Message message) {
+		auto handle = message.template GetData<MsgObjectDestroy>().m_handle;
+		if( !m_registry.Exists(handle) ) return false;
+		if( m_registry.Has<MeshName>(handle) ) ReleaseAsset(m_registry.Get<MeshName>(handle)());
+		if( m_registry.Has<TextureName>(handle) ) ReleaseAsset(m_registry.Get<TextureName>(handle)());
+		return false;
+	}
+
+	/**
+	 * @brief Forget the memory of a destroyed mesh or texture that was loaded from a scene file, whether it was
+	 * evicted or destroyed by someone else. Runs before the renderers erase it. The asset is reloaded when an object
+	 * uses it again.
+	 * @param message Mesh or texture destroy message
+	 * @return false to continue message propagation
+	 */
+	bool AssetManager::OnAssetDestroy(Message message) {
+		vecs::Handle handle = message.template HasType<MsgMeshDestroy>() ? message.template GetData<MsgMeshDestroy>().m_handle()
+			: message.template GetData<MsgTextureDestroy>().m_handle();
+		if( !m_registry.Exists(handle) || !m_registry.Has<Name>(handle) ) return false;
+		auto name = m_registry.Get<Name>(handle)();
+		auto it = m_assets.find(name);
+		if( it == m_assets.end() || !it->second.m_resident || m_engine.GetHandle(name).GetValue() != handle.GetValue() ) return false;
+
+		auto& asset = it->second;
+		asset.m_resident = false;
+		m_cpuBytes -= asset.m_cpuBytes;
+		m_gpuBytes -= asset.m_gpuBytes;
+		m_engine.SetHandle(name, vecs::Handle{});
+		auto [first, last] = m_fileNameMap.equal_range(asset.m_scene);
+		for( auto f = first; f != last; ++f ) {
+			if( f->second == name ) { m_fileNameMap.erase(f); break; }
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Count the frame and evict unused assets if the budget is exceeded
+	 * @param message Frame end message
+	 * @return false to continue message propagation
+	 */
+	bool AssetManager::OnFrameEnd(Message message) {
+		++m_frame;
+		EvictAssets();
+		return false;
+	}
+
+	/**
+	 * @brief Remember the memory of an asset loaded from a scene file. A new asset counts as used in this frame,
+	 * so objects created later in the frame find it.
+	 * @param name Name of the asset
+	 * @param scene Path of the scene file
+	 * @param flags Import flags of the scene
+	 * @param mesh true for a mesh, false for a texture
+	 * @param cpuBytes Memory on the CPU
+	 * @param gpuBytes Memory on the GPU
+	 */
+	void AssetManager::MakeResident(const std::string& name, const std::filesystem::path& scene, aiPostProcessSteps flags, bool mesh, size_t cpuBytes, size_t gpuBytes) {
+		auto& asset = m_assets[name];
+		asset.m_scene = scene;
+		asset.m_flags = flags;
+		asset.m_mesh = mesh;
+		asset.m_resident = true;
+		asset.m_lastUse = m_frame;
+		asset.m_cpuBytes = cpuBytes;
+		asset.m_gpuBytes = gpuBytes;
+		m_cpuBytes += cpuBytes;
+		m_gpuBytes += gpuBytes;
+	}
+
+	/**
+	 * @brief Count an object using an asset, and start reloading the asset if it was evicted. Assets that are still
+	 * loading are not reloaded.
+	 * @param name Name of the asset
+	 */
+	void AssetManager::AcquireAsset(const std::string& name) {
+		auto& asset = m_assets[name];
+		++asset.m_refs;
+		if( !asset.m_resident && !asset.m_scene.empty() && !m_waiting.contains(name) ) ReloadAsset(name);
+	}
+
+	/**
+	 * @brief Count an object no longer using an asset. When the last object is gone, the asset becomes a
+	 * candidate for eviction.
+	 * @param name Name of the asset
+	 */
+	void AssetManager::ReleaseAsset(const std::string& name) {
+		auto it = m_assets.find(name);
+		if( it == m_assets.end() || it->second.m_refs == 0 ) return;
+		if( --it->second.m_refs == 0 ) it->second.m_lastUse = m_frame;
+	}
+
+	/**
+	 * @brief Start reloading an evicted asset, without blocking the frame. The asset is remembered as loading, so
+	 * objects get the placeholder until it is created in a load step. A texture is decoded on a worker thread like
+	 * the textures of async imports, from its cooked KTX2 file if there is one. A mesh is read with its scene on a
+	 * worker thread, from the mesh cache if it is enabled. Meshes of the same scene asked for before the import is
+	 * done share it, the other evicted meshes of the scene are not created, so they do not take up the budget.
+	 * @param name Name of the asset
+	 */
+	void AssetManager::ReloadAsset(const std::string& name) {
+		Asset asset = m_assets[name]; //copy, creating the placeholders announces new assets
+		CreatePlaceholders();
+		m_waiting[name];
+		++m_loadTotal;
+		if( !asset.m_mesh ) {
+			m_asyncTextures.push_back( { asset.m_scene, name } );
+			return;
+		}
+
+		auto reload = std::ranges::find_if(m_asyncReloads, [&](auto& pending) { return pending.m_scene == asset.m_scene && pending.m_flags == asset.m_flags; });
+		if( reload == m_asyncReloads.end() ) {
+			m_asyncReloads.push_back( { asset.m_scene, asset.m_flags, {}, std::async(std::launch::async, &AssetManager::ImportScene,
+				Filename{asset.m_scene.string()}, asset.m_flags, m_cacheDirectory, m_optimizeMeshes, m_lodLevels, m_lodMinTriangles, std::ref(m_engine.GetJobPool())) } );
+			reload = std::prev(m_asyncReloads.end());
+		}
+		reload->m_meshes.push_back(name);
+	}
+
+	/**
+	 * @brief Evict unused assets, least recently used first, until the memory is within the budget. An asset must
+	 * have been unused for MAX_FRAMES_IN_FLIGHT frames, so no frame that is still rendering can use it.
+	 */
+	void AssetManager::EvictAssets() {
+		auto over = [&]() { return (m_cpuBudget > 0 && m_cpuBytes > m_cpuBudget) || (m_gpuBudget > 0 && m_gpuBytes > m_gpuBudget); };
+		if( !over() ) return;
+
+		std::vector<std::pair<uint64_t, std::string>> unused;
+		for( auto& [name, asset] : m_assets ) {
+			if( asset.m_resident && asset.m_refs == 0 && asset.m_lastUse + MAX_FRAMES_IN_FLIGHT <= m_frame ) unused.push_back({ asset.m_lastUse, name });
+		}
+		std::ranges::sort(unused);
+		for( auto& [lastUse, name] : unused ) {
+			if( !over() ) break;
+			auto handle = m_engine.GetHandle(name);
+			if( m_assets[name].m_mesh ) m_engine.DestroyMesh(MeshHandle{handle});
+			else m_engine.DestroyTexture(TextureHandle{handle});
+			++m_evicted;
+		}
+	}
+
+	/**
+	 * @brief Get the memory of the meshes and textures loaded from scene files
+	 * @return Current memory and eviction counts
+	 */
+	auto AssetManager::GetResidency() const -> Residency {
+		Residency residency{ .m_cpuBytes = m_cpuBytes, .m_gpuBytes = m_gpuBytes, .m_evicted = m_evicted, .m_reloaded = m_reloaded };
+		for( auto& [name, asset] : m_assets ) {
+			if( !asset.m_resident ) continue;
+			++residency.m_assets;
+			if( asset.m_refs > 0 ) ++residency.m_referenced;
+		}
+		return residency;
+	}
+
+	/**
+	 * @brief Add prefabs, the file name map, pending imports and async loads to a memory report. Pixels that are
+	 * still being decoded are not included.
+	 * @param message Memory report message
+	 * @return false to continue message propagation
+	 */
+	bool AssetManager::OnMemoryReport(Message message) {
+		auto& msg = message.template GetData<MsgMemoryReport>();
+		auto& report = *msg.m_report;
+
+		size_t bytes = MemoryReport::HashMapBytes(m_prefabs);
+		for( auto& [key, prefab] : m_prefabs ) {
+			bytes += MemoryReport::StringBytes(key) + MemoryReport::VectorBytes(prefab.m_nodes);
+			for( auto& node : prefab.m_nodes ) {
+				bytes += MemoryReport::StringBytes(node.m_name) + MemoryReport::StringBytes(node.m_meshName) + MemoryReport::StringBytes(node.m_textureName);
+			}
+		}
+		MemoryReport::Add(report.m_assets, "Prefabs", m_prefabs.size(), bytes);
+
+		bytes = MemoryReport::HashMapBytes(m_fileNameMap);
+		for( auto& [path, name] : m_fileNameMap ) { bytes += MemoryReport::StringBytes(path.native()) + MemoryReport::StringBytes(name); }
+		MemoryReport::Add(report.m_systems, "Asset manager file names", m_fileNameMap.size(), bytes);
+
+		auto meshBytes = [](const ImportedMesh& mesh) -> size_t {
+			auto& data = mesh.m_mesh.m_verticesData;
+			return MemoryReport::StringBytes(mesh.m_name) + MemoryReport::VectorBytes(mesh.m_mesh.m_indices)
+				+ MemoryReport::VectorBytes(data.m_positions) + MemoryReport::VectorBytes(data.m_normals) + MemoryReport::VectorBytes(data.m_texCoords)
+				+ MemoryReport::VectorBytes(data.m_colors) + MemoryReport::VectorBytes(data.m_tangents);
+		};
+		bytes = m_pendingImports.size() * sizeof(PendingImport);
+		for( auto& import : m_pendingImports ) {
+			bytes += MemoryReport::VectorBytes(import.m_meshes) + MemoryReport::VectorBytes(import.m_textures);
+			for( auto& mesh : import.m_meshes ) { bytes += meshBytes(mesh); }
+			for( auto& texture : import.m_textures ) { bytes += MemoryReport::StringBytes(texture); }
+		}
+		MemoryReport::Add(report.m_systems, "Asset manager pending imports", m_pendingImports.size(), bytes);
+
+		bytes = m_asyncImports.size() * sizeof(AsyncImport) + m_asyncReloads.size() * sizeof(AsyncReload) + m_asyncTextures.size() * sizeof(AsyncTexture);
+		for( auto& reload : m_asyncReloads ) { bytes += MemoryReport::VectorBytes(reload.m_meshes); }
+		for( auto& mesh : m_asyncMeshes ) { bytes += sizeof(ImportedMesh) + meshBytes(mesh); }
+		for( auto& texture : m_asyncTextures ) { bytes += MemoryReport::StringBytes(texture.m_name); }
+		MemoryReport::Add(report.m_systems, "Asset manager async loads", m_asyncImports.size() + m_asyncReloads.size() + m_asyncMeshes.size() + m_asyncTextures.size(), bytes);
+
+		bytes = MemoryReport::HashMapBytes(m_waiting);
+		for( auto& [name, objects] : m_waiting ) { bytes += MemoryReport::StringBytes(name) + MemoryReport::VectorBytes(objects); }
+		MemoryReport::Add(report.m_systems, "Asset manager placeholder objects", m_waiting.size(), bytes);
+
+		bytes = MemoryReport::HashMapBytes(m_assets);
+		for( auto& [name, asset] : m_assets ) { bytes += MemoryReport::StringBytes(name) + MemoryReport::StringBytes(asset.m_scene.native()); }
+		MemoryReport::Add(report.m_systems, "Asset manager references", m_assets.size(), bytes);
+		return false;
+	}
+
 	/**
 	 * @brief Handle play sound message
 	 * @param message Message containing sound playback data
@@ -225,21 +1199,20 @@ namespace vve {
 	}
 
 	/**
-	 * @brief Load texture data from file
+	 * @brief Load texture data from file, or from its cooked KTX2 file
 	 * @param tHandle Handle to the texture to load
 	 * @return Pointer to loaded texture data
 	 */
 	auto AssetManager::LoadTexture(TextureHandle tHandle) -> stbi_uc* {
 		auto fileName = m_registry.Get<Name&>(tHandle);
-		if( m_engine.ContainsHandle(fileName()) ) return nullptr;
+		if( m_engine.ContainsHandle(fileName()) && m_engine.GetHandle(fileName()).IsValid() ) return nullptr; //evicted textures are invalid
 
-		int texWidth, texHeight, texChannels;
-        stbi_uc* pixels = stbi_load(fileName().c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-        VkDeviceSize imageSize = texWidth * texHeight * 4;
+		auto image = DecodeTexture(fileName());
+		auto pixels = (stbi_uc*)image.m_pixels;
         if (!pixels) { return nullptr; }
 
 		m_engine.SetHandle(fileName(), tHandle );
-		m_registry.Put(tHandle, vvh::Image{texWidth, texHeight, 1, imageSize, pixels});
+		m_registry.Put(tHandle, std::move(image));
 		return pixels;
 	}
 
@@ -0,0 +1,85 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+namespace vve {
+
+	/**
+	 * @brief Constructor for the ChangeTracker class
+	 * @param history Number of frames kept in the log
+	 */
+	ChangeTracker::ChangeTracker(uint64_t history) : m_history{std::max<uint64_t>(history, 1)} {}
+
+	/**
+	 * @brief Start a new frame, drops log entries older than the history
+	 */
+	void ChangeTracker::NextFrame() {
+		++m_frame;
+		if( m_frame <= m_history ) return;
+		m_oldest = m_frame - m_history;
+		while( m_first < m_log.size() && m_log[m_first].m_frame < m_oldest ) ++m_first;
+		if( m_first > 1024 && m_first * 2 > m_log.size() ) {	//compact only now and then, dropping is O(1) per entry
+			m_log.erase(m_log.begin(), m_log.begin() + m_first);
+			m_first = 0;
+		}
+	}
+
+	/**
+	 * @brief Mark an entity as changed in the current frame
+	 * @param handle The entity
+	 */
+	void ChangeTracker::Touch(vecs::Handle handle) {
+		auto& version = m_versions[handle.GetValue()];
+		if( version == m_frame ) return;
+		version = m_frame;
+		m_log.push_back({m_frame, handle});
+	}
+
+	/**
+	 * @brief Forget an entity, e.g. when it is erased from the registry
+	 * @param handle The entity
+	 */
+	void ChangeTracker::Erase(vecs::Handle handle) {
+		m_versions.erase(handle.GetValue());
+	}
+
+	/**
+	 * @brief Get the frame an entity was last changed in
+	 * @param handle The entity
+	 * @return The frame number, or 0 if the entity has not been changed
+	 */
+	auto ChangeTracker::GetVersion(vecs::Handle handle) const -> uint64_t {
+		auto it = m_versions.find(handle.GetValue());
+		return it != m_versions.end() ? it->second : 0;
+	}
+
+	/**
+	 * @brief Get the entities changed in a frame or later, each entity is returned once. An entity changed in
+	 * several frames has a log entry for each of them, only the entry matching its version is taken.
+	 * @param frame The first frame to look at
+	 * @param changed Receives the changed entities, the vector is cleared first
+	 * @return False if the log does not reach back to the frame, the caller must then treat all entities as changed
+	 */
+	auto ChangeTracker::GetChangedSince(uint64_t frame, std::vector<vecs::Handle>& changed) const -> bool {
+		changed.clear();
+		if( frame < m_oldest ) return false;
+
+		auto begin = std::lower_bound(m_log.begin() + m_first, m_log.end(), frame,
+			[](const Change& change, uint64_t f) { return change.m_frame < f; });
+		for( auto it = begin; it != m_log.end(); ++it ) {
+			auto version = m_versions.find(it->m_handle.GetValue());
+			if( version != m_versions.end() && version->second == it->m_frame ) changed.push_back(it->m_handle);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Get the CPU memory of the log and the versions
+	 * @return Number of bytes
+	 */
+	auto ChangeTracker::GetMemoryBytes() const -> size_t {
+		return MemoryReport::VectorBytes(m_log) + MemoryReport::HashMapBytes(m_versions);
+	}
+
+};  // namespace vve
+
@@ -33,12 +33,19 @@ namespace vve {
 		m_debug = m_debug | debug;
 		auto transform = [&](const std::string& str) { m_msgTypeMap[std::hash<std::string>{}(str)] = str; };
 		std::ranges::for_each( MsgTypeNames, transform );
+
+		RegisterCallbacks( {
+			{this, 0, "MEMORY_REPORT", [this](Message& message){ return OnMemoryReport(message);} }
+		} );
 	};
 
 	/**
-	 * @brief Destructor for the Engine class
+	 * @brief Destructor for the Engine class. The systems are destroyed first, since they may still use the job pool
+	 * and the registry, e.g. the asset manager waits for imports that convert meshes on the job pool.
 	 */
-	Engine::~Engine() {};
+	Engine::~Engine() {
+		m_systems.clear();
+	};
 
 	/**
 	 * @brief Register message callbacks for the engine
@@ -107,6 +114,10 @@ namespace vve {
 	 * @brief Create and register the window system
 	 */
 	void Engine::CreateWindows(){
+		if (m_type == vve::RendererType::RENDERER_TYPE_NULL) {
+			RegisterSystem(std::make_unique<WindowNull>(m_windowName, *this, m_windowName, 1200, 600 ) );
+			return;
+		}
 		RegisterSystem(std::make_unique<WindowSDL>(m_windowName, *this, m_windowName, 1200, 600 ) );
 	};
 
@@ -114,6 +125,10 @@ namespace vve {
 	 * @brief Create and register the renderer systems
 	 */
 	void Engine::CreateRenderer(){
+		if (m_type == vve::RendererType::RENDERER_TYPE_NULL) {
+			RegisterSystem(std::make_unique<RendererNull>(m_rendererNullName, *this, m_windowName) );
+			return;
+		}
 		RegisterSystem(std::make_unique<RendererVulkan>( m_rendererVulkanName,  *this, m_windowName ) );
 		RegisterSystem(std::make_unique<RendererImgui>(  m_rendererImguiName,   *this, m_windowName ) );
 		if (m_type == vve::RendererType::RENDERER_TYPE_FORWARD)
@@ -171,12 +186,16 @@ namespace vve {
 		auto now = std::chrono::high_resolution_clock::now();
 		double dt = std::chrono::duration<double, std::micro>(now - m_last).count() / 1'000'000.0;
 		m_last = now;
+		if( m_fixedDt > 0.0 ) dt = m_fixedDt;
 
+		m_changes.NextFrame();
+		m_entityCommands.Playback(*this);	//sync point for structural changes recorded by worker threads
+		LoadStep();
 		SendMsg( MsgFrameStart{dt} ) ;
 		SendMsg( MsgPollEvents{dt} ) ;
 		SendMsg( MsgUpdate{dt} ) ;
 
-		auto [handle, stateW, stateSDL] = WindowSDL::GetState(m_registry);
+		auto [handle, stateW] = Window::GetState(m_registry);
 
 		if(!stateW().m_isMinimized) {
 			SendMsg( MsgPrepareNextFrame{dt} ) ;
@@ -319,6 +338,92 @@ namespace vve {
 		return handle;
 	};
 
+	/**
+	 * @brief Create a scene from a file with transform, meshes, textures and nodes are created over the next frames
+	 * @param name Name of the scene
+	 * @param parent Parent node handle
+	 * @param filename Path to the scene file
+	 * @param flags Assimp post-process flags
+	 * @param position Initial position
+	 * @param rotation Initial rotation
+	 * @param scale Initial scale
+	 * @return Handle to the scene root
+	 */
+	auto Engine::CreateSceneIncremental(Name name, ParentHandle parent, const Filename& filename, aiPostProcessSteps flags,
+							Position position, Rotation rotation, Scale scale) -> ObjectHandle {
+		ObjectHandle handle{ m_registry.Insert( position, rotation, scale) };
+        m_engine.SendMsg(MsgSceneCreate{ handle, parent, filename, flags, LoadMode::LOAD_MODE_INCREMENTAL });
+		return handle;
+	};
+
+	/**
+	 * @brief Create a scene from a file with transform, the file is imported and decoded on worker threads
+	 * @param name Name of the scene
+	 * @param parent Parent node handle
+	 * @param filename Path to the scene file
+	 * @param flags Assimp post-process flags
+	 * @param position Initial position
+	 * @param rotation Initial rotation
+	 * @param scale Initial scale
+	 * @return Handle to the scene root
+	 */
+	auto Engine::CreateSceneAsync(Name name, ParentHandle parent, const Filename& filename, aiPostProcessSteps flags,
+							Position position, Rotation rotation, Scale scale) -> ObjectHandle {
+		ObjectHandle handle{ m_registry.Insert( position, rotation, scale) };
+        m_engine.SendMsg(MsgSceneCreate{ handle, parent, filename, flags, LoadMode::LOAD_MODE_ASYNC });
+		return handle;
+	};
+
+	/**
+	 * @brief Continue incremental loading within the load budget
+	 * @return Progress after the step
+	 */
+	auto Engine::LoadStep() -> const LoadProgress& {
+		auto& progress = m_loadProgress;
+		bool idle = !progress.IsLoading();	//maxima are kept until the next load starts
+		double maxUnitMs = progress.m_maxUnitMs;
+		progress.m_units = 0;
+		progress.m_maxUnitMs = 0.0;
+
+		MsgLoadStep msg{ m_loadBudgetMs, &progress };
+		SendMsg( msg );
+		if( progress.m_units == 0 ) {
+			progress.m_maxUnitMs = maxUnitMs;
+			return progress;
+		}
+		progress.m_lastStepMs = msg.ElapsedMs();
+		progress.m_maxStepMs = idle ? progress.m_lastStepMs : std::max(progress.m_maxStepMs, progress.m_lastStepMs);
+		progress.m_maxUnitMs = idle ? progress.m_maxUnitMs : std::max(progress.m_maxUnitMs, maxUnitMs);
+		return progress;
+	}
+
+	/**
+	 * @brief Add the handle map, message callbacks and change tracking to a memory report
+	 * @param message Memory report message
+	 * @return false to continue message propagation
+	 */
+	bool Engine::OnMemoryReport(Message& message) {
+		auto& msg = message.template GetData<MsgMemoryReport>();
+		auto& report = *msg.m_report;
+
+		size_t bytes = MemoryReport::HashMapBytes(m_handleMap);
+		for( auto& [name, handle] : m_handleMap ) { bytes += MemoryReport::StringBytes(name); }
+		MemoryReport::Add(report.m_systems, "Engine handle map", m_handleMap.size(), bytes);
+
+		size_t callbacks = 0;
+		bytes = MemoryReport::TreeMapBytes(m_messageMap) + MemoryReport::TreeMapBytes(m_msgTypeMap);
+		for( auto& [type, priorities] : m_messageMap ) {
+			callbacks += priorities.size();
+			bytes += MemoryReport::TreeMapBytes(priorities);
+			for( auto& [phase, callback] : priorities ) { bytes += MemoryReport::StringBytes(callback.m_messageName); }
+		}
+		for( auto& [type, name] : m_msgTypeMap ) { bytes += MemoryReport::StringBytes(name); }
+		MemoryReport::Add(report.m_systems, "Engine message callbacks", callbacks, bytes);
+
+		MemoryReport::Add(report.m_systems, "Engine change tracker", m_changes.GetLogSize(), m_changes.GetMemoryBytes());
+		return false;
+	}
+
 	/**
 	 * @brief Create an object with a mesh and color
 	 * @param name Name of the object
@@ -357,6 +462,29 @@ namespace vve {
 			return handle;
     	};
 
+	/**
+	 * @brief Create a batch of objects and announce them with one message
+	 * @param parent Parent node handle for all objects
+	 * @param objects Descriptions of the objects
+	 * @return Handles to the created objects
+	 */
+	auto Engine::CreateObjects(ParentHandle parent, std::span<const ObjectInfo> objects) -> std::vector<ObjectHandle> {
+		std::vector<ObjectHandle> handles(objects.size());
+		//insert one archetype after the other, so that consecutive inserts append to the same table
+		for( size_t i = 0; i < objects.size(); ++i ) {
+			auto& info = objects[i];
+			if( !info.m_textureName().empty() ) continue;
+			handles[i] = ObjectHandle{ m_registry.Insert(info.m_position, info.m_rotation, info.m_scale, info.m_color, info.m_meshName, info.m_uvScale) };
+		}
+		for( size_t i = 0; i < objects.size(); ++i ) {
+			auto& info = objects[i];
+			if( info.m_textureName().empty() ) continue;
+			handles[i] = ObjectHandle{ m_registry.Insert(info.m_position, info.m_rotation, info.m_scale, info.m_meshName, info.m_textureName, info.m_uvScale) };
+		}
+		m_engine.SendMsg(MsgObjectsCreate{ handles, parent });
+		return handles;
+	};
+
 	/**
 	 * @brief Destroy an object
 	 * @param handle Handle to the object to destroy
@@ -543,6 +671,50 @@ namespace vve {
 		return m_registry.Put(handle, uvScale);
 	};
 
+	/**
+	 * @brief Write positions and orientations of many objects, one registry write per object. The objects are 
+	 * touched in the change tracker, objects that no longer exist are skipped.
+	 * @param transforms Contiguous array of handles, positions and orientations
+	 */
+	void Engine::SetTransforms(std::span<const TransformInfo> transforms) {
+		for( auto& info : transforms ) {
+			if( !m_registry.Exists(info.m_handle) ) continue;
+			auto [position, rotation] = m_registry.template Get<Position&, Rotation&>(info.m_handle);
+			position() = info.m_position;
+			rotation() = glm::mat3_cast(info.m_orientation);
+			if( m_registry.template Has<DirectWorldMatrix>(info.m_handle) ) m_registry.template Get<DirectWorldMatrix&>(info.m_handle)() = false;
+			m_changes.Touch(info.m_handle);
+		}
+	};
+
+	/**
+	 * @brief Write local to world matrices of many objects. Only the local to parent matrices are written, relative
+	 * to the world matrix the parent gets in this frame, and the objects are marked to keep them. The scene manager
+	 * then computes the world matrices of the objects and their children, touches them, sends OBJECT_CHANGED and 
+	 * updates cameras, as for objects moved by their position. Objects that no longer exist are skipped.
+	 * @param matrices Contiguous array of handles and world matrices
+	 */
+	void Engine::SetWorldMatrices(std::span<const WorldMatrixInfo> matrices) {
+		auto root = GetRootSceneNode();
+
+		// world matrix of a node as the scene manager computes it, this includes matrices written before in this call
+		auto worldMatrix = [&](vecs::Handle handle, auto& self) -> mat4_t {
+			if( handle == root() || !m_registry.template Has<ParentHandle>(handle) ) return mat4_t{1.0f};
+			auto [parent, position, rotation, scale, LtoP] = 
+				m_registry.template Get<ParentHandle, Position&, Rotation&, Scale&, LocalToParentMatrix&>(handle);
+			bool direct = m_registry.template Has<DirectWorldMatrix>(handle) && m_registry.template Get<DirectWorldMatrix>(handle)();
+			mat4_t local = direct ? LtoP() : glm::translate(mat4_t{1.0f}, position()) * mat4_t(rotation()) * glm::scale(mat4_t{1.0f}, scale());
+			return self(parent(), self) * local;
+		};
+
+		for( auto& info : matrices ) {
+			if( !m_registry.Exists(info.m_handle) ) continue;
+			auto [parent, LtoP] = m_registry.template Get<ParentHandle, LocalToParentMatrix&>(info.m_handle);
+			LtoP() = parent() == root() ? info.m_matrix : glm::inverse(worldMatrix(parent(), worldMatrix)) * info.m_matrix;
+			m_registry.Put(info.m_handle, DirectWorldMatrix{true});
+		}
+	};
+
 
 	//-------------------------------------------------------------------------------------------------------------------
 
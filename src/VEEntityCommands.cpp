@@ -0,0 +1,113 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+namespace vve {
+
+	/**
+	 * @brief Erase an entity, skipped if the entity does not exist any more
+	 * @param handle The entity
+	 */
+	void EntityCommands::Buffer::Erase(vecs::Handle handle) {
+		m_commands.push_back( [handle](Engine& engine, std::vector<vecs::Handle>& created) {
+			if( !engine.GetRegistry().Exists(handle) ) return;
+			engine.GetChanges().Erase(handle);
+			engine.GetRegistry().Erase(handle);
+		});
+	}
+
+	/**
+	 * @brief Erase a pending entity
+	 * @param pending The pending entity
+	 */
+	void EntityCommands::Buffer::Erase(Pending pending) {
+		m_commands.push_back( [pending](Engine& engine, std::vector<vecs::Handle>& created) {
+			auto handle = created[pending.m_index];
+			if( !engine.GetRegistry().Exists(handle) ) return;
+			engine.GetChanges().Erase(handle);
+			engine.GetRegistry().Erase(handle);
+		});
+	}
+
+	/**
+	 * @brief Create an object with a mesh and color, see Engine::CreateObject
+	 * @return The pending object
+	 */
+	auto EntityCommands::Buffer::CreateObject(Name name, ParentHandle parent, const MeshName& meshName, vvh::Color color,
+							Position position, Rotation rotation, Scale scale, UVScale uvScale) -> Pending {
+		m_commands.push_back( [=](Engine& engine, std::vector<vecs::Handle>& created) {
+			created.push_back( engine.CreateObject(name, parent, meshName, color, position, rotation, scale, uvScale) );
+		});
+		return Pending{ m_numCreated++ };
+	}
+
+	/**
+	 * @brief Create an object with a mesh and texture, see Engine::CreateObject
+	 * @return The pending object
+	 */
+	auto EntityCommands::Buffer::CreateObject(Name name, ParentHandle parent, const MeshName& meshName, const TextureName& textureName,
+							Position position, Rotation rotation, Scale scale, UVScale uvScale) -> Pending {
+		m_commands.push_back( [=](Engine& engine, std::vector<vecs::Handle>& created) {
+			created.push_back( engine.CreateObject(name, parent, meshName, textureName, position, rotation, scale, uvScale) );
+		});
+		return Pending{ m_numCreated++ };
+	}
+
+	/**
+	 * @brief Destroy an object, skipped if the object does not exist any more
+	 * @param handle The object
+	 */
+	void EntityCommands::Buffer::DestroyObject(ObjectHandle handle) {
+		m_commands.push_back( [handle](Engine& engine, std::vector<vecs::Handle>& created) {
+			if( engine.GetRegistry().Exists(handle) ) engine.DestroyObject(handle);
+		});
+	}
+
+	/**
+	 * @brief Destroy a pending object
+	 * @param pending The pending object
+	 */
+	void EntityCommands::Buffer::DestroyObject(Pending pending) {
+		m_commands.push_back( [pending](Engine& engine, std::vector<vecs::Handle>& created) {
+			ObjectHandle handle{ created[pending.m_index] };
+			if( engine.GetRegistry().Exists(handle) ) engine.DestroyObject(handle);
+		});
+	}
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Get the buffer with a key, it is created if needed. Can be called from any thread.
+	 * @param key Key of the buffer, defines the playback order. Each recording thread should use its own key.
+	 * @return The buffer
+	 */
+	auto EntityCommands::GetBuffer(uint64_t key) -> Buffer& {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_buffers[key];
+	}
+
+	/**
+	 * @brief Play back all buffers and remove them. Commands may record new commands, e.g. from message callbacks,
+	 * these are played back at the next sync point.
+	 * @param engine The engine
+	 */
+	void EntityCommands::Playback(Engine& engine) {
+		std::map<uint64_t, Buffer> buffers;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			buffers.swap(m_buffers);
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		m_stats = { buffers.size(), 0, 0.0 };
+		std::vector<vecs::Handle> created;
+		for( auto& [key, buffer] : buffers ) {
+			created.clear();
+			for( auto& command : buffer.m_commands ) { command(engine, created); }
+			m_stats.m_commands += buffer.m_commands.size();
+		}
+		m_stats.m_playbackMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+};  // namespace vve
+
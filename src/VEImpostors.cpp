@@ -0,0 +1,336 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the Impostors class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 * @param distance Objects farther away than this are drawn as impostors
+	 * @param views Number of views per atlas
+	 * @param resolution Edge length of a view in pixels
+	 */
+    Impostors::Impostors(std::string systemName, Engine& engine, real_t distance, uint32_t views, uint32_t resolution)
+		: System{systemName, engine }, m_distance{distance}, m_views{views}, m_resolution{resolution} {
+		engine.RegisterCallbacks( {
+			{this, std::numeric_limits<int>::max() - 3000, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the Impostors class
+	 */
+    Impostors::~Impostors() {}
+
+	/**
+	 * @brief Render the atlas of a mesh on the CPU. Each view is an orthographic projection of the bounding sphere,
+	 * shaded with the normal facing the view direction. Pixels outside the silhouette get the average color of
+	 * the view and alpha 0.
+	 * @param mesh The mesh
+	 * @param diffuse Color used if the mesh has no vertex colors
+	 * @param views Number of views
+	 * @param resolution Edge length of a view in pixels
+	 * @return The atlas
+	 */
+	auto Impostors::BakeAtlas(const vvh::Mesh& mesh, vec4_t diffuse, uint32_t views, uint32_t resolution) -> ImpostorAtlas {
+		auto& data = mesh.m_verticesData;
+		ImpostorAtlas atlas{ views, resolution };
+		atlas.m_pixels.assign(views * resolution * resolution * 4, 0);
+		atlas.m_hulls.resize(views);
+
+		vec3_t lo{ std::numeric_limits<real_t>::max() }, hi{ std::numeric_limits<real_t>::lowest() };
+		for( auto& p : data.m_positions ) { lo = glm::min(lo, vec3_t{p}); hi = glm::max(hi, vec3_t{p}); }
+		atlas.m_center = (lo + hi) * (real_t)0.5;
+		atlas.m_radius = 0;
+		for( auto& p : data.m_positions ) { atlas.m_radius = std::max(atlas.m_radius, glm::length(vec3_t{p} - atlas.m_center)); }
+		if( atlas.m_radius <= 0 ) return atlas;
+
+		size_t width = views * resolution;
+		std::vector<glm::vec3> projected(data.m_positions.size());	//pixel x, pixel y, depth
+		std::vector<float> depth(resolution * resolution);
+
+		for( uint32_t view = 0; view < views; ++view ) {
+			real_t angle = glm::two_pi<real_t>() * view / views;
+			vec3_t dir{ std::cos(angle), std::sin(angle), 0 }, right{ -std::sin(angle), std::cos(angle), 0 }, up{ 0, 0, 1 };
+
+			// project, and bound the silhouette by a polygon whose edges have fixed normals
+			std::vector<float> support(c_cardSides, -1.0f);
+			for( size_t i = 0; i < data.m_positions.size(); ++i ) {
+				vec3_t q = vec3_t{data.m_positions[i]} - atlas.m_center;
+				glm::vec2 p = glm::vec2{ glm::dot(q, right), glm::dot(q, up) } / (float)atlas.m_radius;
+				projected[i] = glm::vec3{ (p.x * 0.5f + 0.5f) * resolution, (0.5f - p.y * 0.5f) * resolution, -glm::dot(q, dir) };
+				for( uint32_t j = 0; j < c_cardSides; ++j ) {
+					float a = glm::two_pi<float>() * j / c_cardSides;
+					support[j] = std::max(support[j], p.x * std::cos(a) + p.y * std::sin(a));
+				}
+			}
+			for( uint32_t j = 0; j < c_cardSides; ++j ) {
+				float a0 = glm::two_pi<float>() * j / c_cardSides, a1 = glm::two_pi<float>() * (j + 1) / c_cardSides;
+				glm::vec2 n0{ std::cos(a0), std::sin(a0) }, n1{ std::cos(a1), std::sin(a1) };
+				float s0 = support[j], s1 = support[(j + 1) % c_cardSides];
+				float det = n0.x * n1.y - n0.y * n1.x;
+				glm::vec2 corner{ (s0 * n1.y - s1 * n0.y) / det, (n0.x * s1 - n1.x * s0) / det };
+				atlas.m_hulls[view].push_back( glm::clamp(corner, glm::vec2{-1.0f}, glm::vec2{1.0f}) );
+			}
+
+			// rasterize with a depth buffer
+			std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::max());
+			uint8_t* cell = &atlas.m_pixels[view * resolution * 4];
+			for( size_t t = 0; t + 2 < mesh.m_indices.size(); t += 3 ) {
+				uint32_t i0 = mesh.m_indices[t], i1 = mesh.m_indices[t + 1], i2 = mesh.m_indices[t + 2];
+				glm::vec3 v0 = projected[i0], v1 = projected[i1], v2 = projected[i2];
+				float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+				if( std::abs(area) < 1e-8f ) continue;
+
+				vec3_t normal = data.m_normals.empty()
+					? glm::normalize(glm::cross(vec3_t{data.m_positions[i1] - data.m_positions[i0]}, vec3_t{data.m_positions[i2] - data.m_positions[i0]}))
+					: glm::normalize(vec3_t{data.m_normals[i0] + data.m_normals[i1] + data.m_normals[i2]});
+				vec4_t color = data.m_colors.empty() ? diffuse : vec4_t{(data.m_colors[i0] + data.m_colors[i1] + data.m_colors[i2]) / 3.0f};
+				color *= (real_t)0.35 + (real_t)0.65 * std::abs(glm::dot(normal, dir));
+
+				int minX = std::max(0, (int)std::floor(std::min({v0.x, v1.x, v2.x})));
+				int maxX = std::min((int)resolution - 1, (int)std::ceil(std::max({v0.x, v1.x, v2.x})));
+				int minY = std::max(0, (int)std::floor(std::min({v0.y, v1.y, v2.y})));
+				int maxY = std::min((int)resolution - 1, (int)std::ceil(std::max({v0.y, v1.y, v2.y})));
+				for( int y = minY; y <= maxY; ++y ) {
+					for( int x = minX; x <= maxX; ++x ) {
+						glm::vec2 p{ x + 0.5f, y + 0.5f };
+						float b0 = ((v1.x - p.x) * (v2.y - p.y) - (v1.y - p.y) * (v2.x - p.x)) / area;
+						float b1 = ((v2.x - p.x) * (v0.y - p.y) - (v2.y - p.y) * (v0.x - p.x)) / area;
+						float b2 = 1.0f - b0 - b1;
+						if( b0 < 0.0f || b1 < 0.0f || b2 < 0.0f ) continue;
+						float z = b0 * v0.z + b1 * v1.z + b2 * v2.z;
+						if( z >= depth[y * resolution + x] ) continue;
+						depth[y * resolution + x] = z;
+						uint8_t* pixel = &cell[(y * width + x) * 4];
+						for( int c = 0; c < 3; ++c ) pixel[c] = (uint8_t)std::clamp((float)color[c] * 255.0f, 0.0f, 255.0f);
+						pixel[3] = 255;
+					}
+				}
+			}
+
+			// background gets the average color, so bilinear filtering at the silhouette does not darken it
+			glm::dvec3 sum{0.0};
+			size_t covered = 0;
+			for( uint32_t y = 0; y < resolution; ++y ) {
+				for( uint32_t x = 0; x < resolution; ++x ) {
+					uint8_t* pixel = &cell[(y * width + x) * 4];
+					if( pixel[3] == 0 ) continue;
+					sum += glm::dvec3{ pixel[0], pixel[1], pixel[2] };
+					++covered;
+				}
+			}
+			if( covered == 0 ) continue;
+			sum /= (double)covered;
+			for( uint32_t y = 0; y < resolution; ++y ) {
+				for( uint32_t x = 0; x < resolution; ++x ) {
+					uint8_t* pixel = &cell[(y * width + x) * 4];
+					if( pixel[3] == 0 ) { pixel[0] = (uint8_t)sum.x; pixel[1] = (uint8_t)sum.y; pixel[2] = (uint8_t)sum.z; }
+				}
+			}
+		}
+		return atlas;
+	}
+
+	/**
+	 * @brief Write an atlas to a PNG file
+	 * @param atlas The atlas
+	 * @param path Path of the file
+	 * @return True if the file was written
+	 */
+	auto Impostors::SaveAtlas(const ImpostorAtlas& atlas, const std::filesystem::path& path) -> bool {
+		int width = atlas.m_views * atlas.m_resolution;
+		return stbi_write_png(path.string().c_str(), width, atlas.m_resolution, 4, atlas.m_pixels.data(), width * 4) != 0;
+	}
+
+	/**
+	 * @brief Create the billboard mesh of a view. The card lies in the yz-plane facing +x, and is a triangle fan
+	 * over the silhouette polygon. Both windings are emitted, so the card is visible regardless of face culling.
+	 * @param atlas The atlas
+	 * @param view Index of the view
+	 * @return The billboard mesh
+	 */
+	auto Impostors::CreateCard(const ImpostorAtlas& atlas, uint32_t view) -> vvh::Mesh {
+		vvh::Mesh card{};
+		auto& data = card.m_verticesData;
+		auto addVertex = [&](glm::vec2 h) {
+			data.m_positions.push_back( glm::vec3{ 0.0f, h.x, h.y } * (float)atlas.m_radius );
+			data.m_normals.push_back( glm::vec3{ 1.0f, 0.0f, 0.0f } );
+			data.m_tangents.push_back( glm::vec3{ 0.0f, 1.0f, 0.0f } );
+			data.m_texCoords.push_back( glm::vec2{ (view + h.x * 0.5f + 0.5f) / atlas.m_views, 0.5f - h.y * 0.5f } );
+		};
+
+		auto& hull = atlas.m_hulls[view];
+		addVertex( glm::vec2{0.0f} );
+		for( auto& h : hull ) addVertex(h);
+		for( uint32_t i = 0; i < hull.size(); ++i ) {
+			uint32_t a = 1 + i, b = 1 + (i + 1) % (uint32_t)hull.size();
+			card.m_indices.insert(card.m_indices.end(), { 0, a, b, 0, b, a });
+		}
+		card.chooseIndexType();
+		return card;
+	}
+
+	/**
+	 * @brief Append a billboard to a batch. Indices are offset by the vertices already in the batch, normals
+	 * and tangents are turned with the billboard.
+	 * @param batch The batch mesh
+	 * @param card The billboard
+	 * @param transform Places the billboard in the world
+	 */
+	void Impostors::AppendCard(vvh::Mesh& batch, const vvh::Mesh& card, const mat4_t& transform) {
+		auto& to = batch.m_verticesData;
+		auto& from = card.m_verticesData;
+		uint32_t base = (uint32_t)to.m_positions.size();
+		mat3_t rotation{ glm::normalize(vec3_t{transform[0]}), glm::normalize(vec3_t{transform[1]}), glm::normalize(vec3_t{transform[2]}) };
+		for( auto& p : from.m_positions ) to.m_positions.push_back( glm::vec3{ transform * vec4_t{vec3_t{p}, 1.0} } );
+		for( auto& n : from.m_normals ) to.m_normals.push_back( glm::vec3{ rotation * vec3_t{n} } );
+		for( auto& t : from.m_tangents ) to.m_tangents.push_back( glm::vec3{ rotation * vec3_t{t} } );
+		to.m_texCoords.insert(to.m_texCoords.end(), from.m_texCoords.begin(), from.m_texCoords.end());
+		for( auto i : card.m_indices ) batch.m_indices.push_back(base + i);
+	}
+
+	/**
+	 * @brief Bake the atlas of a mesh and create its billboard batch and texture. The batch is a dynamic mesh drawn
+	 * by one object, it starts with the first billboard so that it has the vertex streams of the billboards.
+	 * @param meshName Name of the mesh, the mesh must be loaded
+	 * @param diffuse Color used if the mesh has no vertex colors
+	 * @return True if the atlas was baked
+	 */
+	auto Impostors::Bake(const MeshName& meshName, vec4_t diffuse) -> bool {
+		if( m_entries.contains(meshName()) ) return true;
+		if( !m_engine.ContainsHandle(meshName()) ) return false;
+
+		auto start = std::chrono::high_resolution_clock::now();
+		Entry entry{};
+		{
+			const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(m_engine.GetHandle(meshName()));
+			entry.m_atlas = BakeAtlas(mesh, diffuse, m_views, m_resolution);
+			entry.m_triangles = mesh.m_indices.size() / 3;
+		}
+		if( entry.m_atlas.m_radius <= 0 ) return false;
+
+		for( uint32_t view = 0; view < m_views; ++view ) { entry.m_cards.push_back(CreateCard(entry.m_atlas, view)); }
+
+		Name batchName{ meshName() + "/impostors" };
+		vvh::Mesh batch = entry.m_cards[0];
+		batch.m_dynamic = true;
+		batch.m_indexType = VK_INDEX_TYPE_UINT32;	//many billboards exceed 16 bit indices
+		auto bHandle = m_registry.Insert(batchName, std::move(batch));
+		m_engine.SetHandle(batchName, bHandle);
+		m_engine.SendMsg( MsgMeshCreate{MeshHandle{bHandle}} );
+		entry.m_batch = MeshHandle{bHandle};
+
+		//the pixels are released with stbi_image_free after the upload, like loaded textures
+		Name textureName{ meshName() + "/impostor" };
+		size_t size = entry.m_atlas.m_pixels.size();
+		void* pixels = std::malloc(size);
+		std::memcpy(pixels, entry.m_atlas.m_pixels.data(), size);
+		auto tHandle = m_registry.Insert(textureName, vvh::Image{ (int)(m_views * m_resolution), (int)m_resolution, 1, size, pixels });
+		m_engine.SetHandle(textureName, tHandle);
+		m_engine.SendMsg( MsgTextureCreate{TextureHandle{tHandle}, this} );
+		entry.m_texture = TextureHandle{tHandle};
+
+		entry.m_object = m_engine.CreateObject( Name{}, ParentHandle{}, MeshName{batchName()}, TextureName{textureName()} );
+		m_registry.Put(entry.m_object, Hidden{true});
+		m_registry.Put(entry.m_object, ShadowCaster{false});	//the objects themselves cast the shadows
+
+		m_entries[meshName()] = std::move(entry);
+		m_stats.m_bakeMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return true;
+	}
+
+	/**
+	 * @brief Get a baked atlas
+	 * @param meshName Name of the mesh
+	 * @return Pointer to the atlas, or nullptr if the mesh has not been baked
+	 */
+	auto Impostors::GetAtlas(const MeshName& meshName) -> const ImpostorAtlas* {
+		auto it = m_entries.find(meshName());
+		return it == m_entries.end() ? nullptr : &it->second.m_atlas;
+	}
+
+	/**
+	 * @brief Switch objects between mesh and billboard, and write the billboards into the batches. A billboard is
+	 * turned around the up axis towards the camera, and shows the view closest to the camera direction relative
+	 * to the object. Batches without billboards are hidden.
+	 * @param message Update message
+	 * @return false to continue message propagation
+	 */
+	bool Impostors::OnUpdate(Message message) {
+		auto view = m_registry.template GetView<vecs::Handle, Camera&, LocalToWorldMatrix&>();
+		auto it = view.begin();
+		if( !(it != view.end()) ) return false;
+		auto [cHandle, camera, cameraLtoW] = *it;
+		vec3_t cameraPos{ cameraLtoW()[3] };
+
+		m_stats.m_objects = m_stats.m_impostors = m_stats.m_draws = m_stats.m_trianglesFull = m_stats.m_trianglesDrawn = 0;
+		for( auto& [name, entry] : m_entries ) {
+			auto batch = m_registry.template Get<vvh::Mesh&>(entry.m_batch);
+			batch().m_verticesData.m_positions.clear();
+			batch().m_verticesData.m_normals.clear();
+			batch().m_verticesData.m_tangents.clear();
+			batch().m_verticesData.m_texCoords.clear();
+			batch().m_indices.clear();
+		}
+
+		std::vector<std::pair<vecs::Handle, Entry*>> newObjects;
+		for( auto [handle, meshName, LtoW] : m_registry.template GetView<vecs::Handle, MeshName, LocalToWorldMatrix&>() ) {
+			auto entry = m_entries.find(meshName());
+			if( entry == m_entries.end() ) continue;
+			if( !m_registry.template Has<Impostor>(handle) ) {
+				newObjects.push_back({handle, &entry->second});
+				continue;
+			}
+
+			auto& atlas = entry->second.m_atlas;
+			auto impostor = m_registry.template Get<Impostor&>(handle);
+			vec3_t center{ LtoW() * vec4_t{atlas.m_center, 1.0} };
+			real_t distance = glm::length(center - cameraPos);
+			bool active = distance > m_distance * (impostor().m_active ? 1 - m_hysteresis : 1 + m_hysteresis);
+			if( active != impostor().m_active ) {
+				impostor().m_active = active;
+				m_registry.template Get<Hidden&>(handle)() = active;
+			}
+
+			++m_stats.m_objects;
+			m_stats.m_trianglesFull += entry->second.m_triangles;
+			if( !active ) {
+				m_stats.m_trianglesDrawn += entry->second.m_triangles;
+				continue;
+			}
+
+			real_t cameraAngle = std::atan2(cameraPos.y - center.y, cameraPos.x - center.x);
+			real_t objectAngle = std::atan2(LtoW()[0].y, LtoW()[0].x);
+			real_t step = glm::two_pi<real_t>() / atlas.m_views;
+			int index = (int)std::round((cameraAngle - objectAngle) / step) % (int)atlas.m_views;
+			if( index < 0 ) index += atlas.m_views;
+			real_t scale = std::max({ glm::length(vec3_t{LtoW()[0]}), glm::length(vec3_t{LtoW()[1]}), glm::length(vec3_t{LtoW()[2]}) });
+
+			mat4_t transform = glm::scale(glm::rotate(glm::translate(mat4_t{1.0}, center), cameraAngle, vec3_t{0, 0, 1}), vec3_t{scale});
+			auto& card = entry->second.m_cards[index];
+			AppendCard(m_registry.template Get<vvh::Mesh&>(entry->second.m_batch), card, transform);
+			++m_stats.m_impostors;
+			m_stats.m_trianglesDrawn += card.m_indices.size() / 3;
+		}
+
+		for( auto& [name, entry] : m_entries ) {
+			bool empty = m_registry.template Get<vvh::Mesh&>(entry.m_batch)().m_indices.empty();
+			m_registry.template Get<Hidden&>(entry.m_object)() = empty;
+			if( !empty ) ++m_stats.m_draws;
+		}
+
+		for( auto& [handle, entry] : newObjects ) {
+			m_registry.Put(handle, Impostor{false});
+			m_registry.Put(handle, Hidden{false});
+		}
+		return false;
+	}
+
+
+};  // namespace vve
+
@@ -0,0 +1,96 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+namespace vve {
+
+	/**
+	 * @brief Constructor for the JobPool class
+	 * @param numThreads Number of threads including the caller, 0 means one per hardware thread
+	 */
+	JobPool::JobPool(uint32_t numThreads) {
+		if( numThreads == 0 ) numThreads = std::max(1u, std::thread::hardware_concurrency());
+		for( uint32_t i = 1; i < numThreads; ++i ) {
+			m_workers.emplace_back( [this](std::stop_token stop){ Run(stop); } );
+		}
+	}
+
+	/**
+	 * @brief Destructor for the JobPool class, stops the workers
+	 */
+	JobPool::~JobPool() {
+		for( auto& worker : m_workers ) { worker.request_stop(); }
+		m_condition.notify_all();
+		m_workers.clear();
+	}
+
+	/**
+	 * @brief Run a function on chunks of an index range in parallel and wait until all chunks are done
+	 * @param count Number of indices
+	 * @param chunkSize Number of indices per chunk
+	 * @param func Function called with the begin and end index of a chunk
+	 */
+	void JobPool::ParallelFor(size_t count, size_t chunkSize, const std::function<void(size_t, size_t)>& func) {
+		if( count == 0 ) return;
+		chunkSize = std::max<size_t>(chunkSize, 1);
+		size_t numChunks = (count + chunkSize - 1) / chunkSize;
+		if( numChunks == 1 || m_workers.empty() ) {
+			func(0, count);
+			return;
+		}
+
+		auto loop = std::make_shared<Loop>();
+		loop->m_func = &func;
+		loop->m_count = count;
+		loop->m_chunkSize = chunkSize;
+		loop->m_numChunks = numChunks;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for( size_t i = 0; i < std::min(m_workers.size(), numChunks - 1); ++i ) { m_loops.push(loop); }
+		}
+		m_condition.notify_all();
+
+		RunChunks(*loop);
+		for( size_t done = loop->m_done.load(); done < numChunks; done = loop->m_done.load() ) {
+			loop->m_done.wait(done);
+		}
+		if( loop->m_exception ) std::rethrow_exception(loop->m_exception);
+	}
+
+	/**
+	 * @brief Take chunks of a loop until none is left
+	 * @param loop The loop
+	 */
+	void JobPool::RunChunks(Loop& loop) {
+		for( size_t chunk = loop.m_next++; chunk < loop.m_numChunks; chunk = loop.m_next++ ) {
+			size_t begin = chunk * loop.m_chunkSize;
+			try {
+				(*loop.m_func)(begin, std::min(begin + loop.m_chunkSize, loop.m_count));
+			} catch( ... ) {
+				std::lock_guard<std::mutex> lock(loop.m_mutex);
+				if( !loop.m_exception ) loop.m_exception = std::current_exception();
+			}
+			++loop.m_done;
+			loop.m_done.notify_all();
+		}
+	}
+
+	/**
+	 * @brief Main function of a worker thread
+	 * @param stop Stop token of the thread
+	 */
+	void JobPool::Run(std::stop_token stop) {
+		while( true ) {
+			std::shared_ptr<Loop> loop;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				if( !m_condition.wait(lock, stop, [this]() { return !m_loops.empty(); }) ) return;
+				loop = std::move(m_loops.front());
+				m_loops.pop();
+			}
+			RunChunks(*loop);
+		}
+	}
+
+};  // namespace vve
+
@@ -0,0 +1,304 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the LevelOfDetail class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 * @param thresholds Projected size (fraction of the screen height) below which the next level is used
+	 * @param hysteresis Relative band around the thresholds in which the level is not changed
+	 * @param minTriangles Meshes with fewer triangles get no levels of detail
+	 */
+    LevelOfDetail::LevelOfDetail(std::string systemName, Engine& engine, std::vector<real_t> thresholds, real_t hysteresis, size_t minTriangles)
+		: System{systemName, engine }, m_thresholds{thresholds}, m_hysteresis{hysteresis}, m_minTriangles{minTriangles} {
+		m_stats.m_objectsPerLevel.resize(m_thresholds.size() + 1);
+		engine.RegisterCallbacks( {
+			{this,    0, "INIT", [this](Message& message){ return OnInit(message);} },
+			{this, -100, "MESH_DESTROY", [this](Message& message){ return OnMeshDestroy(message);} },
+			{this,  900, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the LevelOfDetail class
+	 */
+    LevelOfDetail::~LevelOfDetail() {}
+
+	/**
+	 * @brief Simplify a mesh by quadric error edge collapse. Each vertex has the summed error quadric of its
+	 * triangle planes. The cheapest edge is collapsed into one of its end points, so all vertex attributes stay
+	 * valid. Vertices on open borders and on attribute seams are locked, and collapses that flip a triangle are
+	 * rejected.
+	 * @param mesh The mesh to simplify
+	 * @param targetTriangles Number of triangles to reduce to
+	 * @return The simplified mesh, having the same vertex attributes and quantization bounds
+	 */
+	auto LevelOfDetail::Simplify(const vvh::Mesh& mesh, size_t targetTriangles) -> vvh::Mesh {
+		auto& positions = mesh.m_verticesData.m_positions;
+		std::vector<uint32_t> indices = mesh.m_indices;
+		size_t numVertices = positions.size();
+		size_t numTriangles = indices.size() / 3;
+		size_t liveTriangles = numTriangles;
+
+		// error quadrics and vertex to triangle adjacency
+		std::vector<glm::dmat4> quadrics(numVertices, glm::dmat4{0.0});
+		std::vector<std::vector<uint32_t>> vertexTriangles(numVertices);
+		for( uint32_t t = 0; t < numTriangles; ++t ) {
+			glm::dvec3 a{positions[indices[3*t]]}, b{positions[indices[3*t+1]]}, c{positions[indices[3*t+2]]};
+			glm::dvec3 n = glm::cross(b - a, c - a);
+			double area = glm::length(n);
+			if( area > 0.0 ) {
+				n /= area;
+				glm::dvec4 plane{ n, -glm::dot(n, a) };
+				glm::dmat4 q = glm::outerProduct(plane, plane) * area;
+				for( int k = 0; k < 3; ++k ) quadrics[indices[3*t+k]] += q;
+			}
+			for( int k = 0; k < 3; ++k ) vertexTriangles[indices[3*t+k]].push_back(t);
+		}
+
+		// lock vertices on seams (same position, different attributes) and on open borders
+		std::vector<uint8_t> locked(numVertices, 0);
+		std::map<std::tuple<float, float, float>, uint32_t> positionMap;
+		for( uint32_t v = 0; v < numVertices; ++v ) {
+			auto [it, inserted] = positionMap.insert({ {positions[v].x, positions[v].y, positions[v].z}, v });
+			if( !inserted ) locked[v] = locked[it->second] = 1;
+		}
+		std::unordered_map<uint64_t, uint32_t> edgeCount;
+		auto edgeKey = [](uint32_t a, uint32_t b) { return ((uint64_t)std::min(a, b) << 32) | std::max(a, b); };
+		for( size_t i = 0; i < indices.size(); ++i ) {
+			++edgeCount[ edgeKey(indices[i], indices[i - i % 3 + (i + 1) % 3]) ];
+		}
+		for( auto& [key, count] : edgeCount ) {
+			if( count == 1 ) locked[key >> 32] = locked[key & 0xffffffff] = 1;
+		}
+
+		// collapse candidates, entries become stale when the version of one of their vertices changes
+		struct Collapse {
+			double m_cost;
+			uint32_t m_from, m_to;
+			uint32_t m_versionFrom, m_versionTo;
+			bool operator>(const Collapse& other) const { return m_cost > other.m_cost; }
+		};
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+		std::vector<uint32_t> version(numVertices, 0);
+		std::vector<uint8_t> vertexRemoved(numVertices, 0);
+		std::vector<uint8_t> triangleRemoved(numTriangles, 0);
+
+		auto push = [&](uint32_t from, uint32_t to) {
+			if( locked[from] || from == to ) return;
+			glm::dvec4 p{ glm::dvec3{positions[to]}, 1.0 };
+			double cost = glm::dot(p, (quadrics[from] + quadrics[to]) * p);
+			heap.push({ cost, from, to, version[from], version[to] });
+		};
+		auto pushVertex = [&](uint32_t v) {
+			std::erase_if(vertexTriangles[v], [&](uint32_t t) { return triangleRemoved[t] != 0; });
+			for( auto t : vertexTriangles[v] ) {
+				for( int k = 0; k < 3; ++k ) {
+					push(v, indices[3*t+k]);
+					push(indices[3*t+k], v);
+				}
+			}
+		};
+		for( uint32_t v = 0; v < numVertices; ++v ) pushVertex(v);
+
+		auto contains = [&](uint32_t t, uint32_t v) { return indices[3*t] == v || indices[3*t+1] == v || indices[3*t+2] == v; };
+
+		while( liveTriangles > targetTriangles && !heap.empty() ) {
+			Collapse c = heap.top();
+			heap.pop();
+			if( vertexRemoved[c.m_from] || vertexRemoved[c.m_to] || version[c.m_from] != c.m_versionFrom || version[c.m_to] != c.m_versionTo ) continue;
+
+			// reject collapses that flip or degenerate a remaining triangle
+			bool valid = true;
+			for( auto t : vertexTriangles[c.m_from] ) {
+				if( triangleRemoved[t] || contains(t, c.m_to) ) continue;
+				std::array<glm::dvec3, 3> before, after;
+				for( int k = 0; k < 3; ++k ) {
+					uint32_t v = indices[3*t+k];
+					before[k] = glm::dvec3{positions[v]};
+					after[k] = glm::dvec3{positions[v == c.m_from ? c.m_to : v]};
+				}
+				glm::dvec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+				glm::dvec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+				if( glm::dot(n0, n1) <= 0.0 || glm::length(n1) < 1e-12 ) { valid = false; break; }
+			}
+			if( !valid ) continue;
+
+			for( auto t : vertexTriangles[c.m_from] ) {
+				if( triangleRemoved[t] ) continue;
+				if( contains(t, c.m_to) ) {
+					triangleRemoved[t] = 1;
+					--liveTriangles;
+					continue;
+				}
+				for( int k = 0; k < 3; ++k ) { if( indices[3*t+k] == c.m_from ) indices[3*t+k] = c.m_to; }
+				vertexTriangles[c.m_to].push_back(t);
+			}
+			quadrics[c.m_to] += quadrics[c.m_from];
+			vertexRemoved[c.m_from] = 1;
+			++version[c.m_from];
+			++version[c.m_to];
+			pushVertex(c.m_to);
+		}
+
+		// compact the remaining vertices
+		vvh::Mesh result{};
+		auto& src = mesh.m_verticesData;
+		auto& dst = result.m_verticesData;
+		std::vector<uint32_t> remap(numVertices, std::numeric_limits<uint32_t>::max());
+		uint32_t next = 0;
+		for( uint32_t t = 0; t < numTriangles; ++t ) {
+			if( triangleRemoved[t] ) continue;
+			for( int k = 0; k < 3; ++k ) {
+				uint32_t v = indices[3*t+k];
+				if( remap[v] == std::numeric_limits<uint32_t>::max() ) {
+					remap[v] = next++;
+					dst.m_positions.push_back(src.m_positions[v]);
+					if( !src.m_normals.empty() ) dst.m_normals.push_back(src.m_normals[v]);
+					if( !src.m_texCoords.empty() ) dst.m_texCoords.push_back(src.m_texCoords[v]);
+					if( !src.m_colors.empty() ) dst.m_colors.push_back(src.m_colors[v]);
+					if( !src.m_tangents.empty() ) dst.m_tangents.push_back(src.m_tangents[v]);
+				}
+				result.m_indices.push_back(remap[v]);
+			}
+		}
+		if( src.m_quantized ) {	//keep the bounds of the source, so objects keep their dequantization when the level changes
+			dst.m_quantized = true;
+			dst.m_boundsMin = src.m_boundsMin;
+			dst.m_boundsMax = src.m_boundsMax;
+		}
+		if( src.m_interleaved ) dst.interleave();
+		result.m_indexType = mesh.m_indexType;	//fewer vertices, the width still fits
+		return result;
+	}
+
+	/**
+	 * @brief Generate the coarser levels of a mesh. Each level is simplified from the previous one. Generation
+	 * stops when a level can not be reduced by at least 10%. Does not use the registry and can run on a worker thread.
+	 * @param mesh The full resolution mesh
+	 * @param levels Maximum number of coarser levels
+	 * @param minTriangles Meshes with fewer triangles get no levels
+	 * @return The coarser levels, level 1 first
+	 */
+	auto LevelOfDetail::GenerateLevels(const vvh::Mesh& mesh, uint32_t levels, size_t minTriangles) -> std::vector<vvh::Mesh> {
+		std::vector<vvh::Mesh> result;
+		size_t triangles = mesh.m_indices.size() / 3;
+		if( triangles < minTriangles || mesh.m_verticesData.m_positions.empty() ) return result;
+		result.reserve(levels);
+
+		const vvh::Mesh* current = &mesh;
+		for( uint32_t level = 1; level <= levels; ++level ) {
+			auto lod = Simplify(*current, triangles / 2);
+			size_t lodTriangles = lod.m_indices.size() / 3;
+			if( lodTriangles == 0 || lodTriangles * 10 > triangles * 9 ) break;
+			result.push_back(std::move(lod));
+			current = &result.back();		//reserved, the vector does not reallocate
+			triangles = lodTriangles;
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Tell the asset manager how many levels to generate for imported meshes. The asset manager is created
+	 * when the engine is initialized, after this system.
+	 * @param message Init message
+	 * @return false to continue message propagation
+	 */
+	bool LevelOfDetail::OnInit(Message message) {
+		auto assets = dynamic_cast<AssetManager*>(m_engine.GetSystem(m_engine.m_assetManagerName));
+		if( assets != nullptr ) assets->SetLevelsOfDetail((uint32_t)m_thresholds.size(), m_minTriangles);
+		return false;
+	}
+
+	/**
+	 * @brief Destroy the levels of detail of a destroyed mesh, e.g. when the asset manager evicts it. They are
+	 * created again with the mesh when it is reloaded.
+	 * @param message Mesh destroy message
+	 * @return false to continue message propagation
+	 */
+	bool LevelOfDetail::OnMeshDestroy(Message message) {
+		auto handle = message.template GetData<MsgMeshDestroy>().m_handle;
+		if( !m_registry.template Has<MeshLods>(handle()) ) return false;
+		auto levels = m_registry.template Get<MeshLods&>(handle())().m_levels; //copy, destroying meshes may move the component
+		for( size_t level = 1; level < levels.size(); ++level ) { m_engine.DestroyMesh(levels[level]); }
+		return false;
+	}
+
+	/**
+	 * @brief Select a level from the projected size. The level only changes if the size is outside the hysteresis
+	 * band around the thresholds of the current level.
+	 * @param size Projected size as fraction of the screen height
+	 * @param level Current level
+	 * @param numLevels Number of levels of the mesh
+	 * @return New level
+	 */
+	auto LevelOfDetail::SelectLevel(real_t size, uint32_t level, uint32_t numLevels) -> uint32_t {
+		level = std::min(level, numLevels - 1);
+		while( level + 1 < numLevels && size < m_thresholds[level] * (1 - m_hysteresis) ) ++level;
+		while( level > 0 && size > m_thresholds[level - 1] * (1 + m_hysteresis) ) --level;
+		return level;
+	}
+
+	/**
+	 * @brief Select the level of each object and switch its MeshHandle. Switched objects are touched in the change
+	 * tracker. Objects seen for the first time get a LodState and are switched in the next frame.
+	 * @param message Prepare next frame message
+	 * @return false to continue message propagation
+	 */
+	bool LevelOfDetail::OnPrepareNextFrame(Message message) {
+		auto view = m_registry.template GetView<vecs::Handle, Camera&, ViewMatrix&, ProjectionMatrix&>();
+		auto it = view.begin();
+		if( !(it != view.end()) ) return false;
+		auto [cHandle, camera, viewMatrix, projMatrix] = *it;
+		vec3_t cameraPos{ glm::inverse(viewMatrix())[3] };
+		real_t focal = projMatrix()[1][1];
+
+		m_stats.m_objects = m_stats.m_trianglesFull = m_stats.m_trianglesDrawn = 0;
+		std::fill(m_stats.m_objectsPerLevel.begin(), m_stats.m_objectsPerLevel.end(), 0);
+
+		std::vector<std::pair<vecs::Handle, MeshHandle>> newObjects;
+		for( auto [handle, mesh, LtoW] : m_registry.template GetView<vecs::Handle, MeshHandle&, LocalToWorldMatrix&>() ) {
+			if( !m_registry.template Has<LodState>(handle) ) {
+				if( m_registry.template Has<MeshLods>(mesh()) ) newObjects.push_back({handle, mesh()});
+				continue;
+			}
+
+			auto state = m_registry.template Get<LodState&>(handle);
+			auto& lods = m_registry.template Get<MeshLods&>(state().m_base)();
+			if( state().m_level >= lods.m_levels.size() || mesh()().GetValue() != lods.m_levels[state().m_level]().GetValue() ) {
+				if( m_registry.template Has<MeshLods>(mesh()) ) state() = LodState{mesh(), 0}; //mesh was replaced by someone else
+				continue;
+			}
+
+			uint32_t level = 0;
+			if( m_enabled ) {
+				vec3_t center{ LtoW() * vec4_t{lods.m_center, 1.0} };
+				real_t scale = std::max({ glm::length(vec3_t{LtoW()[0]}), glm::length(vec3_t{LtoW()[1]}), glm::length(vec3_t{LtoW()[2]}) });
+				real_t distance = glm::length(center - cameraPos);
+				real_t radius = lods.m_radius * scale;
+				real_t size = distance > radius ? radius * focal / distance : std::numeric_limits<real_t>::max();
+				level = SelectLevel(size, state().m_level, (uint32_t)lods.m_levels.size());
+			}
+			if( level != state().m_level ) {
+				state().m_level = level;
+				mesh() = lods.m_levels[level];
+				m_engine.GetChanges().Touch(handle);	//the renderers update the object buffer of changed objects only
+			}
+
+			++m_stats.m_objects;
+			m_stats.m_trianglesFull += lods.m_triangles[0];
+			m_stats.m_trianglesDrawn += lods.m_triangles[level];
+			++m_stats.m_objectsPerLevel[level];
+		}
+		for( auto& [handle, mesh] : newObjects ) { m_registry.Put(handle, LodState{mesh, 0}); }
+		return false;
+	}
+
+
+};  // namespace vve
+
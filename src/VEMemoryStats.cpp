@@ -0,0 +1,236 @@
+#include <fstream>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Add to an entry, the entry is created if it does not exist
+	 * @param entries The list to add to
+	 * @param name Name of the entry
+	 * @param count Number of items
+	 * @param bytes Number of bytes
+	 */
+	void MemoryReport::Add(std::vector<Entry>& entries, const std::string& name, size_t count, size_t bytes) {
+		auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.m_name == name; });
+		if( it == entries.end() ) { entries.push_back({name, count, bytes}); return; }
+		it->m_count += count;
+		it->m_bytes += bytes;
+	}
+
+	/**
+	 * @brief Find an entry
+	 * @param entries The list to search
+	 * @param name Name of the entry
+	 * @return The entry, or nullptr if there is none
+	 */
+	auto MemoryReport::Find(const std::vector<Entry>& entries, const std::string& name) -> const Entry* {
+		auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.m_name == name; });
+		return it != entries.end() ? &*it : nullptr;
+	}
+
+	/**
+	 * @brief Sum the bytes of a list
+	 * @param entries The list
+	 * @return Number of bytes
+	 */
+	auto MemoryReport::Total(const std::vector<Entry>& entries) -> size_t {
+		size_t bytes = 0;
+		for( auto& entry : entries ) { bytes += entry.m_bytes; }
+		return bytes;
+	}
+
+	/**
+	 * @brief Write the report as CSV with the columns category, name, count, bytes
+	 * @param file Path of the file
+	 * @return true if the file was written
+	 */
+	auto MemoryReport::Write(const std::filesystem::path& file) const -> bool {
+		std::ofstream out(file);
+		if( !out ) return false;
+		out << "category,name,count,bytes\n";
+		auto write = [&](const char* category, const std::vector<Entry>& entries) {
+			for( auto& entry : entries ) { out << category << ",\"" << entry.m_name << "\"," << entry.m_count << "," << entry.m_bytes << "\n"; }
+		};
+		write("component", m_components);
+		write("asset", m_assets);
+		write("system", m_systems);
+		return out.good();
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the MemoryStats class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 * @param showWindow Show the report in an ImGui window
+	 * @param refreshFrames The window collects a new report every this many frames
+	 */
+    MemoryStats::MemoryStats(std::string systemName, Engine& engine, bool showWindow, uint32_t refreshFrames)
+		: System{systemName, engine }, m_showWindow{showWindow}, m_refreshFrames{std::max(refreshFrames, 1u)} {
+		engine.RegisterCallbacks( {
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the MemoryStats class
+	 */
+    MemoryStats::~MemoryStats() {}
+
+	/**
+	 * @brief Add the components of a type to a report
+	 * @tparam T Component type
+	 * @param report The report
+	 * @param name Name of the component type
+	 * @param heap Returns the heap memory owned by a component
+	 */
+	template<typename T>
+	void MemoryStats::CountComponents(MemoryReport& report, const std::string& name, auto heap) {
+		size_t count = 0, bytes = 0;
+		for( auto [handle, component] : m_registry.template GetView<vecs::Handle, T&>() ) {
+			++count;
+			bytes += sizeof(T) + heap(component());
+		}
+		if( count > 0 ) MemoryReport::Add(report.m_components, name, count, bytes);
+	}
+
+	/**
+	 * @brief Add the components of a type that owns no heap memory to a report
+	 * @tparam T Component type
+	 * @param report The report
+	 * @param name Name of the component type
+	 */
+	template<typename T>
+	void MemoryStats::CountComponents(MemoryReport& report, const std::string& name) {
+		CountComponents<T>(report, name, [](auto& component) -> size_t { return 0; });
+	}
+
+	/**
+	 * @brief Collect the memory currently in use
+	 * @return The report
+	 */
+	auto MemoryStats::Collect() -> MemoryReport {
+		MemoryReport report;
+		auto string = [](auto& str) -> size_t { return MemoryReport::StringBytes(str); };
+		auto vector = [](auto& vec) -> size_t { return MemoryReport::VectorBytes(vec); };
+		auto vertices = [](vvh::VertexData& data) -> size_t {
+			return MemoryReport::VectorBytes(data.m_positions) + MemoryReport::VectorBytes(data.m_normals) + MemoryReport::VectorBytes(data.m_texCoords)
+				+ MemoryReport::VectorBytes(data.m_colors) + MemoryReport::VectorBytes(data.m_tangents);
+		};
+		auto pixels = [](vvh::Image& image) -> size_t { return image.m_pixels != nullptr ? (size_t)image.m_size : 0; };
+
+		//names and hierarchy
+		CountComponents<Name>(report, "Name", string);
+		CountComponents<MeshName>(report, "MeshName", string);
+		CountComponents<TextureName>(report, "TextureName", string);
+		CountComponents<ParentHandle>(report, "ParentHandle");
+		CountComponents<Children>(report, "Children", vector);
+
+		//transforms
+		CountComponents<Position>(report, "Position");
+		CountComponents<Rotation>(report, "Rotation");
+		CountComponents<Scale>(report, "Scale");
+		CountComponents<UVScale>(report, "UVScale");
+		CountComponents<LocalToParentMatrix>(report, "LocalToParentMatrix");
+		CountComponents<LocalToWorldMatrix>(report, "LocalToWorldMatrix");
+		CountComponents<ViewMatrix>(report, "ViewMatrix");
+		CountComponents<ProjectionMatrix>(report, "ProjectionMatrix");
+
+		//rendering
+		CountComponents<MeshHandle>(report, "MeshHandle");
+		CountComponents<TextureHandle>(report, "TextureHandle");
+		CountComponents<vvh::Color>(report, "vvh::Color");
+		CountComponents<vvh::Material>(report, "vvh::Material");
+		CountComponents<vvh::Mesh>(report, "vvh::Mesh", [&](vvh::Mesh& mesh) { return vertices(mesh.m_verticesData) + vector(mesh.m_indices); });
+		CountComponents<vvh::Image>(report, "vvh::Image", pixels);
+		CountComponents<vvh::Buffer>(report, "vvh::Buffer", [&](vvh::Buffer& buffer) {
+			return vector(buffer.m_uniformBuffers) + vector(buffer.m_uniformBuffersAllocation) + vector(buffer.m_uniformBuffersMapped);
+		});
+		CountComponents<vvh::DescriptorSet>(report, "vvh::DescriptorSet", [&](vvh::DescriptorSet& set) { return vector(set.m_descriptorSetPerFrameInFlight); });
+		CountComponents<Camera>(report, "Camera");
+		CountComponents<PointLight>(report, "PointLight");
+		CountComponents<DirectionalLight>(report, "DirectionalLight");
+		CountComponents<SpotLight>(report, "SpotLight");
+
+		//culling, level of detail and views
+		CountComponents<Hidden>(report, "Hidden");
+		CountComponents<Occluder>(report, "Occluder");
+		CountComponents<Occluded>(report, "Occluded");
+		CountComponents<ViewMask>(report, "ViewMask");
+		CountComponents<PortalCellId>(report, "PortalCellId");
+		CountComponents<PortalVisibility>(report, "PortalVisibility", [&](PortalVisibility& visibility) { return vector(visibility.m_visibleCells); });
+		CountComponents<BoundingBox>(report, "BoundingBox");
+		CountComponents<MeshLods>(report, "MeshLods", [&](MeshLods& lods) { return vector(lods.m_levels) + vector(lods.m_triangles); });
+		CountComponents<LodState>(report, "LodState");
+		CountComponents<Impostor>(report, "Impostor");
+		CountComponents<ImpostorAtlas>(report, "ImpostorAtlas", [&](ImpostorAtlas& atlas) {
+			size_t bytes = vector(atlas.m_pixels) + vector(atlas.m_hulls);
+			for( auto& hull : atlas.m_hulls ) { bytes += vector(hull); }
+			return bytes;
+		});
+		CountComponents<RenderView>(report, "RenderView", [&](RenderView& view) { return string(view.m_name); });
+
+		//assets
+		for( auto [handle, mesh] : m_registry.template GetView<vecs::Handle, vvh::Mesh&>() ) {
+			MemoryReport::Add(report.m_assets, "Mesh vertices", 1, vertices(mesh().m_verticesData));
+			MemoryReport::Add(report.m_assets, "Mesh indices", 1, vector(mesh().m_indices));
+		}
+		for( auto [handle, image] : m_registry.template GetView<vecs::Handle, vvh::Image&>() ) {
+			if( image().m_pixels != nullptr ) MemoryReport::Add(report.m_assets, "Texture pixels", 1, pixels(image()));
+		}
+		for( auto [handle, atlas] : m_registry.template GetView<vecs::Handle, ImpostorAtlas&>() ) {
+			MemoryReport::Add(report.m_assets, "Impostor atlas pixels", 1, vector(atlas().m_pixels));
+		}
+
+		//systems add their own memory
+		m_engine.SendMsg( MsgMemoryReport{&report} );
+		return report;
+	}
+
+	/**
+	 * @brief Collect a report and write it to a file
+	 * @param file Path of the file
+	 * @return true if the file was written
+	 */
+	auto MemoryStats::Dump(const std::filesystem::path& file) -> bool {
+		m_report = Collect();
+		return m_report.Write(file);
+	}
+
+	/**
+	 * @brief Show the last report in an ImGui window
+	 * @param message Record next frame message
+	 * @return false to continue message propagation
+	 */
+	bool MemoryStats::OnRecordNextFrame(Message message) {
+		if( !m_showWindow ) return false;
+		if( m_frame++ % m_refreshFrames == 0 ) m_report = Collect();
+
+		auto table = [](const char* title, const std::vector<MemoryReport::Entry>& entries) {
+			if( !ImGui::CollapsingHeader(title, ImGuiTreeNodeFlags_DefaultOpen) ) return;
+			ImGui::Text("Total %.1f KiB", MemoryReport::Total(entries) / 1024.0);
+			for( auto& entry : entries ) {
+				ImGui::Text("%-28s %8zu %10.1f KiB", entry.m_name.c_str(), entry.m_count, entry.m_bytes / 1024.0);
+			}
+		};
+
+		ImGui::Begin("Memory");
+		table("Components", m_report.m_components);
+		table("Assets", m_report.m_assets);
+		table("Systems", m_report.m_systems);
+		char file[256];
+		std::snprintf(file, sizeof(file), "%s", m_dumpFile.c_str());
+		if( ImGui::InputText("File", file, sizeof(file)) ) m_dumpFile = file;
+		if( ImGui::Button("Dump") ) Dump(m_dumpFile);
+		ImGui::End();
+		return false;
+	}
+
+};  // namespace vve
+
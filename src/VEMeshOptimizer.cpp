@@ -0,0 +1,264 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+	// Vertex cache
+
+	static const uint32_t c_maxValence = 32;	//valences above this get the same score
+
+	/**
+	 * @brief Score of a vertex in Forsyth's algorithm: vertices in the cache score high, the three of the last
+	 * triangle a bit lower so strips do not flip back. Vertices with few remaining triangles are boosted, so no
+	 * lone triangles are left behind.
+	 * @param cachePosition Position in the LRU cache, -1 if the vertex is not in the cache
+	 * @param liveTriangles Number of triangles of the vertex that are not emitted yet
+	 * @return The score, -1 if the vertex has no triangles left
+	 */
+	static auto VertexScore(int32_t cachePosition, uint32_t liveTriangles) -> float {
+		static const auto tables = [] {
+			std::pair<std::array<float, MeshOptimizer::c_cacheSize>, std::array<float, c_maxValence + 1>> tables{};
+			for( uint32_t i = 0; i < MeshOptimizer::c_cacheSize; ++i ) {
+				tables.first[i] = i < 3 ? 0.75f : std::pow(1.0f - (float)(i - 3) / (MeshOptimizer::c_cacheSize - 3), 1.5f);
+			}
+			for( uint32_t i = 1; i <= c_maxValence; ++i ) { tables.second[i] = 2.0f / std::sqrt((float)i); }
+			return tables;
+		}();
+		if( liveTriangles == 0 ) return -1.0f;
+		float score = cachePosition >= 0 ? tables.first[cachePosition] : 0.0f;
+		return score + tables.second[std::min(liveTriangles, c_maxValence)];
+	}
+
+	/**
+	 * @brief Reorder triangles with Forsyth's linear speed vertex cache optimization. An LRU cache is simulated,
+	 * the next triangle is the best scoring one that uses a vertex in the cache. If there is none, the first
+	 * triangle not emitted yet is taken.
+	 * @param indices Triangle list, reordered in place
+	 * @param vertexCount Number of vertices
+	 */
+	void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+		size_t triangleCount = indices.size() / 3;
+		if( triangleCount < 2 ) return;
+
+		std::vector<uint32_t> live(vertexCount, 0);
+		for( auto index : indices ) { ++live[index]; }
+		std::vector<uint32_t> offsets(vertexCount + 1, 0);
+		for( size_t v = 0; v < vertexCount; ++v ) { offsets[v + 1] = offsets[v] + live[v]; }
+		std::vector<uint32_t> adjacency(indices.size());
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for( size_t i = 0; i < triangleCount * 3; ++i ) { adjacency[fill[indices[i]]++] = (uint32_t)(i / 3); }
+
+		std::vector<int32_t> cachePosition(vertexCount, -1);
+		std::vector<float> score(vertexCount);
+		for( size_t v = 0; v < vertexCount; ++v ) { score[v] = VertexScore(-1, live[v]); }
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> result;
+		result.reserve(triangleCount * 3);
+		std::vector<uint32_t> cache, newCache;
+
+		size_t cursor = 0;
+		int64_t best = -1;
+		for( size_t n = 0; n < triangleCount; ++n ) {
+			if( best < 0 ) {
+				while( emitted[cursor] ) ++cursor;
+				best = (int64_t)cursor;
+			}
+			emitted[best] = true;
+			const uint32_t* triangle = &indices[3 * best];
+			result.insert(result.end(), triangle, triangle + 3);
+
+			newCache.clear();
+			for( int k = 0; k < 3; ++k ) {
+				uint32_t v = triangle[k];
+				if( std::ranges::find(newCache, v) == newCache.end() ) newCache.push_back(v);
+				auto begin = adjacency.begin() + offsets[v], end = begin + live[v];
+				auto it = std::find(begin, end, (uint32_t)best);
+				if( it != end ) { std::iter_swap(it, end - 1); --live[v]; }
+			}
+			auto fresh = newCache.size();
+			for( auto v : cache ) {
+				if( std::find(newCache.begin(), newCache.begin() + fresh, v) == newCache.begin() + fresh ) newCache.push_back(v);
+			}
+			for( size_t i = c_cacheSize; i < newCache.size(); ++i ) {
+				cachePosition[newCache[i]] = -1;
+				score[newCache[i]] = VertexScore(-1, live[newCache[i]]);
+			}
+			newCache.resize(std::min<size_t>(newCache.size(), c_cacheSize));
+			for( size_t i = 0; i < newCache.size(); ++i ) {
+				cachePosition[newCache[i]] = (int32_t)i;
+				score[newCache[i]] = VertexScore((int32_t)i, live[newCache[i]]);
+			}
+
+			best = -1;
+			float bestScore = -1.0f;
+			for( auto v : newCache ) {
+				for( uint32_t i = offsets[v]; i < offsets[v] + live[v]; ++i ) {
+					uint32_t t = adjacency[i];
+					float s = score[indices[3 * t]] + score[indices[3 * t + 1]] + score[indices[3 * t + 2]];
+					if( s > bestScore ) { bestScore = s; best = t; }
+				}
+			}
+			std::swap(cache, newCache);
+		}
+		indices = std::move(result);
+	}
+
+	//-------------------------------------------------------------------------------------------------------
+	// Overdraw
+
+	/**
+	 * @brief Reorder clusters of triangles in vertex cache order to reduce overdraw, after Sander et al., "Fast
+	 * Triangle Reordering for Vertex Locality and Reduced Overdraw". A hard boundary is a triangle whose three
+	 * vertices all miss the cache, there the cache order started over. Within a hard cluster, a soft boundary is
+	 * placed as soon as the ACMR since the last boundary, including the misses of a cold cache, falls below the
+	 * threshold times the ACMR of the cluster. Clusters are sorted by how much they face away from the center of
+	 * the mesh, those facing outwards first.
+	 * @param indices Triangle list in vertex cache order, reordered in place
+	 * @param positions Positions of the vertices
+	 * @param threshold Allowed loss of cache efficiency, e.g. 1.05 allows the ACMR to grow by 5%
+	 */
+	void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold) {
+		size_t triangleCount = indices.size() / 3;
+		if( triangleCount < 2 ) return;
+
+		std::vector<uint32_t> timestamps(positions.size(), 0);
+		uint32_t time = c_cacheSize + 1;
+		auto misses = [&](size_t t) {
+			uint32_t count = 0;
+			for( int k = 0; k < 3; ++k ) {
+				uint32_t v = indices[3 * t + k];
+				if( time - timestamps[v] > c_cacheSize ) { timestamps[v] = time++; ++count; }
+			}
+			return count;
+		};
+		auto flush = [&]() { time += c_cacheSize + 1; };
+
+		std::vector<size_t> hard;
+		for( size_t t = 0; t < triangleCount; ++t ) {
+			if( misses(t) == 3 || t == 0 ) hard.push_back(t);
+		}
+		hard.push_back(triangleCount);
+
+		std::vector<size_t> clusters;
+		for( size_t c = 0; c + 1 < hard.size(); ++c ) {
+			size_t begin = hard[c], end = hard[c + 1];
+			flush();
+			size_t clusterMisses = 0;
+			for( size_t t = begin; t < end; ++t ) clusterMisses += misses(t);
+			float limit = threshold * (float)clusterMisses / (float)(end - begin);
+
+			flush();
+			clusters.push_back(begin);
+			size_t runningMisses = 0, runningTriangles = 0;
+			for( size_t t = begin; t < end; ++t ) {
+				runningMisses += misses(t);
+				++runningTriangles;
+				if( t + 1 < end && (float)runningMisses <= limit * (float)runningTriangles ) {
+					clusters.push_back(t + 1);
+					flush();
+					runningMisses = runningTriangles = 0;
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+		if( clusters.size() <= 2 ) return;
+
+		glm::vec3 meshCenter{0.0f};
+		float meshArea = 0.0f;
+		struct Cluster { size_t m_begin, m_end; float m_sort; };
+		std::vector<Cluster> sorted;
+		std::vector<std::pair<glm::vec3, glm::vec3>> centers;	//area weighted center and normal of each cluster
+		for( size_t c = 0; c + 1 < clusters.size(); ++c ) {
+			glm::vec3 center{0.0f}, normal{0.0f};
+			float area = 0.0f;
+			for( size_t t = clusters[c]; t < clusters[c + 1]; ++t ) {
+				glm::vec3 a = positions[indices[3 * t]], b = positions[indices[3 * t + 1]], d = positions[indices[3 * t + 2]];
+				glm::vec3 n = glm::cross(b - a, d - a);
+				float weight = glm::length(n);
+				center += weight * (a + b + d) / 3.0f;
+				normal += n;
+				area += weight;
+			}
+			meshCenter += center;
+			meshArea += area;
+			centers.push_back({ area > 0.0f ? center / area : positions[indices[3 * clusters[c]]], glm::length(normal) > 0.0f ? glm::normalize(normal) : normal });
+			sorted.push_back({ clusters[c], clusters[c + 1], 0.0f });
+		}
+		if( meshArea > 0.0f ) meshCenter /= meshArea;
+		for( size_t c = 0; c < sorted.size(); ++c ) { sorted[c].m_sort = glm::dot(centers[c].first - meshCenter, centers[c].second); }
+		std::ranges::stable_sort(sorted, [](auto& a, auto& b) { return a.m_sort > b.m_sort; });
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		for( auto& cluster : sorted ) {
+			result.insert(result.end(), indices.begin() + 3 * cluster.m_begin, indices.begin() + 3 * cluster.m_end);
+		}
+		indices = std::move(result);
+	}
+
+	//-------------------------------------------------------------------------------------------------------
+	// Vertex fetch
+
+	/**
+	 * @brief Renumber the vertices in the order the indices use them and drop unused vertices. All vertex streams
+	 * that have one entry per vertex are reordered.
+	 * @param mesh The mesh, its indices and vertex streams are changed
+	 */
+	void MeshOptimizer::OptimizeVertexFetch(vvh::Mesh& mesh) {
+		auto& vertices = mesh.m_verticesData;
+		size_t vertexCount = vertices.m_positions.size();
+		std::vector<uint32_t> remap(vertexCount, std::numeric_limits<uint32_t>::max());
+		uint32_t next = 0;
+		for( auto& index : mesh.m_indices ) {
+			if( remap[index] == std::numeric_limits<uint32_t>::max() ) remap[index] = next++;
+			index = remap[index];
+		}
+
+		auto reorder = [&](auto& stream) {
+			if( stream.size() != vertexCount ) return;
+			std::remove_reference_t<decltype(stream)> result(next);
+			for( size_t v = 0; v < vertexCount; ++v ) {
+				if( remap[v] != std::numeric_limits<uint32_t>::max() ) result[remap[v]] = stream[v];
+			}
+			stream = std::move(result);
+		};
+		reorder(vertices.m_positions);
+		reorder(vertices.m_normals);
+		reorder(vertices.m_texCoords);
+		reorder(vertices.m_colors);
+		reorder(vertices.m_tangents);
+	}
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Run all passes on a mesh: vertex cache, overdraw, then vertex fetch, which keeps the triangle order
+	 * @param mesh The mesh, its indices and vertex streams are changed
+	 */
+	void MeshOptimizer::Optimize(vvh::Mesh& mesh) {
+		OptimizeVertexCache(mesh.m_indices, mesh.m_verticesData.m_positions.size());
+		OptimizeOverdraw(mesh.m_indices, mesh.m_verticesData.m_positions);
+		OptimizeVertexFetch(mesh);
+	}
+
+	/**
+	 * @brief Simulate a FIFO post transform cache. A vertex hits if it was loaded within the last cacheSize misses.
+	 * @param indices Triangle list
+	 * @param vertexCount Number of vertices
+	 * @param cacheSize Number of cache entries
+	 * @return Triangles, referenced vertices and cache misses
+	 */
+	auto MeshOptimizer::Analyze(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) -> MeshStats {
+		MeshStats stats{ indices.size() / 3, 0, 0 };
+		std::vector<uint32_t> timestamps(vertexCount, 0);
+		uint32_t time = cacheSize + 1;
+		for( auto index : indices ) {
+			if( timestamps[index] == 0 ) ++stats.m_vertices;
+			if( time - timestamps[index] > cacheSize ) { timestamps[index] = time++; ++stats.m_transformed; }
+		}
+		return stats;
+	}
+
+};  // namespace vve
+
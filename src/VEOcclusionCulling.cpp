@@ -0,0 +1,413 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Occlusion buffer
+
+	/**
+	 * @brief Constructor for the OcclusionBuffer class
+	 * @param width Width in pixels, rounded up to a multiple of the tile size
+	 * @param height Height in pixels, rounded up to a multiple of the tile size
+	 * @param jobPool Threads for rasterizing and testing, nullptr runs everything on the calling thread
+	 */
+	OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height, JobPool* jobPool) : m_jobPool{jobPool} {
+		m_tilesX = (width + c_tileSize - 1) / c_tileSize;
+		m_tilesY = (height + c_tileSize - 1) / c_tileSize;
+		m_width = m_tilesX * c_tileSize;
+		m_height = m_tilesY * c_tileSize;
+		m_tiles.resize(m_tilesX * m_tilesY);
+		Clear();
+	}
+
+	/**
+	 * @brief Reset all tiles to the far plane with an empty working layer
+	 */
+	void OcclusionBuffer::Clear() {
+		std::fill(m_tiles.begin(), m_tiles.end(), Tile{ 0, 0.0f, 1.0f });
+	}
+
+	/**
+	 * @brief Split a range into one chunk per thread and run them on the job pool
+	 * @param count Size of the range
+	 * @param func Function called with the begin and end of each chunk
+	 */
+	void OcclusionBuffer::ParallelFor(size_t count, const std::function<void(size_t, size_t)>& func) {
+		if( m_jobPool == nullptr || m_jobPool->GetNumThreads() <= 1 ) {
+			if( count > 0 ) func(0, count);
+			return;
+		}
+		m_jobPool->ParallelFor(count, (count + m_jobPool->GetNumThreads() - 1) / m_jobPool->GetNumThreads(), func);
+	}
+
+	/**
+	 * @brief Rasterize occluders into the buffer. Triangles crossing the near plane are skipped, which is
+	 * conservative since it only removes occlusion.
+	 * @param occluders The occluder meshes
+	 * @return Number of triangles rasterized
+	 */
+	auto OcclusionBuffer::Rasterize(std::span<const OccluderMesh> occluders) -> size_t {
+		std::vector<std::vector<Triangle>> transformed(occluders.size());
+		ParallelFor(occluders.size(), [&](size_t begin, size_t end) {
+			std::vector<glm::vec4> clip;
+			for( size_t i = begin; i < end; ++i ) {
+				auto& occluder = occluders[i];
+				clip.resize(occluder.m_positions->size());
+				for( size_t v = 0; v < clip.size(); ++v ) {
+					clip[v] = glm::vec4{ occluder.m_modelViewProj * vec4_t{ vec3_t{(*occluder.m_positions)[v]}, 1.0 } };
+				}
+
+				auto& indices = *occluder.m_indices;
+				transformed[i].reserve(indices.size() / 3);
+				for( size_t t = 0; t + 2 < indices.size(); t += 3 ) {
+					Triangle tri;
+					bool front = true;
+					for( int k = 0; k < 3; ++k ) {
+						auto& c = clip[indices[t + k]];
+						if( c.w <= 1e-5f ) { front = false; break; }
+						tri.m_v[k] = glm::vec3{ (c.x / c.w * 0.5f + 0.5f) * m_width, (c.y / c.w * 0.5f + 0.5f) * m_height, c.z / c.w };
+					}
+					if( front ) transformed[i].push_back(tri);
+				}
+			}
+		});
+
+		m_triangles.clear();
+		for( auto& triangles : transformed ) { m_triangles.insert(m_triangles.end(), triangles.begin(), triangles.end()); }
+
+		ParallelFor(m_tilesY, [&](size_t begin, size_t end) {
+			RasterizeBand(m_triangles, (int)begin * c_tileSize, (int)end * c_tileSize);
+		});
+		return m_triangles.size();
+	}
+
+	/**
+	 * @brief Merge the coverage of a triangle into a tile. Pixels in the mask are bounded by the working depth, all
+	 * others by the reference depth, which is never nearer than the working depth. A triangle that is closer to the
+	 * reference layer than to the working layer starts a new working layer, which keeps the working depth tight.
+	 * Dropping the working layer only makes the buffer more conservative.
+	 * @param tile The tile
+	 * @param mask Pixels of the tile covered by the triangle
+	 * @param z Farthest depth of the triangle in the tile
+	 */
+	void OcclusionBuffer::Merge(Tile& tile, uint64_t mask, float z) {
+		if( z >= tile.m_zRef ) return;
+		if( mask == ~0ull ) {
+			tile.m_zRef = z;
+			if( tile.m_zWork >= z ) tile.m_mask = 0;
+			return;
+		}
+		if( tile.m_mask != 0 && z - tile.m_zWork > tile.m_zRef - z ) tile.m_mask = 0;
+		tile.m_zWork = tile.m_mask == 0 ? z : std::max(tile.m_zWork, z);
+		tile.m_mask |= mask;
+		if( tile.m_mask == ~0ull ) {
+			tile.m_zRef = tile.m_zWork;
+			tile.m_mask = 0;
+		}
+	}
+
+	/**
+	 * @brief Get the mask of a pixel rectangle inside a tile
+	 * @param x0 First column in the tile
+	 * @param x1 Last column in the tile
+	 * @param y0 First row in the tile
+	 * @param y1 Last row in the tile
+	 * @return Mask with the bits of the rectangle set
+	 */
+	auto OcclusionBuffer::RectMask(int x0, int x1, int y0, int y1) -> uint64_t {
+		uint64_t row = ((1ull << (x1 - x0 + 1)) - 1) << x0;
+		uint64_t mask = 0;
+		for( int y = y0; y <= y1; ++y ) { mask |= row << (y * c_tileSize); }
+		return mask;
+	}
+
+	/**
+	 * @brief Rasterize triangles into a horizontal band of tile rows. Bands do not overlap, so the threads do not
+	 * need to synchronize. Pixels are covered if their center is inside the triangle. For each pixel row the edge
+	 * functions are solved for the covered span, and the spans of a tile are turned into its mask with shifts.
+	 * The depth of the triangle in a tile is the farthest depth of its plane at the tile corners.
+	 * @param triangles Triangles in screen space
+	 * @param y0 First pixel row of the band
+	 * @param y1 One past the last pixel row of the band
+	 */
+	void OcclusionBuffer::RasterizeBand(std::span<const Triangle> triangles, int y0, int y1) {
+		for( auto& tri : triangles ) {
+			glm::vec3 v0 = tri.m_v[0], v1 = tri.m_v[1], v2 = tri.m_v[2];
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+			if( std::abs(area) < 1e-8f ) continue;
+			if( area < 0.0f ) { std::swap(v1, v2); area = -area; }
+
+			int minX = std::max(0, (int)std::floor(std::min({v0.x, v1.x, v2.x})));
+			int maxX = std::min((int)m_width - 1, (int)std::ceil(std::max({v0.x, v1.x, v2.x})));
+			int minY = std::max(y0, (int)std::floor(std::min({v0.y, v1.y, v2.y})));
+			int maxY = std::min(y1 - 1, (int)std::ceil(std::max({v0.y, v1.y, v2.y})));
+			if( minX > maxX || minY > maxY ) continue;
+
+			// edge functions E = a*x + b*y + c, positive inside, and the depth plane
+			auto edge = [](const glm::vec3& p, const glm::vec3& q) { return glm::vec3{ p.y - q.y, q.x - p.x, (q.y - p.y) * p.x - (q.x - p.x) * p.y }; };
+			std::array<glm::vec3, 3> edges{ edge(v1, v2) / area, edge(v2, v0) / area, edge(v0, v1) / area };
+			glm::vec3 ez = edges[0] * v0.z + edges[1] * v1.z + edges[2] * v2.z;
+			float zMax = std::max({v0.z, v1.z, v2.z});
+
+			for( int ty = minY / c_tileSize; ty <= maxY / c_tileSize; ++ty ) {
+				std::array<int, c_tileSize> spanX0, spanX1;		//covered pixels of each row, empty if x0 > x1
+				for( int r = 0; r < c_tileSize; ++r ) {
+					int y = ty * c_tileSize + r;
+					float py = y + 0.5f, lo = std::numeric_limits<float>::lowest(), hi = std::numeric_limits<float>::max();
+					for( auto& e : edges ) {
+						float c = e.y * py + e.z;
+						if( e.x > 0.0f ) lo = std::max(lo, -c / e.x);
+						else if( e.x < 0.0f ) hi = std::min(hi, -c / e.x);
+						else if( c < 0.0f ) { lo = 1.0f; hi = 0.0f; }
+					}
+					bool inside = y >= minY && y <= maxY && lo <= hi;
+					spanX0[r] = inside ? (int)std::max((float)minX, std::ceil(lo - 0.5f)) : 1;
+					spanX1[r] = inside ? (int)std::min((float)maxX, std::floor(hi - 0.5f)) : 0;
+				}
+
+				for( int tx = minX / c_tileSize; tx <= maxX / c_tileSize; ++tx ) {
+					int left = tx * c_tileSize;
+					uint64_t mask = 0;
+					for( int r = 0; r < c_tileSize; ++r ) {
+						int x0 = std::max(spanX0[r], left), x1 = std::min(spanX1[r], left + c_tileSize - 1);
+						if( x0 <= x1 ) mask |= (((1ull << (x1 - x0 + 1)) - 1) << (x0 - left)) << (r * c_tileSize);
+					}
+					if( mask == 0 ) continue;
+
+					float zCorner = std::numeric_limits<float>::lowest();
+					for( int corner = 0; corner < 4; ++corner ) {
+						float x = (float)(left + (corner & 1) * c_tileSize), y = (float)((ty + (corner >> 1)) * c_tileSize);
+						zCorner = std::max(zCorner, ez.x * x + ez.y * y + ez.z);
+					}
+					Merge(m_tiles[ty * m_tilesX + tx], mask, std::min(zMax, zCorner));
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief Project a box to the screen
+	 * @param box The box
+	 * @param rect Resulting pixel rectangle and nearest depth
+	 * @return False if the box crosses the near plane or is off screen
+	 */
+	auto OcclusionBuffer::ProjectBox(const TestBox& box, ScreenRect& rect) -> bool {
+		glm::vec2 lo{ std::numeric_limits<float>::max() };
+		glm::vec2 hi{ std::numeric_limits<float>::lowest() };
+		rect.m_minDepth = std::numeric_limits<float>::max();
+		for( int i = 0; i < 8; ++i ) {
+			vec3_t corner{ i & 1 ? box.m_bounds.m_max.x : box.m_bounds.m_min.x,
+						   i & 2 ? box.m_bounds.m_max.y : box.m_bounds.m_min.y,
+						   i & 4 ? box.m_bounds.m_max.z : box.m_bounds.m_min.z };
+			glm::vec4 c{ box.m_modelViewProj * vec4_t{corner, 1.0} };
+			if( c.w <= 1e-5f ) return false;
+			glm::vec2 p{ (c.x / c.w * 0.5f + 0.5f) * m_width, (c.y / c.w * 0.5f + 0.5f) * m_height };
+			lo = glm::min(lo, p);
+			hi = glm::max(hi, p);
+			rect.m_minDepth = std::min(rect.m_minDepth, c.z / c.w);
+		}
+		rect.m_x0 = std::max(0, (int)std::floor(lo.x));
+		rect.m_y0 = std::max(0, (int)std::floor(lo.y));
+		rect.m_x1 = std::min((int)m_width - 1, (int)std::floor(hi.x));
+		rect.m_y1 = std::min((int)m_height - 1, (int)std::floor(hi.y));
+		return rect.m_x0 <= rect.m_x1 && rect.m_y0 <= rect.m_y1;
+	}
+
+	/**
+	 * @brief Test a single box against the buffer. Tiles whose reference depth is in front of the box are skipped
+	 * without looking at their masks. Otherwise the box is visible if it covers pixels outside the working layer,
+	 * or if the working layer is not in front of it.
+	 * @param box The box
+	 * @return True if the box may be visible, false if it is occluded
+	 */
+	auto OcclusionBuffer::IsVisible(const TestBox& box) -> bool {
+		ScreenRect rect;
+		if( !ProjectBox(box, rect) ) return true;
+
+		for( int ty = rect.m_y0 / c_tileSize; ty <= rect.m_y1 / c_tileSize; ++ty ) {
+			for( int tx = rect.m_x0 / c_tileSize; tx <= rect.m_x1 / c_tileSize; ++tx ) {
+				const Tile& tile = m_tiles[ty * m_tilesX + tx];
+				if( tile.m_zRef < rect.m_minDepth ) continue;
+
+				int top = ty * c_tileSize, left = tx * c_tileSize;
+				uint64_t mask = RectMask(std::max(rect.m_x0, left) - left, std::min(rect.m_x1, left + c_tileSize - 1) - left,
+										 std::max(rect.m_y0, top) - top, std::min(rect.m_y1, top + c_tileSize - 1) - top);
+				if( (mask & ~tile.m_mask) != 0 || tile.m_zWork >= rect.m_minDepth ) return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Test boxes against the buffer in parallel
+	 * @param boxes The boxes
+	 * @param visible Result per box, 1 if the box may be visible, 0 if it is occluded
+	 */
+	void OcclusionBuffer::Test(std::span<const TestBox> boxes, std::span<uint8_t> visible) {
+		assert( visible.size() >= boxes.size() );
+		ParallelFor(boxes.size(), [&](size_t begin, size_t end) {
+			for( size_t i = begin; i < end; ++i ) { visible[i] = IsVisible(boxes[i]) ? 1 : 0; }
+		});
+	}
+
+	/**
+	 * @brief Get the depth bound of each pixel, e.g. for debug display
+	 * @return Working depth for pixels in the mask of their tile, reference depth for the others, row by row
+	 */
+	auto OcclusionBuffer::GetDepth() -> std::vector<float> {
+		std::vector<float> depth(m_width * m_height);
+		for( uint32_t y = 0; y < m_height; ++y ) {
+			for( uint32_t x = 0; x < m_width; ++x ) {
+				const Tile& tile = m_tiles[(y / c_tileSize) * m_tilesX + x / c_tileSize];
+				bool covered = (tile.m_mask >> ((y % c_tileSize) * c_tileSize + x % c_tileSize)) & 1;
+				depth[y * m_width + x] = covered ? tile.m_zWork : tile.m_zRef;
+			}
+		}
+		return depth;
+	}
+
+	/**
+	 * @brief Get the fraction of the screen covered by the screen rectangle of a box
+	 * @param box The box
+	 * @return Covered fraction of the screen, 0 if the box crosses the near plane
+	 */
+	auto OcclusionBuffer::ScreenCoverage(const TestBox& box) -> real_t {
+		ScreenRect rect;
+		if( !ProjectBox(box, rect) ) return 0.0;
+		return (real_t)(rect.m_x1 - rect.m_x0 + 1) * (rect.m_y1 - rect.m_y0 + 1) / (m_width * m_height);
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Occlusion culling system
+
+	/**
+	 * @brief Constructor for the OcclusionCulling class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 * @param width Width of the depth buffer
+	 * @param height Height of the depth buffer
+	 * @param occluderCoverage Objects covering at least this fraction of the screen become occluders
+	 * @param maxOccluders Maximum number of occluders per frame, the largest are used
+	 */
+    OcclusionCulling::OcclusionCulling(std::string systemName, Engine& engine, uint32_t width, uint32_t height, real_t occluderCoverage, size_t maxOccluders)
+		: System{systemName, engine }, m_buffer{width, height, &engine.GetJobPool()}, m_occluderCoverage{occluderCoverage}, m_maxOccluders{maxOccluders} {
+		engine.RegisterCallbacks( {
+			{this, 1100, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the OcclusionCulling class
+	 */
+    OcclusionCulling::~OcclusionCulling() {}
+
+	/**
+	 * @brief Compute the bounding box of a mesh
+	 * @param mesh The mesh
+	 * @return Bounding box of the vertex positions
+	 */
+	auto OcclusionCulling::ComputeBounds(const vvh::Mesh& mesh) -> BoundingBox {
+		BoundingBox bounds{ vec3_t{std::numeric_limits<real_t>::max()}, vec3_t{std::numeric_limits<real_t>::lowest()} };
+		for( auto& p : mesh.m_verticesData.m_positions ) {
+			bounds.m_min = glm::min(bounds.m_min, vec3_t{p});
+			bounds.m_max = glm::max(bounds.m_max, vec3_t{p});
+		}
+		return bounds;
+	}
+
+	/**
+	 * @brief Select occluders, rasterize them and test all objects. Mesh bounding boxes are computed once and
+	 * stored with the mesh.
+	 * @param message Prepare next frame message
+	 * @return false to continue message propagation
+	 */
+	bool OcclusionCulling::OnPrepareNextFrame(Message message) {
+		if( !m_enabled ) {
+			for( auto [handle, occluded] : m_registry.template GetView<vecs::Handle, Occluded&>() ) { occluded() = false; }
+			m_stats = {};
+			return false;
+		}
+
+		auto view = m_registry.template GetView<vecs::Handle, Camera&, ViewMatrix&, ProjectionMatrix&>();
+		auto it = view.begin();
+		if( !(it != view.end()) ) return false;
+		auto [cHandle, camera, viewMatrix, projMatrix] = *it;
+		mat4_t viewProj = projMatrix() * viewMatrix();
+
+		struct Item {
+			vecs::Handle m_handle;
+			MeshHandle m_mesh;
+			mat4_t m_LtoW;
+		};
+		std::vector<Item> items;
+		for( auto [handle, mesh, LtoW] : m_registry.template GetView<vecs::Handle, MeshHandle, LocalToWorldMatrix&>() ) {
+			items.push_back({handle, mesh, LtoW()});
+		}
+		std::unordered_map<size_t, BoundingBox> dynamicBounds;	//the data of dynamic meshes changes every frame, their bounds are not kept
+		std::erase_if(items, [&](const Item& item) {
+			const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(item.m_mesh());
+			if( mesh.m_dynamic ) {
+				if( mesh.m_verticesData.m_positions.empty() ) return true;
+				if( !dynamicBounds.contains(item.m_mesh().GetValue()) ) dynamicBounds.emplace(item.m_mesh().GetValue(), ComputeBounds(mesh));
+			}
+			else if( !m_registry.template Has<BoundingBox>(item.m_mesh()) ) m_registry.Put(item.m_mesh(), ComputeBounds(mesh));
+			return false;
+		});
+
+		std::vector<OcclusionBuffer::TestBox> boxes;
+		boxes.reserve(items.size());
+		for( auto& item : items ) {
+			auto dynamic = dynamicBounds.find(item.m_mesh().GetValue());
+			boxes.push_back({ viewProj * item.m_LtoW, dynamic != dynamicBounds.end() ? dynamic->second : m_registry.template Get<BoundingBox>(item.m_mesh()) });
+		}
+
+		// occluders are the flagged objects, followed by the objects covering most of the screen
+		std::vector<std::pair<real_t, size_t>> candidates;
+		for( size_t i = 0; i < items.size(); ++i ) {
+			bool hasFlag = m_registry.template Has<Occluder>(items[i].m_handle);
+			bool flag = hasFlag && m_registry.template Get<Occluder>(items[i].m_handle)();
+			if( hasFlag && !flag ) continue;
+			real_t coverage = m_buffer.ScreenCoverage(boxes[i]);
+			if( flag ) candidates.push_back({coverage + 1.0, i});
+			else if( coverage >= m_occluderCoverage ) candidates.push_back({coverage, i});
+		}
+		std::sort(candidates.begin(), candidates.end(), [](auto& a, auto& b) { return a.first > b.first; });
+		if( candidates.size() > m_maxOccluders ) candidates.resize(m_maxOccluders);
+
+		std::vector<OcclusionBuffer::OccluderMesh> occluders;
+		for( auto& [coverage, i] : candidates ) {
+			const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(items[i].m_mesh());
+			occluders.push_back({ boxes[i].m_modelViewProj, &mesh.m_verticesData.m_positions, &mesh.m_indices });
+		}
+
+		auto start = std::chrono::high_resolution_clock::now();
+		m_buffer.Clear();
+		m_stats.m_triangles = m_buffer.Rasterize(occluders);
+		auto raster = std::chrono::high_resolution_clock::now();
+
+		std::vector<uint8_t> visible(boxes.size());
+		m_buffer.Test(boxes, visible);
+		auto test = std::chrono::high_resolution_clock::now();
+
+		std::vector<size_t> missingResults;
+		m_stats.m_objectsCulled = 0;
+		for( size_t i = 0; i < items.size(); ++i ) {
+			if( !visible[i] ) ++m_stats.m_objectsCulled;
+			if( m_registry.template Has<Occluded>(items[i].m_handle) ) m_registry.template Get<Occluded&>(items[i].m_handle)() = !visible[i];
+			else missingResults.push_back(i);
+		}
+		for( auto i : missingResults ) { m_registry.Put(items[i].m_handle, Occluded{!visible[i]}); }
+
+		m_stats.m_occluders = occluders.size();
+		m_stats.m_objectsTested = items.size();
+		m_stats.m_rasterMs = std::chrono::duration<double, std::milli>(raster - start).count();
+		m_stats.m_testMs = std::chrono::duration<double, std::milli>(test - raster).count();
+		return false;
+	}
+
+
+};  // namespace vve
+
@@ -0,0 +1,156 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the PortalCulling class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 */
+    PortalCulling::PortalCulling(std::string systemName, Engine& engine ) : System{systemName, engine } {
+		m_visibilityHandle = m_registry.Insert(Name{systemName}, PortalVisibility{});
+		engine.RegisterCallbacks( {
+			{this, 1000, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the PortalCulling class
+	 */
+    PortalCulling::~PortalCulling() {}
+
+	/**
+	 * @brief Add a cell
+	 * @param min Minimum corner of the cell in world space
+	 * @param max Maximum corner of the cell in world space
+	 * @return Id of the new cell
+	 */
+	auto PortalCulling::AddCell(vec3_t min, vec3_t max) -> uint32_t {
+		m_cells.push_back({min, max, {}});
+		return (uint32_t)m_cells.size() - 1;
+	}
+
+	/**
+	 * @brief Add a portal between two cells
+	 * @param cell0 Id of the first cell
+	 * @param cell1 Id of the second cell
+	 * @param corners Corners of the portal polygon in world space
+	 */
+	void PortalCulling::AddPortal(uint32_t cell0, uint32_t cell1, std::array<vec3_t, 4> corners) {
+		assert( cell0 < m_cells.size() && cell1 < m_cells.size() );
+		m_portals.push_back({{cell0, cell1}, corners});
+		m_cells[cell0].m_portals.push_back((uint32_t)m_portals.size() - 1);
+		m_cells[cell1].m_portals.push_back((uint32_t)m_portals.size() - 1);
+	}
+
+	/**
+	 * @brief Find the cell containing a point
+	 * @param point Point in world space
+	 * @return Id of the cell, or -1 if the point is outside all cells
+	 */
+	auto PortalCulling::FindCell(vec3_t point) -> int {
+		for( size_t i = 0; i < m_cells.size(); ++i ) {
+			if( glm::all(glm::greaterThanEqual(point, m_cells[i].m_min)) && glm::all(glm::lessThanEqual(point, m_cells[i].m_max)) ) return (int)i;
+		}
+		return -1;
+	}
+
+	/**
+	 * @brief Assign all objects with a mesh to the cell containing their world position
+	 */
+	void PortalCulling::AssignObjects() {
+		std::vector<std::pair<vecs::Handle, int>> cells;
+		for( auto [handle, mesh, LtoW] : m_registry.template GetView<vecs::Handle, MeshHandle, LocalToWorldMatrix&>() ) {
+			cells.emplace_back(handle, FindCell(vec3_t{LtoW()[3]}));
+		}
+		for( auto& [handle, cell] : cells ) { //do not change components while iterating the view
+			if( cell >= 0 ) m_registry.Put(handle, PortalCellId{(uint32_t)cell});
+			else if( m_registry.template Has<PortalCellId>(handle) ) m_registry.template Erase<PortalCellId>(handle);
+		}
+	}
+
+	/**
+	 * @brief Compute the visible cells for the current camera
+	 * @param message Prepare next frame message
+	 * @return false to continue message propagation
+	 */
+	bool PortalCulling::OnPrepareNextFrame(Message message) {
+		auto visibility = m_registry.template Get<PortalVisibility&>(m_visibilityHandle);
+		visibility().m_visibleCells.assign(m_cells.size(), 0);
+
+		auto view = m_registry.template GetView<vecs::Handle, Camera&, ViewMatrix&, ProjectionMatrix&>();
+		auto it = view.begin();
+		if( !(it != view.end()) ) return false;
+		auto [cHandle, camera, viewMatrix, projMatrix] = *it;
+
+		int start = FindCell( vec3_t{glm::inverse(viewMatrix())[3]} );
+		visibility().m_enabled = start >= 0;
+		if( start >= 0 ) {
+			VisitCell((uint32_t)start, vec4_t{-1.0f, -1.0f, 1.0f, 1.0f}, projMatrix() * viewMatrix(), visibility().m_visibleCells, 0);
+		}
+
+		m_stats = {};
+		for( auto cell : visibility().m_visibleCells ) { m_stats.m_cellsVisible += cell; }
+		for( auto [handle, cell] : m_registry.template GetView<vecs::Handle, PortalCellId>() ) {
+			if( !visibility().m_enabled || visibility().m_visibleCells[cell()] ) ++m_stats.m_objectsVisible;
+			else ++m_stats.m_objectsCulled;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Mark a cell visible and continue through its portals with the narrowed screen rectangle
+	 * @param cell Id of the cell
+	 * @param rect Screen rectangle in NDC through which the cell is seen
+	 * @param viewProj View projection matrix of the camera
+	 * @param visible Visibility per cell
+	 * @param depth Recursion depth, bounded by the number of cells
+	 */
+	void PortalCulling::VisitCell(uint32_t cell, vec4_t rect, const mat4_t& viewProj, std::vector<uint8_t>& visible, uint32_t depth) {
+		visible[cell] = 1;
+		if( depth >= m_cells.size() ) return;
+
+		for( auto p : m_cells[cell].m_portals ) {
+			auto& portal = m_portals[p];
+			uint32_t next = portal.m_cells[0] == cell ? portal.m_cells[1] : portal.m_cells[0];
+			vec4_t clipped;
+			if( ClipPortal(portal, viewProj, rect, clipped) ) {
+				VisitCell(next, clipped, viewProj, visible, depth + 1);
+			}
+		}
+	}
+
+	/**
+	 * @brief Project a portal to the screen and clip it against a rectangle. If the portal crosses the camera
+	 * plane, the whole rectangle is kept, which is conservative.
+	 * @param portal The portal
+	 * @param viewProj View projection matrix of the camera
+	 * @param rect Screen rectangle in NDC to clip against
+	 * @param clipped Resulting screen rectangle
+	 * @return True if the clipped rectangle is not empty
+	 */
+	auto PortalCulling::ClipPortal(const Portal& portal, const mat4_t& viewProj, const vec4_t& rect, vec4_t& clipped) -> bool {
+		vec2_t lo{ std::numeric_limits<real_t>::max() };
+		vec2_t hi{ std::numeric_limits<real_t>::lowest() };
+		int behind = 0;
+		for( auto& corner : portal.m_corners ) {
+			vec4_t c = viewProj * vec4_t{corner, 1.0f};
+			if( c.w <= 1e-5f ) { ++behind; continue; }
+			vec2_t ndc = vec2_t{c} / c.w;
+			lo = glm::min(lo, ndc);
+			hi = glm::max(hi, ndc);
+		}
+		if( behind == (int)portal.m_corners.size() ) return false;
+		if( behind > 0 ) { lo = vec2_t{rect.x, rect.y}; hi = vec2_t{rect.z, rect.w}; }
+
+		clipped = vec4_t{ glm::max(lo, vec2_t{rect.x, rect.y}), glm::min(hi, vec2_t{rect.z, rect.w}) };
+		return clipped.x < clipped.z && clipped.y < clipped.w;
+	}
+
+
+};  // namespace vve
+
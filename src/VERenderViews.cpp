@@ -0,0 +1,201 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the RenderViews class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 */
+    RenderViews::RenderViews(std::string systemName, Engine& engine ) : System{systemName, engine } {
+		engine.RegisterCallbacks( {
+			{this, 1200, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
+			{this,    0, "MEMORY_REPORT", [this](Message& message){ return OnMemoryReport(message);} },
+			{this,    0, "MESH_DESTROY", [this](Message& message){ return OnMeshDestroy(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the RenderViews class, removes all views
+	 */
+    RenderViews::~RenderViews() {
+		for( auto handle : m_views ) { if( m_registry.Exists(handle) ) m_registry.Erase(handle); }
+	}
+
+	/**
+	 * @brief Add a view
+	 * @param name Name of the view
+	 * @param node Scene node giving the camera pose, invalid for the main camera
+	 * @param viewport x, y, width, height as fraction of the window
+	 * @param camera Projection parameters, the aspect is taken from the viewport
+	 * @param clear Clear the viewport before drawing, e.g. for a picture in picture
+	 * @return Handle of the view entity
+	 */
+	auto RenderViews::AddView(std::string name, ObjectHandle node, vec4_t viewport, Camera camera, bool clear) -> vecs::Handle {
+		uint32_t index = 0;
+		for( ; index < c_maxViews; ++index ) {	//smallest free index
+			bool used = false;
+			for( auto handle : m_views ) { used = used || m_registry.template Get<RenderView&>(handle)().m_index == index; }
+			if( !used ) break;
+		}
+		assert( index < c_maxViews );
+		RenderView view{ .m_name = name, .m_index = index, .m_node = node, .m_camera = camera, .m_viewport = viewport, .m_clear = clear };
+		auto handle = m_registry.Insert(Name{name}, view);
+		m_views.push_back(handle);
+		std::sort(m_views.begin(), m_views.end(), [&](vecs::Handle a, vecs::Handle b) {
+			return m_registry.template Get<RenderView&>(a)().m_index < m_registry.template Get<RenderView&>(b)().m_index;
+		});
+		return handle;
+	}
+
+	/**
+	 * @brief Remove a view
+	 * @param handle Handle of the view entity
+	 */
+	void RenderViews::RemoveView(vecs::Handle handle) {
+		std::erase(m_views, handle);
+		if( m_registry.Exists(handle) ) m_registry.Erase(handle);
+	}
+
+	/**
+	 * @brief Turn a view on or off
+	 * @param handle Handle of the view entity
+	 * @param enabled True to draw the view
+	 */
+	void RenderViews::SetEnabled(vecs::Handle handle, bool enabled) {
+		m_registry.template Get<RenderView&>(handle)().m_enabled = enabled;
+	}
+
+	/**
+	 * @brief Remove the bounding sphere of a destroyed mesh, its handle may be reused by a new mesh
+	 * @param message Mesh destroy message
+	 * @return false to continue message propagation
+	 */
+	bool RenderViews::OnMeshDestroy(Message message) {
+		m_meshSpheres.erase(message.template GetData<MsgMeshDestroy>().m_handle().GetValue());
+		return false;
+	}
+
+	/**
+	 * @brief Get the bounding sphere of a mesh in model space
+	 * @param mesh Handle of the mesh
+	 * @return Center and radius
+	 */
+	auto RenderViews::MeshSphere(MeshHandle mesh) -> vec4_t {
+		auto it = m_meshSpheres.find(mesh().GetValue());
+		if( it != m_meshSpheres.end() ) return it->second;
+
+		const vvh::Mesh& data = m_registry.template Get<vvh::Mesh&>(mesh);
+		vec3_t lo{ std::numeric_limits<real_t>::max() }, hi{ std::numeric_limits<real_t>::lowest() };
+		for( auto& p : data.m_verticesData.m_positions ) { lo = glm::min(lo, vec3_t{p}); hi = glm::max(hi, vec3_t{p}); }
+		vec4_t sphere{ 0.0f };
+		if( !data.m_verticesData.m_positions.empty() ) sphere = vec4_t{ (lo + hi) * (real_t)0.5, glm::length(hi - lo) * (real_t)0.5 };
+		if( data.m_dynamic ) return sphere;		//changes every frame
+		return m_meshSpheres[mesh().GetValue()] = sphere;
+	}
+
+	/**
+	 * @brief Compute the matrices of all views and cull objects. Views with the same view projection matrix
+	 * share one frustum, and each object is transformed once for all frusta.
+	 * @param message Prepare next frame message
+	 * @return false to continue message propagation
+	 */
+	bool RenderViews::OnPrepareNextFrame(Message message) {
+		struct Frustum {
+			mat4_t m_viewProj;
+			std::array<vec4_t, 6> m_planes;
+			uint32_t m_mask{0};			//views using this frustum
+		};
+
+		auto [wHandle, wstate] = Window::GetState(m_registry);
+		real_t windowAspect = wstate().m_height > 0 ? (real_t)wstate().m_width / (real_t)wstate().m_height : (real_t)1.0;
+
+		std::vector<Frustum> frusta;
+		std::array<RenderView::Stats, c_maxViews> stats{};
+		for( auto handle : m_views ) {
+			auto view = m_registry.template Get<RenderView&>(handle);
+			if( !view().m_enabled ) continue;
+
+			Camera camera = view().m_camera;
+			mat4_t LtoW;
+			if( !view().m_node().IsValid() ) {
+				auto cameras = m_registry.template GetView<Camera&, ViewMatrix&>();
+				auto it = cameras.begin();
+				if( !(it != cameras.end()) ) continue;
+				auto [mainCamera, viewMatrix] = *it;
+				camera = mainCamera();
+				LtoW = glm::inverse(viewMatrix());
+			} else {
+				if( !m_registry.Exists(view().m_node) ) continue;
+				LtoW = m_registry.template Get<LocalToWorldMatrix&>(view().m_node)();
+			}
+			camera.m_aspect = windowAspect * view().m_viewport.z / std::max(view().m_viewport.w, (real_t)1e-6);
+			view().m_view = glm::inverse(LtoW);
+			view().m_proj = camera.Matrix();
+			view().m_position = vec3_t{ LtoW[3] };
+
+			mat4_t viewProj = view().m_proj * view().m_view;
+			uint32_t bit = 1u << view().m_index;
+			auto frustum = std::find_if(frusta.begin(), frusta.end(), [&](const Frustum& f) { return f.m_viewProj == viewProj; });
+			if( frustum != frusta.end() ) { frustum->m_mask |= bit; continue; }
+
+			//planes of the clip volume -w <= x,y <= w, 0 <= z <= w
+			auto row = [&](int i) { return vec4_t{ viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i] }; };
+			Frustum f{ viewProj, { row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1), row(2), row(3) - row(2) }, bit };
+			for( auto& plane : f.m_planes ) { plane /= glm::length(vec3_t{plane}); }
+			frusta.push_back(f);
+		}
+
+		std::vector<uint32_t> indices;		//views having a frustum
+		for( auto& frustum : frusta ) {
+			for( uint32_t i = 0; i < c_maxViews; ++i ) { if( frustum.m_mask & (1u << i) ) indices.push_back(i); }
+		}
+
+		std::vector<std::pair<vecs::Handle, uint32_t>> missingMasks;
+		for( auto [handle, mesh, LtoW] : m_registry.template GetView<vecs::Handle, MeshHandle, LocalToWorldMatrix&>() ) {
+			vec4_t sphere = MeshSphere(mesh);
+			vec3_t center = vec3_t{ LtoW() * vec4_t{ vec3_t{sphere}, 1.0f } };
+			real_t scale = std::max({ glm::length(vec3_t{LtoW()[0]}), glm::length(vec3_t{LtoW()[1]}), glm::length(vec3_t{LtoW()[2]}) });
+			real_t radius = sphere.w * scale;
+
+			uint32_t mask = 0;
+			for( auto& frustum : frusta ) {
+				bool inside = true;
+				for( auto& plane : frustum.m_planes ) { inside = inside && glm::dot(vec3_t{plane}, center) + plane.w >= -radius; }
+				if( inside ) mask |= frustum.m_mask;
+			}
+			for( auto i : indices ) {
+				++stats[i].m_objects;
+				stats[i].m_visible += (mask >> i) & 1;
+			}
+
+			if( m_registry.template Has<ViewMask>(handle) ) m_registry.template Get<ViewMask&>(handle)() = mask;
+			else missingMasks.emplace_back(handle, mask);
+		}
+		for( auto& [handle, mask] : missingMasks ) { m_registry.Put(handle, ViewMask{mask}); } //do not change components while iterating the view
+
+		for( auto handle : m_views ) {
+			auto view = m_registry.template Get<RenderView&>(handle);
+			view().m_stats = stats[view().m_index];
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Add the bounding sphere cache to a memory report
+	 * @param message Memory report message
+	 * @return false to continue message propagation
+	 */
+	bool RenderViews::OnMemoryReport(Message message) {
+		auto& msg = message.template GetData<MsgMemoryReport>();
+		size_t bytes = MemoryReport::VectorBytes(m_views) + MemoryReport::HashMapBytes(m_meshSpheres);
+		MemoryReport::Add(msg.m_report->m_systems, "Render views sphere cache", m_meshSpheres.size(), bytes);
+		return false;
+	}
+
+};  // namespace vve
+
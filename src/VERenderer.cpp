@@ -52,6 +52,57 @@ namespace vve {
 		return false;
 	}
 
+	/**
+	 * @brief Check whether an object is hidden, culled by occlusion culling or is in a portal cell that is not visible.
+	 * Objects without culling components are always visible.
+	 * @param handle Handle of the object
+	 * @param occlusion If false, occlusion from the camera is ignored
+	 * @return True if the object should be drawn
+	 */
+	auto Renderer::IsVisible(vecs::Handle handle, bool occlusion) -> bool {
+		if( m_registry.template Has<Hidden>(handle) && m_registry.template Get<Hidden>(handle)() ) return false;
+		if( occlusion && m_registry.template Has<Occluded>(handle) && m_registry.template Get<Occluded>(handle)() ) return false;
+		if( !m_registry.template Has<PortalCellId>(handle) ) return true;
+		if( !m_portalVisibilityHandle.IsValid() || !m_registry.Exists(m_portalVisibilityHandle) ) {
+			auto view = m_registry.template GetView<vecs::Handle, PortalVisibility&>();
+			auto it = view.begin();
+			if( !(it != view.end()) ) return true;
+			auto [vHandle, visibility] = *it;
+			m_portalVisibilityHandle = vHandle;
+		}
+		auto visibility = m_registry.template Get<PortalVisibility&>(m_portalVisibilityHandle);
+		auto cell = m_registry.template Get<PortalCellId>(handle);
+		return !visibility().m_enabled || cell() >= visibility().m_visibleCells.size() || visibility().m_visibleCells[cell()];
+	}
+
+	/**
+	 * @brief Check whether an object is drawn in a render view. Views of the main camera use all culling results,
+	 * other views only their frustum, since occlusion and portal culling are done for the main camera.
+	 * @param handle Handle of the object
+	 * @param view The render view
+	 * @return True if the object should be drawn in the view
+	 */
+	auto Renderer::IsVisibleInView(vecs::Handle handle, const RenderView& view) -> bool {
+		if( m_registry.template Has<ViewMask>(handle) && !(m_registry.template Get<ViewMask>(handle)() & (1u << view.m_index)) ) return false;
+		if( !view.m_node().IsValid() ) return IsVisible(handle);
+		return !(m_registry.template Has<Hidden>(handle) && m_registry.template Get<Hidden>(handle)());
+	}
+
+	/**
+	 * @brief Get the enabled render views in drawing order
+	 * @return Handles of the view entities, empty if there are no views
+	 */
+	auto Renderer::GetRenderViews() -> std::vector<vecs::Handle> {
+		std::vector<std::pair<uint32_t, vecs::Handle>> sorted;
+		for( auto [handle, view] : m_registry.template GetView<vecs::Handle, RenderView&>() ) {
+			if( view().m_enabled ) sorted.emplace_back(view().m_index, handle);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) { return a.first < b.first; });
+		std::vector<vecs::Handle> views;
+		for( auto& [index, handle] : sorted ) { views.push_back(handle); }
+		return views;
+	}
+
 	/**
 	 * @brief Submits a command buffer for rendering
 	 * @param commandBuffer Vulkan command buffer to submit
@@ -79,18 +130,28 @@ namespace vve {
 
 	/**
 	 * @brief Creates all vertex input binding descriptions for the given vertex type
-	 * @param type Vertex attribute type string (e.g., "PNUT" for Position, Normal, UV, Tangent)
+	 * @param type Vertex attribute type string (e.g., "PNUT" for Position, Normal, UV, Tangent), with Q for quantized attributes
+	 * and I for one interleaved stream
+	 * @param layout Streams of the interleaved vertices (e.g., "PNUCT"), may contain more streams than the type uses
 	 * @return Vector of vertex input binding descriptions
 	 */
-	auto Renderer::getBindingDescriptions( std::string type ) -> std::vector<VkVertexInputBindingDescription> {
+	auto Renderer::getBindingDescriptions( std::string type, std::string layout ) -> std::vector<VkVertexInputBindingDescription> {
 		std::vector<VkVertexInputBindingDescription> bindingDescriptions{};
+		bool q = type.find("Q") != std::string::npos;
+
+		if( type.find("I") != std::string::npos ) {
+			uint32_t stride = 0;
+			for( char c : vvh::VertexData::getStreams(layout) ) stride += (uint32_t)vvh::VertexData::getAttributeSize(c, q);
+			bindingDescriptions.push_back( { .binding = 0, .stride = stride, .inputRate = VK_VERTEX_INPUT_RATE_VERTEX } );
+			return bindingDescriptions;
+		}
 			
 		int binding=0;
-		getBindingDescription( type, "P", binding, size_pos, bindingDescriptions );
-		getBindingDescription( type, "N", binding, size_nor, bindingDescriptions );
-		getBindingDescription( type, "U", binding, size_tex, bindingDescriptions );
-		getBindingDescription( type, "C", binding, size_col, bindingDescriptions );
-		getBindingDescription( type, "T", binding, size_tan, bindingDescriptions );
+		getBindingDescription( type, "P", binding, q ? vvh::VertexData::size_pos_q : size_pos, bindingDescriptions );
+		getBindingDescription( type, "N", binding, q ? vvh::VertexData::size_nor_q : size_nor, bindingDescriptions );
+		getBindingDescription( type, "U", binding, q ? vvh::VertexData::size_tex_q : size_tex, bindingDescriptions );
+		getBindingDescription( type, "C", binding, q ? vvh::VertexData::size_col_q : size_col, bindingDescriptions );
+		getBindingDescription( type, "T", binding, q ? vvh::VertexData::size_tan_q : size_tan, bindingDescriptions );
 		return bindingDescriptions;
 	}
 
@@ -115,19 +176,45 @@ namespace vve {
 
     /**
      * @brief Creates all vertex input attribute descriptions for the given vertex type
-     * @param type Vertex attribute type string (e.g., "PNUT" for Position, Normal, UV, Tangent)
+     * @param type Vertex attribute type string (e.g., "PNUT" for Position, Normal, UV, Tangent), with Q for quantized attributes
+     * and I for one interleaved stream
+     * @param layout Streams of the interleaved vertices (e.g., "PNUCT"), may contain more streams than the type uses
      * @return Vector of vertex input attribute descriptions
      */
-    auto Renderer::getAttributeDescriptions(std::string type) -> std::vector<VkVertexInputAttributeDescription> {
+    auto Renderer::getAttributeDescriptions(std::string type, std::string layout) -> std::vector<VkVertexInputAttributeDescription> {
         std::vector<VkVertexInputAttributeDescription> attributeDescriptions{};
 
 		int binding=0;
 		int location=0;
-		addAttributeDescription( type, "P", binding, location, VK_FORMAT_R32G32B32_SFLOAT, attributeDescriptions );
-		addAttributeDescription( type, "N", binding, location, VK_FORMAT_R32G32B32_SFLOAT, attributeDescriptions );
-		addAttributeDescription( type, "U", binding, location, VK_FORMAT_R32G32_SFLOAT,    attributeDescriptions );
-		addAttributeDescription( type, "C", binding, location, VK_FORMAT_R32G32B32A32_SFLOAT, attributeDescriptions );
-		addAttributeDescription( type, "T", binding, location, VK_FORMAT_R32G32B32_SFLOAT, attributeDescriptions );
+		if( type.find("Q") != std::string::npos ) {
+			// the input assembler unpacks the attributes, so the shaders are the same as for float attributes
+			addAttributeDescription( type, "P", binding, location, VK_FORMAT_R16G16B16A16_SNORM, attributeDescriptions );
+			addAttributeDescription( type, "N", binding, location, VK_FORMAT_R8G8B8A8_SNORM, attributeDescriptions );
+			addAttributeDescription( type, "U", binding, location, VK_FORMAT_R16G16_SFLOAT,  attributeDescriptions );
+			addAttributeDescription( type, "C", binding, location, VK_FORMAT_R8G8B8A8_UNORM, attributeDescriptions );
+			addAttributeDescription( type, "T", binding, location, VK_FORMAT_R8G8B8A8_SNORM, attributeDescriptions );
+		} else {
+			addAttributeDescription( type, "P", binding, location, VK_FORMAT_R32G32B32_SFLOAT, attributeDescriptions );
+			addAttributeDescription( type, "N", binding, location, VK_FORMAT_R32G32B32_SFLOAT, attributeDescriptions );
+			addAttributeDescription( type, "U", binding, location, VK_FORMAT_R32G32_SFLOAT,    attributeDescriptions );
+			addAttributeDescription( type, "C", binding, location, VK_FORMAT_R32G32B32A32_SFLOAT, attributeDescriptions );
+			addAttributeDescription( type, "T", binding, location, VK_FORMAT_R32G32B32_SFLOAT, attributeDescriptions );
+		}
+
+		if( type.find("I") != std::string::npos ) {
+			// all attributes come from binding 0, at their offset in the interleaved vertex
+			bool q = type.find("Q") != std::string::npos;
+			auto streams = vvh::VertexData::getStreams(type);
+			for( size_t i = 0; i < attributeDescriptions.size(); ++i ) {
+				uint32_t offset = 0;
+				for( char c : vvh::VertexData::getStreams(layout) ) {
+					if( c == streams[i] ) break;
+					offset += (uint32_t)vvh::VertexData::getAttributeSize(c, q);
+				}
+				attributeDescriptions[i].binding = 0;
+				attributeDescriptions[i].offset = offset;
+			}
+		}
         return attributeDescriptions;
     }
 
@@ -156,5 +243,125 @@ namespace vve {
 	template auto Renderer::RegisterLight<DirectionalLight>(float type, std::vector<vvh::Light>& lights, int& i) -> int;
 	template auto Renderer::RegisterLight<SpotLight>(float type, std::vector<vvh::Light>& lights, int& i) -> int;
 
+	/**
+	 * @brief Create the uniform buffers of a batch of objects as ranges of one buffer per frame in flight, so a
+	 * batch needs one allocation per frame in flight instead of one per object
+	 * @param sizes Size of the uniform buffer of each object
+	 * @param buffers Receives one range per size
+	 */
+	void Renderer::CreateObjectBuffers(const std::vector<VkDeviceSize>& sizes, std::vector<vvh::Buffer>& buffers) {
+		buffers.clear();
+		if( sizes.empty() ) return;
+		UniformBlock block{};
+		vvh::BufCreateBufferRanges({
+			.m_device 		= m_vkState().m_device, 
+			.m_vmaAllocator = m_vkState().m_vmaAllocator, 
+			.m_usageFlags 	= VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			.m_alignment 	= m_vkState().m_physicalDeviceProperties.limits.minUniformBufferOffsetAlignment,
+			.m_sizes 		= sizes,
+			.m_buffer 		= block.m_buffers,
+			.m_ranges 		= buffers
+		});
+		block.m_users = buffers.size();
+		m_uniformBlocks[block.m_buffers.m_uniformBuffers[0]] = std::move(block);
+	}
+
+	/**
+	 * @brief Release the uniform buffer of an object. Buffers with own allocations are destroyed at once, shared
+	 * buffers when their last range is released.
+	 * @param buffer The buffer or range, it is empty afterwards
+	 */
+	void Renderer::DestroyObjectBuffer(vvh::Buffer& buffer) {
+		if( !buffer.m_uniformBuffersAllocation.empty() ) {
+			vvh::BufDestroyBuffer2({
+				.m_device 		= m_vkState().m_device, 
+				.m_vmaAllocator = m_vkState().m_vmaAllocator, 
+				.m_buffers 		= buffer
+			});
+		} else if( !buffer.m_uniformBuffers.empty() ) {
+			auto it = m_uniformBlocks.find(buffer.m_uniformBuffers[0]);
+			if( it != m_uniformBlocks.end() && --it->second.m_users == 0 ) {
+				vvh::BufDestroyBuffer2({
+					.m_device 		= m_vkState().m_device, 
+					.m_vmaAllocator = m_vkState().m_vmaAllocator, 
+					.m_buffers 		= it->second.m_buffers
+				});
+				m_uniformBlocks.erase(it);
+			}
+		}
+		buffer = {};
+	}
+
+	/**
+	 * @brief Allocate the descriptor sets of a batch of objects with one call. Descriptor pools cannot grow, so if
+	 * the last pool is full a new one with at least twice the sets and enough for the batch is added.
+	 * @param layouts Layout of each descriptor set
+	 * @param descriptorSets Receives one descriptor set per layout
+	 */
+	void Renderer::CreateObjectDescriptorSets(const std::vector<VkDescriptorSetLayout>& layouts, std::vector<vvh::DescriptorSet>& descriptorSets) {
+		descriptorSets.clear();
+		if( layouts.empty() ) return;
+		if( !m_objectDescriptorPools.empty() ) {
+			auto result = vvh::RenCreateDescriptorSets({
+				.m_device 				= m_vkState().m_device, 
+				.m_descriptorSetLayouts = layouts, 
+				.m_descriptorPool 		= m_objectDescriptorPools.back(), 
+				.m_descriptorSets 		= descriptorSets
+			});
+			if( result == VK_SUCCESS ) return;
+		}
+
+		uint32_t needed = (uint32_t)(layouts.size() * MAX_FRAMES_IN_FLIGHT);
+		m_objectPoolSize = std::max( { c_objectPoolSize, 2 * m_objectPoolSize, needed } );
+		VkDescriptorPool pool{VK_NULL_HANDLE};
+		vvh::RenCreateDescriptorPool({
+			.m_device 			= m_vkState().m_device, 
+			.m_sizes 			= m_objectPoolSize, 
+			.m_descriptorPool 	= pool
+		});
+		m_objectDescriptorPools.push_back(pool);
+		auto result = vvh::RenCreateDescriptorSets({
+			.m_device 				= m_vkState().m_device, 
+			.m_descriptorSetLayouts = layouts, 
+			.m_descriptorPool 		= pool, 
+			.m_descriptorSets 		= descriptorSets
+		});
+		if( result != VK_SUCCESS ) {
+			throw std::runtime_error("failed to allocate descriptor sets!");
+		}
+	}
+
+	/**
+	 * @brief Free the descriptor set of an object in the pool it was allocated from
+	 * @param descriptorSet The descriptor set, it is empty afterwards
+	 */
+	void Renderer::FreeObjectDescriptorSet(vvh::DescriptorSet& descriptorSet) {
+		if( !descriptorSet.m_descriptorSetPerFrameInFlight.empty() && descriptorSet.m_descriptorPool != VK_NULL_HANDLE ) {
+			vkFreeDescriptorSets(m_vkState().m_device, descriptorSet.m_descriptorPool, 
+				(uint32_t)descriptorSet.m_descriptorSetPerFrameInFlight.size(), descriptorSet.m_descriptorSetPerFrameInFlight.data());
+		}
+		descriptorSet.m_descriptorSetPerFrameInFlight.clear();
+		descriptorSet.m_descriptorPool = VK_NULL_HANDLE;
+	}
+
+	/**
+	 * @brief Destroy the shared uniform buffers and the object descriptor pools when quitting
+	 */
+	void Renderer::DestroyObjectResources() {
+		for( auto& [buffer, block] : m_uniformBlocks ) {
+			vvh::BufDestroyBuffer2({
+				.m_device 		= m_vkState().m_device, 
+				.m_vmaAllocator = m_vkState().m_vmaAllocator, 
+				.m_buffers 		= block.m_buffers
+			});
+		}
+		m_uniformBlocks.clear();
+		for( auto pool : m_objectDescriptorPools ) {
+			vkDestroyDescriptorPool(m_vkState().m_device, pool, nullptr);
+		}
+		m_objectDescriptorPools.clear();
+	}
+
+
 };  // namespace vve
 
@@ -18,6 +18,8 @@ namespace vve {
 			{this,  2000, "PREPARE_NEXT_FRAME",  [this](Message& message) { return OnPrepareNextFrame(message); } },
 			{this,  2000, "RECORD_NEXT_FRAME",	 [this](Message& message) { return OnRecordNextFrame(message); } },
 			{this,  1750, "OBJECT_CREATE",		 [this](Message& message) { return OnObjectCreate(message); } },
+			{this,  1750, "OBJECTS_CREATE",		 [this](Message& message) { return OnObjectsCreate(message); } },
+			{this,  1750, "OBJECTS_ASSETS_CHANGED", [this](Message& message) { return OnObjectsAssetsChanged(message); } },
 			{this,  1750, "OBJECT_DESTROY",		 [this](Message& message) { return OnObjectDestroy(message); } },
 			{this,  1500, "WINDOW_SIZE",		 [this](Message& message) { return OnWindowSize(message); }},
 			{this, 	   0, "QUIT",				 [this](Message& message) { return OnQuit(message); } },
@@ -247,41 +249,20 @@ namespace vve {
 		ubc.camera.positionW = lToW()[3];
 		memcpy(m_uniformBuffersPerFrame.m_uniformBuffersMapped[m_vkState().m_currentFrame], &ubc, sizeof(ubc));
 
-		for (const auto& pipeline : m_geomPipesPerType) {
-			for (auto [oHandle, name, ghandle, LtoW, uniformBuffers, dirty] :
-				m_registry.template GetView<vecs::Handle, Name, MeshHandle, LocalToWorldMatrix&, vvh::Buffer&, Dirty&>({ (size_t)pipeline.second.m_graphicsPipeline.m_pipeline })) {
-
-				if (!dirty()[m_vkState().m_currentFrame]) continue;
-				bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
-				bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
-				bool hasVertexColor = pipeline.second.m_type.find("C") != std::string::npos;
-				if (!hasTexture && !hasColor && !hasVertexColor) [[unlikely]] continue;
-
-				if (hasTexture) {
-					vvh::BufferPerObjectTexture uboTexture{};
-					uboTexture.model = LtoW();
-					uboTexture.modelInverseTranspose = glm::inverse(glm::transpose(uboTexture.model));
-					UVScale uvScale{ { 1.0f, 1.0f } };
-					if (m_registry.template Has<UVScale>(oHandle)) { uvScale = m_registry.template Get<UVScale>(oHandle); }
-					uboTexture.uvScale = uvScale;
-					memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboTexture, sizeof(uboTexture));
-				}
-				else if (hasColor) {
-					vvh::BufferPerObjectColor uboColor{};
-					uboColor.model = LtoW();
-					uboColor.modelInverseTranspose = glm::inverse(glm::transpose(uboColor.model));
-					uboColor.color = m_registry.template Get<vvh::Color>(oHandle);
-					memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboColor, sizeof(uboColor));
+		// Only objects changed since this frame slot was written last need new uniform buffers
+		auto& changes = m_engine.GetChanges();
+		auto& updated = m_updatedFrame[m_vkState().m_currentFrame];
+		if (!changes.GetChangedSince(updated, m_changedObjects)) [[unlikely]] {
+			for (const auto& pipeline : m_geomPipesPerType) {
+				for (auto [oHandle, uniformBuffers] : m_registry.template GetView<vecs::Handle, vvh::Buffer&>({ (size_t)pipeline.second.m_graphicsPipeline.m_pipeline })) {
+					m_changedObjects.push_back(oHandle);
 				}
-				else if (hasVertexColor) {
-					vvh::BufferPerObject uboColor{};
-					uboColor.model = LtoW();
-					uboColor.modelInverseTranspose = glm::inverse(glm::transpose(uboColor.model));
-					memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboColor, sizeof(uboColor));
-				}
-				dirty()[m_vkState().m_currentFrame] = false;
 			}
 		}
+		m_engine.GetJobPool().ParallelFor(m_changedObjects.size(), 256, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) { UpdateObjectUniformBuffer(m_changedObjects[i]); }
+			});
+		updated = changes.GetFrame();
 
 		static_cast<Derived*>(this)->OnPrepareNextFrame();
 
@@ -310,83 +291,180 @@ namespace vve {
 	 */
 	template<typename Derived>
 	bool RendererDeferredCommon<Derived>::OnObjectCreate(Message& message) {
-		const ObjectHandle& oHandle = message.template GetData<MsgObjectCreate>().m_object;
+		ObjectHandle oHandle = message.template GetData<MsgObjectCreate>().m_object;
+		CreateObjectResources({ &oHandle, 1 });
+		static_cast<Derived*>(this)->OnObjectCreate();
+		return false;
+	}
 
-		if (m_registry.template Has<PointLight>(oHandle) ||
-			m_registry.template Has<DirectionalLight>(oHandle) ||
-			m_registry.template Has<SpotLight>(oHandle)) {
-			// Object is a light, update m_storageBuffersLights in OnPrepareNextFrame!
-			m_lightsChanged = true;
+	/**
+	 * @brief Handles batch object creation events, the derived renderer is notified once for the whole batch
+	 * @tparam Derived The derived renderer type
+	 * @param message Batch object creation message
+	 * @return false to continue message processing
+	 */
+	template<typename Derived>
+	bool RendererDeferredCommon<Derived>::OnObjectsCreate(Message& message) {
+		const auto& msg = message.template GetData<MsgObjectsCreate>();
+		CreateObjectResources(msg.m_objects);
+		static_cast<Derived*>(this)->OnObjectCreate();
+		return false;
+	}
+
+	/**
+	 * @brief Handles objects that got a new mesh or texture, e.g. when a placeholder was replaced. The geometry
+	 * pipeline and descriptor set depend on both, so the resources of the objects are created again.
+	 * @tparam Derived The derived renderer type
+	 * @param message Message containing the object handles
+	 * @return false to continue message processing
+	 */
+	template<typename Derived>
+	bool RendererDeferredCommon<Derived>::OnObjectsAssetsChanged(Message& message) {
+		const auto& msg = message.template GetData<MsgObjectsAssetsChanged>();
+		vkDeviceWaitIdle(m_vkState().m_device);	// old descriptor sets may be used by frames in flight
+		for (const auto& oHandle : msg.m_objects) {
+			if (m_registry.template Has<vvh::Buffer>(oHandle)) {
+				DestroyObjectBuffer(m_registry.template Get<vvh::Buffer&>(oHandle));
+				m_registry.template Erase<vvh::Buffer>(oHandle);
+			}
+			if (m_registry.template Has<vvh::DescriptorSet>(oHandle)) {
+				FreeObjectDescriptorSet(m_registry.template Get<vvh::DescriptorSet&>(oHandle));
+				m_registry.template Erase<vvh::DescriptorSet>(oHandle);
+			}
+			for (const auto& [pri, pipeline] : m_geomPipesPerType) {
+				m_registry.EraseTags(oHandle, (size_t)pipeline.m_graphicsPipeline.m_pipeline);
+			}
 		}
+		CreateObjectResources(msg.m_objects);
+		static_cast<Derived*>(this)->OnObjectCreate();
+		return false;
+	}
 
-		if (m_registry.template Has<DirectionalLight>(oHandle)) return false;
+	/**
+	 * @brief Creates the descriptor sets and uniform buffers of a batch of objects. The descriptor sets are allocated
+	 * with one call and the uniform buffers are ranges of one buffer per frame in flight.
+	 * @tparam Derived The derived renderer type
+	 * @param objects Handles of the objects
+	 */
+	template<typename Derived>
+	void RendererDeferredCommon<Derived>::CreateObjectResources(std::span<const ObjectHandle> objects) {
+		std::vector<ObjectHandle> handles;
+		std::vector<const PipelinePerType*> pipelines;
+		std::vector<VkDescriptorSetLayout> layouts;
+		std::vector<VkDeviceSize> sizes;
+		for (const auto& oHandle : objects) {
+			if (m_registry.template Has<PointLight>(oHandle) ||
+				m_registry.template Has<DirectionalLight>(oHandle) ||
+				m_registry.template Has<SpotLight>(oHandle)) {
+				// Object is a light, update m_storageBuffersLights in OnPrepareNextFrame!
+				m_lightsChanged = true;
+			}
 
-		assert(m_registry.template Has<MeshHandle>(oHandle));
+			if (m_registry.template Has<DirectionalLight>(oHandle)) continue;
 
-		const auto& meshHandle = m_registry.template Get<MeshHandle>(oHandle);
-		const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(meshHandle);
-		const auto& type = getPipelineType(oHandle, mesh.m_verticesData);
-		const auto& pipelinePerType = getPipelinePerType(type);
+			assert(m_registry.template Has<MeshHandle>(oHandle));
 
-		bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
-		bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
-		bool hasVertexColor = pipelinePerType->m_type.find("C") != std::string::npos;
-		if (!hasTexture && !hasColor && !hasVertexColor) return false;
+			const auto& meshHandle = m_registry.template Get<MeshHandle>(oHandle);
+			const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(meshHandle);
+			const auto& type = getPipelineType(oHandle, mesh.m_verticesData);
+			const auto& pipelinePerType = getPipelinePerType(type);
 
-		vvh::Buffer ubo;
-		size_t sizeUbo = 0;
-		vvh::DescriptorSet descriptorSet{ 1 };
-		vvh::RenCreateDescriptorSet({
-			.m_device = m_vkState().m_device,
-			.m_descriptorSetLayouts = pipelinePerType->m_descriptorSetLayoutPerObject,
-			.m_descriptorPool = m_descriptorPool,
-			.m_descriptorSet = descriptorSet
-			});
+			bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
+			bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
+			bool hasVertexColor = pipelinePerType->m_type.find("C") != std::string::npos;
+			if (!hasTexture && !hasColor && !hasVertexColor) continue;
 
-		if (hasTexture) {
-			sizeUbo = sizeof(vvh::BufferPerObjectTexture);
-			const auto& tHandle = m_registry.template Get<TextureHandle>(oHandle);
-			const vvh::Image& texture = m_registry.template Get<vvh::Image&>(tHandle);
-			vvh::RenUpdateDescriptorSetTexture({
+			size_t sizeUbo = sizeof(vvh::BufferPerObject);
+			if (hasTexture) sizeUbo = sizeof(vvh::BufferPerObjectTexture);
+			else if (hasColor) sizeUbo = sizeof(vvh::BufferPerObjectColor);
+
+			handles.push_back(oHandle);
+			pipelines.push_back(pipelinePerType);
+			layouts.push_back(pipelinePerType->m_descriptorSetLayoutPerObject);
+			sizes.push_back(sizeUbo);
+		}
+
+		std::vector<vvh::DescriptorSet> descriptorSets;
+		std::vector<vvh::Buffer> ubos;
+		CreateObjectDescriptorSets(layouts, descriptorSets);
+		CreateObjectBuffers(sizes, ubos);
+
+		for (size_t i = 0; i < handles.size(); ++i) {
+			const auto& oHandle = handles[i];
+			auto& descriptorSet = descriptorSets[i];
+			descriptorSet.m_set = 1;
+			if (m_registry.template Has<TextureHandle>(oHandle)) {
+				const auto& tHandle = m_registry.template Get<TextureHandle>(oHandle);
+				const vvh::Image& texture = m_registry.template Get<vvh::Image&>(tHandle);
+				vvh::RenUpdateDescriptorSetTexture({
+					.m_device = m_vkState().m_device,
+					.m_texture = texture,
+					.m_binding = 1,
+					.m_descriptorSet = descriptorSet
+					});
+			}
+			vvh::RenUpdateDescriptorSet({
 				.m_device = m_vkState().m_device,
-				.m_texture = texture,
-				.m_binding = 1,
+				.m_uniformBuffers = ubos[i],
+				.m_binding = 0,
+				.m_type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+				.m_size = (size_t)sizes[i],
 				.m_descriptorSet = descriptorSet
 				});
-		}
-		else if (hasColor) {
-			sizeUbo = sizeof(vvh::BufferPerObjectColor);
-		}
-		else if (hasVertexColor) {
-			sizeUbo = sizeof(vvh::BufferPerObject);
-		}
 
-		vvh::BufCreateBuffers({
-			.m_device = m_vkState().m_device,
-			.m_vmaAllocator = m_vkState().m_vmaAllocator,
-			.m_usageFlags = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-			.m_size = sizeUbo,
-			.m_buffer = ubo
-			});
-		vvh::RenUpdateDescriptorSet({
-			.m_device = m_vkState().m_device,
-			.m_uniformBuffers = ubo,
-			.m_binding = 0,
-			.m_type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-			.m_size = sizeUbo,
-			.m_descriptorSet = descriptorSet
-			});
+			m_registry.Put(oHandle, ubos[i], descriptorSet);
+			m_registry.AddTags(oHandle, (size_t)pipelines[i]->m_graphicsPipeline.m_pipeline);
 
-		m_registry.Put(oHandle, ubo, descriptorSet);
-		m_registry.AddTags(oHandle, (size_t)pipelinePerType->m_graphicsPipeline.m_pipeline);
+			assert(m_registry.template Has<vvh::Buffer>(oHandle));
+			assert(m_registry.template Has<vvh::DescriptorSet>(oHandle));
+		}
+	}
 
-		assert(m_registry.template Has<vvh::Buffer>(oHandle));
-		assert(m_registry.template Has<vvh::DescriptorSet>(oHandle));
+	/**
+	 * @brief Writes the uniform buffer of an object for the current frame slot
+	 * @tparam Derived The derived renderer type
+	 * @param oHandle Handle of the object, objects without uniform buffer are skipped
+	 */
+	template<typename Derived>
+	void RendererDeferredCommon<Derived>::UpdateObjectUniformBuffer(const vecs::Handle& oHandle) {
+		if (!m_registry.Exists(oHandle) || !m_registry.template Has<vvh::Buffer>(oHandle)) return;
 
+		auto [LtoW, uniformBuffers] = m_registry.template Get<LocalToWorldMatrix&, vvh::Buffer&>(oHandle);
+		bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
+		bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
 
-		static_cast<Derived*>(this)->OnObjectCreate();
+		// quantized positions are in [-1,1], normals are not scaled by the bounds
+		glm::mat4 lToW{ LtoW() };
+		glm::mat4 dequantization{ 1.0f };
+		if (m_registry.template Has<MeshHandle>(oHandle)) {
+			const auto& meshHandle = m_registry.template Get<MeshHandle>(oHandle);
+			const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(meshHandle);
+			dequantization = mesh.m_verticesData.getDequantization();
+		}
 
-		return false;
+		// Objects without texture and color only got a uniform buffer if they have vertex colors
+		if (hasTexture) {
+			vvh::BufferPerObjectTexture uboTexture{};
+			uboTexture.model = lToW * dequantization;
+			uboTexture.modelInverseTranspose = glm::inverse(glm::transpose(lToW));
+			UVScale uvScale{ { 1.0f, 1.0f } };
+			if (m_registry.template Has<UVScale>(oHandle)) { uvScale = m_registry.template Get<UVScale>(oHandle); }
+			uboTexture.uvScale = uvScale;
+			memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboTexture, sizeof(uboTexture));
+		}
+		else if (hasColor) {
+			vvh::BufferPerObjectColor uboColor{};
+			uboColor.model = lToW * dequantization;
+			uboColor.modelInverseTranspose = glm::inverse(glm::transpose(lToW));
+			uboColor.color = m_registry.template Get<vvh::Color>(oHandle);
+			memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboColor, sizeof(uboColor));
+		}
+		else {
+			vvh::BufferPerObject uboColor{};
+			uboColor.model = lToW * dequantization;
+			uboColor.modelInverseTranspose = glm::inverse(glm::transpose(lToW));
+			memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboColor, sizeof(uboColor));
+		}
 	}
 
 	/**
@@ -410,19 +488,11 @@ namespace vve {
 		}
 
 		if (m_registry.template Has<vvh::Buffer>(oHandle)) {
-			vvh::Buffer& ubo = m_registry.template Get<vvh::Buffer&>(oHandle);
-			vvh::BufDestroyBuffer2({
-				.m_device = m_vkState().m_device,
-				.m_vmaAllocator = m_vkState().m_vmaAllocator,
-				.m_buffers = ubo
-				});
+			DestroyObjectBuffer(m_registry.template Get<vvh::Buffer&>(oHandle));
 		}
 
 		if (m_registry.template Has<vvh::DescriptorSet&>(oHandle)) {
-			vvh::DescriptorSet& vvh_ds = m_registry.template Get<vvh::DescriptorSet&>(oHandle);
-			for (auto& ds : vvh_ds.m_descriptorSetPerFrameInFlight) {
-				vkFreeDescriptorSets(m_vkState().m_device, m_descriptorPool, 1, &ds);
-			}
+			FreeObjectDescriptorSet(m_registry.template Get<vvh::DescriptorSet&>(oHandle));
 		}
 
 		static_cast<Derived*>(this)->OnObjectDestroy();
@@ -477,6 +547,7 @@ namespace vve {
 		vkDestroyDescriptorSetLayout(m_vkState().m_device, m_descriptorSetLayoutPerFrame, nullptr);
 		vkDestroyDescriptorSetLayout(m_vkState().m_device, m_descriptorSetLayoutComposition, nullptr);
 
+		DestroyObjectResources();
 		vkDestroyDescriptorPool(m_vkState().m_device, m_descriptorPool, nullptr);
 
 		vkDestroySampler(m_vkState().m_device, m_sampler, nullptr);
@@ -516,11 +587,6 @@ namespace vve {
 		const auto& msg = message.template GetData<MsgObjectChanged>();
 		const auto& oHandle = msg.m_object();
 
-		static std::array<bool, MAX_FRAMES_IN_FLIGHT> dirty;
-		dirty.fill(true);
-		m_registry.Put(oHandle, Dirty{ dirty });
-
-
 		if (m_registry.template Has<PointLight>(oHandle) ||
 			m_registry.template Has<DirectionalLight>(oHandle) ||
 			m_registry.template Has<SpotLight>(oHandle)) {
@@ -666,6 +732,7 @@ namespace vve {
 	 */
 	template<typename Derived>
 	void RendererDeferredCommon<Derived>::CreateGeometryPipeline(const VkRenderPass* renderPass) {
+		m_geometryRenderPass = renderPass;
 		const std::filesystem::path shaders{ "shaders/Deferred" };
 		if (!std::filesystem::exists(shaders)) {
 			std::cerr << "ERROR: Folder does not exist: " << std::filesystem::absolute(shaders) << "\n";
@@ -679,55 +746,74 @@ namespace vve {
 				auto pri = std::stoi(filename.substr(0, pos1 - 1));
 				std::string type = filename.substr(pos1 + 1, pos2 - pos1 - 1);
 
-				vvh::Pipeline graphicsPipeline{};
+				// every shader gets a second pipeline for quantized vertex data, pipelines for interleaved
+				// vertex data are created when a mesh layout needs them
+				CreateGeometryPipelineVariant(entry.path(), pri, type);
+				CreateGeometryPipelineVariant(entry.path(), pri, type + "Q");
+			}
+		}
+	}
 
-				VkDescriptorSetLayout descriptorSetLayoutPerObject{};
-				std::vector<VkDescriptorSetLayoutBinding> bindings{
-					{.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT }
-				};
+	/**
+	 * @brief Creates one geometry pipeline from a shader file
+	 * @tparam Derived The derived renderer type
+	 * @param shader Path of the shader file
+	 * @param pri Priority of the shader, pipelines are recorded in this order
+	 * @param type Pipeline type string, the shader type with Q for quantized and I for interleaved vertex data
+	 * @param layout Streams of the interleaved vertices, empty for separate streams
+	 * @return The new pipeline
+	 */
+	template<typename Derived>
+	auto RendererDeferredCommon<Derived>::CreateGeometryPipelineVariant(const std::filesystem::path& shader, int pri, const std::string& type, const std::string& layout)
+			-> RendererDeferredCommon<Derived>::PipelinePerType* {
+		vvh::Pipeline graphicsPipeline{};
 
-				if (type.find("U") != std::string::npos) { //texture map
-					bindings.push_back({ .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT });
-				}
+		VkDescriptorSetLayout descriptorSetLayoutPerObject{};
+		std::vector<VkDescriptorSetLayoutBinding> bindings{
+			{.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT }
+		};
 
-				vvh::RenCreateDescriptorSetLayout({
-					.m_device = m_vkState().m_device,
-					.m_bindings = bindings,
-					.m_descriptorSetLayout = descriptorSetLayoutPerObject
-					});
+		if (type.find("U") != std::string::npos) { //texture map
+			bindings.push_back({ .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT });
+		}
 
-				std::vector<VkVertexInputBindingDescription> bindingDescriptions = getBindingDescriptions(type);
-				std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions(type);
+		vvh::RenCreateDescriptorSetLayout({
+			.m_device = m_vkState().m_device,
+			.m_bindings = bindings,
+			.m_descriptorSetLayout = descriptorSetLayoutPerObject
+			});
 
-				VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-				colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
-					| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-				colorBlendAttachment.blendEnable = VK_FALSE;
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions = getBindingDescriptions(type, layout);
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions(type, layout);
 
-				std::vector<VkPipelineColorBlendAttachmentState> blends{};
-				blends.reserve(COUNT);
-				for (uint8_t i = 0; i < COUNT; ++i) blends.push_back(colorBlendAttachment);
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+			| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.blendEnable = VK_FALSE;
 
-				vvh::RenCreateGraphicsPipeline({
-					.m_device = m_vkState().m_device,
-					.m_renderPass = renderPass != VK_NULL_HANDLE ? *renderPass : VK_NULL_HANDLE,
-					.m_vertShaderPath = entry.path().string(),
-					.m_fragShaderPath = entry.path().string(),
-					.m_bindingDescription = bindingDescriptions,
-					.m_attributeDescriptions = attributeDescriptions,
-					.m_descriptorSetLayouts = { m_descriptorSetLayoutPerFrame, descriptorSetLayoutPerObject },
-					.m_specializationConstants = {},
-					.m_pushConstantRanges = { {.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT, .offset = 0, .size = sizeof(PushConstantsMaterial) } },
-					.m_blendAttachments = blends,
-					.m_graphicsPipeline = graphicsPipeline,
-					.m_attachmentFormats = getAttachmentFormats(),
-					.m_depthFormat = m_vkState().m_depthMapFormat,
-					.m_depthWrite = true
-					});
+		std::vector<VkPipelineColorBlendAttachmentState> blends{};
+		blends.reserve(COUNT);
+		for (uint8_t i = 0; i < COUNT; ++i) blends.push_back(colorBlendAttachment);
 
-				m_geomPipesPerType[pri] = { type, descriptorSetLayoutPerObject, graphicsPipeline };
-			}
-		}
+		vvh::RenCreateGraphicsPipeline({
+			.m_device = m_vkState().m_device,
+			.m_renderPass = m_geometryRenderPass != nullptr ? *m_geometryRenderPass : VK_NULL_HANDLE,
+			.m_vertShaderPath = shader.string(),
+			.m_fragShaderPath = shader.string(),
+			.m_bindingDescription = bindingDescriptions,
+			.m_attributeDescriptions = attributeDescriptions,
+			.m_descriptorSetLayouts = { m_descriptorSetLayoutPerFrame, descriptorSetLayoutPerObject },
+			.m_specializationConstants = {},
+			.m_pushConstantRanges = { {.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT, .offset = 0, .size = sizeof(PushConstantsMaterial) } },
+			.m_blendAttachments = blends,
+			.m_graphicsPipeline = graphicsPipeline,
+			.m_attachmentFormats = getAttachmentFormats(),
+			.m_depthFormat = m_vkState().m_depthMapFormat,
+			.m_depthWrite = true
+			});
+
+		auto it = m_geomPipesPerType.insert({ pri, { type, descriptorSetLayoutPerObject, graphicsPipeline, shader, layout } });
+		return &it->second;
 	}
 
 	/**
@@ -803,11 +889,23 @@ namespace vve {
 	 * @return Pointer to the pipeline per type structure
 	 */
 	template<typename Derived>
-	auto RendererDeferredCommon<Derived>::getPipelinePerType(const std::string& type) const -> const RendererDeferredCommon<Derived>::PipelinePerType* {
+	auto RendererDeferredCommon<Derived>::getPipelinePerType(const std::string& type) -> const RendererDeferredCommon<Derived>::PipelinePerType* {
+		bool quantized = type.find("Q") != std::string::npos;
+		bool interleaved = type.find("I") != std::string::npos;
 		for (auto& [pri, pipeline] : m_geomPipesPerType) {
+			if (!pipeline.m_layout.empty()) continue;
 			bool found = true;
 			for (auto& c : pipeline.m_type) { found = found && (type.find(c) != std::string::npos); }
-			if (found) [[likely]] return &pipeline;
+			found = found && (quantized == (pipeline.m_type.find("Q") != std::string::npos));
+			if (!found) continue;
+			if (!interleaved) [[likely]] return &pipeline;
+
+			// interleaved vertices need a pipeline with the stride and offsets of the mesh layout
+			auto layout = vvh::VertexData::getStreams(type);
+			for (auto& [pri2, variant] : m_geomPipesPerType) {
+				if (variant.m_type == pipeline.m_type + "I" && variant.m_layout == layout) return &variant;
+			}
+			return CreateGeometryPipelineVariant(pipeline.m_shader, pri, pipeline.m_type + "I", layout);
 		}
 		std::cout << "Pipeline not found for type: " << type << std::endl;
 		exit(-1);
@@ -971,6 +1069,7 @@ namespace vve {
 					// Does not render the point or spot light sphere - has to be removed if this wants to be used
 					continue;
 				}
+				if (!IsVisible(oHandle)) continue;
 
 				bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
 				bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
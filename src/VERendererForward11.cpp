@@ -37,6 +37,8 @@ namespace vve {
   			{this,  2000, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
   			{this,  2000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} },
 			{this,  2000, "OBJECT_CREATE", [this](Message& message){ return OnObjectCreate(message);} },
+			{this,  2000, "OBJECTS_CREATE", [this](Message& message){ return OnObjectsCreate(message);} },
+			{this,  2000, "OBJECTS_ASSETS_CHANGED", [this](Message& message){ return OnObjectsAssetsChanged(message);} },
 			{this, 10000, "OBJECT_DESTROY", [this](Message& message){ return OnObjectDestroy(message);} },
   			{this,     0, "QUIT", [this](Message& message){ return OnQuit(message);} }
   		} );
@@ -158,51 +160,67 @@ namespace vve {
 				auto pri = std::stoi( filename.substr(0, pos1-1) );
 				std::string type = filename.substr(pos1+1, pos2 - pos1 - 1);
 				
-				vvh::Pipeline graphicsPipeline;
+				// every shader gets a second pipeline for quantized vertex data, pipelines for interleaved
+				// vertex data are created when a mesh layout needs them
+				CreatePipeline( entry.path(), pri, type );
+				CreatePipeline( entry.path(), pri, type + "Q" );
+			}
+		}
+	}
 
-				VkDescriptorSetLayout descriptorSetLayoutPerObject;
-				std::vector<VkDescriptorSetLayoutBinding> bindings{
-					{ .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT }
-				};
+	/**
+	 * @brief Creates one graphics pipeline from a shader file
+	 * @param shader Path of the shader file
+	 * @param pri Priority of the shader, pipelines are recorded in this order
+	 * @param type Pipeline type string, the shader type with Q for quantized and I for interleaved vertex data
+	 * @param layout Streams of the interleaved vertices, empty for separate streams
+	 * @return The new pipeline
+	 */
+	RendererForward11::PipelinePerType* RendererForward11::CreatePipeline(const std::filesystem::path& shader, int pri, std::string type, std::string layout) {
+		vvh::Pipeline graphicsPipeline;
 
-				if(type.find("U") != std::string::npos) { //texture map
-					bindings.push_back( { .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT } );
-				}
+		VkDescriptorSetLayout descriptorSetLayoutPerObject;
+		std::vector<VkDescriptorSetLayoutBinding> bindings{
+			{ .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT }
+		};
 
-				vvh::RenCreateDescriptorSetLayout( {m_vkState().m_device, bindings, descriptorSetLayoutPerObject });
-
-				std::vector<VkVertexInputBindingDescription> bindingDescriptions = getBindingDescriptions(type);
-				std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions(type);
-
-				VkPipelineColorBlendAttachmentState colorBlendAttachment{};
-				colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-				colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-				colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_CONSTANT_COLOR;
-				colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
-				colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_CONSTANT_ALPHA;
-				colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_ALPHA;
-				colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_MAX;
-				colorBlendAttachment.blendEnable = VK_TRUE;
-
-				vvh::RenCreateGraphicsPipeline({
-					.m_device 					= m_vkState().m_device, 
-					.m_renderPass 				= m_renderPass, 
-					.m_vertShaderPath 			= entry.path().string(), 
-					.m_fragShaderPath 			= entry.path().string(),
-					.m_bindingDescription 		= bindingDescriptions, 
-					.m_attributeDescriptions 	= attributeDescriptions,
-					.m_descriptorSetLayouts 	= { m_descriptorSetLayoutPerFrame, descriptorSetLayoutPerObject }, 
-					.m_specializationConstants 	= {(int)MAX_NUMBER_LIGHTS}, //spezialization constants
-					.m_pushConstantRanges 		=  {{.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT, .offset = 0, .size = 8}}, //push constant ranges -> 2 ints
-					.m_blendAttachments 		= {colorBlendAttachment}, //blend attachments
-					.m_graphicsPipeline 		= graphicsPipeline
-				});
-				
-				m_pipelinesPerType[pri] = { type, descriptorSetLayoutPerObject, graphicsPipeline };
-
-				std::cout << "Pipeline (" << graphicsPipeline.m_pipeline << "): " << filename << " Priority: " << pri << " Type: " << type << std::endl;
-			}
+		if(type.find("U") != std::string::npos) { //texture map
+			bindings.push_back( { .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT } );
 		}
+
+		vvh::RenCreateDescriptorSetLayout( {m_vkState().m_device, bindings, descriptorSetLayoutPerObject });
+
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions = getBindingDescriptions(type, layout);
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions(type, layout);
+
+		VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+		colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+		colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+		colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_CONSTANT_COLOR;
+		colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+		colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_CONSTANT_ALPHA;
+		colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_ALPHA;
+		colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_MAX;
+		colorBlendAttachment.blendEnable = VK_TRUE;
+
+		vvh::RenCreateGraphicsPipeline({
+			.m_device 					= m_vkState().m_device, 
+			.m_renderPass 				= m_renderPass, 
+			.m_vertShaderPath 			= shader.string(), 
+			.m_fragShaderPath 			= shader.string(),
+			.m_bindingDescription 		= bindingDescriptions, 
+			.m_attributeDescriptions 	= attributeDescriptions,
+			.m_descriptorSetLayouts 	= { m_descriptorSetLayoutPerFrame, descriptorSetLayoutPerObject }, 
+			.m_specializationConstants 	= {(int)MAX_NUMBER_LIGHTS}, //spezialization constants
+			.m_pushConstantRanges 		=  {{.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT, .offset = 0, .size = 8}}, //push constant ranges -> 2 ints
+			.m_blendAttachments 		= {colorBlendAttachment}, //blend attachments
+			.m_graphicsPipeline 		= graphicsPipeline
+		});
+
+		auto it = m_pipelinesPerType.insert( { pri, { type, descriptorSetLayoutPerObject, graphicsPipeline, shader, layout } } );
+
+		std::cout << "Pipeline (" << graphicsPipeline.m_pipeline << "): " << shader.filename().string() << " Priority: " << pri << " Type: " << type << " " << layout << std::endl;
+		return &it->second;
 	}
 
 	/**
@@ -235,37 +253,57 @@ namespace vve {
 		ubc.camera.positionW = lToW()[3];
 		memcpy(m_uniformBuffersPerFrame.m_uniformBuffersMapped[m_vkState().m_currentFrame], &ubc, sizeof(ubc));
 
+		//Same lights, camera of the view
+		for( auto handle : GetRenderViews() ) {
+			auto view = m_registry.template Get<RenderView&>(handle);
+			CreateViewResources(view().m_index);
+			vvh::UniformBufferFrame ubv = ubc;
+			ubv.camera.view = view().m_view;
+			ubv.camera.proj = view().m_proj;
+			ubv.camera.positionW = view().m_position;
+			memcpy(m_viewResources[view().m_index].m_uniformBuffers.m_uniformBuffersMapped[m_vkState().m_currentFrame], &ubv, sizeof(ubv));
+		}
+
+		// Each object writes only its own uniform buffer, so objects are updated in parallel
 		for( auto& pipeline : m_pipelinesPerType) {
-			for( auto[oHandle, name, ghandle, LtoW, uniformBuffers] : 
+			m_engine.GetJobPool().ParallelForEach(
 				m_registry.template GetView<vecs::Handle, Name, MeshHandle, LocalToWorldMatrix&, vvh::Buffer&>
-						({(size_t)pipeline.second.m_graphicsPipeline.m_pipeline}) ) {
+						({(size_t)pipeline.second.m_graphicsPipeline.m_pipeline}),
+				[&](auto oHandle, auto& name, auto& ghandle, auto& LtoW, auto& uniformBuffers) {
 
 				bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
 				bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
 				bool hasVertexColor = pipeline.second.m_type.find("C") != std::string::npos;
-				if( !hasTexture && !hasColor && !hasVertexColor ) continue;
+				if( !hasTexture && !hasColor && !hasVertexColor ) return;
+
+				// quantized positions are in [-1,1], normals are not scaled by the bounds
+				glm::mat4 lToW{ LtoW() };
+				glm::mat4 dequantization{ 1.0f };
+				if( pipeline.second.m_type.find("Q") != std::string::npos ) {
+					dequantization = m_registry.template Get<vvh::Mesh&>(ghandle)().m_verticesData.getDequantization();
+				}
 
 				if( hasTexture ) {
 					vvh::BufferPerObjectTexture uboTexture{};
-					uboTexture.model = LtoW(); 		
-					uboTexture.modelInverseTranspose = glm::inverse( glm::transpose(uboTexture.model) );
+					uboTexture.model = lToW * dequantization;
+					uboTexture.modelInverseTranspose = glm::inverse( glm::transpose(lToW) );
 					UVScale uvScale{ { 1.0f, 1.0f }};
 					if( m_registry.template Has<UVScale>(oHandle) ) { uvScale = m_registry.template Get<UVScale>(oHandle); }
 					uboTexture.uvScale = uvScale;
 					memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboTexture, sizeof(uboTexture));
 				} else if( hasColor ) {
 					vvh::BufferPerObjectColor uboColor{};
-					uboColor.model = LtoW(); 		
-					uboColor.modelInverseTranspose = glm::inverse( glm::transpose(uboColor.model) );
+					uboColor.model = lToW * dequantization;
+					uboColor.modelInverseTranspose = glm::inverse( glm::transpose(lToW) );
 					uboColor.color = m_registry.template Get<vvh::Color>(oHandle);
 					memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboColor, sizeof(uboColor));
 				} else if( hasVertexColor ) {
 					vvh::BufferPerObject uboColor{};
-					uboColor.model = LtoW(); 
-					uboColor.modelInverseTranspose = glm::inverse( glm::transpose(uboColor.model) );
+					uboColor.model = lToW * dequantization;
+					uboColor.modelInverseTranspose = glm::inverse( glm::transpose(lToW) );
 					memcpy(uniformBuffers().m_uniformBuffersMapped[m_vkState().m_currentFrame], &uboColor, sizeof(uboColor));
 				}
-			}
+			});
 		}
 		return false;
 	}
@@ -298,6 +336,96 @@ namespace vve {
 			.m_currentFrame 	= m_vkState().m_currentFrame
 		});
 
+		auto views = GetRenderViews();
+		if( views.empty() ) {
+			RecordObjects(cmdBuffer, m_descriptorSetPerFrame, {}, {}, nullptr);
+		}
+		for( auto handle : views ) {
+			auto view = m_registry.template Get<RenderView&>(handle);
+			auto extent = m_vkState().m_swapChain.m_swapChainExtent;
+			VkViewport viewport{ 
+				.x = (float)(view().m_viewport.x * extent.width), .y = (float)(view().m_viewport.y * extent.height),
+				.width = (float)(view().m_viewport.z * extent.width), .height = (float)(view().m_viewport.w * extent.height),
+				.minDepth = 0.0f, .maxDepth = 1.0f 
+			};
+			VkRect2D scissor{ 
+				.offset = { (int32_t)viewport.x, (int32_t)viewport.y }, 
+				.extent = { (uint32_t)viewport.width, (uint32_t)viewport.height } 
+			};
+
+			if( view().m_clear ) {
+				std::array<VkClearAttachment, 2> attachments{
+					VkClearAttachment{ .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .colorAttachment = 0, .clearValue = { .color = {0.0f, 0.0f, 0.0f, 1.0f} } },
+					VkClearAttachment{ .aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT, .colorAttachment = 0, .clearValue = { .depthStencil = {1.0f, 0} } }
+				};
+				VkClearRect rect{ .rect = scissor, .baseArrayLayer = 0, .layerCount = 1 };
+				vkCmdClearAttachments(cmdBuffer, (uint32_t)attachments.size(), attachments.data(), 1, &rect);
+			}
+
+			view().m_stats.m_drawCalls = 0;
+			view().m_stats.m_triangles = 0;
+			RecordObjects(cmdBuffer, m_viewResources[view().m_index].m_descriptorSet, {viewport}, {scissor}, &view());
+		}
+
+		vvh::ComEndRenderPass({.m_commandBuffer = cmdBuffer});
+		vvh::ComEndCommandBuffer({.m_commandBuffer = cmdBuffer});
+	    SubmitCommandBuffer(cmdBuffer);
+
+		++m_pass;
+		return false;
+    }
+
+	/**
+	 * @brief Create the per frame uniform buffer and descriptor set of a render view
+	 * @param index Index of the view
+	 */
+	void RendererForward11::CreateViewResources(uint32_t index) {
+		if( index < m_viewResources.size() && m_viewResources[index].m_created ) return;
+		if( index >= m_viewResources.size() ) m_viewResources.resize(index + 1);
+		auto& resources = m_viewResources[index];
+
+		vvh::RenCreateDescriptorSet({
+			.m_device 				= m_vkState().m_device, 
+			.m_descriptorSetLayouts	= m_descriptorSetLayoutPerFrame, 
+			.m_descriptorPool 		= m_descriptorPool, 
+			.m_descriptorSet 		= resources.m_descriptorSet
+		});
+		vvh::BufCreateBuffers({
+			.m_device 		= m_vkState().m_device, 
+			.m_vmaAllocator = m_vkState().m_vmaAllocator, 
+			.m_usageFlags = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			.m_size 		= sizeof(vvh::UniformBufferFrame), 
+			.m_buffer 		= resources.m_uniformBuffers
+		});
+		vvh::RenUpdateDescriptorSet({
+			.m_device 			= m_vkState().m_device, 
+			.m_uniformBuffers	= resources.m_uniformBuffers, 
+			.m_binding 			= 0, 
+			.m_type 			= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 
+			.m_size 			= sizeof(vvh::UniformBufferFrame), 
+			.m_descriptorSet 	= resources.m_descriptorSet
+		});   
+		vvh::RenUpdateDescriptorSet({
+			.m_device 			= m_vkState().m_device, 
+			.m_uniformBuffers 	= m_storageBuffersLights, 
+			.m_binding 			= 1, 
+			.m_type 			= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 
+			.m_size 			= MAX_NUMBER_LIGHTS*sizeof(vvh::Light), 
+			.m_descriptorSet 	= resources.m_descriptorSet
+		});   
+		resources.m_created = true;
+	}
+
+	/**
+	 * @brief Record all visible objects with a per frame descriptor set
+	 * @param cmdBuffer Command buffer to record into
+	 * @param descriptorSetPerFrame Descriptor set holding camera and lights
+	 * @param viewports Viewports, empty for the whole window
+	 * @param scissors Scissor rectangles, empty for the whole window
+	 * @param view Render view whose statistics are counted, nullptr if there are no views
+	 */
+	void RendererForward11::RecordObjects(VkCommandBuffer cmdBuffer, vvh::DescriptorSet& descriptorSetPerFrame, 
+			const std::vector<VkViewport>& viewports, const std::vector<VkRect2D>& scissors, RenderView* view) {
 		float f = 0.0;
 		std::array<float,4> blendconst = (m_pass == 0 ? std::array<float,4>{f,f,f,f} : std::array<float,4>{1-f,1-f,1-f,1-f});
 		
@@ -315,8 +443,8 @@ namespace vve {
 				.m_commandBuffer 	= cmdBuffer, 
 				.m_graphicsPipeline = pip, 
 				.m_extent = m_vkState().m_swapChain.m_swapChainExtent,
-				.m_viewPorts 		= {},	
-				.m_scissors 		= {}, 
+				.m_viewPorts 		= viewports,	
+				.m_scissors 		= scissors, 
 				.m_blendConstants 	= blendconst, //blend constants
 				.m_pushConstants 	= {
 					{	.layout = pipeline.second.m_graphicsPipeline.m_pipelineLayout, 
@@ -332,6 +460,7 @@ namespace vve {
 				m_registry.template GetView<vecs::Handle, Name, MeshHandle, LocalToWorldMatrix&, vvh::Buffer&, vvh::DescriptorSet&>
 						({(size_t)pipeline.second.m_graphicsPipeline.m_pipeline}) ) {
 
+				if( view ? !IsVisibleInView(oHandle, *view) : !IsVisible(oHandle) ) continue;
 				bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
 				bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
 				bool hasVertexColor = pipeline.second.m_type.find("C") != std::string::npos;
@@ -341,21 +470,18 @@ namespace vve {
 				vvh::ComRecordObject( {
 					.m_commandBuffer 	= cmdBuffer, 
 					.m_graphicsPipeline = pipeline.second.m_graphicsPipeline, 
-					.m_descriptorSets 	= { m_descriptorSetPerFrame, descriptorsets }, 
+					.m_descriptorSets 	= { descriptorSetPerFrame, descriptorsets }, 
 					.m_type 			= pipeline.second.m_type, 
 					.m_mesh 			= mesh(), 
 					.m_currentFrame 	= m_vkState().m_currentFrame 
 				});
+				if( view ) {
+					++view->m_stats.m_drawCalls;
+					view->m_stats.m_triangles += mesh().m_indices.size() / 3;
+				}
 			}
 		}
-
-		vvh::ComEndRenderPass({.m_commandBuffer = cmdBuffer});
-		vvh::ComEndCommandBuffer({.m_commandBuffer = cmdBuffer});
-	    SubmitCommandBuffer(cmdBuffer);
-
-		++m_pass;
-		return false;
-    }
+	}
 
 	/**
 	 * @brief Handles object creation by setting up descriptor sets and uniform buffers
@@ -364,65 +490,111 @@ namespace vve {
 	 */
 	bool RendererForward11::OnObjectCreate( Message message ) {
 		ObjectHandle oHandle = message.template GetData<MsgObjectCreate>().m_object;
-		assert( m_registry.template Has<MeshHandle>(oHandle) );	
-		auto meshHandle = m_registry.template Get<MeshHandle>(oHandle);
-		auto mesh = m_registry.template Get<vvh::Mesh&>(meshHandle);
-		auto type = getPipelineType(oHandle, mesh().m_verticesData);
-		auto pipelinePerType = getPipelinePerType(type);
-
-		bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
-		bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
-		bool hasVertexColor = pipelinePerType->m_type.find("C") != std::string::npos;
-		if( !hasTexture && !hasColor && !hasVertexColor ) return false;	
-
-		vvh::Buffer ubo;
-		size_t sizeUbo = 0;
-		vvh::DescriptorSet descriptorSet{1};
-		vvh::RenCreateDescriptorSet({
-			.m_device 				= m_vkState().m_device, 
-			.m_descriptorSetLayouts = pipelinePerType->m_descriptorSetLayoutPerObject, 
-			.m_descriptorPool 		= m_descriptorPool, 
-			.m_descriptorSet 		= descriptorSet
-		});
+		CreateObjectResources({&oHandle, 1});
+		return false; //true if handled
+	}
+
+	/**
+	 * @brief Handles batch object creation by setting up descriptor sets and uniform buffers for all objects
+	 * @param message Message containing the object handles
+	 * @return false to continue message propagation
+	 */
+	bool RendererForward11::OnObjectsCreate( Message message ) {
+		auto msg = message.template GetData<MsgObjectsCreate>();
+		CreateObjectResources(msg.m_objects);
+		return false;
+	}
 
-		if( hasTexture ) {
-			sizeUbo = sizeof(vvh::BufferPerObjectTexture);
-			auto tHandle = m_registry.template Get<TextureHandle>(oHandle);
-			auto texture = m_registry.template Get<vvh::Image&>(tHandle);
-	    	vvh::RenUpdateDescriptorSetTexture({
+	/**
+	 * @brief Handles objects that got a new mesh or texture, e.g. when a placeholder was replaced. The pipeline and
+	 * descriptor set depend on both, so the resources of the objects are created again.
+	 * @param message Message containing the object handles
+	 * @return false to continue message propagation
+	 */
+	bool RendererForward11::OnObjectsAssetsChanged( Message message ) {
+		auto msg = message.template GetData<MsgObjectsAssetsChanged>();
+		vkDeviceWaitIdle(m_vkState().m_device);	//old descriptor sets may be used by frames in flight
+		for( auto& oHandle : msg.m_objects ) {
+			if( m_registry.template Has<vvh::Buffer>(oHandle) ) {
+				DestroyObjectBuffer(m_registry.template Get<vvh::Buffer&>(oHandle)());
+				m_registry.template Erase<vvh::Buffer>(oHandle);
+			}
+			if( m_registry.template Has<vvh::DescriptorSet>(oHandle) ) {
+				FreeObjectDescriptorSet(m_registry.template Get<vvh::DescriptorSet&>(oHandle)());
+				m_registry.template Erase<vvh::DescriptorSet>(oHandle);
+			}
+			for( auto& [pri, pipeline] : m_pipelinesPerType ) { m_registry.EraseTags(oHandle, (size_t)pipeline.m_graphicsPipeline.m_pipeline); }
+		}
+		CreateObjectResources(msg.m_objects);
+		return false;
+	}
+
+	/**
+	 * @brief Creates the descriptor sets and uniform buffers of a batch of objects. The descriptor sets are allocated
+	 * with one call and the uniform buffers are ranges of one buffer per frame in flight.
+	 * @param objects Handles of the objects
+	 */
+	void RendererForward11::CreateObjectResources( std::span<const ObjectHandle> objects ) {
+		std::vector<ObjectHandle> handles;
+		std::vector<PipelinePerType*> pipelines;
+		std::vector<VkDescriptorSetLayout> layouts;
+		std::vector<VkDeviceSize> sizes;
+		for( auto& oHandle : objects ) {
+			assert( m_registry.template Has<MeshHandle>(oHandle) );	
+			auto meshHandle = m_registry.template Get<MeshHandle>(oHandle);
+			auto mesh = m_registry.template Get<vvh::Mesh&>(meshHandle);
+			auto type = getPipelineType(oHandle, mesh().m_verticesData);
+			auto pipelinePerType = getPipelinePerType(type);
+
+			bool hasTexture = m_registry.template Has<TextureHandle>(oHandle);
+			bool hasColor = m_registry.template Has<vvh::Color>(oHandle);
+			bool hasVertexColor = pipelinePerType->m_type.find("C") != std::string::npos;
+			if( !hasTexture && !hasColor && !hasVertexColor ) continue;
+
+			size_t sizeUbo = sizeof(vvh::BufferPerObject);
+			if( hasTexture ) sizeUbo = sizeof(vvh::BufferPerObjectTexture);
+			else if( hasColor ) sizeUbo = sizeof(vvh::BufferPerObjectColor);
+
+			handles.push_back(oHandle);
+			pipelines.push_back(pipelinePerType);
+			layouts.push_back(pipelinePerType->m_descriptorSetLayoutPerObject);
+			sizes.push_back(sizeUbo);
+		}
+
+		std::vector<vvh::DescriptorSet> descriptorSets;
+		std::vector<vvh::Buffer> ubos;
+		CreateObjectDescriptorSets(layouts, descriptorSets);
+		CreateObjectBuffers(sizes, ubos);
+
+		for( size_t i = 0; i < handles.size(); ++i ) {
+			auto oHandle = handles[i];
+			auto& descriptorSet = descriptorSets[i];
+			descriptorSet.m_set = 1;
+			if( m_registry.template Has<TextureHandle>(oHandle) ) {
+				auto tHandle = m_registry.template Get<TextureHandle>(oHandle);
+				auto texture = m_registry.template Get<vvh::Image&>(tHandle);
+		    	vvh::RenUpdateDescriptorSetTexture({
+					.m_device 			= m_vkState().m_device, 
+					.m_texture 			= texture(), 
+					.m_binding 			= 1,
+					.m_descriptorSet 	= descriptorSet
+				});
+			}
+		    vvh::RenUpdateDescriptorSet({
 				.m_device 			= m_vkState().m_device, 
-				.m_texture 			= texture(), 
-				.m_binding 			= 1,
+				.m_uniformBuffers 	= ubos[i], 
+				.m_binding 			= 0, 
+				.m_type 			= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 
+				.m_size 			= (size_t)sizes[i], 
 				.m_descriptorSet 	= descriptorSet
 			});
-		} else if(hasColor) {
-			sizeUbo = sizeof(vvh::BufferPerObjectColor);
-		} else if(hasVertexColor) {
-			sizeUbo = sizeof(vvh::BufferPerObject);
-		}
-
-		vvh::BufCreateBuffers({
-			.m_device 		= m_vkState().m_device, 
-			.m_vmaAllocator = m_vkState().m_vmaAllocator, 
-			.m_usageFlags = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-			.m_size 		= sizeUbo, 
-			.m_buffer 		= ubo
-		});
-	    vvh::RenUpdateDescriptorSet({
-			.m_device 			= m_vkState().m_device, 
-			.m_uniformBuffers 	= ubo, 
-			.m_binding 			= 0, 
-			.m_type 			= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 
-			.m_size 			= sizeUbo, 
-			.m_descriptorSet 	= descriptorSet
-		});
 
-		m_registry.Put(oHandle, ubo, descriptorSet);
-		m_registry.AddTags(oHandle, (size_t)pipelinePerType->m_graphicsPipeline.m_pipeline);
+			m_registry.Put(oHandle, ubos[i], descriptorSet);
+			m_registry.AddTags(oHandle, (size_t)pipelines[i]->m_graphicsPipeline.m_pipeline);
 
-		assert( m_registry.template Has<vvh::Buffer>(oHandle) );
-		assert( m_registry.template Has<vvh::DescriptorSet>(oHandle) );
-		return false; //true if handled
+			assert( m_registry.template Has<vvh::Buffer>(oHandle) );
+			assert( m_registry.template Has<vvh::DescriptorSet>(oHandle) );
+		}
 	}
 
 	/**
@@ -437,12 +609,10 @@ namespace vve {
 		assert(m_registry.Exists(oHandle) );
 
 		if( !m_registry.template Has<vvh::Buffer>(oHandle) ) return false;
-		auto ubo = m_registry.template Get<vvh::Buffer&>(oHandle);
-		vvh::BufDestroyBuffer2({
-			.m_device 		= m_vkState().m_device, 
-			.m_vmaAllocator = m_vkState().m_vmaAllocator, 
-			.m_buffers 		= ubo()
-		});
+		DestroyObjectBuffer(m_registry.template Get<vvh::Buffer&>(oHandle)());
+		if( m_registry.template Has<vvh::DescriptorSet>(oHandle) ) {
+			FreeObjectDescriptorSet(m_registry.template Get<vvh::DescriptorSet&>(oHandle)());
+		}
 		return false;
 	}
 
@@ -466,10 +636,22 @@ namespace vve {
 	 * @return Pointer to the matching pipeline, or exits if not found
 	 */
 	RendererForward11::PipelinePerType* RendererForward11::getPipelinePerType(std::string type) {
+		bool quantized = type.find("Q") != std::string::npos;
+		bool interleaved = type.find("I") != std::string::npos;
 		for( auto& [pri, pipeline] : m_pipelinesPerType ) {
+			if( !pipeline.m_layout.empty() ) continue;
 			bool found = true;
 			for( auto& c : pipeline.m_type ) {found = found && ( type.find(c) != std::string::npos ); }
-			if( found ) return &pipeline;
+			found = found && ( quantized == (pipeline.m_type.find("Q") != std::string::npos) );
+			if( !found ) continue;
+			if( !interleaved ) return &pipeline;
+
+			// interleaved vertices need a pipeline with the stride and offsets of the mesh layout
+			auto layout = vvh::VertexData::getStreams(type);
+			for( auto& [pri2, variant] : m_pipelinesPerType ) {
+				if( variant.m_type == pipeline.m_type + "I" && variant.m_layout == layout ) return &variant;
+			}
+			return CreatePipeline( pipeline.m_shader, pri, pipeline.m_type + "I", layout );
 		}
 		std::cout << "Pipeline not found for type: " << type << std::endl;
 		exit(-1);
@@ -494,6 +676,7 @@ namespace vve {
 			vkDestroyPipelineLayout(m_vkState().m_device, pipeline.m_graphicsPipeline.m_pipelineLayout, nullptr);
 		}
 
+        DestroyObjectResources();
         vkDestroyDescriptorPool(m_vkState().m_device, m_descriptorPool, nullptr);		
 		vkDestroyRenderPass(m_vkState().m_device, m_renderPass, nullptr);
 		vkDestroyRenderPass(m_vkState().m_device, m_renderPassClear, nullptr);
@@ -509,6 +692,15 @@ namespace vve {
 			.m_buffers 		= m_storageBuffersLights
 		});
 
+		for( auto& resources : m_viewResources ) {
+			if( !resources.m_created ) continue;
+			vvh::BufDestroyBuffer2({
+				.m_device 		= m_vkState().m_device, 
+				.m_vmaAllocator = m_vkState().m_vmaAllocator, 
+				.m_buffers 		= resources.m_uniformBuffers
+			});
+		}
+
 		vkDestroyDescriptorSetLayout(m_vkState().m_device, m_descriptorSetLayoutPerFrame, nullptr);
 
 		return false;
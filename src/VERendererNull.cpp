@@ -0,0 +1,228 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+namespace vve {
+
+    /**
+     * @brief Constructor for the null renderer, registers for the same messages as the Vulkan renderers
+     * @param systemName Name of the system
+     * @param engine Reference to the engine
+     * @param windowName Name of the associated window
+     */
+    RendererNull::RendererNull(std::string systemName, Engine& engine, std::string windowName )
+		: Renderer(systemName, engine, windowName ) {
+
+        engine.RegisterCallbacks( { 
+			{this,   1000, "INIT", [this](Message& message){ return OnInit(message);} }, 
+			{this,   1000, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
+			{this,   2000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} },
+			{this,   1000, "TEXTURE_CREATE",   [this](Message& message){ return OnTextureCreate(message);} },
+			{this,      0, "TEXTURE_DESTROY",  [this](Message& message){ return OnTextureDestroy(message);} },
+			{this,      0, "MESH_CREATE",  [this](Message& message){ return OnMeshCreate(message);} },
+			{this,      0, "MESH_DESTROY", [this](Message& message){ return OnMeshDestroy(message);} },
+			{this,   2000, "OBJECT_CREATE", [this](Message& message){ return OnObjectCreate(message);} },
+			{this,   2000, "OBJECTS_CREATE", [this](Message& message){ return OnObjectsCreate(message);} },
+			{this,  10000, "OBJECT_DESTROY", [this](Message& message){ return OnObjectDestroy(message);} },
+			{this,      0, "MEMORY_REPORT", [this](Message& message){ return OnMemoryReport(message);} },
+			{this,   2000, "QUIT", [this](Message& message){ return OnQuit(message);} },
+		} );
+    }
+
+    /**
+     * @brief Destructor for the null renderer
+     */
+    RendererNull::~RendererNull() {}
+
+    /**
+     * @brief Get the window state and create an ImGui context without a backend
+     * @param message Initialization message
+     * @return false to continue message propagation
+     */
+    bool RendererNull::OnInit(Message message) {
+		auto [handle, stateW] = Window::GetState(m_registry);
+		m_windowState = stateW;
+
+		ImGui::CreateContext();
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2{ (float)m_windowState().m_width, (float)m_windowState().m_height };
+		io.Fonts->Build();
+		return false;
+	}
+
+    /**
+     * @brief Start a new ImGui frame
+     * @param message Prepare next frame message
+     * @return false to continue message propagation
+     */
+    bool RendererNull::OnPrepareNextFrame(Message message) {
+		ImGuiIO& io = ImGui::GetIO();
+		io.DisplaySize = ImVec2{ (float)m_windowState().m_width, (float)m_windowState().m_height };
+		io.DeltaTime = std::max((float)message.GetDt(), 1e-6f);
+        ImGui::NewFrame();
+		return false;
+	}
+
+    /**
+     * @brief Count what would be drawn and end the ImGui frame
+     * @param message Record next frame message
+     * @return false to continue message propagation
+     */
+    bool RendererNull::OnRecordNextFrame(Message message) {
+		m_stats.m_drawCalls = m_stats.m_triangles = 0;
+		auto views = GetRenderViews();
+		if( views.empty() ) {
+			CountObjects(nullptr, m_stats.m_drawCalls, m_stats.m_triangles);
+		}
+		for( auto handle : views ) {
+			auto view = m_registry.template Get<RenderView&>(handle);
+			view().m_stats.m_drawCalls = view().m_stats.m_triangles = 0;
+			CountObjects(&view(), view().m_stats.m_drawCalls, view().m_stats.m_triangles);
+			m_stats.m_drawCalls += view().m_stats.m_drawCalls;
+			m_stats.m_triangles += view().m_stats.m_triangles;
+		}
+		++m_stats.m_frames;
+		ImGui::Render();
+		return false;
+	}
+
+	/**
+	 * @brief Count the draw calls and triangles of the visible objects
+	 * @param view Render view, or nullptr if there are no views
+	 * @param drawCalls Receives the number of draw calls
+	 * @param triangles Receives the number of triangles
+	 */
+	void RendererNull::CountObjects(const RenderView* view, size_t& drawCalls, size_t& triangles) {
+		for( auto value : m_objects ) {
+			vecs::Handle oHandle{value};
+			if( view != nullptr ? !IsVisibleInView(oHandle, *view) : !IsVisible(oHandle) ) continue;
+			auto mesh = m_registry.template Get<MeshHandle>(oHandle);
+			if( !m_registry.Exists(mesh) ) continue;
+			++drawCalls;
+			triangles += m_registry.template Get<vvh::Mesh&>(mesh)().m_indices.size() / 3;
+		}
+	}
+
+	/**
+	 * @brief Record the texel bytes of a new texture
+	 * @param message Message containing the texture handle
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnTextureCreate( Message message ) {
+		auto msg = message.template GetData<MsgTextureCreate>();
+		auto texture = m_registry.template Get<vvh::Image&>(msg.m_handle);
+		m_textureBytes[msg.m_handle().GetValue()] = (size_t)texture().m_size;
+		m_stats.m_textureBytes += (size_t)texture().m_size;
+		m_stats.m_textures = m_textureBytes.size();
+		return false;
+	}
+
+	/**
+	 * @brief Forget a texture and erase it, like the Vulkan renderer does
+	 * @param message Message containing the texture handle
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnTextureDestroy( Message message ) {
+		auto handle = message.template GetData<MsgTextureDestroy>().m_handle;
+		if( auto it = m_textureBytes.find(handle().GetValue()); it != m_textureBytes.end() ) {
+			m_stats.m_textureBytes -= it->second;
+			m_textureBytes.erase(it);
+		}
+		m_stats.m_textures = m_textureBytes.size();
+		m_registry.Erase(handle);
+		return false;
+	}
+
+	/**
+	 * @brief Record the vertex and index bytes of a new mesh
+	 * @param message Message containing the mesh handle
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnMeshCreate( Message message ) {
+		auto handle = message.template GetData<MsgMeshCreate>().m_handle;
+		auto mesh = m_registry.template Get<vvh::Mesh&>(handle);
+		size_t bytes = (size_t)mesh().m_verticesData.getSize() + mesh().getIndexSize();
+		m_meshBytes[handle().GetValue()] = bytes;
+		m_stats.m_bufferBytes += bytes;
+		m_stats.m_meshes = m_meshBytes.size();
+		return false;
+	}
+
+	/**
+	 * @brief Forget a mesh and erase it, like the Vulkan renderer does
+	 * @param message Message containing the mesh handle
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnMeshDestroy( Message message ) {
+		auto handle = message.template GetData<MsgMeshDestroy>().m_handle;
+		if( auto it = m_meshBytes.find(handle().GetValue()); it != m_meshBytes.end() ) {
+			m_stats.m_bufferBytes -= it->second;
+			m_meshBytes.erase(it);
+		}
+		m_stats.m_meshes = m_meshBytes.size();
+		m_registry.Erase(handle);
+		return false;
+	}
+
+	/**
+	 * @brief Track a new object if it has a mesh
+	 * @param message Message containing the object handle
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnObjectCreate( Message message ) {
+		auto oHandle = message.template GetData<MsgObjectCreate>().m_object;
+		if( m_registry.template Has<MeshHandle>(oHandle) ) m_objects.insert(oHandle().GetValue());
+		m_stats.m_objects = m_objects.size();
+		return false;
+	}
+
+	/**
+	 * @brief Track a batch of new objects
+	 * @param message Message containing the object handles
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnObjectsCreate( Message message ) {
+		auto msg = message.template GetData<MsgObjectsCreate>();
+		for( auto& oHandle : msg.m_objects ) {
+			if( m_registry.template Has<MeshHandle>(oHandle) ) m_objects.insert(oHandle().GetValue());
+		}
+		m_stats.m_objects = m_objects.size();
+		return false;
+	}
+
+	/**
+	 * @brief Forget a destroyed object
+	 * @param message Message containing the object handle
+	 * @return false to continue message propagation
+	 */
+	bool RendererNull::OnObjectDestroy( Message message ) {
+		auto msg = message.template GetData<MsgObjectDestroy>();
+		m_objects.erase(msg.m_handle().GetValue());
+		m_stats.m_objects = m_objects.size();
+		return false;
+	}
+
+    /**
+     * @brief Add the resource bookkeeping to a memory report
+     * @param message Memory report message
+     * @return false to continue message propagation
+     */
+	bool RendererNull::OnMemoryReport(Message message) {
+		auto& msg = message.template GetData<MsgMemoryReport>();
+		size_t bytes = MemoryReport::HashMapBytes(m_meshBytes) + MemoryReport::HashMapBytes(m_textureBytes) + MemoryReport::HashMapBytes(m_objects);
+		MemoryReport::Add(msg.m_report->m_systems, "Null renderer bookkeeping", m_meshBytes.size() + m_textureBytes.size() + m_objects.size(), bytes);
+		return false;
+	}
+
+    /**
+     * @brief Destroy the ImGui context
+     * @param message Quit message
+     * @return false to continue message propagation
+     */
+    bool RendererNull::OnQuit(Message message) {
+		ImGui::DestroyContext();
+		return false;
+	}
+
+};   // namespace vve
+
@@ -18,6 +18,8 @@ namespace vve {
 			{this,  1800, "PREPARE_NEXT_FRAME", [this](Message& message){ return OnPrepareNextFrame(message);} },
 			//{this,  1990, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} },
 			{this,  1700, "OBJECT_CREATE",		[this](Message& message) { return OnObjectCreate(message); } },
+			{this,  1700, "OBJECTS_CREATE",		[this](Message& message) { return OnObjectsCreate(message); } },
+			{this,  1700, "OBJECTS_ASSETS_CHANGED", [this](Message& message) { return OnObjectsAssetsChanged(message); } },
 			{this, 10000, "OBJECT_DESTROY",		[this](Message& message) { return OnObjectDestroy(message); } },
 			{this,  1800, "OBJECT_CHANGED",		 [this](Message& message) { return OnObjectChanged(message); } },
 			{this,     0, "QUIT", [this](Message& message){ return OnQuit(message);} }
@@ -63,39 +65,14 @@ namespace vve {
 		}
 
 
-		vvh::RenCreateDescriptorPool({ 
-			.m_device = m_vkState().m_device, 
-			.m_sizes = 1000, 
-			.m_descriptorPool = m_descriptorPool 
-			});
-
 		vvh::RenCreateDescriptorSetLayout({ 
 			.m_device = m_vkState().m_device,
 			.m_bindings = { {.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .stageFlags = VK_SHADER_STAGE_VERTEX_BIT } },
 			.m_descriptorSetLayout = m_descriptorSetLayoutPerObject 
 			});
 
-		std::vector<VkVertexInputBindingDescription> bindingDescriptions = getBindingDescriptions("P");
-		std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions("P");
-
-		// TODO: Move shadow into own folder so deferred AND forward can use it
-		vvh::RenCreateGraphicsPipeline({
-			.m_device = m_vkState().m_device,
-			.m_renderPass = m_renderPass,
-			.m_vertShaderPath = "shaders/Deferred/Shadow11.spv", 
-			.m_fragShaderPath = "shaders/Deferred/Shadow11.spv",
-			.m_bindingDescription = bindingDescriptions, 
-			.m_attributeDescriptions = attributeDescriptions,
-			.m_descriptorSetLayouts = { m_descriptorSetLayoutPerObject },
-			.m_specializationConstants = {},
-			.m_pushConstantRanges = { {.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, .offset = 0, .size = sizeof(PushConstantShadow)} },
-			.m_blendAttachments = {},
-			.m_graphicsPipeline = m_shadowPipeline,
-			.m_attachmentFormats = {}, //
-			.m_depthFormat = m_vkState().m_depthMapFormat,
-			.m_depthWrite = true,
-			.m_cullModeFlagBits = VK_CULL_MODE_FRONT_BIT
-		});	
+		// pipelines for quantized and interleaved positions are created when a mesh needs them
+		CreateShadowPipeline("P", "", m_shadowPipeline);
 
 		std::cout << "Pipeline Shadow" << std::endl;
 
@@ -358,27 +335,57 @@ namespace vve {
 	 * @return False to continue processing
 	 */
 	bool RendererShadow11::OnObjectCreate(Message& message) {
-		const ObjectHandle& oHandle = message.template GetData<MsgObjectCreate>().m_object;
-		if (m_registry.template Has<DirectionalLight>(oHandle)) return false;	// Object without mesh, e.g. direct light
-
-		assert(m_registry.template Has<MeshHandle>(oHandle));
-
-		vvh::DescriptorSet descriptorSet{ 0 };
-		vvh::RenCreateDescriptorSet({
-			.m_device = m_vkState().m_device,
-			.m_descriptorSetLayouts = m_descriptorSetLayoutPerObject,
-			.m_descriptorPool = m_descriptorPool,
-			.m_descriptorSet = descriptorSet
-			});
+		ObjectHandle oHandle = message.template GetData<MsgObjectCreate>().m_object;
+		CreateObjectResources({ &oHandle, 1 });
+		m_state = State::STATE_NEW;
+		return false;
+	}
 
-		m_registry.AddTags(oHandle, (size_t)m_shadowPipeline.m_pipeline);
-		oShadowDescriptor ds = { descriptorSet };
-		m_registry.Put(oHandle, ds);
+	/**
+	 * @brief Handle batch object creation, the shadow map is invalidated once for the whole batch
+	 * @param message Batch object creation message containing the object handles
+	 * @return False to continue processing
+	 */
+	bool RendererShadow11::OnObjectsCreate(Message& message) {
+		const auto& msg = message.template GetData<MsgObjectsCreate>();
+		CreateObjectResources(msg.m_objects);
+		m_state = State::STATE_NEW;
+		return false;
+	}
 
+	/**
+	 * @brief Handle objects that got a new mesh or texture, the shadow pipeline does not depend on them but the
+	 * shadow map must be rendered again
+	 * @param message Message containing the object handles
+	 * @return False to continue processing
+	 */
+	bool RendererShadow11::OnObjectsAssetsChanged(Message& message) {
 		m_state = State::STATE_NEW;
 		return false;
 	}
 
+	/**
+	 * @brief Allocate the shadow descriptor sets of a batch of objects with one call
+	 * @param objects Handles of the objects
+	 */
+	void RendererShadow11::CreateObjectResources(std::span<const ObjectHandle> objects) {
+		std::vector<ObjectHandle> handles;
+		for (const auto& oHandle : objects) {
+			if (m_registry.template Has<DirectionalLight>(oHandle)) continue;	// Object without mesh, e.g. direct light
+			assert(m_registry.template Has<MeshHandle>(oHandle));
+			handles.push_back(oHandle);
+		}
+
+		std::vector<vvh::DescriptorSet> descriptorSets;
+		CreateObjectDescriptorSets(std::vector<VkDescriptorSetLayout>(handles.size(), m_descriptorSetLayoutPerObject), descriptorSets);
+
+		for (size_t i = 0; i < handles.size(); ++i) {
+			m_registry.AddTags(handles[i], (size_t)m_shadowPipeline.m_pipeline);
+			oShadowDescriptor ds = { descriptorSets[i] };
+			m_registry.Put(handles[i], ds);
+		}
+	}
+
 	/**
 	 * @brief Handle object destruction by freeing shadow descriptor sets
 	 * @param message Object destruction message containing object handle
@@ -389,9 +396,7 @@ namespace vve {
 		const auto& oHandle = msg.m_handle();
 		if (m_registry.template Has<oShadowDescriptor&>(oHandle)) {
 			oShadowDescriptor& vvh_ds = m_registry.template Get<oShadowDescriptor&>(oHandle);
-			for (auto& ds : vvh_ds.m_oShadowDescriptor.m_descriptorSetPerFrameInFlight) {
-				vkFreeDescriptorSets(m_vkState().m_device, m_descriptorPool, 1, &ds);
-			}
+			FreeObjectDescriptorSet(vvh_ds.m_oShadowDescriptor);
 		}
 
 		m_state = State::STATE_NEW;
@@ -423,12 +428,16 @@ namespace vve {
 			vkDestroyCommandPool(m_vkState().m_device, pool, nullptr);
 		}
 
-        vkDestroyDescriptorPool(m_vkState().m_device, m_descriptorPool, nullptr);
+        DestroyObjectResources();
 		vkDestroyRenderPass(m_vkState().m_device, m_renderPass, nullptr);
 		vkDestroyDescriptorSetLayout(m_vkState().m_device, m_descriptorSetLayoutPerObject, nullptr);
 
 		vkDestroyPipeline(m_vkState().m_device, m_shadowPipeline.m_pipeline, nullptr);
 		vkDestroyPipelineLayout(m_vkState().m_device, m_shadowPipeline.m_pipelineLayout, nullptr);
+		for (auto& [layout, pipeline] : m_shadowPipelineVariants) {
+			vkDestroyPipeline(m_vkState().m_device, pipeline.m_pipeline, nullptr);
+			vkDestroyPipelineLayout(m_vkState().m_device, pipeline.m_pipelineLayout, nullptr);
+		}
 
 		vvh::ImgDestroyImage({ 
 			.m_device = m_vkState().m_device, 
@@ -678,6 +687,8 @@ namespace vve {
 			.m_clearValues = m_clearValue
 		});
 
+		// All pipelines have the same layout, so the push constants stay valid when switching
+		VkPipeline bound{ VK_NULL_HANDLE };
 		for (auto [oHandle, ghandle, descriptorset] :
 			m_registry.template GetView<vecs::Handle, MeshHandle, oShadowDescriptor&>
 			({ (size_t)m_shadowPipeline.m_pipeline })) {
@@ -686,14 +697,21 @@ namespace vve {
 				// Renders depth image without the point or spot light sphere
 				continue;
 			}
+			// The shadow map is only redrawn when objects change, so camera dependent culling (portals, impostors) is not applied
+			if (m_registry.template Has<ShadowCaster>(oHandle) && !m_registry.template Get<ShadowCaster>(oHandle)()) continue;
 
 			const vvh::Mesh& mesh = m_registry.template Get<vvh::Mesh&>(ghandle);
+			const vvh::Pipeline& pipeline = getShadowPipeline(mesh.m_verticesData);
+			if (pipeline.m_pipeline != bound) {
+				vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.m_pipeline);
+				bound = pipeline.m_pipeline;
+			}
 
 			vvh::ComRecordObject({
 				.m_commandBuffer = cmdBuffer,
-				.m_graphicsPipeline = m_shadowPipeline,
+				.m_graphicsPipeline = pipeline,
 				.m_descriptorSets = { descriptorset().m_oShadowDescriptor },
-				.m_type = "P",
+				.m_type = mesh.m_verticesData.m_quantized ? "PQ" : "P",
 				.m_mesh = mesh,
 				.m_currentFrame = m_vkState().m_currentFrame
 				});
@@ -702,4 +720,52 @@ namespace vve {
 		vvh::ComEndRenderPass({ .m_commandBuffer = cmdBuffer });
 	}
 
+	/**
+	 * @brief Create a shadow pipeline for a vertex layout
+	 * @param type "P", with Q for quantized and I for interleaved positions
+	 * @param layout Streams of the interleaved vertices, empty for separate streams
+	 * @param pipeline The new pipeline
+	 */
+	void RendererShadow11::CreateShadowPipeline(const std::string& type, const std::string& layout, vvh::Pipeline& pipeline) {
+		std::vector<VkVertexInputBindingDescription> bindingDescriptions = getBindingDescriptions(type, layout);
+		std::vector<VkVertexInputAttributeDescription> attributeDescriptions = getAttributeDescriptions(type, layout);
+
+		// TODO: Move shadow into own folder so deferred AND forward can use it
+		vvh::RenCreateGraphicsPipeline({
+			.m_device = m_vkState().m_device,
+			.m_renderPass = m_renderPass,
+			.m_vertShaderPath = "shaders/Deferred/Shadow11.spv", 
+			.m_fragShaderPath = "shaders/Deferred/Shadow11.spv",
+			.m_bindingDescription = bindingDescriptions, 
+			.m_attributeDescriptions = attributeDescriptions,
+			.m_descriptorSetLayouts = { m_descriptorSetLayoutPerObject },
+			.m_specializationConstants = {},
+			.m_pushConstantRanges = { {.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, .offset = 0, .size = sizeof(PushConstantShadow)} },
+			.m_blendAttachments = {},
+			.m_graphicsPipeline = pipeline,
+			.m_attachmentFormats = {}, //
+			.m_depthFormat = m_vkState().m_depthMapFormat,
+			.m_depthWrite = true,
+			.m_cullModeFlagBits = VK_CULL_MODE_FRONT_BIT
+		});	
+	}
+
+	/**
+	 * @brief Get the shadow pipeline that reads the positions of a mesh, created if it does not exist yet
+	 * @param vertexData Vertex data of the mesh
+	 * @return The pipeline
+	 */
+	auto RendererShadow11::getShadowPipeline(const vvh::VertexData& vertexData) -> const vvh::Pipeline& {
+		if (!vertexData.m_quantized && !vertexData.m_interleaved) [[likely]] return m_shadowPipeline;
+
+		// interleaved positions need the stride of the whole vertex, so the layout is part of the key
+		std::string type = std::string{ "P" } + (vertexData.m_quantized ? "Q" : "") + (vertexData.m_interleaved ? "I" : "");
+		std::string layout = vertexData.m_interleaved ? vvh::VertexData::getStreams(vertexData.getType()) : "";
+		auto it = m_shadowPipelineVariants.find(type + layout);
+		if (it != m_shadowPipelineVariants.end()) return it->second;
+		auto& pipeline = m_shadowPipelineVariants[type + layout];
+		CreateShadowPipeline(type, layout, pipeline);
+		return pipeline;
+	}
+
 };   // namespace vve
\ No newline at end of file
@@ -278,6 +278,8 @@ namespace vve {
 		m_vkState().m_commandBuffersSubmit.clear();
 
 		vkWaitForFences(m_vkState().m_device, 1, &m_fences[m_vkState().m_currentFrame], VK_TRUE, UINT64_MAX);
+		DestroyTextureUploads(m_uploadsInFlight[m_vkState().m_currentFrame]);
+		WriteDynamicMeshes();
 
         VkResult result = vkAcquireNextImageKHR(
 							m_vkState().m_device, 
@@ -336,7 +338,7 @@ namespace vve {
         vkResetCommandBuffer(m_commandBuffers[m_vkState().m_currentFrame],  0);
 
 		vvh::ComBeginCommandBuffer({.m_commandBuffer = m_commandBuffers[m_vkState().m_currentFrame]});
-
+		RecordTextureUploads(m_commandBuffers[m_vkState().m_currentFrame]);
 
 		vvh::ComBeginRenderPass({
 			.m_commandBuffer 	= m_commandBuffers[m_vkState().m_currentFrame], 
@@ -438,6 +440,8 @@ namespace vve {
      */
     bool RendererVulkan::OnQuit(Message message) {
         vkDeviceWaitIdle(m_vkState().m_device);
+		DestroyTextureUploads(m_textureUploads);
+		for( auto& uploads : m_uploadsInFlight ) { DestroyTextureUploads(uploads); }
 
         vvh::DevCleanupSwapChain({
 			.m_device 		= m_vkState().m_device, 
@@ -522,7 +526,9 @@ namespace vve {
 	//-------------------------------------------------------------------------------------------------------
 
 	/**
-	 * @brief Creates a Vulkan texture from image data
+	 * @brief Creates a Vulkan texture from image data. The image, its view and sampler are created now, the pixels
+	 * are copied to a staging buffer and uploaded in the next frame. Uncompressed textures with only one level get a
+	 * full mip chain, which is blitted on the GPU in the same frame.
 	 * @param message Message containing texture creation parameters
 	 * @return false to continue message propagation
 	 */
@@ -530,25 +536,206 @@ namespace vve {
 		auto msg = message.template GetData<MsgTextureCreate>();
 		auto handle = msg.m_handle;
 		auto texture = m_registry.template Get<vvh::Image&>(handle);
-		auto pixels = texture().m_pixels;
+		if( TextureCooker::IsCompressed(texture().m_format) ) {
+			VkFormatProperties properties;
+			vkGetPhysicalDeviceFormatProperties(m_vkState().m_physicalDevice, texture().m_format, &properties);
+			bool sampled = properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+			if( !sampled && !DecompressTexture(texture()) ) {
+				throw std::runtime_error("texture format is not supported by the device!");
+			}
+		}
 
-		vvh::ImgCreateTextureImage({
-			m_vkState().m_physicalDevice, 
-			m_vkState().m_device, 
-			m_vkState().m_vmaAllocator, 
-			m_vkState().m_graphicsQueue, 
-			m_commandPool, 
-			pixels, 
-			texture().m_width, 
-			texture().m_height, 
-			texture().m_size, 
-			texture
+		uint32_t width = (uint32_t)texture().m_width, height = (uint32_t)texture().m_height;
+		uint32_t levels = texture().m_mipLevels;
+		bool generate = levels == 1 && !TextureCooker::IsCompressed(texture().m_format) && CanGenerateMips(texture().m_format);
+		if( generate ) texture().m_mipLevels = (uint32_t)std::floor(std::log2(std::max(width, height))) + 1;
+
+		TextureUpload upload{ VK_NULL_HANDLE, VK_NULL_HANDLE, nullptr, width, height, levels, texture().m_mipLevels, texture().m_mipOffsets };
+		if( upload.m_offsets.empty() ) upload.m_offsets.push_back(0);
+		VmaAllocationInfo allocInfo;
+		vvh::BufCreateBuffer({
+			.m_vmaAllocator = m_vkState().m_vmaAllocator,
+			.m_size 		= texture().m_size,
+			.m_usageFlags 	= VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			.m_properties 	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			.m_vmaFlags 	= VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+			.m_buffer 		= upload.m_buffer,
+			.m_allocation 	= upload.m_allocation,
+			.m_allocationInfo = &allocInfo
 		});
+		memcpy(allocInfo.pMappedData, texture().m_pixels, texture().m_size);
+
+		vvh::ImgCreateImage({
+			.m_physicalDevice 	= m_vkState().m_physicalDevice,
+			.m_device 			= m_vkState().m_device,
+			.m_vmaAllocator 	= m_vkState().m_vmaAllocator,
+			.m_width 			= width,
+			.m_height 			= height,
+			.m_depth 			= 1,
+			.m_layers 			= 1,
+			.m_mipLevels 		= texture().m_mipLevels,
+			.m_format 			= texture().m_format,
+			.m_tiling 			= VK_IMAGE_TILING_OPTIMAL,
+			.m_usage 			= VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | (generate ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0u),
+			.m_imageLayout 		= VK_IMAGE_LAYOUT_UNDEFINED,
+			.m_properties 		= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			.m_image 			= texture().m_mapImage,
+			.m_imageAllocation 	= texture().m_mapImageAllocation
+		});
+		upload.m_image = texture().m_mapImage;
+		m_textureUploads.push_back(std::move(upload));
+
 		vvh::ImgCreateTextureImageView({m_vkState().m_device, texture});
 		vvh::ImgCreateTextureSampler({m_vkState().m_physicalDevice, m_vkState().m_device, texture});
 		return false;
 	}
 
+	/**
+	 * @brief Check if mips of a format can be generated with linear blits
+	 * @param format The format
+	 * @return true if the format supports linear filtering and blits from and to optimal images
+	 */
+	auto RendererVulkan::CanGenerateMips( VkFormat format ) -> bool {
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(m_vkState().m_physicalDevice, format, &properties);
+		VkFormatFeatureFlags needed = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+		return (properties.optimalTilingFeatures & needed) == needed;
+	}
+
+	/**
+	 * @brief Record the copies and mip blits of all textures created since the last frame. All images go to
+	 * transfer destination with one barrier, then the given levels are copied. Each generated level is blitted from
+	 * the previous one with a linear filter, sRGB images are filtered in linear space by the blit. Before the blits
+	 * of a level, one barrier turns the previous level of all images into a transfer source. A last barrier makes all
+	 * levels readable by shaders. Barriers in this command buffer also order the shader reads of command buffers
+	 * submitted later in the frame. The staging buffers are freed when the frame is done.
+	 * @param commandBuffer The command buffer of the frame, outside a render pass
+	 */
+	void RendererVulkan::RecordTextureUploads( VkCommandBuffer commandBuffer ) {
+		if( m_textureUploads.empty() ) return;
+
+		auto barrier = [](VkImage image, uint32_t baseLevel, uint32_t levels, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess) {
+			VkImageMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.oldLayout = oldLayout;
+			barrier.newLayout = newLayout;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = image;
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, baseLevel, levels, 0, 1 };
+			barrier.srcAccessMask = srcAccess;
+			barrier.dstAccessMask = dstAccess;
+			return barrier;
+		};
+		auto pipelineBarrier = [&](std::vector<VkImageMemoryBarrier>& barriers, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage) {
+			if( !barriers.empty() ) vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, (uint32_t)barriers.size(), barriers.data());
+			barriers.clear();
+		};
+
+		std::vector<VkImageMemoryBarrier> barriers;
+		uint32_t maxLevels = 0;
+		for( auto& upload : m_textureUploads ) {
+			barriers.push_back( barrier(upload.m_image, 0, upload.m_mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT) );
+			maxLevels = std::max(maxLevels, upload.m_mipLevels);
+		}
+		pipelineBarrier(barriers, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+		for( auto& upload : m_textureUploads ) {
+			std::vector<VkBufferImageCopy> regions;
+			for( uint32_t level = 0; level < upload.m_levels && level < upload.m_offsets.size(); ++level ) {
+				VkBufferImageCopy region{};
+				region.bufferOffset = upload.m_offsets[level];
+				region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+				region.imageExtent = { std::max(1u, upload.m_width >> level), std::max(1u, upload.m_height >> level), 1 };
+				regions.push_back(region);
+			}
+			vkCmdCopyBufferToImage(commandBuffer, upload.m_buffer, upload.m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.size(), regions.data());
+		}
+
+		for( uint32_t level = 1; level < maxLevels; ++level ) {
+			auto blitted = [&](const TextureUpload& upload) { return level >= upload.m_levels && level < upload.m_mipLevels; };
+			for( auto& upload : m_textureUploads ) {
+				if( !blitted(upload) ) continue;
+				barriers.push_back( barrier(upload.m_image, level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT) );
+			}
+			pipelineBarrier(barriers, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+			for( auto& upload : m_textureUploads ) {
+				if( !blitted(upload) ) continue;
+				VkImageBlit blit{};
+				blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1 };
+				blit.srcOffsets[1] = { (int32_t)std::max(1u, upload.m_width >> (level - 1)), (int32_t)std::max(1u, upload.m_height >> (level - 1)), 1 };
+				blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+				blit.dstOffsets[1] = { (int32_t)std::max(1u, upload.m_width >> level), (int32_t)std::max(1u, upload.m_height >> level), 1 };
+				vkCmdBlitImage(commandBuffer, upload.m_image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, upload.m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+			}
+		}
+
+		// levels that were blit sources are transfer sources now, all others are still transfer destinations
+		for( auto& upload : m_textureUploads ) {
+			uint32_t firstSource = upload.m_mipLevels > upload.m_levels ? upload.m_levels - 1 : upload.m_mipLevels;
+			uint32_t sources = upload.m_mipLevels > upload.m_levels ? upload.m_mipLevels - upload.m_levels : 0;
+			VkAccessFlags read = VK_ACCESS_SHADER_READ_BIT;
+			if( firstSource > 0 ) barriers.push_back( barrier(upload.m_image, 0, firstSource, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, read) );
+			if( sources > 0 ) {
+				barriers.push_back( barrier(upload.m_image, firstSource, sources, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, read) );
+				barriers.push_back( barrier(upload.m_image, upload.m_mipLevels - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, read) );
+			}
+		}
+		pipelineBarrier(barriers, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+		auto& inFlight = m_uploadsInFlight[m_vkState().m_currentFrame];
+		for( auto& upload : m_textureUploads ) { inFlight.push_back(std::move(upload)); }
+		m_textureUploads.clear();
+	}
+
+	/**
+	 * @brief Destroy the staging buffers of uploads
+	 * @param uploads The uploads, cleared
+	 */
+	void RendererVulkan::DestroyTextureUploads( std::vector<TextureUpload>& uploads ) {
+		for( auto& upload : uploads ) {
+			vvh::BufDestroyBuffer({ m_vkState().m_device, m_vkState().m_vmaAllocator, upload.m_buffer, upload.m_allocation });
+		}
+		uploads.clear();
+	}
+
+	/**
+	 * @brief Decode a block compressed texture to RGBA8 on the CPU, for devices that cannot sample its format.
+	 * The pixels are owned by the asset manager and freed with stbi_image_free, so the new pixels are allocated
+	 * with malloc as well.
+	 * @param texture The texture, its pixels are replaced
+	 * @return false if the texture could not be decoded
+	 */
+	auto RendererVulkan::DecompressTexture( vvh::Image& texture ) -> bool {
+		CookedTexture cooked{ texture.m_format, (uint32_t)texture.m_width, (uint32_t)texture.m_height };
+		std::vector<std::vector<uint8_t>> levels;
+		VkDeviceSize size = 0;
+		for( uint32_t level = 0; level < texture.m_mipLevels; ++level ) {
+			uint32_t w = std::max(1u, cooked.m_width >> level), h = std::max(1u, cooked.m_height >> level);
+			auto begin = (uint8_t*)texture.m_pixels + (level < texture.m_mipOffsets.size() ? texture.m_mipOffsets[level] : 0);
+			cooked.m_levels.emplace_back(begin, begin + TextureCooker::LevelBytes(texture.m_format, w, h));
+			levels.push_back(TextureCooker::Decode(cooked, level));
+			if( levels.back().empty() ) return false;
+			size += levels.back().size();
+		}
+
+		bool srgb = texture.m_format == VK_FORMAT_BC1_RGB_SRGB_BLOCK || texture.m_format == VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+			|| texture.m_format == VK_FORMAT_BC3_SRGB_BLOCK || texture.m_format == VK_FORMAT_BC7_SRGB_BLOCK;
+		stbi_image_free(texture.m_pixels);
+		texture.m_pixels = malloc(size);
+		texture.m_size = 0;
+		texture.m_mipOffsets.clear();
+		for( auto& level : levels ) {
+			memcpy((uint8_t*)texture.m_pixels + texture.m_size, level.data(), level.size());
+			texture.m_mipOffsets.push_back(texture.m_size);
+			texture.m_size += level.size();
+		}
+		texture.m_format = srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+		return true;
+	}
+
 	/**
 	 * @brief Destroys a Vulkan texture and frees associated resources
 	 * @param message Message containing texture handle to destroy
@@ -557,6 +744,10 @@ namespace vve {
 	bool RendererVulkan::OnTextureDestroy( Message message ) {
 		auto handle = message.template GetData<MsgTextureDestroy>().m_handle;
 		auto texture = m_registry.template Get<vvh::Image&>(handle);
+		auto pending = std::ranges::partition(m_textureUploads, [&](auto& upload) { return upload.m_image != texture().m_mapImage; });
+		std::vector<TextureUpload> unused{ std::make_move_iterator(pending.begin()), std::make_move_iterator(pending.end()) };
+		m_textureUploads.erase(pending.begin(), pending.end());
+		DestroyTextureUploads(unused);
 		vkDestroySampler(m_vkState().m_device, texture().m_mapSampler, nullptr);
 		vkDestroyImageView(m_vkState().m_device, texture().m_mapImageView, nullptr);
 		vvh::ImgDestroyImage({
@@ -577,6 +768,11 @@ namespace vve {
 	bool RendererVulkan::OnMeshCreate( Message message ) {
 		auto handle = message.template GetData<MsgMeshCreate>().m_handle;
 		auto mesh = m_registry.template Get<vvh::Mesh&>(handle);
+		if( mesh().m_dynamic ) {
+			vvh::BufCreateDynamicMeshBuffers({ m_vkState().m_vmaAllocator, mesh });
+			m_dynamicMeshes.push_back(handle());
+			return false;
+		}
 		vvh::BufCreateVertexBuffer({
 			m_vkState().m_physicalDevice, m_vkState().m_device, m_vkState().m_vmaAllocator, m_vkState().m_graphicsQueue, m_commandPool, mesh
 		});
@@ -606,10 +802,27 @@ namespace vve {
 			.m_buffer 		= mesh().m_vertexBuffer, 
 			.m_allocation 	= mesh().m_vertexBufferAllocation
 		});
+		if( mesh().m_dynamic ) std::erase(m_dynamicMeshes, handle());
 		m_registry.Erase(handle);
 		return false;
 	}
 
+	/**
+	 * @brief Copies the data of the dynamic meshes to their buffer regions of the current frame, after its fence
+	 * was waited for. Buffers that are too small are created again, the other frame in flight must be finished first.
+	 */
+	void RendererVulkan::WriteDynamicMeshes() {
+		for( auto handle : m_dynamicMeshes ) {
+			auto mesh = m_registry.template Get<vvh::Mesh&>(handle);
+			if( vvh::BufWriteDynamicMesh({ mesh, m_vkState().m_currentFrame }) ) continue;
+			vkDeviceWaitIdle(m_vkState().m_device);
+			vvh::BufDestroyBuffer({ m_vkState().m_device, m_vkState().m_vmaAllocator, mesh().m_indexBuffer, mesh().m_indexBufferAllocation });
+			vvh::BufDestroyBuffer({ m_vkState().m_device, m_vkState().m_vmaAllocator, mesh().m_vertexBuffer, mesh().m_vertexBufferAllocation });
+			vvh::BufCreateDynamicMeshBuffers({ m_vkState().m_vmaAllocator, mesh });
+			vvh::BufWriteDynamicMesh({ mesh, m_vkState().m_currentFrame });
+		}
+	}
+
 
 
 };   // namespace vve
\ No newline at end of file
@@ -22,7 +22,10 @@ namespace vve {
 			{this,  							 0, "WINDOW_SIZE", [this](Message& message){ return OnWindowSize(message);} },
 			{this, std::numeric_limits<int>::max(), "UPDATE", [this](Message& message){ return OnUpdate(message);} },
 			{this,                            1000, "SCENE_CREATE", [this](Message& message){ return OnSceneCreate(message);} },
+			{this,                            1000, "LOAD_STEP", [this](Message& message){ return OnLoadStep(message);} },
+			{this,                               0, "MEMORY_REPORT", [this](Message& message){ return OnMemoryReport(message);} },
 			{this,                               0, "OBJECT_CREATE", [this](Message& message){ return OnObjectCreate(message);} },
+			{this,                               0, "OBJECTS_CREATE", [this](Message& message){ return OnObjectsCreate(message);} },
 			{this, std::numeric_limits<int>::max(), "OBJECT_SET_PARENT", [this](Message& message){ return OnObjectSetParent(message);} },
 			{this,                               0, "OBJECT_DESTROY", [this](Message& message){ return OnObjectDestroy(message);} },
 			{this,                           20000, "OBJECT_DESTROY", [this](Message& message){ return OnObjectDestroy(message);} }
@@ -123,44 +126,69 @@ namespace vve {
 
 
 	/**
-	 * @brief Updates all scene node transformations by traversing the scene hierarchy
+	 * @brief Updates all scene node transformations by traversing the scene hierarchy. The components of all nodes
+	 * are gathered on this thread first, so the workers do not access the registry.
 	 * @param message Update message
 	 * @return false to continue message propagation
 	 */
     bool SceneManager::OnUpdate(Message message) {
-		auto children = m_registry.template Get<Children&>(m_rootHandle);
-
-		auto update = [](auto& registry, mat4_t& parentToWorld, vecs::Handle& handle, auto& self, auto& engine) -> void {
-			auto [name, p, r, s, LtoP, LtoW] = registry.template Get<Name&, Position&, Rotation&, Scale&, LocalToParentMatrix&, LocalToWorldMatrix&>(handle);
-
-			auto temp1 = glm::translate(mat4_t{1.0f}, p()) * mat4_t(r()) * glm::scale(mat4_t{1.0f}, s());
-			if (LtoP() != temp1) [[unlikely]] LtoP() = std::move(temp1);
-			auto temp = parentToWorld * LtoP();
-			if (temp != LtoW()) [[unlikely]] {
-				LtoW() = std::move(temp);
-
-				engine.SendMsg(MsgObjectChanged{ ObjectHandle{handle} });
-			}
-			else return;
-			//std::cout << "Handle: " << handle << " Name: " << name() << " Position: " << p().x << ", " << p().y << ", " << p().z << std::endl;
-
-			if( registry.template Has<Camera>(handle) ) {
-				auto [name, camera] = registry.template Get<Name&, Camera&>(handle);
-				registry.Put(handle, ViewMatrix{glm::inverse(LtoW())});
-				registry.Put(handle, ProjectionMatrix{camera().Matrix()});
-				//std::cout << "Camera: " << name() << " R: " << camera.m_aspect << std::endl;
+		const size_t none = std::numeric_limits<size_t>::max();
+		m_transformNodes.clear();
+		m_transformRoots.clear();
+		auto gather = [&](vecs::Handle handle, size_t parent, auto& self) -> void {
+			auto [p, r, s, LtoP, LtoW] = m_registry.template Get<Position&, Rotation&, Scale&, LocalToParentMatrix&, LocalToWorldMatrix&>(handle);
+			bool direct = m_registry.template Has<DirectWorldMatrix>(handle) && m_registry.template Get<DirectWorldMatrix>(handle)(); //set by SetWorldMatrices
+			size_t index = m_transformNodes.size();
+			m_transformNodes.push_back({ handle, &p(), &r(), &s(), &LtoP(), &LtoW(), direct, parent, 0 });
+			if( m_registry.template Has<Children>(handle) ) {
+				for( auto& child : m_registry.template Get<Children&>(handle)() ) { self(child, index, self); }
 			}
+			m_transformNodes[index].m_end = m_transformNodes.size();
+		};
+		for( auto& child : m_registry.template Get<Children&>(m_rootHandle)() ) {
+			m_transformRoots.push_back(m_transformNodes.size());
+			gather(child, none, gather);
+		}
 
-			if( registry.template Has<Children&>(handle) ) {
-				auto children = registry.template Get<Children&>(handle);
-				for( auto& child : children() ) {
-					self(registry, LtoW(), child, self, engine);
+		// Subtrees of the root are independent and updated in parallel, each chunk collects its changed nodes.
+		// Subtrees whose world matrix did not change are skipped. Messages and camera matrices are handled 
+		// afterwards on this thread, in the same order as before.
+		auto update = [&](size_t begin, size_t end, std::vector<vecs::Handle>& changed) {
+			for( size_t i = begin; i < end; ) {
+				auto& node = m_transformNodes[i];
+				if( !node.m_direct ) {
+					auto LtoP = glm::translate(mat4_t{1.0f}, *node.m_position) * mat4_t(*node.m_rotation) * glm::scale(mat4_t{1.0f}, *node.m_scale);
+					if (*node.m_LtoP != LtoP) [[unlikely]] *node.m_LtoP = LtoP;
+				}
+				auto LtoW = (node.m_parent == none ? mat4_t{1.0f} : *m_transformNodes[node.m_parent].m_LtoW) * *node.m_LtoP;
+				if (LtoW != *node.m_LtoW) [[unlikely]] {
+					*node.m_LtoW = LtoW;
+					changed.push_back(node.m_handle);
+					++i;
 				}
+				else i = node.m_end;
 			}
 		};
 
-		for( auto& child : children() ) {
-			update(m_registry, LocalToWorldMatrix{mat4_t{1.0f}}, child, update, m_engine);
+		const size_t chunkSize = 16;
+		std::vector<std::vector<vecs::Handle>> changed((m_transformRoots.size() + chunkSize - 1) / chunkSize);
+		m_engine.GetJobPool().ParallelFor(m_transformRoots.size(), chunkSize, [&](size_t begin, size_t end) {
+			for( size_t i = begin; i < end; ++i ) {
+				update(m_transformRoots[i], m_transformNodes[m_transformRoots[i]].m_end, changed[begin / chunkSize]);
+			}
+		});
+
+		for( auto& handles : changed ) {
+			for( auto& handle : handles ) {
+				m_engine.GetChanges().Touch(handle);
+				m_engine.SendMsg(MsgObjectChanged{ ObjectHandle{handle} });
+
+				if( m_registry.template Has<Camera>(handle) ) {
+					auto [LtoW, camera] = m_registry.template Get<LocalToWorldMatrix&, Camera&>(handle);
+					m_registry.Put(handle, ViewMatrix{glm::inverse(LtoW())});
+					m_registry.Put(handle, ProjectionMatrix{camera().Matrix()});
+				}
+			}
 		}
 		return false;
 	}
@@ -172,6 +200,7 @@ namespace vve {
 	 */
 	bool SceneManager::OnObjectCreate(Message message) {
 		auto& msg = message.template GetData<MsgObjectCreate>();
+		m_engine.GetChanges().Touch(msg.m_object);
 		if( msg.m_sender == this ) return false;
 		ObjectHandle oHandle = msg.m_object;
 		assert( oHandle().IsValid() );
@@ -181,6 +210,27 @@ namespace vve {
 		return false;
 	}
 
+	/**
+	 * @brief Handles batch object creation by attaching all objects to the same parent
+	 * @param message Message containing the object handles and their parent
+	 * @return false to continue message propagation
+	 */
+	bool SceneManager::OnObjectsCreate(Message message) {
+		auto& msg = message.template GetData<MsgObjectsCreate>();
+		for( auto& oHandle : msg.m_objects ) { m_engine.GetChanges().Touch(oHandle); }
+		if( msg.m_sender == this ) return false;
+		ParentHandle pHandle = msg.m_parent;
+		if( !pHandle().IsValid() ) { pHandle = ParentHandle{ m_rootHandle }; }
+
+		auto children = m_registry.template Get<Children&>(pHandle);
+		children().reserve(children().size() + msg.m_objects.size());
+		for( auto& oHandle : msg.m_objects ) {
+			assert( oHandle().IsValid() );
+			SetParent(oHandle, pHandle);
+		}
+		return false;
+	}
+
 	/**
 	 * @brief Creates a scene from loaded 3D model by processing the scene hierarchy
 	 * @param message Message containing scene creation parameters
@@ -207,99 +257,109 @@ namespace vve {
 		exists(oHandle, LocalToParentMatrix{mat4_t{1.0f}});
 		exists(oHandle, LocalToWorldMatrix{mat4_t{0.0f}});
 
-		std::filesystem::path filepath = msg.m_sceneName();
-		uint64_t id = 1;
-		ProcessNode(msg.m_scene->mRootNode, ParentHandle(oHandle), filepath, msg.m_scene, id);
+		if( msg.m_prefab == nullptr ) {
+			std::cerr << "Scene " << msg.m_sceneName() << " could not be loaded!" << std::endl;
+			return false;
+		}
+		if( msg.m_mode != LoadMode::LOAD_MODE_BLOCKING || msg.m_prefab->m_loading ) {
+			m_pendingScenes.push_back( { msg.m_prefab, oHandle, msg.m_mode == LoadMode::LOAD_MODE_INCREMENTAL } );
+			return false;
+		}
+		InstantiatePrefab(*msg.m_prefab, oHandle);
 		return false;
 	}
 
 	/**
-	 * @brief Recursively processes nodes in a 3D model scene hierarchy
-	 * @param node Current node being processed
-	 * @param parent Handle to the parent node
-	 * @param filepath Path to the model file
-	 * @param scene Pointer to the Assimp scene data
-	 * @param id Reference to unique node ID counter
+	 * @brief Clones the nodes of a prefab below a given root node
+	 * @param prefab The prefab template to clone
+	 * @param root Handle to the node the prefab is attached to
 	 */
-	void SceneManager::ProcessNode(aiNode* node, ParentHandle parent, std::filesystem::path& filepath, const aiScene* scene, uint64_t& id) {
-		auto directory = filepath.parent_path();
-
-		auto transform = node->mTransformation;
-		aiVector3D scaling, position;
-    	aiQuaternion rotation;
-    	transform.Decompose(scaling, rotation, position);
-		aiMatrix3x3 rotMat = rotation.GetMatrix();
-		mat3_t rotMat3x3 = mat3_t(rotMat.a1, rotMat.a2, rotMat.a3, rotMat.b1, rotMat.b2, rotMat.b3, rotMat.c1, rotMat.c2, rotMat.c3);
-
-		std::cout << "\nCreate Node: " << node->mName.C_Str() << std::endl;
+	void SceneManager::InstantiatePrefab(const Prefab& prefab, ObjectHandle root) {
+		std::vector<vecs::Handle> handles;
+		handles.reserve(prefab.m_nodes.size());
+		for( auto& node : prefab.m_nodes ) { InstantiateNode(node, root, handles); }
+	}
 
+	/**
+	 * @brief Clones one node of a prefab, its parent must have been cloned before
+	 * @param node The prefab node
+	 * @param root Handle to the node the prefab is attached to
+	 * @param handles Handles of the nodes cloned so far, receives the new node
+	 */
+	void SceneManager::InstantiateNode(const Prefab::Node& node, ObjectHandle root, std::vector<vecs::Handle>& handles) {
+		ParentHandle parent{ node.m_parent < 0 ? root() : handles[node.m_parent] };
 		auto nHandle = m_registry.Insert(
-								node->mName.C_Str()[0] != 0 ? Name{node->mName.C_Str()} : Name{"Node" + std::to_string(id++)},
-								Children{},
-								Position{ { position.x, position.y, position.z } }, 
-								Rotation{rotMat3x3}, 
-								Scale{{ scaling.x, scaling.y, scaling.z }},
-								LocalToParentMatrix{mat4_t{1.0f}}, 
-								LocalToWorldMatrix{mat4_t{0.0f}});
-
+							Name{node.m_name},
+							ParentHandle{},
+							Children{},
+							Position{node.m_position}, 
+							Rotation{node.m_rotation}, 
+							Scale{node.m_scale},
+							LocalToParentMatrix{mat4_t{1.0f}}, 
+							LocalToWorldMatrix{mat4_t{0.0f}});
+		handles.push_back(nHandle);
 		SetParent(ObjectHandle{nHandle}, parent);
 
-		if ( node->mNumMeshes > 0) {
-		    auto mesh = scene->mMeshes[node->mMeshes[0]];
-			m_registry.Put(nHandle, MeshName{(filepath.string() + "/" + mesh->mName.C_Str())});
-			
-			auto material = scene->mMaterials[mesh->mMaterialIndex];
-		    aiString texturePath;
-			std::string texturePathStr{};
-		    if (material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == AI_SUCCESS) {
-				texturePathStr = (directory.string() + "/" + std::string{texturePath.C_Str()});
-		        std::cout << "Diffuse Texture: " << texturePathStr << std::endl;
-				m_registry.Put(nHandle, TextureName{texturePathStr});
-			}
+		if( node.m_meshName.empty() ) return;
+		m_registry.Put(nHandle, MeshName{node.m_meshName});
+		if( !node.m_textureName.empty() ) { m_registry.Put(nHandle, TextureName{node.m_textureName}); }
+		if( node.m_color.has_value() ) { m_registry.Put(nHandle, node.m_color.value()); }
+		if( node.m_material.has_value() ) { m_registry.Put(nHandle, node.m_material.value()); }
+		m_engine.SendMsg( MsgObjectCreate{ObjectHandle{nHandle}, parent, this }); 
+	}
 
-			vvh::Color color;
-			bool hasColor = false;
-			aiColor4D ambientColor;
-			if (AI_SUCCESS == material->Get(AI_MATKEY_COLOR_AMBIENT, ambientColor)) {
-				hasColor = true;
-				color.m_ambientColor = to_vec4(ambientColor);
-		        std::cout << "Ambient Color: " << ambientColor.r << ambientColor .g<< ambientColor.b << ambientColor.a << std::endl;
-			}
-			aiColor4D diffuseColor;
-			if (AI_SUCCESS == material->Get(AI_MATKEY_COLOR_DIFFUSE, diffuseColor)) {
-				hasColor = true;
-				color.m_diffuseColor = to_vec4(diffuseColor);
-		        std::cout << "Diffuse Color: " << diffuseColor.r << diffuseColor.g << diffuseColor.b << diffuseColor.a << std::endl;
-			}
-			if( hasColor ) {
-				m_registry.Put(nHandle, color);
-			}
+	/**
+	 * @brief Clones nodes of pending scenes, one node per unit of work, until the budget is used up. Scenes wait
+	 * until their prefab is imported. Incremental scenes also wait until the asset manager has created all pending
+	 * meshes and textures, since new objects look them up by name. Objects of async scenes get placeholders instead.
+	 * @param message Load step message
+	 * @return false to continue message propagation
+	 */
+	bool SceneManager::OnLoadStep(Message message) {
+		auto& msg = message.template GetData<MsgLoadStep>();
+		auto& progress = *msg.m_progress;
+		std::erase_if(m_pendingScenes, [](const PendingScene& scene) { return scene.m_prefab->m_failed; }); //the asset manager printed the error
+		for( auto& scene : m_pendingScenes ) {
+			if( scene.m_counted || scene.m_prefab->m_loading ) continue;
+			m_loadTotal += scene.m_prefab->m_nodes.size();
+			scene.m_counted = true;
+		}
 
-			// Material: Metallic, Rougness
-			vvh::Material mat;
-			bool hasMat = false;
-			aiColor4D metallicFactor;
-			if (AI_SUCCESS == material->Get(AI_MATKEY_METALLIC_FACTOR, metallicFactor)) {
-				hasMat = true;
-				mat.m_material[0] = metallicFactor.r;
-				std::cout << "Metallic Factor: " << metallicFactor.r << std::endl;
-			}
-			aiColor4D rougnessFactor;
-			if (AI_SUCCESS == material->Get(AI_MATKEY_ROUGHNESS_FACTOR, rougnessFactor)) {
-				hasMat = true;
-				mat.m_material[1] = rougnessFactor.r;
-				std::cout << "Roughness Factor: " << rougnessFactor.r << std::endl;
+		bool assetsDone = progress.m_assetsDone == progress.m_assetsTotal;
+		auto ready = [&](const PendingScene& scene) { return scene.m_counted && (assetsDone || !scene.m_waitForAssets); };
+		while( progress.m_units == 0 || msg.ElapsedMs() < msg.m_budgetMs ) {
+			auto scene = std::find_if(m_pendingScenes.begin(), m_pendingScenes.end(), ready);
+			if( scene == m_pendingScenes.end() ) break;
+			size_t next = scene->m_handles.size(), total = scene->m_prefab->m_nodes.size();
+			if( next == total || !m_registry.Exists(scene->m_root) ) { //empty, or the scene was destroyed while loading
+				m_loadDone += total - next;
+				m_pendingScenes.erase(scene);
+				continue;
 			}
-			if (hasMat) {
-				m_registry.Put(nHandle, mat);
-			}
-
-			m_engine.SendMsg( MsgObjectCreate{ObjectHandle{nHandle}, ParentHandle{parent}, this }); 
+			double start = msg.ElapsedMs();
+			InstantiateNode(scene->m_prefab->m_nodes[next], scene->m_root, scene->m_handles);
+			if( scene->m_handles.size() == total ) { m_pendingScenes.erase(scene); }
+			progress.m_maxUnitMs = std::max(progress.m_maxUnitMs, msg.ElapsedMs() - start);
+			++progress.m_units;
+			++m_loadDone;
 		}
+		if( m_pendingScenes.empty() ) { m_loadDone = m_loadTotal = 0; }
+		progress.m_nodesDone = m_loadDone;
+		progress.m_nodesTotal = m_loadTotal;
+		return false;
+	}
 
-		for (unsigned int i = 0; i < node->mNumChildren; i++) {
-			ProcessNode(node->mChildren[i], ParentHandle{nHandle}, filepath, scene, id);
-		}
+	/**
+	 * @brief Adds the scenes waiting for incremental instantiation to a memory report
+	 * @param message Memory report message
+	 * @return false to continue message propagation
+	 */
+	bool SceneManager::OnMemoryReport(Message message) {
+		auto& msg = message.template GetData<MsgMemoryReport>();
+		size_t bytes = m_pendingScenes.size() * sizeof(PendingScene);
+		for( auto& scene : m_pendingScenes ) { bytes += MemoryReport::VectorBytes(scene.m_handles); }
+		MemoryReport::Add(msg.m_report->m_systems, "Scene manager pending scenes", m_pendingScenes.size(), bytes);
+		return false;
 	}
 
 	/**
@@ -340,6 +400,7 @@ namespace vve {
     bool SceneManager::OnObjectDestroy(Message message) {
 		auto msg = message.template GetData<MsgObjectDestroy>();
 		if( msg.m_phase > 0) { //last phase -> Uniform Buffers have been deallocated
+			m_engine.GetChanges().Erase(msg.m_handle);
 			m_registry.Erase(msg.m_handle);
 			return false;
 		}
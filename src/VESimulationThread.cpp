@@ -0,0 +1,122 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the SimulationThread class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 * @param stepSize Fixed simulation step in seconds
+	 * @param callback Function advancing the simulation by one step
+	 */
+    SimulationThread::SimulationThread(std::string systemName, Engine& engine, double stepSize, SimulateCallback callback )
+		: System{systemName, engine }, m_stepSize{stepSize}, m_callback{callback} {
+		engine.RegisterCallbacks( {
+			{this, std::numeric_limits<int>::max() - 1000, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+			{this,                                      0, "QUIT", [this](Message& message){ return OnQuit(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the SimulationThread class
+	 */
+    SimulationThread::~SimulationThread() { Stop(); }
+
+	/**
+	 * @brief Start the simulation thread
+	 */
+	void SimulationThread::Start() {
+		if( m_thread.joinable() ) return;
+		m_thread = std::jthread{ [this](std::stop_token stop){ Run(stop); } };
+	}
+
+	/**
+	 * @brief Stop the simulation thread and wait for it to finish
+	 */
+	void SimulationThread::Stop() {
+		if( !m_thread.joinable() ) return;
+		m_thread.request_stop();
+		m_thread.join();
+	}
+
+	/**
+	 * @brief Main loop of the simulation thread. Steps the simulation at fixed time slots and publishes each result.
+	 * If the simulation falls behind, it catches up without sleeping.
+	 * @param stop Stop token of the thread
+	 */
+	void SimulationThread::Run(std::stop_token stop) {
+		auto step = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(m_stepSize));
+		auto next = std::chrono::high_resolution_clock::now();
+
+		while( !stop.stop_requested() ) {
+			m_working.m_transforms.clear();
+			{
+				std::lock_guard<std::mutex> lock(m_simulationMutex);
+				m_callback(m_stepSize, m_working.m_transforms);
+			}
+			m_working.m_index.clear();
+			for( size_t i = 0; i < m_working.m_transforms.size(); ++i ) { m_working.m_index[m_working.m_transforms[i].m_handle().GetValue()] = i; }
+			next += step;
+			m_working.m_time = next;
+			{
+				std::lock_guard<std::mutex> lock(m_publishMutex);
+				std::swap(m_published[0], m_published[1]);
+				std::swap(m_published[1], m_working);
+			}
+			++m_numberSteps;
+			std::this_thread::sleep_until(next);
+		}
+	}
+
+	/**
+	 * @brief Interpolate between the last two published states and write the result to the registry.
+	 * Rendering is one simulation step behind, but always between two states that were actually computed.
+	 * Transforms are matched by handle, since a step may publish other objects than the step before, e.g. when
+	 * bodies fall asleep, wake up or are added. Objects without a previous transform are placed at the current one,
+	 * objects missing in the current state are placed at their previous one.
+	 * Objects destroyed after the step was published are dropped.
+	 * @param message Update message
+	 * @return false to continue message propagation
+	 */
+	bool SimulationThread::OnUpdate(Message message) {
+		{
+			std::lock_guard<std::mutex> lock(m_publishMutex);
+			auto& previous = m_published[0];
+			auto& current = m_published[1];
+			m_interpolated = current.m_transforms;
+
+			double alpha = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - current.m_time).count() / m_stepSize + 1.0;
+			real_t t = (real_t)std::clamp(alpha, 0.0, 1.0);
+			for( auto& transform : m_interpolated ) {
+				auto it = previous.m_index.find(transform.m_handle().GetValue());
+				if( it == previous.m_index.end() ) continue;
+				auto& prev = previous.m_transforms[it->second];
+				transform.m_position = glm::mix(prev.m_position, transform.m_position, t);
+				transform.m_orientation = glm::slerp(prev.m_orientation, transform.m_orientation, t);
+			}
+			for( auto& prev : previous.m_transforms ) {	//not published anymore, e.g. asleep, ends at its last state
+				if( !current.m_index.contains(prev.m_handle().GetValue()) ) m_interpolated.push_back(prev);
+			}
+		}
+		std::erase_if(m_interpolated, [this](auto& transform) { return !m_registry.Exists(transform.m_handle); }); //destroyed since the step
+		m_engine.SetTransforms(m_interpolated);
+		return false;
+	}
+
+	/**
+	 * @brief Stop the thread on quit
+	 * @param message Quit message
+	 * @return false to continue message propagation
+	 */
+	bool SimulationThread::OnQuit(Message message) {
+		Stop();
+		return false;
+	}
+
+
+};  // namespace vve
+
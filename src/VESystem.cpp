@@ -55,12 +55,21 @@ namespace vve {
 
 	System::MsgSceneLoad::MsgSceneLoad(Filename sceneName, aiPostProcessSteps ai_flags) : MsgBase{"SCENE_LOAD"}, m_sceneName{sceneName}, m_ai_flags{ai_flags} {};
 
-	System::MsgSceneCreate::MsgSceneCreate(ObjectHandle object, ParentHandle parent, Filename sceneName, aiPostProcessSteps ai_flags) : 
-		MsgBase{"SCENE_CREATE"}, m_object{object}, m_parent{parent}, m_sceneName{sceneName}, m_ai_flags{ai_flags} {};
+	System::MsgSceneCreate::MsgSceneCreate(ObjectHandle object, ParentHandle parent, Filename sceneName, aiPostProcessSteps ai_flags, LoadMode mode) : 
+		MsgBase{"SCENE_CREATE"}, m_object{object}, m_parent{parent}, m_sceneName{sceneName}, m_ai_flags{ai_flags}, m_mode{mode} {};
+
+	System::MsgLoadStep::MsgLoadStep(double budgetMs, LoadProgress* progress) : 
+		MsgBase{"LOAD_STEP"}, m_budgetMs{budgetMs}, m_progress{progress}, m_start{std::chrono::high_resolution_clock::now()} {};
 
 	System::MsgObjectCreate::MsgObjectCreate(ObjectHandle object, ParentHandle parent, System* sender) 
 		: MsgBase{"OBJECT_CREATE"}, m_object{object}, m_parent{parent}, m_sender{sender} {};
 	
+	System::MsgObjectsCreate::MsgObjectsCreate(std::span<const ObjectHandle> objects, ParentHandle parent, System* sender) 
+		: MsgBase{"OBJECTS_CREATE"}, m_objects{objects}, m_parent{parent}, m_sender{sender} {};
+
+	System::MsgObjectsAssetsChanged::MsgObjectsAssetsChanged(std::span<const ObjectHandle> objects) 
+		: MsgBase{"OBJECTS_ASSETS_CHANGED"}, m_objects{objects} {};
+
 	System::MsgObjectSetParent::MsgObjectSetParent(ObjectHandle object, ParentHandle parent) : MsgBase("OBJECT_SET_PARENT"), m_object{object}, m_parent{parent} {};
 	System::MsgObjectDestroy::MsgObjectDestroy(ObjectHandle handle) : MsgBase("OBJECT_DESTROY"), m_handle{handle} {};
 
@@ -70,6 +79,7 @@ namespace vve {
     System::MsgTextureDestroy::MsgTextureDestroy(TextureHandle handle) : MsgBase{"TEXTURE_DESTROY"}, m_handle{handle} {};
 	System::MsgMeshCreate::MsgMeshCreate(MeshHandle handle) : MsgBase{"MESH_CREATE"}, m_handle{handle} {};
     System::MsgMeshDestroy::MsgMeshDestroy(MeshHandle handle) : MsgBase{"MESH_DESTROY"}, m_handle{handle} {};
+    System::MsgMemoryReport::MsgMemoryReport(MemoryReport* report) : MsgBase{"MEMORY_REPORT"}, m_report{report} {};
     System::MsgDeleted:: MsgDeleted(double dt): MsgBase{"DELETED"} {}; 
 
 	//------------------------------------------------------------------------
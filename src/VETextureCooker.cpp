@@ -0,0 +1,814 @@
+#include <fstream>
+#include <cstring>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+	//-------------------------------------------------------------------------------------------------------
+	// Color space and filtering
+
+	/**
+	 * @brief Convert an 8 bit sRGB value to linear
+	 * @param value The sRGB value
+	 * @return The linear value in [0,1]
+	 */
+	static auto SrgbToLinear(uint8_t value) -> float {
+		static const auto table = [] {
+			std::array<float, 256> table{};
+			for( int i = 0; i < 256; ++i ) {
+				float c = i / 255.0f;
+				table[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+			}
+			return table;
+		}();
+		return table[value];
+	}
+
+	/**
+	 * @brief Convert a linear value to 8 bit sRGB
+	 * @param value The linear value in [0,1]
+	 * @return The sRGB value
+	 */
+	static auto LinearToSrgb(float value) -> uint8_t {
+		float c = std::clamp(value, 0.0f, 1.0f);
+		c = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+		return (uint8_t)std::lround(c * 255.0f);
+	}
+
+	/**
+	 * @brief Convert a value in [0,1] to 8 bit
+	 * @param value The value
+	 * @return The 8 bit value
+	 */
+	static auto ToUnorm8(float value) -> uint8_t {
+		return (uint8_t)std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+	}
+
+	/**
+	 * @brief Source texels and weights of a box filter along one axis. Each destination texel covers an interval of
+	 * the source, source texels that are only partly covered get a smaller weight.
+	 * @param source Source size
+	 * @param destination Destination size
+	 * @return For each destination texel the pairs of source texel and normalized weight
+	 */
+	static auto BoxWeights(uint32_t source, uint32_t destination) -> std::vector<std::vector<std::pair<uint32_t, float>>> {
+		std::vector<std::vector<std::pair<uint32_t, float>>> weights(destination);
+		double scale = (double)source / destination;
+		for( uint32_t i = 0; i < destination; ++i ) {
+			double begin = i * scale, end = (i + 1) * scale;
+			for( uint32_t j = (uint32_t)begin; j < source && j < end; ++j ) {
+				double w = std::min(end, j + 1.0) - std::max(begin, (double)j);
+				if( w > 1e-6 ) weights[i].push_back( { j, (float)(w / scale) } );
+			}
+		}
+		return weights;
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Mips
+
+	/**
+	 * @brief Generate the mip chain of an image. Texels are converted to a linear working space first: colors to
+	 * linear light with premultiplied alpha, normals to vectors. Each level is box filtered from the previous one,
+	 * separately in x and y, then converted back to 8 bit. Level 0 is copied unchanged.
+	 * @param rgba The pixels, 8 bit RGBA
+	 * @param width Width of the image
+	 * @param height Height of the image
+	 * @param usage Usage of the texture, decides how texels are filtered
+	 * @param mips Generate all levels down to 1x1, otherwise only level 0
+	 * @return The levels, level 0 first
+	 */
+	auto TextureCooker::GenerateMips(const uint8_t* rgba, uint32_t width, uint32_t height, TextureUsage usage, bool mips) -> std::vector<MipLevel> {
+		std::vector<MipLevel> levels;
+		levels.push_back( { width, height, std::vector<uint8_t>(rgba, rgba + (size_t)width * height * 4) } );
+		if( !mips ) return levels;
+
+		std::vector<float> current((size_t)width * height * 4);
+		for( size_t i = 0; i < (size_t)width * height; ++i ) {
+			const uint8_t* t = rgba + 4 * i;
+			float* c = &current[4 * i];
+			c[3] = t[3] / 255.0f;
+			for( int k = 0; k < 3; ++k ) {
+				switch( usage ) {
+					case TextureUsage::TEXTURE_USAGE_COLOR: c[k] = SrgbToLinear(t[k]) * c[3]; break;
+					case TextureUsage::TEXTURE_USAGE_NORMAL: c[k] = t[k] / 127.5f - 1.0f; break;
+					default: c[k] = t[k] / 255.0f; break;
+				}
+			}
+		}
+
+		uint32_t w = width, h = height;
+		while( w > 1 || h > 1 ) {
+			uint32_t nw = std::max(1u, w / 2), nh = std::max(1u, h / 2);
+			auto wx = BoxWeights(w, nw), wy = BoxWeights(h, nh);
+
+			std::vector<float> rows((size_t)nw * h * 4, 0.0f);
+			for( uint32_t y = 0; y < h; ++y ) {
+				for( uint32_t x = 0; x < nw; ++x ) {
+					for( auto [sx, weight] : wx[x] ) {
+						for( int k = 0; k < 4; ++k ) rows[4 * ((size_t)y * nw + x) + k] += weight * current[4 * ((size_t)y * w + sx) + k];
+					}
+				}
+			}
+			std::vector<float> next((size_t)nw * nh * 4, 0.0f);
+			for( uint32_t y = 0; y < nh; ++y ) {
+				for( auto [sy, weight] : wy[y] ) {
+					for( size_t i = 0; i < (size_t)nw * 4; ++i ) next[4 * (size_t)y * nw + i] += weight * rows[4 * (size_t)sy * nw + i];
+				}
+			}
+			if( usage == TextureUsage::TEXTURE_USAGE_NORMAL ) {
+				for( size_t i = 0; i < (size_t)nw * nh; ++i ) {
+					float* n = &next[4 * i];
+					float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+					if( length > 1e-6f ) { n[0] /= length; n[1] /= length; n[2] /= length; }
+				}
+			}
+
+			MipLevel level{ nw, nh, std::vector<uint8_t>((size_t)nw * nh * 4) };
+			for( size_t i = 0; i < (size_t)nw * nh; ++i ) {
+				const float* c = &next[4 * i];
+				uint8_t* t = &level.m_pixels[4 * i];
+				t[3] = ToUnorm8(c[3]);
+				for( int k = 0; k < 3; ++k ) {
+					switch( usage ) {
+						case TextureUsage::TEXTURE_USAGE_COLOR: t[k] = LinearToSrgb(c[3] > 0.0f ? c[k] / c[3] : 0.0f); break;
+						case TextureUsage::TEXTURE_USAGE_NORMAL: t[k] = ToUnorm8(c[k] * 0.5f + 0.5f); break;
+						default: t[k] = ToUnorm8(c[k]); break;
+					}
+				}
+			}
+			levels.push_back(std::move(level));
+			current = std::move(next);
+			w = nw;
+			h = nh;
+		}
+		return levels;
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Cooking
+
+	/**
+	 * @brief Choose the format of a cooked texture
+	 * @param options Usage and quality
+	 * @param opaque All texels of level 0 have alpha 255
+	 * @return The format
+	 */
+	auto TextureCooker::ChooseFormat(CookOptions options, bool opaque) -> VkFormat {
+		switch( options.m_usage ) {
+			case TextureUsage::TEXTURE_USAGE_NORMAL: return VK_FORMAT_BC5_UNORM_BLOCK;
+			case TextureUsage::TEXTURE_USAGE_MASK: return VK_FORMAT_BC4_UNORM_BLOCK;
+			case TextureUsage::TEXTURE_USAGE_LINEAR:
+				if( options.m_highQuality ) return VK_FORMAT_BC7_UNORM_BLOCK;
+				return opaque ? VK_FORMAT_BC1_RGB_UNORM_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+			default:
+				if( options.m_highQuality ) return VK_FORMAT_BC7_SRGB_BLOCK;
+				return opaque ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC3_SRGB_BLOCK;
+		}
+	}
+
+	/**
+	 * @brief Cook an image: generate its mips and encode each level block by block. Blocks at the right and bottom
+	 * border of levels that are not a multiple of 4 repeat the last texel.
+	 * @param rgba The pixels, 8 bit RGBA
+	 * @param width Width of the image
+	 * @param height Height of the image
+	 * @param options Usage and quality
+	 * @return The cooked texture
+	 */
+	auto TextureCooker::Cook(const uint8_t* rgba, uint32_t width, uint32_t height, CookOptions options) -> CookedTexture {
+		bool opaque = true;
+		for( size_t i = 0; i < (size_t)width * height && opaque; ++i ) { opaque = rgba[4 * i + 3] == 255; }
+
+		CookedTexture texture{ ChooseFormat(options, opaque), width, height };
+		uint32_t blockBytes = BlockBytes(texture.m_format);
+		uint32_t channel = std::min(options.m_channel, 3u);
+
+		for( auto& level : GenerateMips(rgba, width, height, options.m_usage, options.m_mips) ) {
+			uint32_t bw = (level.m_width + 3) / 4, bh = (level.m_height + 3) / 4;
+			std::vector<uint8_t> data((size_t)bw * bh * blockBytes);
+			for( uint32_t by = 0; by < bh; ++by ) {
+				for( uint32_t bx = 0; bx < bw; ++bx ) {
+					uint8_t texels[64];
+					for( uint32_t i = 0; i < 16; ++i ) {
+						uint32_t x = std::min(bx * 4 + i % 4, level.m_width - 1), y = std::min(by * 4 + i / 4, level.m_height - 1);
+						std::memcpy(&texels[4 * i], &level.m_pixels[4 * ((size_t)y * level.m_width + x)], 4);
+					}
+					uint8_t* out = &data[((size_t)by * bw + bx) * blockBytes];
+					switch( texture.m_format ) {
+						case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+						case VK_FORMAT_BC1_RGB_SRGB_BLOCK: EncodeBC1(texels, out); break;
+						case VK_FORMAT_BC3_UNORM_BLOCK:
+						case VK_FORMAT_BC3_SRGB_BLOCK: EncodeBC4(texels, 3, out); EncodeBC1(texels, out + 8); break;
+						case VK_FORMAT_BC4_UNORM_BLOCK: EncodeBC4(texels, channel, out); break;
+						case VK_FORMAT_BC5_UNORM_BLOCK: EncodeBC4(texels, 0, out); EncodeBC4(texels, 1, out + 8); break;
+						default: EncodeBC7(texels, out); break;
+					}
+				}
+			}
+			texture.m_levels.push_back(std::move(data));
+		}
+		return texture;
+	}
+
+	/**
+	 * @brief Cook an image file into a KTX2 file
+	 * @param source The image file, any format stb_image reads
+	 * @param target The KTX2 file
+	 * @param options Usage and quality
+	 * @return true if the file was written
+	 */
+	auto TextureCooker::CookFile(const std::filesystem::path& source, const std::filesystem::path& target, CookOptions options) -> bool {
+		int width, height, channels;
+		stbi_uc* pixels = stbi_load(source.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+		if( pixels == nullptr ) {
+			std::cerr << "Texture " << source.string() << " could not be loaded!" << std::endl;
+			return false;
+		}
+		auto texture = Cook(pixels, (uint32_t)width, (uint32_t)height, options);
+		stbi_image_free(pixels);
+		return WriteKtx2(target, texture);
+	}
+
+	/**
+	 * @brief Path of the cooked file of an image, the image path with the extension .ktx2
+	 * @param source The image file
+	 * @return The path of the cooked file
+	 */
+	auto TextureCooker::CookedPath(const std::filesystem::path& source) -> std::filesystem::path {
+		return std::filesystem::path{source}.replace_extension(c_extension);
+	}
+
+	/**
+	 * @brief Guess the usage of a texture from its file name. Looks for the usual suffixes of normal maps and
+	 * single channel maps, packed occlusion/roughness/metallic maps are linear, everything else is color.
+	 * @param file The image file
+	 * @return The usage
+	 */
+	auto TextureCooker::GuessUsage(const std::filesystem::path& file) -> TextureUsage {
+		auto stem = file.stem().string();
+		std::transform(stem.begin(), stem.end(), stem.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		auto has = [&](std::initializer_list<const char*> words) {
+			return std::ranges::any_of(words, [&](const char* word) { return stem.find(word) != std::string::npos; });
+		};
+		if( has({"normal", "_nrm"}) || stem.ends_with("_n") ) return TextureUsage::TEXTURE_USAGE_NORMAL;
+		if( has({"occlusionroughnessmetallic", "_orm", "_arm", "metallicroughness"}) ) return TextureUsage::TEXTURE_USAGE_LINEAR;
+		if( has({"rough", "metal", "_ao", "occlusion", "height", "disp", "mask", "gloss"}) ) return TextureUsage::TEXTURE_USAGE_MASK;
+		return TextureUsage::TEXTURE_USAGE_COLOR;
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Block encoders
+
+	/**
+	 * @brief Principal axis of a set of points by power iteration on their covariance
+	 * @tparam N Number of channels
+	 * @param points The points
+	 * @param mean Returns the mean
+	 * @return The axis, zero if all points are equal
+	 */
+	template<int N>
+	static auto PrincipalAxis(const std::array<std::array<float, N>, 16>& points, std::array<float, N>& mean) -> std::array<float, N> {
+		mean.fill(0.0f);
+		for( auto& p : points ) { for( int k = 0; k < N; ++k ) mean[k] += p[k] / 16.0f; }
+		float cov[N][N]{};
+		for( auto& p : points ) {
+			for( int i = 0; i < N; ++i ) { for( int j = 0; j < N; ++j ) cov[i][j] += (p[i] - mean[i]) * (p[j] - mean[j]); }
+		}
+		std::array<float, N> axis;
+		axis.fill(1.0f);
+		for( int iteration = 0; iteration < 8; ++iteration ) {
+			std::array<float, N> next{};
+			for( int i = 0; i < N; ++i ) { for( int j = 0; j < N; ++j ) next[i] += cov[i][j] * axis[j]; }
+			float length = 0.0f;
+			for( int k = 0; k < N; ++k ) length = std::max(length, std::abs(next[k]));
+			if( length < 1e-6f ) { axis.fill(0.0f); return axis; }
+			for( int k = 0; k < N; ++k ) axis[k] = next[k] / length;
+		}
+		return axis;
+	}
+
+	/**
+	 * @brief Pack a color into RGB565
+	 * @param c The color, channels in [0,255]
+	 * @return The packed color
+	 */
+	static auto Pack565(const std::array<float, 3>& c) -> uint16_t {
+		auto q = [](float v, int max) { return (uint16_t)std::lround(std::clamp(v, 0.0f, 255.0f) * max / 255.0f); };
+		return (uint16_t)(q(c[0], 31) << 11 | q(c[1], 63) << 5 | q(c[2], 31));
+	}
+
+	/**
+	 * @brief Unpack an RGB565 color
+	 * @param c The packed color
+	 * @return The color, channels in [0,255]
+	 */
+	static auto Unpack565(uint16_t c) -> std::array<int, 3> {
+		int r = c >> 11 & 31, g = c >> 5 & 63, b = c & 31;
+		return { r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2 };
+	}
+
+	/**
+	 * @brief Encode a 4x4 block of RGBA texels as BC1 color block, always in four color mode. The endpoints are the
+	 * extremes of the colors along their principal axis, then refined once by least squares on the chosen indices.
+	 * @param texels 16 texels, 8 bit RGBA
+	 * @param out 8 bytes
+	 */
+	void TextureCooker::EncodeBC1(const uint8_t* texels, uint8_t* out) {
+		std::array<std::array<float, 3>, 16> colors;
+		for( int i = 0; i < 16; ++i ) { for( int k = 0; k < 3; ++k ) colors[i][k] = texels[4 * i + k]; }
+		std::array<float, 3> mean;
+		auto axis = PrincipalAxis<3>(colors, mean);
+
+		float tMin = 0.0f, tMax = 0.0f;
+		for( auto& c : colors ) {
+			float t = (c[0] - mean[0]) * axis[0] + (c[1] - mean[1]) * axis[1] + (c[2] - mean[2]) * axis[2];
+			tMin = std::min(tMin, t);
+			tMax = std::max(tMax, t);
+		}
+		float length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+		std::array<float, 3> e0, e1;
+		for( int k = 0; k < 3; ++k ) {
+			e0[k] = mean[k] + axis[k] * tMax / std::max(length, 1e-6f);
+			e1[k] = mean[k] + axis[k] * tMin / std::max(length, 1e-6f);
+		}
+
+		auto encode = [&](uint16_t c0, uint16_t c1, uint32_t& indices) -> float {
+			if( c0 < c1 ) std::swap(c0, c1);
+			auto p0 = Unpack565(c0), p1 = Unpack565(c1);
+			std::array<std::array<int, 3>, 4> palette{ p0, p1 };
+			for( int k = 0; k < 3; ++k ) {
+				palette[2][k] = (2 * p0[k] + p1[k]) / 3;
+				palette[3][k] = (p0[k] + 2 * p1[k]) / 3;
+			}
+			indices = 0;
+			float error = 0.0f;
+			for( int i = 0; i < 16; ++i ) {
+				int best = 0;
+				float bestError = std::numeric_limits<float>::max();
+				for( int j = 0; j < (c0 == c1 ? 1 : 4); ++j ) {
+					float e = 0.0f;
+					for( int k = 0; k < 3; ++k ) e += (colors[i][k] - palette[j][k]) * (colors[i][k] - palette[j][k]);
+					if( e < bestError ) { bestError = e; best = j; }
+				}
+				indices |= (uint32_t)best << (2 * i);
+				error += bestError;
+			}
+			return error;
+		};
+
+		uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+		uint32_t indices;
+		float error = encode(c0, c1, indices);
+		if( c0 < c1 ) std::swap(c0, c1);
+
+		if( c0 != c1 ) {
+			static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+			float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+			std::array<float, 3> ax{}, bx{};
+			for( int i = 0; i < 16; ++i ) {
+				float a = weights[indices >> (2 * i) & 3], b = 1.0f - a;
+				aa += a * a; bb += b * b; ab += a * b;
+				for( int k = 0; k < 3; ++k ) { ax[k] += a * colors[i][k]; bx[k] += b * colors[i][k]; }
+			}
+			float det = aa * bb - ab * ab;
+			if( std::abs(det) > 1e-6f ) {
+				for( int k = 0; k < 3; ++k ) {
+					e0[k] = (ax[k] * bb - bx[k] * ab) / det;
+					e1[k] = (bx[k] * aa - ax[k] * ab) / det;
+				}
+				uint16_t r0 = Pack565(e0), r1 = Pack565(e1);
+				uint32_t refined;
+				if( r0 != r1 && encode(r0, r1, refined) < error ) {
+					c0 = std::max(r0, r1);
+					c1 = std::min(r0, r1);
+					indices = refined;
+				}
+			}
+		}
+
+		out[0] = (uint8_t)c0; out[1] = (uint8_t)(c0 >> 8);
+		out[2] = (uint8_t)c1; out[3] = (uint8_t)(c1 >> 8);
+		for( int i = 0; i < 4; ++i ) out[4 + i] = (uint8_t)(indices >> (8 * i));
+	}
+
+	/**
+	 * @brief Encode one channel of a 4x4 block as BC4 block in eight value mode, with the minimum and maximum of
+	 * the block as endpoints
+	 * @param texels 16 texels, 8 bit RGBA
+	 * @param channel The channel
+	 * @param out 8 bytes
+	 */
+	void TextureCooker::EncodeBC4(const uint8_t* texels, uint32_t channel, uint8_t* out) {
+		int lo = 255, hi = 0;
+		for( int i = 0; i < 16; ++i ) {
+			lo = std::min(lo, (int)texels[4 * i + channel]);
+			hi = std::max(hi, (int)texels[4 * i + channel]);
+		}
+		out[0] = (uint8_t)hi;
+		out[1] = (uint8_t)lo;
+		uint64_t indices = 0;
+		if( hi > lo ) {
+			int palette[8] = { hi, lo };
+			for( int j = 2; j < 8; ++j ) palette[j] = ((8 - j) * hi + (j - 1) * lo + 3) / 7;
+			for( int i = 0; i < 16; ++i ) {
+				int v = texels[4 * i + channel], best = 0;
+				for( int j = 1; j < 8; ++j ) { if( std::abs(v - palette[j]) < std::abs(v - palette[best]) ) best = j; }
+				indices |= (uint64_t)best << (3 * i);
+			}
+		}
+		for( int i = 0; i < 6; ++i ) out[2 + i] = (uint8_t)(indices >> (8 * i));
+	}
+
+	static const int c_bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	/**
+	 * @brief Encode a 4x4 block as BC7 mode 6 block: one subset, 7 bit RGBA endpoints with a shared low bit each
+	 * and 4 bit indices. The endpoints are the extremes along the principal axis in RGBA, all four combinations of
+	 * low bits are tried.
+	 * @param texels 16 texels, 8 bit RGBA
+	 * @param out 16 bytes
+	 */
+	void TextureCooker::EncodeBC7(const uint8_t* texels, uint8_t* out) {
+		std::array<std::array<float, 4>, 16> colors;
+		for( int i = 0; i < 16; ++i ) { for( int k = 0; k < 4; ++k ) colors[i][k] = texels[4 * i + k]; }
+		std::array<float, 4> mean;
+		auto axis = PrincipalAxis<4>(colors, mean);
+
+		float tMin = 0.0f, tMax = 0.0f, length = 0.0f;
+		for( int k = 0; k < 4; ++k ) length += axis[k] * axis[k];
+		for( auto& c : colors ) {
+			float t = 0.0f;
+			for( int k = 0; k < 4; ++k ) t += (c[k] - mean[k]) * axis[k];
+			tMin = std::min(tMin, t);
+			tMax = std::max(tMax, t);
+		}
+
+		int bestError = std::numeric_limits<int>::max();
+		std::array<int, 4> q0{}, q1{};
+		int p0 = 0, p1 = 0;
+		uint8_t indices[16]{};
+		for( int pbits = 0; pbits < 4; ++pbits ) {
+			std::array<int, 4> a, b, e0, e1;
+			for( int k = 0; k < 4; ++k ) {
+				float v0 = mean[k] + axis[k] * tMin / std::max(length, 1e-6f);
+				float v1 = mean[k] + axis[k] * tMax / std::max(length, 1e-6f);
+				a[k] = std::clamp((int)std::lround((v0 - (pbits & 1)) / 2.0f), 0, 127);
+				b[k] = std::clamp((int)std::lround((v1 - (pbits >> 1)) / 2.0f), 0, 127);
+				e0[k] = a[k] << 1 | (pbits & 1);
+				e1[k] = b[k] << 1 | (pbits >> 1);
+			}
+			int error = 0;
+			uint8_t chosen[16];
+			for( int i = 0; i < 16; ++i ) {
+				int best = 0, bestPixel = std::numeric_limits<int>::max();
+				for( int j = 0; j < 16; ++j ) {
+					int e = 0;
+					for( int k = 0; k < 4; ++k ) {
+						int v = ((64 - c_bc7Weights[j]) * e0[k] + c_bc7Weights[j] * e1[k] + 32) >> 6;
+						e += (v - texels[4 * i + k]) * (v - texels[4 * i + k]);
+					}
+					if( e < bestPixel ) { bestPixel = e; best = j; }
+				}
+				chosen[i] = (uint8_t)best;
+				error += bestPixel;
+			}
+			if( error < bestError ) {
+				bestError = error;
+				q0 = a; q1 = b; p0 = pbits & 1; p1 = pbits >> 1;
+				std::memcpy(indices, chosen, 16);
+			}
+		}
+
+		if( indices[0] >= 8 ) {		//the anchor index has an implicit high bit of 0
+			std::swap(q0, q1);
+			std::swap(p0, p1);
+			for( auto& index : indices ) index = (uint8_t)(15 - index);
+		}
+
+		std::memset(out, 0, 16);
+		uint32_t bit = 0;
+		auto put = [&](uint32_t value, uint32_t count) {
+			for( uint32_t i = 0; i < count; ++i, ++bit ) out[bit / 8] |= (uint8_t)((value >> i & 1) << (bit % 8));
+		};
+		put(1 << 6, 7);
+		for( int k = 0; k < 4; ++k ) { put(q0[k], 7); put(q1[k], 7); }
+		put(p0, 1);
+		put(p1, 1);
+		for( int i = 0; i < 16; ++i ) put(indices[i], i == 0 ? 3 : 4);
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Block decoders
+
+	/**
+	 * @brief Decode a BC1 color block
+	 * @param block 8 bytes
+	 * @param texels 16 texels, 8 bit RGBA
+	 * @param fourColors Always use four colors, as in BC3
+	 */
+	void TextureCooker::DecodeBC1(const uint8_t* block, uint8_t* texels, bool fourColors) {
+		uint16_t c0 = (uint16_t)(block[0] | block[1] << 8), c1 = (uint16_t)(block[2] | block[3] << 8);
+		auto p0 = Unpack565(c0), p1 = Unpack565(c1);
+		std::array<std::array<int, 4>, 4> palette{};
+		for( int k = 0; k < 3; ++k ) {
+			palette[0][k] = p0[k];
+			palette[1][k] = p1[k];
+			palette[2][k] = fourColors || c0 > c1 ? (2 * p0[k] + p1[k]) / 3 : (p0[k] + p1[k]) / 2;
+			palette[3][k] = fourColors || c0 > c1 ? (p0[k] + 2 * p1[k]) / 3 : 0;
+		}
+		for( int j = 0; j < 4; ++j ) palette[j][3] = (j == 3 && !fourColors && c0 <= c1) ? 0 : 255;
+		uint32_t indices = (uint32_t)(block[4] | block[5] << 8 | block[6] << 16 | block[7] << 24);
+		for( int i = 0; i < 16; ++i ) {
+			for( int k = 0; k < 4; ++k ) texels[4 * i + k] = (uint8_t)palette[indices >> (2 * i) & 3][k];
+		}
+	}
+
+	/**
+	 * @brief Decode a BC4 block into one channel
+	 * @param block 8 bytes
+	 * @param texels 16 texels, 8 bit RGBA
+	 * @param channel The channel
+	 */
+	void TextureCooker::DecodeBC4(const uint8_t* block, uint8_t* texels, uint32_t channel) {
+		int a0 = block[0], a1 = block[1];
+		int palette[8] = { a0, a1 };
+		if( a0 > a1 ) {
+			for( int j = 2; j < 8; ++j ) palette[j] = ((8 - j) * a0 + (j - 1) * a1 + 3) / 7;
+		} else {
+			for( int j = 2; j < 6; ++j ) palette[j] = ((6 - j) * a0 + (j - 1) * a1 + 2) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+		uint64_t indices = 0;
+		for( int i = 0; i < 6; ++i ) indices |= (uint64_t)block[2 + i] << (8 * i);
+		for( int i = 0; i < 16; ++i ) texels[4 * i + channel] = (uint8_t)palette[indices >> (3 * i) & 7];
+	}
+
+	/**
+	 * @brief Decode a BC7 mode 6 block
+	 * @param block 16 bytes
+	 * @param texels 16 texels, 8 bit RGBA
+	 * @return false if the block uses another mode
+	 */
+	auto TextureCooker::DecodeBC7(const uint8_t* block, uint8_t* texels) -> bool {
+		if( (block[0] & 0x7f) != 0x40 ) return false;
+		uint32_t bit = 7;
+		auto get = [&](uint32_t count) {
+			uint32_t value = 0;
+			for( uint32_t i = 0; i < count; ++i, ++bit ) value |= (uint32_t)(block[bit / 8] >> (bit % 8) & 1) << i;
+			return value;
+		};
+		int e0[4], e1[4];
+		for( int k = 0; k < 4; ++k ) { e0[k] = (int)get(7) << 1; e1[k] = (int)get(7) << 1; }
+		uint32_t p0 = get(1), p1 = get(1);
+		for( int k = 0; k < 4; ++k ) { e0[k] |= (int)p0; e1[k] |= (int)p1; }
+		for( int i = 0; i < 16; ++i ) {
+			int w = c_bc7Weights[get(i == 0 ? 3 : 4)];
+			for( int k = 0; k < 4; ++k ) texels[4 * i + k] = (uint8_t)(((64 - w) * e0[k] + w * e1[k] + 32) >> 6);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Decode a mip level to 8 bit RGBA. Channels a format does not store read as in a shader: missing color
+	 * channels are 0 and missing alpha is 255.
+	 * @param texture The texture
+	 * @param level The mip level
+	 * @return The pixels, empty if the format or a BC7 mode is not supported
+	 */
+	auto TextureCooker::Decode(const CookedTexture& texture, uint32_t level) -> std::vector<uint8_t> {
+		uint32_t blockBytes = BlockBytes(texture.m_format);
+		if( blockBytes == 0 || level >= texture.m_levels.size() ) return {};
+		uint32_t width = std::max(1u, texture.m_width >> level), height = std::max(1u, texture.m_height >> level);
+		auto& data = texture.m_levels[level];
+		if( data.size() < LevelBytes(texture.m_format, width, height) ) return {};
+		if( !IsCompressed(texture.m_format) ) return data;
+
+		std::vector<uint8_t> pixels((size_t)width * height * 4);
+		uint32_t bw = (width + 3) / 4, bh = (height + 3) / 4;
+		for( uint32_t by = 0; by < bh; ++by ) {
+			for( uint32_t bx = 0; bx < bw; ++bx ) {
+				const uint8_t* block = &data[((size_t)by * bw + bx) * blockBytes];
+				uint8_t texels[64];
+				for( int i = 0; i < 16; ++i ) { texels[4 * i] = texels[4 * i + 1] = texels[4 * i + 2] = 0; texels[4 * i + 3] = 255; }
+				switch( texture.m_format ) {
+					case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+					case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+						DecodeBC1(block, texels, false);
+						for( int i = 0; i < 16; ++i ) texels[4 * i + 3] = 255;
+						break;
+					case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+					case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: DecodeBC1(block, texels, false); break;
+					case VK_FORMAT_BC3_UNORM_BLOCK:
+					case VK_FORMAT_BC3_SRGB_BLOCK: DecodeBC1(block + 8, texels, true); DecodeBC4(block, texels, 3); break;
+					case VK_FORMAT_BC4_UNORM_BLOCK: DecodeBC4(block, texels, 0); break;
+					case VK_FORMAT_BC5_UNORM_BLOCK: DecodeBC4(block, texels, 0); DecodeBC4(block + 8, texels, 1); break;
+					default: if( !DecodeBC7(block, texels) ) return {}; break;
+				}
+				for( uint32_t i = 0; i < 16; ++i ) {
+					uint32_t x = bx * 4 + i % 4, y = by * 4 + i / 4;
+					if( x < width && y < height ) std::memcpy(&pixels[4 * ((size_t)y * width + x)], &texels[4 * i], 4);
+				}
+			}
+		}
+		return pixels;
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Formats
+
+	/**
+	 * @brief Size of a texel block of a format the cooker reads or writes
+	 * @param format The format
+	 * @return Bytes of a 4x4 block, or of a texel for uncompressed formats, 0 if the format is not supported
+	 */
+	auto TextureCooker::BlockBytes(VkFormat format) -> uint32_t {
+		switch( format ) {
+			case VK_FORMAT_R8G8B8A8_UNORM:
+			case VK_FORMAT_R8G8B8A8_SRGB: return 4;
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			case VK_FORMAT_BC4_UNORM_BLOCK: return 8;
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK:
+			case VK_FORMAT_BC5_UNORM_BLOCK:
+			case VK_FORMAT_BC7_UNORM_BLOCK:
+			case VK_FORMAT_BC7_SRGB_BLOCK: return 16;
+			default: return 0;
+		}
+	}
+
+	/**
+	 * @brief Check if a format is block compressed
+	 * @param format The format
+	 * @return true for BC formats
+	 */
+	auto TextureCooker::IsCompressed(VkFormat format) -> bool {
+		return format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK;
+	}
+
+	/**
+	 * @brief Bytes of a mip level
+	 * @param format The format
+	 * @param width Width of the level
+	 * @param height Height of the level
+	 * @return Number of bytes
+	 */
+	auto TextureCooker::LevelBytes(VkFormat format, uint32_t width, uint32_t height) -> size_t {
+		if( !IsCompressed(format) ) return (size_t)width * height * BlockBytes(format);
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * BlockBytes(format);
+	}
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// KTX2
+
+	static const uint8_t c_ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+	/**
+	 * @brief Build the basic data format descriptor of a format, as required by KTX2
+	 * @param format The format
+	 * @return The descriptor including its total size
+	 */
+	static auto Ktx2Descriptor(VkFormat format) -> std::vector<uint32_t> {
+		struct Sample { uint32_t m_offset; uint32_t m_bits; uint32_t m_channel; uint32_t m_upper; };
+		const uint32_t linear = 0x10, alpha = 15;
+		bool srgb = format == VK_FORMAT_R8G8B8A8_SRGB || format == VK_FORMAT_BC1_RGB_SRGB_BLOCK || format == VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+			|| format == VK_FORMAT_BC3_SRGB_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK;
+		uint32_t model = 0;
+		std::vector<Sample> samples;
+		switch( format ) {
+			case VK_FORMAT_R8G8B8A8_UNORM:
+			case VK_FORMAT_R8G8B8A8_SRGB:
+				model = 1;
+				samples = { {0, 8, 0, 255}, {8, 8, 1, 255}, {16, 8, 2, 255}, {24, 8, alpha | (srgb ? linear : 0), 255} };
+				break;
+			case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGB_SRGB_BLOCK: model = 128; samples = { {0, 64, 0, 0xFFFFFFFF} }; break;
+			case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+			case VK_FORMAT_BC1_RGBA_SRGB_BLOCK: model = 128; samples = { {0, 64, 1, 0xFFFFFFFF} }; break;
+			case VK_FORMAT_BC3_UNORM_BLOCK:
+			case VK_FORMAT_BC3_SRGB_BLOCK: model = 130; samples = { {0, 64, alpha | (srgb ? linear : 0), 0xFFFFFFFF}, {64, 64, 0, 0xFFFFFFFF} }; break;
+			case VK_FORMAT_BC4_UNORM_BLOCK: model = 131; samples = { {0, 64, 0, 0xFFFFFFFF} }; break;
+			case VK_FORMAT_BC5_UNORM_BLOCK: model = 132; samples = { {0, 64, 0, 0xFFFFFFFF}, {64, 64, 1, 0xFFFFFFFF} }; break;
+			default: model = 134; samples = { {0, 128, 0, 0xFFFFFFFF} }; break;
+		}
+		uint32_t blockSize = 24 + 16 * (uint32_t)samples.size();
+		uint32_t dimension = TextureCooker::IsCompressed(format) ? 3 | 3 << 8 : 0;
+		std::vector<uint32_t> words = {
+			4 + blockSize,								//total size
+			0,											//vendor and descriptor type
+			2 | blockSize << 16,						//version 2 and block size
+			model | 1 << 8 | (srgb ? 2u : 1u) << 16,	//color model, BT.709 primaries, transfer function, straight alpha
+			dimension,									//texel block dimensions minus 1
+			TextureCooker::BlockBytes(format), 0		//bytes of plane 0 to 7
+		};
+		for( auto& sample : samples ) {
+			words.push_back( sample.m_offset | (sample.m_bits - 1) << 16 | sample.m_channel << 24 );
+			words.push_back( 0 );						//sample position
+			words.push_back( 0 );						//lower
+			words.push_back( sample.m_upper );
+		}
+		return words;
+	}
+
+	/**
+	 * @brief Write a cooked texture as KTX2 file without supercompression. The levels are stored from the smallest
+	 * to the largest, each aligned to the block size. The file is written to a temporary file that is renamed when
+	 * complete, so readers never see a partial file.
+	 * @param file Path of the file
+	 * @param texture The texture
+	 * @return true if the file was written
+	 */
+	auto TextureCooker::WriteKtx2(const std::filesystem::path& file, const CookedTexture& texture) -> bool {
+		uint32_t blockBytes = BlockBytes(texture.m_format);
+		if( blockBytes == 0 || texture.m_levels.empty() ) return false;
+
+		auto dfd = Ktx2Descriptor(texture.m_format);
+		std::string key = "KTXwriter", value = "Vienna Vulkan Engine";
+		uint32_t kvdEntry = (uint32_t)(key.size() + value.size() + 2);
+		uint32_t levelCount = (uint32_t)texture.m_levels.size();
+		uint32_t dfdOffset = 80 + 24 * levelCount;
+		uint32_t dfdLength = (uint32_t)(dfd.size() * 4);
+		uint32_t kvdOffset = dfdOffset + dfdLength;
+		uint32_t kvdLength = 4 + kvdEntry;
+		uint32_t alignment = std::max(4u, blockBytes);
+
+		std::vector<uint8_t> out(kvdOffset + ((kvdLength + 3) & ~3u), 0);
+		auto put32 = [&](size_t offset, uint32_t v) { std::memcpy(&out[offset], &v, 4); };
+		auto put64 = [&](size_t offset, uint64_t v) { std::memcpy(&out[offset], &v, 8); };
+		std::memcpy(out.data(), c_ktx2Identifier, 12);
+		uint32_t header[9] = { (uint32_t)texture.m_format, 1, texture.m_width, texture.m_height, 0, 0, 1, levelCount, 0 };
+		for( int i = 0; i < 9; ++i ) put32(12 + 4 * i, header[i]);
+		put32(48, dfdOffset);
+		put32(52, dfdLength);
+		put32(56, kvdOffset);
+		put32(60, kvdLength);
+		std::memcpy(&out[dfdOffset], dfd.data(), dfdLength);
+		put32(kvdOffset, kvdEntry);
+		std::memcpy(&out[kvdOffset + 4], key.c_str(), key.size() + 1);
+		std::memcpy(&out[kvdOffset + 4 + key.size() + 1], value.c_str(), value.size() + 1);
+
+		for( uint32_t level = levelCount; level-- > 0; ) {
+			out.resize((out.size() + alignment - 1) / alignment * alignment, 0);
+			auto& data = texture.m_levels[level];
+			put64(80 + 24 * level, out.size());
+			put64(80 + 24 * level + 8, data.size());
+			put64(80 + 24 * level + 16, data.size());
+			out.insert(out.end(), data.begin(), data.end());
+		}
+
+		std::error_code ec;
+		if( file.has_parent_path() ) std::filesystem::create_directories(file.parent_path(), ec);
+		auto tmp = std::filesystem::path{file}.concat(".tmp");
+		{
+			std::ofstream stream(tmp, std::ios::binary);
+			if( !stream ) return false;
+			stream.write((const char*)out.data(), out.size());
+			if( !stream ) return false;
+		}
+		std::filesystem::rename(tmp, file, ec);
+		return !ec;
+	}
+
+	/**
+	 * @brief Read a KTX2 file with one 2D image and no supercompression. The file is read at once, every offset is
+	 * checked against its size.
+	 * @param file Path of the file
+	 * @return The texture, or nullopt if the file cannot be read or uses other features
+	 */
+	auto TextureCooker::ReadKtx2(const std::filesystem::path& file) -> std::optional<CookedTexture> {
+		std::ifstream stream(file, std::ios::binary | std::ios::ate);
+		if( !stream ) return std::nullopt;
+		std::vector<uint8_t> in((size_t)stream.tellg());
+		stream.seekg(0);
+		stream.read((char*)in.data(), in.size());
+		if( !stream || in.size() < 80 || std::memcmp(in.data(), c_ktx2Identifier, 12) != 0 ) return std::nullopt;
+
+		auto get32 = [&](size_t offset) { uint32_t v; std::memcpy(&v, &in[offset], 4); return v; };
+		auto get64 = [&](size_t offset) { uint64_t v; std::memcpy(&v, &in[offset], 8); return v; };
+		CookedTexture texture{ (VkFormat)get32(12), get32(20), get32(24) };
+		uint32_t depth = get32(28), layers = get32(32), faces = get32(36), levelCount = std::max(1u, get32(40)), supercompression = get32(44);
+		if( BlockBytes(texture.m_format) == 0 || depth != 0 || layers > 1 || faces != 1 || supercompression != 0 ) return std::nullopt;
+		if( texture.m_width == 0 || texture.m_height == 0 || levelCount > 32 || in.size() < 80 + 24 * (size_t)levelCount ) return std::nullopt;
+
+		for( uint32_t level = 0; level < levelCount; ++level ) {
+			uint64_t offset = get64(80 + 24 * level), length = get64(80 + 24 * level + 8);
+			uint32_t w = std::max(1u, texture.m_width >> level), h = std::max(1u, texture.m_height >> level);
+			if( length != LevelBytes(texture.m_format, w, h) || offset > in.size() || length > in.size() - offset ) return std::nullopt;
+			texture.m_levels.emplace_back(in.begin() + offset, in.begin() + offset + length);
+		}
+		return texture;
+	}
+
+};  // namespace vve
+
@@ -0,0 +1,30 @@
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+	// Null Window
+
+	/**
+	 * @brief Constructs a null window, only the window state is created
+	 * @param systemName Name of the window system
+	 * @param engine Reference to the engine instance
+	 * @param windowName Name for the window
+	 * @param width Window width in pixels
+	 * @param height Window height in pixels
+	 */
+    WindowNull::WindowNull( std::string systemName, Engine& engine, std::string windowName, int width, int height) 
+                : Window(systemName, engine, windowName, width, height ) {
+        m_windowStateHandle = m_registry.Insert(WindowState{width, height, windowName});
+    }
+
+	/**
+	 * @brief Destructor for the null window
+	 */
+    WindowNull::~WindowNull() {}
+
+};  // namespace vve
+
@@ -0,0 +1,174 @@
+#include <fstream>
+#include <sstream>
+
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+namespace vve {
+
+
+	//-------------------------------------------------------------------------------------------------------
+
+	/**
+	 * @brief Constructor for the WorldPartition class
+	 * @param systemName Name of the system
+	 * @param engine Reference to the engine
+	 * @param directory Directory containing the cell files
+	 * @param cellSize Edge length of a cell
+	 * @param radius Cells within this many cells of the camera cell are kept resident
+	 * @param budgetMs Time budget for instantiating objects per frame in milliseconds
+	 */
+    WorldPartition::WorldPartition(std::string systemName, Engine& engine, std::filesystem::path directory, real_t cellSize, int radius, double budgetMs)
+		: System{systemName, engine }, m_directory{directory}, m_cellSize{cellSize}, m_radius{radius}, m_budgetMs{budgetMs} {
+		engine.RegisterCallbacks( {
+			{this, std::numeric_limits<int>::max() - 2000, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+			{this,                                      0, "MEMORY_REPORT", [this](Message& message){ return OnMemoryReport(message);} },
+		} );
+	}
+
+	/**
+	 * @brief Destructor for the WorldPartition class, waits for pending loads
+	 */
+    WorldPartition::~WorldPartition() {
+		for( auto& [key, cell] : m_cells ) { if( cell.m_future.valid() ) cell.m_future.wait(); }
+		for( auto& future : m_discarded ) { future.wait(); }
+	}
+
+	/**
+	 * @brief Get the file name of a cell
+	 * @param directory Directory containing the cell files
+	 * @param x Cell x coordinate
+	 * @param y Cell y coordinate
+	 * @return Path of the cell file
+	 */
+	auto WorldPartition::CellFile(const std::filesystem::path& directory, int x, int y) -> std::filesystem::path {
+		return directory / ("cell_" + std::to_string(x) + "_" + std::to_string(y) + ".cell");
+	}
+
+	/**
+	 * @brief Read a cell file, runs on a worker thread and does not touch the registry
+	 * @param file Path of the cell file
+	 * @return Objects of the cell, empty if the file does not exist
+	 */
+	auto WorldPartition::LoadCell(std::filesystem::path file) -> std::vector<Engine::ObjectInfo> {
+		std::vector<Engine::ObjectInfo> content;
+		std::ifstream in{file};
+		if( !in ) return content;
+
+		std::string line;
+		while( std::getline(in, line) ) {
+			std::istringstream ls{line};
+			std::string mesh;
+			float r, g, b, x, y, z, s;
+			if( !(ls >> mesh >> r >> g >> b >> x >> y >> z >> s) ) continue;
+			content.push_back( {
+				.m_meshName = MeshName{mesh},
+				.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {r, g, b, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+				.m_position = Position{vec3_t{x, y, z}},
+				.m_scale = Scale{vec3_t{s}}
+			} );
+		}
+		return content;
+	}
+
+	/**
+	 * @brief Remove a cell and its objects from the scene
+	 * @param cell The cell to evict
+	 */
+	void WorldPartition::EvictCell(Cell& cell) {
+		if( cell.m_future.valid() ) { m_discarded.push_back(std::move(cell.m_future)); }
+		if( cell.m_node().IsValid() ) {
+			m_stats.m_objects -= cell.m_next;
+			m_engine.DestroyObject(cell.m_node);
+		}
+		for( auto& info : cell.m_content ) { m_stats.m_bytesContent -= sizeof(Engine::ObjectInfo) + info.m_meshName().capacity(); }
+		++m_stats.m_cellsEvicted;
+	}
+
+	/**
+	 * @brief Load and evict cells around the camera, instantiate pending cells within the budget
+	 * @param message Update message
+	 * @return false to continue message propagation
+	 */
+	bool WorldPartition::OnUpdate(Message message) {
+		auto start = std::chrono::high_resolution_clock::now();
+		auto elapsedMs = [&]() { return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count(); };
+
+		auto view = m_registry.template GetView<vecs::Handle, Camera&, LocalToWorldMatrix&>();
+		auto it = view.begin();
+		if( !(it != view.end()) ) return false;
+		auto [cHandle, camera, LtoW] = *it;
+		int cx = (int)std::floor(LtoW()[3].x / m_cellSize);
+		int cy = (int)std::floor(LtoW()[3].y / m_cellSize);
+
+		// evict cells that are too far away
+		for( auto cell = m_cells.begin(); cell != m_cells.end(); ) {
+			auto [x, y] = cell->first;
+			if( std::abs(x - cx) > m_radius || std::abs(y - cy) > m_radius ) {
+				EvictCell(cell->second);
+				cell = m_cells.erase(cell);
+			} else ++cell;
+		}
+		std::erase_if(m_discarded, [](auto& future) { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+
+		// start loading new cells, nearest ring first
+		for( int r = 0; r <= m_radius; ++r ) {
+			for( int y = cy - r; y <= cy + r; ++y ) {
+				for( int x = cx - r; x <= cx + r; ++x ) {
+					if( std::max(std::abs(x - cx), std::abs(y - cy)) != r || m_cells.contains({x, y}) ) continue;
+					Cell cell{};
+					cell.m_future = std::async(std::launch::async, &WorldPartition::LoadCell, CellFile(m_directory, x, y));
+					m_cells.emplace(std::make_pair(x, y), std::move(cell));
+				}
+			}
+		}
+
+		// instantiate loaded cells within the time budget
+		static const size_t c_batchSize = 16;
+		m_stats.m_cellsResident = m_stats.m_cellsPending = 0;
+		for( auto& [key, cell] : m_cells ) {
+			if( cell.m_state == CellState::CELL_LOADING && cell.m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready ) {
+				cell.m_content = cell.m_future.get();
+				for( auto& info : cell.m_content ) { m_stats.m_bytesContent += sizeof(Engine::ObjectInfo) + info.m_meshName().capacity(); }
+				cell.m_node = m_engine.CreateSceneNode(Name{"Cell " + std::to_string(key.first) + " " + std::to_string(key.second)}, ParentHandle{});
+				cell.m_state = CellState::CELL_INSTANTIATING;
+				++m_stats.m_cellsLoaded;
+			}
+
+			while( cell.m_state == CellState::CELL_INSTANTIATING && elapsedMs() < m_budgetMs ) {
+				auto count = std::min(c_batchSize, cell.m_content.size() - cell.m_next);
+				m_engine.CreateObjects(ParentHandle{cell.m_node}, std::span{cell.m_content}.subspan(cell.m_next, count));
+				cell.m_next += count;
+				m_stats.m_objects += count;
+				if( cell.m_next == cell.m_content.size() ) cell.m_state = CellState::CELL_RESIDENT;
+			}
+
+			if( cell.m_state == CellState::CELL_RESIDENT ) ++m_stats.m_cellsResident;
+			else ++m_stats.m_cellsPending;
+		}
+
+		m_stats.m_lastFrameMs = elapsedMs();
+		m_stats.m_maxFrameMs = std::max(m_stats.m_maxFrameMs, m_stats.m_lastFrameMs);
+		return false;
+	}
+
+	/**
+	 * @brief Add the loaded cell content to a memory report, cells still loading on a worker are not included
+	 * @param message Memory report message
+	 * @return false to continue message propagation
+	 */
+	bool WorldPartition::OnMemoryReport(Message message) {
+		auto& msg = message.template GetData<MsgMemoryReport>();
+		size_t objects = 0, bytes = MemoryReport::TreeMapBytes(m_cells);
+		for( auto& [key, cell] : m_cells ) {
+			objects += cell.m_content.size();
+			bytes += MemoryReport::VectorBytes(cell.m_content);
+			for( auto& info : cell.m_content ) { bytes += MemoryReport::StringBytes(info.m_meshName()) + MemoryReport::StringBytes(info.m_textureName()); }
+		}
+		MemoryReport::Add(msg.m_report->m_systems, "World partition cells", objects, bytes);
+		return false;
+	}
+
+
+};  // namespace vve
+
@@ -267,11 +267,16 @@ namespace vvh {
     void ComRecordObject(VkCommandBuffer commandBuffer, Pipeline& graphicsPipeline,
 			const std::vector<DescriptorSet>&& descriptorSets, std::string type, Mesh& mesh, uint32_t currentFrame) {
 
-        auto offsets = mesh.m_verticesData.getOffsets(type);
-        std::vector<VkBuffer> vertexBuffers(offsets.size(), mesh.m_vertexBuffer);
-       	vkCmdBindVertexBuffers(commandBuffer, 0, (uint32_t)offsets.size(), vertexBuffers.data(), offsets.data());
+		if( mesh.m_verticesData.m_interleaved ) {
+			VkDeviceSize offset = 0;	// one stream of whole vertices
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mesh.m_vertexBuffer, &offset);
+		} else {
+			auto offsets = mesh.m_verticesData.getOffsets(type);
+			std::vector<VkBuffer> vertexBuffers(offsets.size(), mesh.m_vertexBuffer);
+			vkCmdBindVertexBuffers(commandBuffer, 0, (uint32_t)offsets.size(), vertexBuffers.data(), offsets.data());
+		}
 
-        vkCmdBindIndexBuffer(commandBuffer, mesh.m_indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdBindIndexBuffer(commandBuffer, mesh.m_indexBuffer, 0, mesh.m_indexType);
 
 		for( auto& descriptorSet : descriptorSets ) {
         	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline.m_pipelineLayout, 
@@ -0,0 +1,202 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <map>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Asset memory budget. The bundled models are loaded one after the other with the null renderer, each scene
+ * replacing the previous one. The first run has no budget and measures the GPU memory of each scene. The second run
+ * cycles through the scenes twice with a budget that fits only the largest scene. The asset manager must stay within
+ * the budget, evict and reload assets, the renderer must free the evicted memory, and the reloaded meshes must be
+ * the same as the first time. Evicted assets are reloaded in the background, the checks wait until loading is done.
+ */
+
+
+/**
+ * @brief Result of cycling through the scenes
+ */
+struct Result {
+	std::map<std::string, uint64_t> m_meshes;		//content hash of each mesh, from the first time it was seen
+	std::map<std::string, bool> m_textures;			//textures and whether they were loaded the first time
+	std::vector<size_t> m_footprints;				//GPU bytes added by each scene of the first cycle
+	vve::AssetManager::Residency m_residency{};		//at the end
+	size_t m_maxGpuBytes{0};						//most GPU memory of the scenes at a check, without the default level
+	size_t m_loadingFrames{0};						//frames waiting for reloads
+	size_t m_failures{0};
+};
+
+
+/**
+ * @brief Hash the positions and indices of a mesh with 64 bit FNV-1a
+ */
+auto Hash(const vvh::Mesh& mesh) -> uint64_t {
+	uint64_t hash = 14695981039346656037ull;
+	auto add = [&](const void* data, size_t size) {
+		for( size_t i = 0; i < size; ++i ) { hash = (hash ^ ((const uint8_t*)data)[i]) * 1099511628211ull; }
+	};
+	add(mesh.m_verticesData.m_positions.data(), mesh.m_verticesData.m_positions.size() * sizeof(glm::vec3));
+	add(mesh.m_indices.data(), mesh.m_indices.size() * sizeof(uint32_t));
+	return hash;
+}
+
+
+/**
+ * @brief Replaces the scene every few frames and checks the assets and the memory before each replacement
+ */
+class BudgetTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the BudgetTest class
+	 * @param engine Reference to the engine
+	 * @param files The scene files
+	 * @param cycles How often each scene is loaded
+	 * @param sceneBudget GPU bytes for the scenes, 0 for no budget
+	 * @param seen Meshes and textures of an earlier run, to compare with
+	 */
+	BudgetTest( vve::Engine& engine, std::vector<std::filesystem::path> files, size_t cycles, size_t sceneBudget, const Result& seen )
+		: EngineTest(engine, "Asset Budget Test", 0, 100), m_result{ .m_meshes = seen.m_meshes, .m_textures = seen.m_textures },	//after the asset manager evicted
+		  m_files{files}, m_cycles{cycles}, m_sceneBudget{sceneBudget} {};
+
+	inline static const size_t c_framesPerScene = 4;	//unused assets can be evicted MAX_FRAMES_IN_FLIGHT frames later
+
+	bool Frame(size_t frame) override {
+		if( m_engine.GetLoadProgress().IsLoading() ) { ++m_result.m_loadingFrames; return true; }	//objects use placeholders
+		if( m_loadedFrames++ % c_framesPerScene != 0 ) return true;
+		auto assets = Assets();
+		if( m_step == 0 ) {
+			m_baseline = assets->GetResidency().m_gpuBytes;		//the default level
+			if( m_sceneBudget > 0 ) assets->SetMemoryBudget(0, m_baseline + m_sceneBudget);
+		} else {
+			Check(assets);
+		}
+		if( m_step == m_files.size() * m_cycles ) {
+			m_result.m_residency = assets->GetResidency();
+			return false;
+		}
+
+		if( m_scene().IsValid() ) m_engine.DestroyObject(m_scene);
+		size_t before = assets->GetResidency().m_gpuBytes;
+		m_scene = m_engine.CreateScene(vve::Name{std::format("Scene{}", m_step)}, vve::ParentHandle{}, vve::Filename{m_files[m_step % m_files.size()].string()}, aiProcess_Triangulate);
+		if( m_step < m_files.size() ) m_result.m_footprints.push_back(assets->GetResidency().m_gpuBytes - before);
+		++m_step;
+		return true;
+	}
+
+	/**
+	 * @brief Check the memory and the assets of the current scene
+	 */
+	void Check(vve::AssetManager* assets) {
+		auto residency = assets->GetResidency();
+		auto renderer = dynamic_cast<vve::RendererNull*>(m_engine.GetSystem(m_engine.m_rendererNullName));
+		size_t rendererBytes = renderer->GetStats().m_bufferBytes + renderer->GetStats().m_textureBytes;
+		m_result.m_maxGpuBytes = std::max(m_result.m_maxGpuBytes, residency.m_gpuBytes - m_baseline);
+
+		auto file = m_files[(m_step - 1) % m_files.size()].string();
+		if( m_sceneBudget > 0 && residency.m_gpuBytes > m_baseline + m_sceneBudget ) Fail(std::format("{}: {} bytes exceed the budget", file, residency.m_gpuBytes));
+		bool placeholders = m_engine.ContainsHandle(vve::AssetManager::c_placeholderMesh);	//created with the first reload
+		if( m_step == 1 || placeholders != m_placeholders ) m_unmanaged = rendererBytes - residency.m_gpuBytes;	//meshes and textures not loaded from scene files
+		else if( rendererBytes - residency.m_gpuBytes != m_unmanaged ) Fail(std::format("{}: renderer has {} bytes, asset manager {} bytes", file, rendererBytes, residency.m_gpuBytes));
+		m_placeholders = placeholders;
+		CheckNode(m_scene());
+	}
+
+	/**
+	 * @brief Check that the objects below a node have their mesh and texture, with the content of the first load
+	 * @param handle The node
+	 */
+	void CheckNode(vecs::Handle handle) {
+		if( !m_registry.Has<vve::Children>(handle) ) return;
+		for( auto child : m_registry.Get<vve::Children&>(handle)() ) {
+			if( m_registry.Has<vve::MeshName>(child) ) {
+				auto name = m_registry.Get<vve::MeshName>(child)();
+				auto mesh = m_registry.Get<vve::MeshHandle>(child)();
+				if( !m_registry.Exists(mesh) || !m_registry.Has<vvh::Mesh>(mesh) ) {
+					Fail(std::format("mesh {} is missing", name));
+				} else {
+					auto hash = Hash(m_registry.Get<vvh::Mesh&>(mesh)());
+					if( !m_result.m_meshes.contains(name) ) m_result.m_meshes[name] = hash;
+					else if( m_result.m_meshes[name] != hash ) Fail(std::format("mesh {} changed", name));
+				}
+			}
+			if( m_registry.Has<vve::TextureName>(child) ) {
+				auto name = m_registry.Get<vve::TextureName>(child)();
+				auto texture = m_registry.Get<vve::TextureHandle>(child)();
+				bool loaded = texture.IsValid() && m_registry.Exists(texture) && m_registry.Has<vvh::Image>(texture);
+				if( !m_result.m_textures.contains(name) ) m_result.m_textures[name] = loaded;
+				else if( m_result.m_textures[name] != loaded ) Fail(std::format("texture {} is missing", name));
+			}
+			CheckNode(child);
+		}
+	}
+
+	void Fail(const std::string& what) {
+		std::cout << "FAILED: " << what << "\n";
+		++m_result.m_failures;
+	}
+
+	Result m_result{};
+
+private:
+	std::vector<std::filesystem::path> m_files;
+	size_t m_cycles;
+	size_t m_sceneBudget;			//GPU bytes for the scenes on top of the default level, 0 for no budget
+	size_t m_loadedFrames{0};		//frames without loading in progress
+	size_t m_step{0};				//scenes created so far
+	size_t m_baseline{0};			//GPU bytes of the default level
+	size_t m_unmanaged{0};
+	bool m_placeholders{false};
+	vve::ObjectHandle m_scene{};
+};
+
+
+/**
+ * @brief Cycle through the scenes in a new engine
+ * @param files The scene files
+ * @param cycles How often each scene is loaded
+ * @param sceneBudget GPU bytes for the scenes, 0 for no budget
+ * @param seen Meshes and textures of an earlier run, to compare with
+ * @return The result
+ */
+auto Run(std::vector<std::filesystem::path> files, size_t cycles, size_t sceneBudget, const Result& seen = {}) -> Result {
+	return RunTest<BudgetTest>("Asset Budget", vve::RendererType::RENDERER_TYPE_NULL, files, cycles, sceneBudget, seen);
+}
+
+
+/**
+ * @brief Usage: testassetbudget [scene files...], e.g. testassetbudget assets/Sponza/glTF/Sponza.gltf assets/viking_room/viking_room.obj
+ * Without scene files the bundled models are used.
+ */
+int main(int argc, char* argv[]) {
+	std::vector<std::filesystem::path> files{ argv + 1, argv + argc };
+	if( files.empty() ) files = {
+		"assets/viking_room/viking_room.obj",
+		"assets/other/zombies 3d.obj",
+		"assets/other/cottage_obj.obj",
+		"assets/test/Fireplace/Fireplace.gltf",
+		"assets/test/cornell/CornellBox-Original.obj",
+		"assets/cloths/cloth0/cloth.obj",
+	};
+
+	auto unlimited = Run(files, 1, 0);
+	size_t total = 0, largest = 0;
+	for( size_t i = 0; i < unlimited.m_footprints.size(); ++i ) {
+		std::cout << std::format("{:<45} {:>12} bytes\n", files[i].string(), unlimited.m_footprints[i]);
+		total += unlimited.m_footprints[i];
+		largest = std::max(largest, unlimited.m_footprints[i]);
+	}
+	auto budgeted = Run(files, 2, largest, unlimited);
+
+	auto& r = budgeted.m_residency;
+	bool ok = unlimited.m_failures == 0 && unlimited.m_residency.m_evicted == 0 && budgeted.m_failures == 0
+		&& total > largest && r.m_evicted > 0 && r.m_reloaded > 0 && budgeted.m_maxGpuBytes <= largest;
+	std::cout << std::format("Scenes need {} bytes, budget {} bytes, at most {} bytes were used\n", total, largest, budgeted.m_maxGpuBytes);
+	std::cout << std::format("{} assets evicted, {} reloaded in {} frames, {} resident at the end\n", r.m_evicted, r.m_reloaded, budgeted.m_loadingFrames, r.m_assets);
+	return Report("Asset budget", ok);
+}
+
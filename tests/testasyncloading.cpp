@@ -0,0 +1,193 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testscene.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Asynchronous asset loading. Several scenes are imported on worker threads at the same time, their
+ * textures are decoded on worker threads, and meshes and textures are handed to the renderer within the load
+ * budget of each frame. Objects use a placeholder mesh and texture until their assets are ready.
+ *
+ * Runs with the null renderer, so no GPU is needed. The time of each load step is checked against the budget,
+ * a step may exceed the budget by at most the longest unit. In the end every object must use its real mesh
+ * and texture, and each scene must have as many nodes as when it is loaded blocking.
+ */
+
+
+/**
+ * @brief Result of the async load
+ */
+struct AsyncResult {
+	std::vector<size_t> m_nodes;	//per scene
+	size_t m_frames{0};
+	size_t m_wrongAssets{0};
+	size_t m_maxPlaceholders{0};	//objects using a placeholder at the same time
+	double m_startMs{0.0};			//time to start all async loads
+	double m_maxStepMs{0.0};
+	double m_maxUnitMs{0.0};
+	double m_maxFrameMs{0.0};
+};
+
+
+/**
+ * @brief Starts loading all scenes at once and watches the load steps until everything is loaded
+ */
+class AsyncLoadingTest : public EngineTest {
+
+public:
+	AsyncLoadingTest( vve::Engine& engine, std::vector<std::filesystem::path> files, double budgetMs )
+		: EngineTest(engine, "Async Loading Test"), m_files{files} {
+		m_engine.SetFixedTimestep(1.0 / 60.0);
+		m_engine.SetLoadBudget(budgetMs);
+	};
+
+	inline static const size_t c_maxFrames = 100000;	//give up if loading does not finish
+
+	void Load() override {
+		auto start = std::chrono::high_resolution_clock::now();
+		for( auto& file : m_files ) {
+			m_scenes.push_back( m_engine.CreateSceneAsync(vve::Name{file.stem().string()}, vve::ParentHandle{}, vve::Filename{file.string()}, aiProcess_Triangulate) );
+		}
+		m_result.m_startMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		m_last = std::chrono::high_resolution_clock::now();
+	};
+
+	/**
+	 * @brief Check that the objects below a node use the assets named by them and not a placeholder
+	 * @param handle The node
+	 * @return Number of objects using a wrong handle
+	 */
+	auto CountWrongAssets(vecs::Handle handle) -> size_t {
+		size_t wrong = 0;
+		if( !m_registry.Has<vve::Children>(handle) ) return wrong;
+		for( auto child : m_registry.Get<vve::Children&>(handle)() ) {
+			if( m_registry.Has<vve::MeshName>(child) ) {
+				auto mesh = m_registry.Get<vve::MeshHandle>(child)();
+				if( mesh.GetValue() != m_engine.GetHandle(m_registry.Get<vve::MeshName>(child)()).GetValue() ) ++wrong;
+			}
+			if( m_registry.Has<vve::TextureName>(child) ) {
+				auto texture = m_registry.Get<vve::TextureHandle>(child)();
+				if( texture.GetValue() != m_engine.GetHandle(m_registry.Get<vve::TextureName>(child)()).GetValue() ) ++wrong;
+			}
+			wrong += CountWrongAssets(child);
+		}
+		return wrong;
+	}
+
+	/**
+	 * @brief Count the objects currently using the placeholder mesh or texture
+	 * @return Number of objects
+	 */
+	auto CountPlaceholders() -> size_t {
+		auto mesh = m_engine.GetHandle(vve::AssetManager::c_placeholderMesh).GetValue();
+		auto texture = m_engine.GetHandle(vve::AssetManager::c_placeholderTexture).GetValue();
+		size_t count = 0;
+		for( auto [handle, meshHandle] : m_registry.GetView<vecs::Handle, vve::MeshHandle&>() ) {
+			if( meshHandle()().GetValue() == mesh ) ++count;
+		}
+		for( auto [handle, textureHandle] : m_registry.GetView<vecs::Handle, vve::TextureHandle&>() ) {
+			if( textureHandle()().GetValue() == texture ) ++count;
+		}
+		return count;
+	}
+
+	bool Frame(size_t frame) override {
+		auto now = std::chrono::high_resolution_clock::now();
+		m_result.m_maxFrameMs = std::max(m_result.m_maxFrameMs, std::chrono::duration<double, std::milli>(now - m_last).count());
+		m_last = now;
+
+		auto& progress = m_engine.GetLoadProgress();
+		m_result.m_maxStepMs = std::max(m_result.m_maxStepMs, progress.m_lastStepMs);
+		m_result.m_maxUnitMs = std::max(m_result.m_maxUnitMs, progress.m_maxUnitMs);
+		m_result.m_maxPlaceholders = std::max(m_result.m_maxPlaceholders, CountPlaceholders());
+		m_result.m_frames = frame + 1;
+		if( progress.IsLoading() && m_result.m_frames < c_maxFrames ) return true;
+
+		for( auto& scene : m_scenes ) {
+			m_result.m_nodes.push_back(CountNodes(m_registry, scene));
+			m_result.m_wrongAssets += CountWrongAssets(scene);
+		}
+		return false;
+	}
+
+	AsyncResult m_result{};
+
+private:
+	std::vector<std::filesystem::path> m_files;
+	std::vector<vve::ObjectHandle> m_scenes;
+	std::chrono::high_resolution_clock::time_point m_last;
+};
+
+
+/**
+ * @brief Result of the blocking load
+ */
+struct BlockingResult {
+	std::vector<size_t> m_nodes;	//per scene
+	double m_ms{0.0};
+};
+
+
+/**
+ * @brief Load the scenes blocking in the first frame
+ */
+class BlockingLoad : public EngineTest {
+
+public:
+	BlockingLoad( vve::Engine& engine, std::vector<std::filesystem::path> files ) : EngineTest(engine, "Blocking Load"), m_files{files} {};
+
+	void Load() override {
+		auto start = std::chrono::high_resolution_clock::now();
+		for( auto& file : m_files ) {
+			auto scene = m_engine.CreateScene(vve::Name{file.stem().string()}, vve::ParentHandle{}, vve::Filename{file.string()}, aiProcess_Triangulate);
+			m_result.m_nodes.push_back(CountNodes(m_registry, scene));
+		}
+		m_result.m_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	};
+
+	BlockingResult m_result{};
+
+private:
+	std::vector<std::filesystem::path> m_files;
+};
+
+
+/**
+ * @brief Usage: testasyncloading [budget ms] [scene files...], e.g. testasyncloading 2 assets/Sponza/glTF/Sponza.gltf
+ * Without scene files a few generated scenes are loaded.
+ */
+int main(int argc, char* argv[]) {
+	double budgetMs = argc > 1 ? std::stod(argv[1]) : 2.0;
+	std::vector<std::filesystem::path> files;
+	for( int i = 2; i < argc; ++i ) { files.push_back(argv[i]); }
+	if( files.empty() ) {
+		for( int i = 0; i < 4; ++i ) {
+			files.push_back( std::filesystem::temp_directory_path() / std::format("vve-async-loading-{}.obj", i) );
+			WriteScene(files.back(), 300, 32, 1024);
+		}
+	}
+
+	auto type = vve::RendererType::RENDERER_TYPE_NULL;
+	auto blocking = RunTest<BlockingLoad>("Blocking", type, files);
+	auto async = RunTest<AsyncLoadingTest>("Async Loading", type, files, budgetMs);
+
+	double ceilingMs = budgetMs + async.m_maxUnitMs;
+	std::cout << std::format("Blocking: {:.2f} ms in one frame\n", blocking.m_ms);
+	std::cout << std::format("Async: start {:.3f} ms, {} frames, max step {:.3f} ms, budget {:.3f} ms, max unit {:.3f} ms, max frame {:.3f} ms\n",
+		async.m_startMs, async.m_frames, async.m_maxStepMs, budgetMs, async.m_maxUnitMs, async.m_maxFrameMs);
+	std::cout << std::format("Objects with placeholders: up to {}, wrong assets at the end: {}\n", async.m_maxPlaceholders, async.m_wrongAssets);
+
+	bool ok = async.m_frames < AsyncLoadingTest::c_maxFrames && async.m_maxStepMs <= ceilingMs && async.m_startMs <= budgetMs
+		&& async.m_wrongAssets == 0 && async.m_nodes == blocking.m_nodes;
+	for( size_t i = 0; i < files.size(); ++i ) {
+		size_t nodes = i < async.m_nodes.size() ? async.m_nodes[i] : 0;
+		std::cout << std::format("{}: {} nodes, blocking {}\n", files[i].string(), nodes, blocking.m_nodes[i]);
+		ok = ok && nodes > 0;
+	}
+	return Report("Async loading", ok);
+}
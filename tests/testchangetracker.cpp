@@ -0,0 +1,124 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include <set>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Change tracker. Runs on the CPU only. First a few entities are touched by hand and the versions, the
+ * changed entities, erasing and the end of the history are checked. Then random entities are touched over many
+ * frames and queried once per frame in flight, like the deferred renderer does, and each query must return exactly
+ * the entities touched since the last query of its slot. The log must stay bounded by the history.
+ */
+
+
+size_t g_failures = 0;
+
+/**
+ * @brief Print and count a failed check
+ * @param ok Result of the check
+ * @param what Description of the check
+ */
+void Check(bool ok, const std::string& what) {
+	if( ok ) return;
+	std::cout << "FAILED: " << what << "\n";
+	++g_failures;
+}
+
+/**
+ * @brief Get the handle values of changed entities as a set
+ */
+auto Values(const std::vector<vecs::Handle>& handles) -> std::set<size_t> {
+	std::set<size_t> values;
+	for( auto& handle : handles ) values.insert(handle.GetValue());
+	return values;
+}
+
+
+/**
+ * @brief Touch entities by hand and check the tracker after each step
+ */
+void TestSteps() {
+	vecs::Registry registry;
+	auto a = registry.Insert(vve::Position{vec3_t{0.0f}});
+	auto b = registry.Insert(vve::Position{vec3_t{0.0f}});
+	auto c = registry.Insert(vve::Position{vec3_t{0.0f}});
+	vve::ChangeTracker tracker{4};
+	std::vector<vecs::Handle> changed;
+
+	tracker.NextFrame();
+	uint64_t first = tracker.GetFrame();
+	tracker.Touch(a);
+	tracker.Touch(b);
+	tracker.Touch(a);
+	Check(tracker.GetVersion(a) == first && tracker.GetVersion(b) == first, "version of touched entities");
+	Check(tracker.GetVersion(c) == 0, "version of an untouched entity");
+	Check(tracker.GetChangedSince(first, changed) && changed.size() == 2, "entity touched twice in a frame is returned once");
+	Check(tracker.GetLogSize() == 2, "entity touched twice in a frame is logged once");
+
+	tracker.NextFrame();
+	tracker.Touch(a);
+	Check(tracker.GetChangedSince(first + 1, changed) && Values(changed) == std::set<size_t>{a.GetValue()}, "changed in the last frame");
+	Check(tracker.GetChangedSince(first, changed) && changed.size() == 2 && Values(changed) == std::set<size_t>{a.GetValue(), b.GetValue()},
+		"entity touched in two frames is returned once");
+
+	tracker.Erase(b);
+	Check(tracker.GetVersion(b) == 0, "version of an erased entity");
+	Check(tracker.GetChangedSince(first, changed) && Values(changed) == std::set<size_t>{a.GetValue()}, "erased entity is not returned");
+
+	for( int i = 0; i < 5; ++i ) tracker.NextFrame();
+	Check(!tracker.GetChangedSince(first, changed), "query behind the history must rescan");
+	Check(tracker.GetChangedSince(tracker.GetFrame() - 3, changed) && changed.empty(), "nothing changed within the history");
+}
+
+
+/**
+ * @brief Touch random entities over many frames and query them per frame in flight
+ * @param numEntities Number of entities
+ * @param numChanged Entities touched per frame
+ * @param frames Number of frames
+ */
+void TestFramesInFlight(size_t numEntities, size_t numChanged, size_t frames) {
+	const uint64_t c_history = 8;
+	vecs::Registry registry;
+	std::vector<vecs::Handle> handles;
+	for( size_t i = 0; i < numEntities; ++i ) handles.push_back( registry.Insert(vve::Position{vec3_t{0.0f}}) );
+
+	vve::ChangeTracker tracker{c_history};
+	std::default_random_engine rnd{ 12345 };
+	std::uniform_int_distribution<size_t> pick{ 0, numEntities - 1 };
+	std::array<uint64_t, MAX_FRAMES_IN_FLIGHT> updated{};
+	std::array<std::set<size_t>, MAX_FRAMES_IN_FLIGHT> expected{};	//touched since the last query of each slot
+	std::vector<vecs::Handle> changed;
+	size_t wrong = 0, maxLog = 0;
+
+	for( size_t frame = 0; frame < frames; ++frame ) {
+		tracker.NextFrame();
+		for( size_t i = 0; i < numChanged; ++i ) {
+			auto handle = handles[pick(rnd)];
+			tracker.Touch(handle);
+			for( auto& slot : expected ) slot.insert(handle.GetValue());
+		}
+		size_t slot = frame % MAX_FRAMES_IN_FLIGHT;
+		bool complete = tracker.GetChangedSince(updated[slot] + 1, changed);
+		if( updated[slot] > 0 && (!complete || changed.size() != expected[slot].size() || Values(changed) != expected[slot]) ) ++wrong;
+		updated[slot] = tracker.GetFrame();
+		expected[slot].clear();
+		maxLog = std::max(maxLog, tracker.GetLogSize());
+	}
+	Check(wrong == 0, std::format("{} of {} queries returned other entities than were touched", wrong, frames));
+	Check(maxLog <= (c_history + 1) * numChanged, std::format("log has {} entries, more than the history of {} frames", maxLog, c_history));
+}
+
+
+int main() {
+	TestSteps();
+	TestFramesInFlight(10000, 500, 500);
+	std::cout << std::format("Change tracker: {}\n", g_failures == 0 ? "passed" : "FAILED");
+	return g_failures == 0 ? 0 : 1;
+}
+
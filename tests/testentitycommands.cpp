@@ -0,0 +1,141 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Stress test of deferred entity commands. Runs on the CPU only, no window or GPU is created. Each frame
+ * many threads concurrently create objects, insert and erase plain entities, and destroy objects of earlier
+ * frames, all through their own command buffer. The buffers are then played back. The test is run twice, the
+ * sequence of create and destroy messages must be the same in both runs although the threads are scheduled
+ * differently.
+ */
+
+using Payload = vsty::strong_type_t<uint64_t, vsty::counter<>>;
+
+
+/**
+ * @brief Listens to object create and destroy messages, and erases destroyed objects like the scene manager does
+ */
+class Recorder : public vve::System {
+
+public:
+	Recorder( vve::Engine& engine ) : vve::System("Recorder", engine ) {
+		m_engine.RegisterCallbacks( {
+			{this, 0, "OBJECT_CREATE",  [this](Message& message){ return OnObjectCreate(message);} },
+			{this, 0, "OBJECT_DESTROY", [this](Message& message){ return OnObjectDestroy(message);} }
+		} );
+	}
+
+	bool OnObjectCreate(Message& message) {
+		auto& msg = message.template GetData<vve::System::MsgObjectCreate>();
+		m_positions[msg.m_object().GetValue()] = m_live.size();
+		m_live.push_back(msg.m_object);
+		m_ordinals[msg.m_object().GetValue()] = m_created;
+		m_hash = m_hash * 31 + m_created;
+		++m_created;
+		return false;
+	}
+
+	bool OnObjectDestroy(Message& message) {
+		auto& msg = message.template GetData<vve::System::MsgObjectDestroy>();
+		size_t position = m_positions[msg.m_handle().GetValue()];	//swap with the last object and pop
+		m_positions[m_live.back().GetValue()] = position;
+		m_live[position] = m_live.back();
+		m_live.pop_back();
+		m_positions.erase(msg.m_handle().GetValue());
+		m_hash = m_hash * 37 + m_ordinals[msg.m_handle().GetValue()];
+		m_registry.Erase(msg.m_handle);
+		++m_destroyed;
+		return false;
+	}
+
+	std::vector<vecs::Handle> m_live;
+	std::unordered_map<size_t, size_t> m_positions;		//handle value to index in m_live
+	std::unordered_map<size_t, size_t> m_ordinals;		//handle value to creation order, handle values may differ between runs
+	size_t m_hash{0};
+	size_t m_created{0};
+	size_t m_destroyed{0};
+};
+
+
+struct Result {
+	size_t m_hash;
+	size_t m_created;
+	size_t m_destroyed;
+	size_t m_live;
+	bool m_consistent;
+	double m_playbackMs;
+};
+
+
+/**
+ * @brief Run the test once
+ * @param numThreads Number of recording threads
+ * @param frames Number of frames
+ * @param perThread Objects created per thread and frame
+ * @return Counters and hash of the message sequence
+ */
+auto Run(uint32_t numThreads, size_t frames, size_t perThread) -> Result {
+	vve::Engine engine("Entity Commands Stress");
+	Recorder recorder{engine};
+	auto& commands = engine.GetEntityCommands();
+	double playbackMs = 0.0;
+
+	for( size_t frame = 0; frame < frames; ++frame ) {
+		const auto& live = recorder.m_live;		//read only while the threads record
+		std::vector<std::jthread> threads;
+		for( uint32_t t = 0; t < numThreads; ++t ) {
+			threads.emplace_back( [&, t]() {
+				auto& buffer = commands.GetBuffer(t);
+				std::default_random_engine rnd{ (unsigned)(frame * numThreads + t) };
+				std::uniform_real_distribution<float> unif{ 0.0f, 1.0f };
+				for( size_t i = 0; i < perThread; ++i ) {
+					auto object = buffer.CreateObject(vve::Name{""}, vve::ParentHandle{}, vve::MeshName{"cube"},
+						vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {unif(rnd), unif(rnd), unif(rnd), 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} });
+					if( unif(rnd) < 0.1f ) buffer.DestroyObject(object);
+
+					auto entity = buffer.Insert(Payload{i});
+					buffer.Put(entity, vve::Position{vec3_t{unif(rnd)}});
+					if( unif(rnd) < 0.2f ) buffer.Erase(entity);
+					if( unif(rnd) < 0.5f ) buffer.Put(object, vve::UVScale{vec2_t{2.0f}});
+				}
+				for( size_t i = t; i < live.size(); i += numThreads ) {
+					if( unif(rnd) < 0.3f ) buffer.DestroyObject(vve::ObjectHandle{live[i]});
+				}
+			});
+		}
+		threads.clear();	//join
+
+		commands.Playback(engine);
+		playbackMs += commands.GetStats().m_playbackMs;
+	}
+
+	bool consistent = recorder.m_created - recorder.m_destroyed == recorder.m_live.size();
+	for( auto& handle : recorder.m_live ) { consistent = consistent && engine.GetRegistry().Exists(handle); }
+	return { recorder.m_hash, recorder.m_created, recorder.m_destroyed, recorder.m_live.size(), consistent, playbackMs / frames };
+}
+
+
+/**
+ * @brief Usage: testentitycommands [threads] [frames] [objects per thread and frame]
+ */
+int main(int argc, char* argv[]) {
+	uint32_t numThreads = argc > 1 ? std::stoul(argv[1]) : std::max(2u, std::thread::hardware_concurrency());
+	size_t frames = argc > 2 ? std::stoull(argv[2]) : 50;
+	size_t perThread = argc > 3 ? std::stoull(argv[3]) : 200;
+
+	auto first = Run(numThreads, frames, perThread);
+	auto second = Run(numThreads, frames, perThread);
+	std::cout << std::format("{} threads, {} frames: created {}, destroyed {}, live {}, playback {:.3f} ms per frame\n",
+		numThreads, frames, first.m_created, first.m_destroyed, first.m_live, first.m_playbackMs);
+
+	bool ok = first.m_consistent && second.m_consistent && first.m_hash == second.m_hash && first.m_created == second.m_created;
+	std::cout << std::format("Deterministic playback: {}\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
+
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <numbers>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief GPU mip generation. Raw textures of several sizes and formats are created, the renderer uploads them and
+ * blits their mip chains in the next frame. After a few frames all levels are read back and compared against a CPU
+ * reference of the same blit chain: each level is filtered bilinearly from the level before, sRGB textures in
+ * linear space, and stored with 8 bits. Needs a Vulkan device, e.g. lavapipe.
+ */
+
+
+/**
+ * @brief A texture created by the test
+ */
+struct Texture {
+	std::string m_name;
+	uint32_t m_width;
+	uint32_t m_height;
+	VkFormat m_format;
+	std::vector<uint8_t> m_pixels;		//level 0, 8 bit RGBA
+	vve::TextureHandle m_handle{};
+};
+
+
+/**
+ * @brief Convert an 8 bit sRGB value to linear
+ * @param value The value
+ * @return The linear value in [0,1]
+ */
+auto ToLinear(uint8_t value) -> float {
+	float c = value / 255.0f;
+	return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+/**
+ * @brief Convert a linear value to 8 bit sRGB
+ * @param value The linear value
+ * @return The sRGB value
+ */
+auto ToSrgb(float value) -> uint8_t {
+	value = std::clamp(value, 0.0f, 1.0f);
+	float c = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	return (uint8_t)std::lround(c * 255.0f);
+}
+
+
+/**
+ * @brief CPU reference of a linear blit chain
+ * @param texture The texture
+ * @return All levels, 8 bit RGBA, level 0 first
+ */
+auto ReferenceMips(const Texture& texture) -> std::vector<std::vector<uint8_t>> {
+	bool srgb = texture.m_format == VK_FORMAT_R8G8B8A8_SRGB;
+	uint32_t levels = (uint32_t)std::floor(std::log2(std::max(texture.m_width, texture.m_height))) + 1;
+	std::vector<std::vector<uint8_t>> mips{ texture.m_pixels };
+	for( uint32_t level = 1; level < levels; ++level ) {
+		uint32_t sw = std::max(1u, texture.m_width >> (level - 1)), sh = std::max(1u, texture.m_height >> (level - 1));
+		uint32_t dw = std::max(1u, texture.m_width >> level), dh = std::max(1u, texture.m_height >> level);
+		auto& src = mips.back();
+		auto texel = [&](int x, int y, int c) {
+			x = std::clamp(x, 0, (int)sw - 1);
+			y = std::clamp(y, 0, (int)sh - 1);
+			uint8_t value = src[4 * ((size_t)y * sw + x) + c];
+			return srgb && c < 3 ? ToLinear(value) : value / 255.0f;
+		};
+		std::vector<uint8_t> dst((size_t)dw * dh * 4);
+		for( uint32_t y = 0; y < dh; ++y ) {
+			for( uint32_t x = 0; x < dw; ++x ) {
+				float u = (x + 0.5f) * sw / dw - 0.5f, v = (y + 0.5f) * sh / dh - 0.5f;
+				int x0 = (int)std::floor(u), y0 = (int)std::floor(v);
+				float fx = u - x0, fy = v - y0;
+				for( int c = 0; c < 4; ++c ) {
+					float value = (1 - fy) * ((1 - fx) * texel(x0, y0, c) + fx * texel(x0 + 1, y0, c))
+						+ fy * ((1 - fx) * texel(x0, y0 + 1, c) + fx * texel(x0 + 1, y0 + 1, c));
+					dst[4 * ((size_t)y * dw + x) + c] = srgb && c < 3 ? ToSrgb(value) : (uint8_t)std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f);
+				}
+			}
+		}
+		mips.push_back(std::move(dst));
+	}
+	return mips;
+}
+
+
+/**
+ * @brief Creates the textures, lets the renderer upload them and reads all levels back
+ */
+class MipmapTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the MipmapTest class
+	 * @param engine Reference to the engine
+	 * @param textures The textures, their handles are set when they are created
+	 */
+	MipmapTest( vve::Engine& engine, std::vector<Texture>& textures ) : EngineTest(engine, "GPU Mipmaps Test"), m_textures{textures} {};
+
+	void Load() override {
+		auto assets = Assets();
+		for( auto& texture : m_textures ) {
+			auto pixels = (stbi_uc*)malloc(texture.m_pixels.size());	//freed by the asset manager
+			memcpy(pixels, texture.m_pixels.data(), texture.m_pixels.size());
+			vvh::Image image{(int)texture.m_width, (int)texture.m_height, 1, texture.m_pixels.size(), pixels};
+			image.m_format = texture.m_format;
+			texture.m_handle = vve::TextureHandle{ m_registry.Insert(vve::Name{texture.m_name}, image) };
+			m_engine.SendMsg( MsgTextureCreate{texture.m_handle, assets} );		//as asset manager, there is no file
+		}
+	}
+
+	bool Frame(size_t frame) override {
+		if( frame + 1 < c_renderFrames ) return true;
+		auto state = std::get<1>(vve::Renderer::GetState(m_registry));
+		vkDeviceWaitIdle(state().m_device);
+		for( auto& texture : m_textures ) { m_result.push_back(ReadBack(state(), m_registry.Get<vvh::Image&>(texture.m_handle)())); }
+		return false;
+	}
+
+	/**
+	 * @brief Copy all levels of a texture to the CPU
+	 * @param state The Vulkan state
+	 * @param image The texture, in shader read layout
+	 * @return The levels, 8 bit RGBA
+	 */
+	auto ReadBack(vve::VulkanState& state, vvh::Image& image) -> std::vector<std::vector<uint8_t>> {
+		std::vector<VkBufferImageCopy> regions;
+		VkDeviceSize size = 0;
+		for( uint32_t level = 0; level < image.m_mipLevels; ++level ) {
+			VkBufferImageCopy region{};
+			region.bufferOffset = size;
+			region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+			region.imageExtent = { std::max(1u, (uint32_t)image.m_width >> level), std::max(1u, (uint32_t)image.m_height >> level), 1 };
+			regions.push_back(region);
+			size += 4 * region.imageExtent.width * region.imageExtent.height;
+		}
+
+		VkBuffer buffer;
+		VmaAllocation allocation;
+		VmaAllocationInfo allocInfo;
+		vvh::BufCreateBuffer({
+			.m_vmaAllocator = state.m_vmaAllocator,
+			.m_size 		= size,
+			.m_usageFlags 	= VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			.m_properties 	= VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			.m_vmaFlags 	= VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT,
+			.m_buffer 		= buffer,
+			.m_allocation 	= allocation,
+			.m_allocationInfo = &allocInfo
+		});
+
+		auto barrier = [&](VkCommandBuffer commandBuffer, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess) {
+			VkImageMemoryBarrier barrier{};
+			barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			barrier.oldLayout = oldLayout;
+			barrier.newLayout = newLayout;
+			barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+			barrier.image = image.m_mapImage;
+			barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, image.m_mipLevels, 0, 1 };
+			barrier.srcAccessMask = srcAccess;
+			barrier.dstAccessMask = dstAccess;
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		};
+		auto commandBuffer = vvh::ComBeginSingleTimeCommands({state.m_device, state.m_commandPool});
+		barrier(commandBuffer, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_READ_BIT);
+		vkCmdCopyImageToBuffer(commandBuffer, image.m_mapImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, (uint32_t)regions.size(), regions.data());
+		barrier(commandBuffer, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT);
+		vvh::ComEndSingleTimeCommands({state.m_device, state.m_graphicsQueue, state.m_commandPool, commandBuffer});
+
+		std::vector<std::vector<uint8_t>> levels;
+		for( auto& region : regions ) {
+			auto data = (uint8_t*)allocInfo.pMappedData + region.bufferOffset;
+			levels.emplace_back(data, data + 4 * region.imageExtent.width * region.imageExtent.height);
+		}
+		vvh::BufDestroyBuffer({state.m_device, state.m_vmaAllocator, buffer, allocation});
+		return levels;
+	}
+
+	std::vector<std::vector<std::vector<uint8_t>>> m_result;	//levels of each texture
+
+private:
+	std::vector<Texture>& m_textures;
+};
+
+
+/**
+ * @brief Generate level 0 of a test texture, smooth waves with sharp edges, alpha is a gradient
+ * @param texture The texture, m_pixels is filled
+ */
+void Generate(Texture& texture) {
+	texture.m_pixels.resize((size_t)texture.m_width * texture.m_height * 4);
+	for( uint32_t y = 0; y < texture.m_height; ++y ) {
+		for( uint32_t x = 0; x < texture.m_width; ++x ) {
+			uint8_t* p = &texture.m_pixels[4 * ((size_t)y * texture.m_width + x)];
+			float u = (float)x / texture.m_width, v = (float)y / texture.m_height;
+			float wave = 0.5f + 0.5f * std::sin(2.0f * std::numbers::pi_v<float> * (5.0f * u + 3.0f * v));
+			p[0] = (uint8_t)std::lround(255.0f * wave);
+			p[1] = ((x / 8 + y / 8) % 2) ? 230 : 20;
+			p[2] = (uint8_t)std::lround(255.0f * v);
+			p[3] = (uint8_t)std::lround(255.0f * u);
+		}
+	}
+}
+
+
+int main() {
+	std::vector<Texture> textures = {
+		{ "mips-256-srgb",  256, 256, VK_FORMAT_R8G8B8A8_SRGB },
+		{ "mips-300-srgb",  300, 200, VK_FORMAT_R8G8B8A8_SRGB },
+		{ "mips-100-unorm", 100,  60, VK_FORMAT_R8G8B8A8_UNORM },
+		{ "mips-1-srgb",      1,   1, VK_FORMAT_R8G8B8A8_SRGB },
+	};
+	for( auto& texture : textures ) { Generate(texture); }
+
+	auto result = RunTest<MipmapTest>("GPU Mipmaps", vve::RendererType::RENDERER_TYPE_FORWARD, textures);
+
+	bool ok = result.size() == textures.size();
+	for( size_t i = 0; i < textures.size() && i < result.size(); ++i ) {
+		auto reference = ReferenceMips(textures[i]);
+		auto& levels = result[i];
+		bool same = levels.size() == reference.size();
+		int maxError = 0;
+		double error = 0.0;
+		size_t count = 0;
+		for( size_t level = 0; level < levels.size() && same; ++level ) {
+			same = levels[level].size() == reference[level].size();
+			for( size_t k = 0; k < levels[level].size() && same; ++k ) {
+				int diff = std::abs((int)levels[level][k] - reference[level][k]);
+				maxError = std::max(maxError, diff);
+				error += diff * diff;
+				++count;
+			}
+		}
+		error /= std::max(count, (size_t)1);
+		double psnr = error == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / error);
+		bool passed = same && maxError <= 3 && psnr >= 40.0;	//implementations may filter with less precision
+		std::cout << std::format("{:<15} {}x{} levels {:2}, max error {}, PSNR {:5.1f} dB: {}\n",
+			textures[i].m_name, textures[i].m_width, textures[i].m_height, levels.size(), maxError, psnr, passed ? "ok" : "FAILED");
+		ok = ok && passed;
+	}
+	return Report("GPU mipmaps", ok);
+}
+
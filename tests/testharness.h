@@ -0,0 +1,173 @@
+#pragma once
+
+#include <iostream>
+#include <format>
+#include <string>
+#include <vector>
+#include <cmath>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Engine harness of the checks. A check derives a system from EngineTest, keeps what it measured in m_result,
+ * and runs it with RunTest in a new engine. Only the request specific loading and assertions stay in the checks.
+ * Checks that render read the swapchain back with ReadSwapchain and compare the images with CompareImages.
+ */
+
+
+/**
+ * @brief Base of the test systems. Calls Load() when the level is loaded and Frame() at the end of each frame,
+ * the engine is stopped when Frame() returns false.
+ */
+class EngineTest : public vve::System {
+
+public:
+	/**
+	 * @brief Constructor for the EngineTest class
+	 * @param engine Reference to the engine
+	 * @param name Name of the system
+	 * @param loadPriority Priority of LOAD_LEVEL, negative to load before the default level
+	 * @param framePriority Priority of FRAME_END
+	 */
+	EngineTest( vve::Engine& engine, std::string name, int loadPriority = 0, int framePriority = 0 ) : vve::System(name, engine ) {
+		m_engine.RegisterCallbacks( {
+			{this, loadPriority, "LOAD_LEVEL", [this](Message& message){ Load(); return false;} },
+			{this, framePriority, "FRAME_END", [this](Message& message){ if( !Frame(m_frames++) ) m_engine.Stop(); return false;} }
+		} );
+	};
+
+	virtual ~EngineTest() {};
+
+	/**
+	 * @brief Load the scene of the test, called in LOAD_LEVEL
+	 */
+	virtual void Load() {};
+
+	/**
+	 * @brief Check the frame that just ended
+	 * @param frame Number of the frame, starting with 0
+	 * @return True to run another frame, false to stop the engine
+	 */
+	virtual bool Frame(size_t frame) { return false; };
+
+	/**
+	 * @brief Get the asset manager, it exists from INIT on
+	 * @return The asset manager
+	 */
+	auto Assets() -> vve::AssetManager* {
+		return dynamic_cast<vve::AssetManager*>(m_engine.GetSystem(m_engine.m_assetManagerName));
+	}
+
+protected:
+	size_t m_frames{0};
+};
+
+
+/**
+ * @brief Run a test system in a new engine until it stops the engine
+ * @tparam Test The test system, derived from EngineTest, with a member m_result
+ * @param name Name of the engine
+ * @param type The renderer
+ * @param args Arguments of the test system after the engine
+ * @return The result of the test system
+ */
+template<typename Test, typename... Args>
+auto RunTest(const std::string& name, vve::RendererType type, Args&&... args) {
+	vve::Engine engine(name, type);
+	Test test{engine, std::forward<Args>(args)...};
+	engine.Run();
+	return std::move(test.m_result);
+}
+
+
+/**
+ * @brief Print the outcome of a check
+ * @param name Name of the check
+ * @param ok True if the check passed
+ * @return Exit code of the check
+ */
+inline auto Report(const std::string& name, bool ok) -> int {
+	std::cout << std::format("{}: {}\n", name, ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+
+/**
+ * @brief Swapchain image read back after rendering
+ */
+struct SwapchainImage {
+	std::vector<uint8_t> m_pixels;	//RGBA, in the channel order of the swapchain
+	uint32_t m_width{0};
+	uint32_t m_height{0};
+};
+
+inline const size_t c_renderFrames = 5;	//frames rendered before the swapchain image is read back
+
+
+/**
+ * @brief Read back the swapchain image of the frame that just ended, waits until the device is idle
+ * @param registry The registry with the renderer state
+ * @return The image
+ */
+inline auto ReadSwapchain(vecs::Registry& registry) -> SwapchainImage {
+	auto state = std::get<1>(vve::Renderer::GetState(registry));
+	vkDeviceWaitIdle(state().m_device);
+
+	auto extent = state().m_swapChain.m_swapChainExtent;
+	uint32_t size = extent.width * extent.height * 4;
+	SwapchainImage image{ std::vector<uint8_t>(size), extent.width, extent.height };
+	vvh::ImgCopyImageToHost( {
+		.m_device 		= state().m_device,
+		.m_vmaAllocator = state().m_vmaAllocator,
+		.m_graphicsQueue = state().m_graphicsQueue,
+		.m_commandPool 	= state().m_commandPool,
+		.m_image 		= state().m_swapChain.m_swapChainImages[state().m_imageIndex],
+		.m_format 		= VK_FORMAT_R8G8B8A8_UNORM,
+		.m_aspects 		= VK_IMAGE_ASPECT_COLOR_BIT,
+		.m_layout 		= VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+		.m_bufferData 	= image.m_pixels.data(),
+		.m_width 		= extent.width,
+		.m_height 		= extent.height,
+		.m_size 		= size,
+		.m_r = 0, .m_g = 1, .m_b = 2, .m_a = 3
+	});
+	return image;
+}
+
+
+/**
+ * @brief Difference of two images over the color channels, alpha is ignored
+ */
+struct ImageDifference {
+	size_t m_channels{0};			//compared channels, 0 if the images cannot be compared
+	size_t m_differing{0};			//channels with different values
+	double m_meanError{0.0};		//mean absolute difference of a channel, out of 255
+	double m_psnr{0.0};				//dB, 99 for identical images
+};
+
+
+/**
+ * @brief Compare two images
+ * @param a First image
+ * @param b Second image
+ * @return The difference, without channels if an image is missing or the sizes differ
+ */
+inline auto CompareImages(const SwapchainImage& a, const SwapchainImage& b) -> ImageDifference {
+	ImageDifference diff{};
+	if( a.m_pixels.empty() || a.m_pixels.size() != b.m_pixels.size() ) return diff;
+
+	double squared = 0.0, absolute = 0.0;
+	for( size_t i = 0; i < a.m_pixels.size(); ++i ) {
+		if( i % 4 == 3 ) continue;	//alpha
+		double d = (double)a.m_pixels[i] - b.m_pixels[i];
+		squared += d * d;
+		absolute += std::abs(d);
+		if( d != 0.0 ) ++diff.m_differing;
+	}
+	diff.m_channels = a.m_pixels.size() / 4 * 3;
+	double mse = squared / diff.m_channels;
+	diff.m_psnr = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0;
+	diff.m_meanError = absolute / diff.m_channels;
+	return diff;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testscene.h"
+
+
+/**
+ * @brief Incremental scene instantiation. No window or GPU is created. A generated scene is created once blocking
+ * and once incrementally, and the time of each load step is checked against the budget. A step never starts a unit
+ * of work after the budget is used up, so it may exceed the budget by at most the longest unit. Both scenes must
+ * have the same nodes.
+ */
+
+
+/**
+ * @brief Engine with only the scene and asset managers, and a root node for scenes
+ * @param engine The engine
+ * @return The root node
+ */
+auto SetupHeadless(vve::Engine& engine) -> vve::ParentHandle {
+	engine.RegisterSystem(std::make_unique<vve::SceneManager>(engine.m_sceneManagerName, engine));
+	engine.RegisterSystem(std::make_unique<vve::AssetManager>(engine.m_assetManagerName, engine));
+	return vve::ParentHandle{ engine.GetRegistry().Insert(vve::Name{"Root"}, vve::ParentHandle{}, vve::Children{},
+		vve::Position{vec3_t{0.0f}}, vve::Rotation{mat3_t{1.0f}}, vve::Scale{vec3_t{1.0f}}, vve::LocalToWorldMatrix{mat4_t{1.0f}}) };
+}
+
+
+/**
+ * @brief Usage: testincrementalloading [objects] [budget ms]
+ */
+int main(int argc, char* argv[]) {
+	size_t objects = argc > 1 ? std::stoull(argv[1]) : 2000;
+	double budgetMs = argc > 2 ? std::stod(argv[2]) : 2.0;
+
+	auto file = std::filesystem::temp_directory_path() / "vve-incremental-loading-test.obj";
+	WriteScene(file, objects, 32);
+
+	using clock = std::chrono::high_resolution_clock;
+	auto ms = [](auto start) { return std::chrono::duration<double, std::milli>(clock::now() - start).count(); };
+
+	size_t blockingNodes = 0;
+	double blockingMs = 0.0;
+	{
+		vve::Engine engine("Blocking");
+		auto root = SetupHeadless(engine);
+		auto start = clock::now();
+		auto scene = engine.CreateScene(vve::Name{"Spheres"}, root, vve::Filename{file.string()}, aiProcess_Triangulate);
+		blockingMs = ms(start);
+		blockingNodes = CountNodes(engine.GetRegistry(), scene);
+	}
+
+	vve::Engine engine("Incremental");
+	auto root = SetupHeadless(engine);
+	engine.SetLoadBudget(budgetMs);
+	auto start = clock::now();
+	auto scene = engine.CreateSceneIncremental(vve::Name{"Spheres"}, root, vve::Filename{file.string()}, aiProcess_Triangulate);
+	double importMs = ms(start);
+
+	size_t steps = 0;
+	double maxStepMs = 0.0, maxUnitMs = 0.0;
+	for( bool loading = true; loading; ++steps ) {
+		auto& progress = engine.LoadStep();
+		maxStepMs = std::max(maxStepMs, progress.m_lastStepMs);
+		maxUnitMs = std::max(maxUnitMs, progress.m_maxUnitMs);
+		loading = progress.IsLoading();
+	}
+	size_t nodes = CountNodes(engine.GetRegistry(), scene);
+
+	double ceilingMs = budgetMs + maxUnitMs;
+	std::cout << std::format("Blocking: {:.2f} ms in one frame, {} nodes\n", blockingMs, blockingNodes);
+	std::cout << std::format("Incremental: import {:.2f} ms, {} steps, max step {:.3f} ms, budget {:.3f} ms, max unit {:.3f} ms, {} nodes\n",
+		importMs, steps, maxStepMs, budgetMs, maxUnitMs, nodes);
+
+	bool ok = maxStepMs <= ceilingMs && nodes == blockingNodes && nodes > 0;
+	std::cout << std::format("Incremental loading: {}\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Index buffer width per mesh. Small bundled models and a procedural grid with more vertices than 16 bit
+ * indices can address are rendered with the forward renderer twice, with 32 bit indices only and with the index
+ * width chosen per mesh, and the swapchain images are compared. The images must be identical, the small meshes
+ * must use 16 bit indices and the grid 32 bit indices. Needs a Vulkan device, e.g. lavapipe.
+ */
+
+
+/**
+ * @brief Result of rendering the scene once
+ */
+struct RenderResult {
+	SwapchainImage m_image;
+	size_t m_indexBytes{0};			//size of all index buffers
+	size_t m_small{0};				//meshes with 16 bit indices
+	size_t m_large{0};				//meshes with 32 bit indices
+	bool m_widthsOk{true};			//every mesh uses the narrowest index type
+};
+
+
+/**
+ * @brief Loads the models and the grid, renders a few frames and reads back the swapchain image
+ */
+class IndexWidthTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the IndexWidthTest class
+	 * @param engine Reference to the engine
+	 * @param files The model files
+	 * @param small Choose the index width per mesh, otherwise all index buffers are 32 bit
+	 */
+	IndexWidthTest( vve::Engine& engine, std::vector<std::filesystem::path> files, bool small )
+		: EngineTest(engine, "Index Width Test", -1000), m_files{files}, m_small{small} {};	//load before the default level
+
+	inline static const std::string c_gridName { "index-width/grid" };
+	inline static const size_t c_side = 300;	//vertices per side of the grid, 90000 vertices need 32 bit indices
+
+	/**
+	 * @brief Create a wavy grid mesh that is too large for 16 bit indices
+	 */
+	void CreateGrid() {
+		vvh::Mesh mesh{};
+		for( size_t y = 0; y < c_side; ++y ) {
+			for( size_t x = 0; x < c_side; ++x ) {
+				float s = (float)x / (c_side - 1), t = (float)y / (c_side - 1);
+				mesh.m_verticesData.m_positions.push_back( glm::vec3{ 4.0f * s - 2.0f, 4.0f * t - 2.0f, 0.1f * std::sin(20.0f * s) * std::cos(20.0f * t) } );
+				mesh.m_verticesData.m_normals.push_back( glm::vec3{ 0.0f, 0.0f, 1.0f } );
+				mesh.m_verticesData.m_texCoords.push_back( glm::vec2{ s, t } );
+			}
+		}
+		for( size_t y = 0; y + 1 < c_side; ++y ) {
+			for( size_t x = 0; x + 1 < c_side; ++x ) {
+				uint32_t a = (uint32_t)(y * c_side + x), b = a + (uint32_t)c_side;
+				for( uint32_t i : { a, b, b + 1, a, b + 1, a + 1 } ) { mesh.m_indices.push_back(i); }
+			}
+		}
+		if( m_small ) mesh.chooseIndexType();	//like the asset manager does for imported meshes
+		auto handle = m_registry.Insert(vve::Name{c_gridName}, std::move(mesh));
+		m_engine.SetHandle(c_gridName, handle);
+		m_engine.SendMsg( MsgMeshCreate{vve::MeshHandle{handle}} );
+	}
+
+	void Load() override {
+		Assets()->SetSmallIndices(m_small);
+		for( size_t i = 0; i < m_files.size(); ++i ) {
+			m_engine.CreateScene(vve::Name{std::format("Model{}", i)}, vve::ParentHandle{}, vve::Filename{m_files[i].string()},
+				aiProcess_Triangulate, vve::Position{ vec3_t{ 2.5f * i, 0.0f, 0.0f } });
+		}
+		CreateGrid();
+		m_engine.CreateObject(vve::Name{"Grid"}, vve::ParentHandle{}, vve::MeshName{c_gridName},
+			vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {0.5f, 0.8f, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+			vve::Position{ vec3_t{ 0.0f, 0.0f, -1.0f } });
+	}
+
+	bool Frame(size_t frame) override {
+		if( frame + 1 < c_renderFrames ) return true;
+		m_result.m_image = ReadSwapchain(m_registry);
+
+		for( auto [handle, mesh] : m_registry.GetView<vecs::Handle, vvh::Mesh&>() ) {
+			m_result.m_indexBytes += (size_t)mesh().getIndexSize();
+			bool small = mesh().m_indexType == VK_INDEX_TYPE_UINT16;
+			if( small ) ++m_result.m_small; else ++m_result.m_large;
+			if( m_small ) m_result.m_widthsOk = m_result.m_widthsOk && small == (mesh().m_verticesData.m_positions.size() <= 65536);
+		}
+		return false;
+	}
+
+	RenderResult m_result{};
+
+private:
+	std::vector<std::filesystem::path> m_files;
+	bool m_small;
+};
+
+
+/**
+ * @brief Render the scene once in a new engine
+ * @param files The model files
+ * @param small Choose the index width per mesh, otherwise all index buffers are 32 bit
+ * @return The image and index memory
+ */
+auto Run(std::vector<std::filesystem::path> files, bool small) -> RenderResult {
+	return RunTest<IndexWidthTest>("Index Width", vve::RendererType::RENDERER_TYPE_FORWARD, files, small);
+}
+
+
+/**
+ * @brief Usage: testindexwidth [model files...], e.g. testindexwidth assets/test/Fireplace/Fireplace.gltf
+ * Without model files a few small bundled models are used.
+ */
+int main(int argc, char* argv[]) {
+	std::vector<std::filesystem::path> files{ argv + 1, argv + argc };
+	if( files.empty() ) files = {
+		"assets/viking_room/viking_room.obj",
+		"assets/standard/sphere.obj",
+		"assets/cloths/cloth0/cloth.obj",
+	};
+
+	auto wide = Run(files, false);
+	auto narrow = Run(files, true);
+	auto diff = CompareImages(wide.m_image, narrow.m_image);
+	if( diff.m_channels == 0 ) {
+		std::cout << "Index width: FAILED (no image)\n";
+		return 1;
+	}
+
+	bool ok = diff.m_differing == 0 && narrow.m_widthsOk && narrow.m_small > 0 && narrow.m_large > 0 && wide.m_small == 0;
+	std::cout << std::format("Image {}x{}: {} channels differ\n", wide.m_image.m_width, wide.m_image.m_height, diff.m_differing);
+	std::cout << std::format("Meshes: {} with 16 bit and {} with 32 bit indices\n", narrow.m_small, narrow.m_large);
+	std::cout << std::format("Index buffers: {} bytes 32 bit only, {} bytes per mesh width, {:.1f}%\n", wide.m_indexBytes,
+		narrow.m_indexBytes, wide.m_indexBytes > 0 ? 100.0 * narrow.m_indexBytes / wide.m_indexBytes : 100.0);
+	return Report("Index width", ok);
+}
+
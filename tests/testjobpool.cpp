@@ -0,0 +1,121 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Correctness of the job pool. Runs on the CPU only, no window or GPU is created. ParallelFor must call the
+ * function for every index exactly once, for counts around the chunk size and with pools of 1 to N threads, and an
+ * exception thrown by a chunk must reach the caller. ParallelForEach must visit every entity of a registry view once,
+ * and the world matrices it computes must be the same as those of a loop on the calling thread.
+ */
+
+using NormalMatrix = vsty::strong_type_t<mat4_t, vsty::counter<>>;
+
+size_t g_failures = 0;
+
+void Check(bool ok, const std::string& what) {
+	if( ok ) return;
+	std::cout << "FAILED: " << what << "\n";
+	++g_failures;
+}
+
+
+/**
+ * @brief Every index must be visited exactly once, chunks must not overlap or exceed the count
+ */
+void TestParallelFor(vve::JobPool& pool) {
+	for( size_t count : {0, 1, 63, 64, 65, 1000, 100003} ) {
+		for( size_t chunkSize : {0, 1, 64, 4096} ) {
+			std::vector<std::atomic<uint32_t>> visits(count);
+			std::atomic<bool> outOfRange{false};
+			pool.ParallelFor(count, chunkSize, [&](size_t begin, size_t end) {
+				if( begin >= end || end > count ) outOfRange = true;
+				for( size_t i = begin; i < std::min(end, count); ++i ) ++visits[i];
+			});
+			bool once = std::all_of(visits.begin(), visits.end(), [](auto& v) { return v.load() == 1; });
+			Check(once && !outOfRange, std::format("{} threads, ParallelFor over {} indices in chunks of {}", pool.GetNumThreads(), count, chunkSize));
+		}
+	}
+}
+
+
+/**
+ * @brief An exception of a chunk must be rethrown to the caller after all chunks are done
+ */
+void TestException(vve::JobPool& pool) {
+	std::atomic<size_t> done{0}, failed{0};
+	bool thrown = false;
+	try {
+		pool.ParallelFor(1000, 10, [&](size_t begin, size_t end) {
+			if( begin <= 500 && 500 < end ) { failed = end - begin; throw std::runtime_error("chunk failed"); }
+			done += end - begin;
+		});
+	} catch( const std::runtime_error& ) { thrown = true; }
+	Check(thrown && done + failed == 1000, std::format("{} threads, exception of a chunk reaches the caller", pool.GetNumThreads()));
+}
+
+
+auto Near(const mat4_t& a, const mat4_t& b) -> bool {
+	for( int i = 0; i < 4; ++i ) {
+		for( int j = 0; j < 4; ++j ) { if( std::abs(a[i][j] - b[i][j]) > 1e-4f * std::max<real_t>(1, std::abs(b[i][j])) ) return false; }
+	}
+	return true;
+}
+
+
+/**
+ * @brief World matrices computed by ParallelForEach must match a loop on the calling thread
+ */
+void TestParallelForEach(vve::JobPool& pool, size_t numEntities) {
+	vecs::Registry registry;
+	std::default_random_engine rnd{ 12345 };
+	std::uniform_real_distribution<float> unif{ -100.0f, 100.0f };
+	for( size_t i = 0; i < numEntities; ++i ) {
+		vve::Position position{ vec3_t{unif(rnd), unif(rnd), unif(rnd)} };
+		vve::Rotation rotation{ mat3_t{glm::rotate(mat4_t{1.0f}, unif(rnd), vec3_t{0.0f, 0.0f, 1.0f})} };
+		registry.Insert(position, rotation, vve::Scale{vec3_t{1.0f + unif(rnd) * 0.01f}}, vve::LocalToWorldMatrix{mat4_t{0.0f}}, NormalMatrix{mat4_t{0.0f}});
+	}
+
+	std::atomic<size_t> visited{0};
+	pool.ParallelForEach(registry.template GetView<vve::Position&, vve::Rotation&, vve::Scale&, vve::LocalToWorldMatrix&, NormalMatrix&>(),
+		[&](auto& p, auto& r, auto& s, auto& LtoW, auto& normal) {
+			LtoW() = glm::translate(mat4_t{1.0f}, p()) * mat4_t(r()) * glm::scale(mat4_t{1.0f}, s());
+			normal() = glm::inverse(glm::transpose(LtoW()));
+			++visited;
+		});
+
+	size_t wrong = 0;
+	for( auto [p, r, s, LtoW, normal] : registry.template GetView<vve::Position&, vve::Rotation&, vve::Scale&, vve::LocalToWorldMatrix&, NormalMatrix&>() ) {
+		mat4_t expected = glm::translate(mat4_t{1.0f}, p()) * mat4_t(r()) * glm::scale(mat4_t{1.0f}, s());
+		if( !Near(LtoW(), expected) || !Near(normal(), glm::inverse(glm::transpose(expected))) ) ++wrong;
+	}
+	Check(visited == numEntities && wrong == 0, std::format("{} threads, ParallelForEach visited {} of {} entities, {} wrong matrices",
+		pool.GetNumThreads(), visited.load(), numEntities, wrong));
+}
+
+
+/**
+ * @brief Usage: testjobpool [number of entities]
+ */
+int main(int argc, char* argv[]) {
+	size_t numEntities = argc > 1 ? std::stoull(argv[1]) : 20000;
+
+	std::vector<uint32_t> threadCounts{ 1, 2 };
+	for( uint32_t threads = 4; threads < std::thread::hardware_concurrency(); threads *= 2 ) threadCounts.push_back(threads);
+	threadCounts.push_back( std::max(3u, std::thread::hardware_concurrency()) );
+
+	for( auto threads : threadCounts ) {
+		vve::JobPool pool{ threads };
+		TestParallelFor(pool);
+		TestException(pool);
+		TestParallelForEach(pool, numEntities);
+	}
+
+	std::cout << std::format("Job pool: {}\n", g_failures == 0 ? "passed" : "FAILED");
+	return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Memory accounting. After the default level is loaded a known scene is added: one generated mesh with a
+ * known number of vertices and indices, and a number of objects using it. Memory reports taken before and after
+ * must differ by exactly the memory of the scene. The report is written to a file and read back. Runs with the
+ * null renderer, so no GPU is needed.
+ */
+class MemoryReportTest : public vve::System {
+
+public:
+	MemoryReportTest( vve::Engine& engine, std::filesystem::path file ) : vve::System("Memory Report Test", engine ), m_file{file} {
+		m_engine.RegisterCallbacks( {
+			{this, 0, "FRAME_END", [this](Message& message){ return OnFrameEnd(message);} }
+		} );
+	};
+
+	~MemoryReportTest() {};
+
+	inline static const std::string c_meshName { "memory-report/grid" };
+	inline static const size_t c_side = 10;		//vertices per side of the grid
+	inline static const size_t c_objects = 50;
+
+	/**
+	 * @brief Create a grid mesh with positions and normals only, all vectors have exactly the needed capacity
+	 * @return Handle of the mesh
+	 */
+	auto CreateMesh() -> vecs::Handle {
+		vvh::Mesh mesh{};
+		mesh.m_verticesData.m_positions.reserve(c_side * c_side);
+		mesh.m_verticesData.m_normals.reserve(c_side * c_side);
+		for( size_t y = 0; y < c_side; ++y ) {
+			for( size_t x = 0; x < c_side; ++x ) {
+				mesh.m_verticesData.m_positions.push_back( glm::vec3{ (float)x, (float)y, 0.0f } );
+				mesh.m_verticesData.m_normals.push_back( glm::vec3{ 0.0f, 0.0f, 1.0f } );
+			}
+		}
+		mesh.m_indices.reserve(IndexCount());
+		for( size_t y = 0; y + 1 < c_side; ++y ) {
+			for( size_t x = 0; x + 1 < c_side; ++x ) {
+				uint32_t a = (uint32_t)(y * c_side + x), b = a + (uint32_t)c_side;
+				for( uint32_t i : { a, b, b + 1, a, b + 1, a + 1 } ) { mesh.m_indices.push_back(i); }
+			}
+		}
+		auto handle = m_registry.Insert(vve::Name{c_meshName}, std::move(mesh));
+		m_engine.SetHandle(c_meshName, handle);
+		m_engine.SendMsg( MsgMeshCreate{vve::MeshHandle{handle}} );
+		return handle;
+	}
+
+	static constexpr auto IndexCount() -> size_t { return (c_side - 1) * (c_side - 1) * 6; }
+	static constexpr auto VertexBytes() -> size_t { return c_side * c_side * 2 * sizeof(glm::vec3); }
+
+	/**
+	 * @brief Compare an entry of two reports
+	 * @return true if count and bytes changed by the expected amounts
+	 */
+	auto Check(const std::vector<vve::MemoryReport::Entry>& before, const std::vector<vve::MemoryReport::Entry>& after,
+			const std::string& name, size_t count, std::optional<size_t> bytes) -> bool {
+		auto b = vve::MemoryReport::Find(before, name);
+		auto a = vve::MemoryReport::Find(after, name);
+		size_t countDelta = (a ? a->m_count : 0) - (b ? b->m_count : 0);
+		size_t bytesDelta = (a ? a->m_bytes : 0) - (b ? b->m_bytes : 0);
+		bool ok = countDelta == count && (!bytes.has_value() || bytesDelta == bytes.value());
+		std::cout << std::format("{:<32} count +{} bytes +{}: {}\n", name, countDelta, bytesDelta, ok ? "ok" : "FAILED");
+		return ok;
+	}
+
+	/**
+	 * @brief Read the bytes of an entry back from a dumped report
+	 * @return The bytes, or nullopt if the entry is missing
+	 */
+	auto ReadBytes(const std::string& category, const std::string& name) -> std::optional<size_t> {
+		std::ifstream in{m_file};
+		std::string line, prefix = category + ",\"" + name + "\",";
+		while( std::getline(in, line) ) {
+			if( !line.starts_with(prefix) ) continue;
+			return std::stoull(line.substr(line.rfind(',') + 1));
+		}
+		return std::nullopt;
+	}
+
+	bool OnFrameEnd(Message message) {
+		auto before = m_stats.Collect();
+
+		CreateMesh();
+		std::vector<vve::Engine::ObjectInfo> infos;
+		for( size_t i = 0; i < c_objects; ++i ) {
+			infos.push_back( {
+				.m_meshName = vve::MeshName{c_meshName},
+				.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 0.5f, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+				.m_position = vve::Position{ vec3_t{ (real_t)i * 10.0f, 0.0f, 0.0f } }
+			} );
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, infos);
+
+		auto after = m_stats.Collect();
+		bool ok = true;
+		ok = Check(before.m_components, after.m_components, "vvh::Mesh", 1, sizeof(vvh::Mesh) + VertexBytes() + IndexCount() * sizeof(uint32_t)) && ok;
+		ok = Check(before.m_components, after.m_components, "Position", c_objects, c_objects * sizeof(vve::Position)) && ok;
+		ok = Check(before.m_components, after.m_components, "vvh::Color", c_objects, c_objects * sizeof(vvh::Color)) && ok;
+		ok = Check(before.m_components, after.m_components, "MeshHandle", c_objects, c_objects * sizeof(vve::MeshHandle)) && ok;
+		ok = Check(before.m_assets, after.m_assets, "Mesh vertices", 1, VertexBytes()) && ok;
+		ok = Check(before.m_assets, after.m_assets, "Mesh indices", 1, IndexCount() * sizeof(uint32_t)) && ok;
+		ok = Check(before.m_systems, after.m_systems, "Engine handle map", 1, std::nullopt) && ok;
+		ok = Check(before.m_systems, after.m_systems, "Null renderer bookkeeping", 1 + c_objects, std::nullopt) && ok;
+
+		ok = after.Write(m_file) && ok;
+		auto vertices = vve::MemoryReport::Find(after.m_assets, "Mesh vertices");
+		bool readBack = vertices != nullptr && ReadBytes("asset", "Mesh vertices") == vertices->m_bytes;
+		std::cout << std::format("Read back {}: {}\n", m_file.string(), readBack ? "ok" : "FAILED");
+
+		std::cout << std::format("Components {} bytes, assets {} bytes, systems {} bytes\n", vve::MemoryReport::Total(after.m_components),
+			vve::MemoryReport::Total(after.m_assets), vve::MemoryReport::Total(after.m_systems));
+		m_passed = ok && readBack;
+		m_engine.Stop();
+		return false;
+	}
+
+	bool m_passed{false};
+
+private:
+	vve::MemoryStats m_stats{ "Memory Stats", m_engine, false };
+	std::filesystem::path m_file;
+};
+
+
+
+/**
+ * @brief Usage: testmemoryreport [file]
+ */
+int main(int argc, char* argv[]) {
+	auto file = argc > 1 ? std::filesystem::path{argv[1]} : std::filesystem::temp_directory_path() / "vve-memory-report.csv";
+
+	vve::Engine engine("Memory Report", vve::RendererType::RENDERER_TYPE_NULL);
+	MemoryReportTest test{engine, file};
+	engine.Run();
+
+	std::cout << std::format("Memory report: {}\n", test.m_passed ? "passed" : "FAILED");
+	return test.m_passed ? 0 : 1;
+}
+
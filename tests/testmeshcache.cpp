@@ -0,0 +1,146 @@
+#include <iostream>
+#include <fstream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testscene.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Cooked mesh cache. A scene is loaded with the null renderer several times: with an empty cache (cold),
+ * again with the cache written by the first load (warm), with other import flags, and after the source file
+ * changed. The warm load must be read from the cache and create the same nodes and meshes as the cold load,
+ * the other two must be imported with Assimp again. Finally the scene is loaded cold and warm with levels of
+ * detail, the warm load must read the same levels from the cache.
+ */
+
+
+/**
+ * @brief Result of loading the scene once
+ */
+struct LoadResult {
+	size_t m_nodes{0};
+	size_t m_levels{0};		//levels of detail of the meshes
+	size_t m_hash{0};		//hash of the node names and mesh data
+	vve::AssetManager::ImportTime m_time{};
+};
+
+
+/**
+ * @brief Loads the scene blocking in the first frame and summarizes its nodes and meshes
+ */
+class CacheTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the CacheTest class
+	 * @param engine Reference to the engine
+	 * @param file The scene file
+	 * @param cache Directory of the mesh cache
+	 * @param flags Assimp post processing flags
+	 * @param lod Generate levels of detail
+	 */
+	CacheTest( vve::Engine& engine, std::filesystem::path file, std::filesystem::path cache, aiPostProcessSteps flags, bool lod )
+		: EngineTest(engine, "Mesh Cache Test"), m_file{file}, m_cache{cache}, m_flags{flags} {
+		if( lod ) m_levels.emplace("Level of Detail", engine);
+	};
+
+	void Load() override {
+		Assets()->SetCacheDirectory(m_cache);
+		auto scene = m_engine.CreateScene(vve::Name{"Scene"}, vve::ParentHandle{}, vve::Filename{m_file.string()}, m_flags);
+		Add(scene);
+		auto& times = Assets()->GetImportTimes();
+		auto time = std::find_if(times.begin(), times.end(), [&](auto& time) { return time.m_scene == m_file.string(); });
+		if( time != times.end() ) m_result.m_time = *time;
+	};
+
+	/**
+	 * @brief Add the nodes below a node to the summary
+	 * @param handle The node
+	 */
+	void Add(vecs::Handle handle) {
+		if( !m_registry.Has<vve::Children>(handle) ) return;
+		auto combine = [&](size_t value) { m_result.m_hash = m_result.m_hash * 31 + value; };
+		for( auto child : m_registry.Get<vve::Children&>(handle)() ) {
+			++m_result.m_nodes;
+			combine(std::hash<std::string>{}(m_registry.Get<vve::Name>(child)()));
+			if( m_registry.Has<vve::MeshHandle>(child) ) {
+				auto mHandle = m_registry.Get<vve::MeshHandle>(child)();
+				std::vector<vve::MeshHandle> meshes{ vve::MeshHandle{mHandle} };
+				if( m_registry.Has<vve::MeshLods>(mHandle) ) meshes = m_registry.Get<vve::MeshLods&>(mHandle)().m_levels;
+				m_result.m_levels += meshes.size() - 1;
+				for( auto level : meshes ) {
+					auto mesh = m_registry.Get<vvh::Mesh&>(level());
+					for( auto& p : mesh().m_verticesData.m_positions ) { combine(std::hash<float>{}(p.x + 3.0f * p.y + 7.0f * p.z)); }
+					for( auto& n : mesh().m_verticesData.m_normals ) { combine(std::hash<float>{}(n.x + 3.0f * n.y + 7.0f * n.z)); }
+					for( auto i : mesh().m_indices ) { combine(i); }
+				}
+			}
+			Add(child);
+		}
+	}
+
+	LoadResult m_result{};
+
+private:
+	std::filesystem::path m_file;
+	std::filesystem::path m_cache;
+	aiPostProcessSteps m_flags;
+	std::optional<vve::LevelOfDetail> m_levels;
+};
+
+
+/**
+ * @brief Load the scene once in a new engine
+ * @param file The scene file
+ * @param cache Directory of the mesh cache
+ * @param flags Assimp post processing flags
+ * @param lod Generate levels of detail
+ * @return Summary of the loaded scene
+ */
+auto Run(std::filesystem::path file, std::filesystem::path cache, aiPostProcessSteps flags, bool lod = false) -> LoadResult {
+	return RunTest<CacheTest>("Mesh Cache", vve::RendererType::RENDERER_TYPE_NULL, file, cache, flags, lod);
+}
+
+
+/**
+ * @brief Usage: testmeshcache [scene file], e.g. testmeshcache assets/Sponza/glTF/Sponza.gltf
+ * Without a scene file a generated scene is loaded, and the test also changes the file.
+ */
+int main(int argc, char* argv[]) {
+	bool generated = argc < 2;
+	auto file = generated ? std::filesystem::temp_directory_path() / "vve-mesh-cache.obj" : std::filesystem::path{argv[1]};
+	if( generated ) WriteScene(file, 1000, 32);
+
+	auto cache = std::filesystem::temp_directory_path() / "vve-mesh-cache-test";
+	std::filesystem::remove_all(cache);
+
+	auto cold = Run(file, cache, aiProcess_Triangulate);
+	auto warm = Run(file, cache, aiProcess_Triangulate);
+	auto flags = Run(file, cache, aiPostProcessSteps(aiProcess_Triangulate | aiProcess_GenBoundingBoxes));
+	std::cout << std::format("Cold: {:.2f} ms, cached {}\n", cold.m_time.m_ms, cold.m_time.m_cached);
+	std::cout << std::format("Warm: {:.2f} ms, cached {}, {:.1f}x faster\n", warm.m_time.m_ms, warm.m_time.m_cached, cold.m_time.m_ms / std::max(warm.m_time.m_ms, 0.001));
+	std::cout << std::format("Other flags: {:.2f} ms, cached {}\n", flags.m_time.m_ms, flags.m_time.m_cached);
+
+	bool ok = !cold.m_time.m_cached && warm.m_time.m_cached && !flags.m_time.m_cached
+		&& cold.m_nodes > 0 && warm.m_nodes == cold.m_nodes && warm.m_hash == cold.m_hash;
+	if( generated ) {
+		std::ofstream{file, std::ios::app} << "# changed\n";
+		auto changed = Run(file, cache, aiProcess_Triangulate);
+		std::cout << std::format("Changed source: {:.2f} ms, cached {}\n", changed.m_time.m_ms, changed.m_time.m_cached);
+		ok = ok && !changed.m_time.m_cached && changed.m_hash == cold.m_hash;
+	}
+
+	auto lodCold = Run(file, cache, aiProcess_Triangulate, true);
+	auto lodWarm = Run(file, cache, aiProcess_Triangulate, true);
+	std::cout << std::format("Levels of detail: {} levels, cold {:.2f} ms, cached {}, warm {:.2f} ms, cached {}\n", lodCold.m_levels,
+		lodCold.m_time.m_ms, lodCold.m_time.m_cached, lodWarm.m_time.m_ms, lodWarm.m_time.m_cached);
+	ok = ok && !lodCold.m_time.m_cached && lodWarm.m_time.m_cached && lodCold.m_levels > 0 && lodWarm.m_levels == lodCold.m_levels
+		&& lodWarm.m_hash == lodCold.m_hash;
+	std::cout << std::format("Nodes {}, {}\n", cold.m_nodes, warm.m_hash == cold.m_hash ? "same data" : "different data");
+	return Report("Mesh cache", ok);
+}
+
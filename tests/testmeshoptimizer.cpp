@@ -0,0 +1,124 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Mesh optimization at import. Each bundled model is imported with the null renderer twice, without and with
+ * the mesh optimizer, and the vertex cache statistics of the import are printed. The optimized meshes must contain
+ * the same triangles as the source meshes, and must not use the vertex cache worse.
+ */
+
+
+/**
+ * @brief Result of loading a scene once
+ */
+struct LoadResult {
+	std::vector<std::vector<std::array<float, 9>>> m_triangles;	//sorted triangles of each mesh, by position
+	vve::AssetManager::ImportTime m_time{};
+};
+
+
+/**
+ * @brief Loads a scene blocking in the first frame and collects the triangles of its meshes
+ */
+class OptimizerTest : public EngineTest {
+
+public:
+	OptimizerTest( vve::Engine& engine, std::filesystem::path file, bool optimize )
+		: EngineTest(engine, "Mesh Optimizer Test"), m_file{file}, m_optimize{optimize} {};
+
+	void Load() override {
+		Assets()->SetCacheDirectory({});
+		Assets()->SetMeshOptimization(m_optimize);
+		auto scene = m_engine.CreateScene(vve::Name{"Scene"}, vve::ParentHandle{}, vve::Filename{m_file.string()}, aiProcess_Triangulate);
+		Add(scene);
+		if( !Assets()->GetImportTimes().empty() ) m_result.m_time = Assets()->GetImportTimes().back();
+	};
+
+	/**
+	 * @brief Add the meshes of the nodes below a node
+	 * @param handle The node
+	 */
+	void Add(vecs::Handle handle) {
+		if( !m_registry.Has<vve::Children>(handle) ) return;
+		for( auto child : m_registry.Get<vve::Children&>(handle)() ) {
+			if( m_registry.Has<vve::MeshHandle>(child) ) {
+				auto meshHandle = m_registry.Get<vve::MeshHandle>(child)();
+				if( std::ranges::find(m_meshes, meshHandle) == m_meshes.end() ) {
+					m_meshes.push_back(meshHandle);
+					auto& mesh = m_registry.Get<vvh::Mesh&>(meshHandle)();
+					auto& positions = mesh.m_verticesData.m_positions;
+					std::vector<std::array<float, 9>> triangles;
+					for( size_t i = 0; i + 2 < mesh.m_indices.size(); i += 3 ) {
+						std::array<float, 9> triangle;
+						for( int k = 0; k < 3; ++k ) {
+							auto& p = positions[mesh.m_indices[i + k]];
+							triangle[3 * k] = p.x; triangle[3 * k + 1] = p.y; triangle[3 * k + 2] = p.z;
+						}
+						triangles.push_back(triangle);
+					}
+					std::ranges::sort(triangles);
+					m_result.m_triangles.push_back(std::move(triangles));
+				}
+			}
+			Add(child);
+		}
+	}
+
+	LoadResult m_result{};
+
+private:
+	std::filesystem::path m_file;
+	bool m_optimize;
+	std::vector<vecs::Handle> m_meshes;
+};
+
+
+/**
+ * @brief Load a scene once in a new engine
+ * @param file The scene file
+ * @param optimize Optimize the meshes
+ * @return The triangles and statistics of the scene
+ */
+auto Run(std::filesystem::path file, bool optimize) -> LoadResult {
+	return RunTest<OptimizerTest>("Mesh Optimizer", vve::RendererType::RENDERER_TYPE_NULL, file, optimize);
+}
+
+
+/**
+ * @brief Usage: testmeshoptimizer [scene files...], e.g. testmeshoptimizer assets/Sponza/glTF/Sponza.gltf
+ * Without scene files the bundled models are used.
+ */
+int main(int argc, char* argv[]) {
+	std::vector<std::filesystem::path> files{ argv + 1, argv + argc };
+	if( files.empty() ) files = {
+		"assets/viking_room/viking_room.obj",
+		"assets/other/zombies 3d.obj",
+		"assets/other/cottage_obj.obj",
+		"assets/test/Fireplace/Fireplace.gltf",
+		"assets/test/cornell/CornellBox-Original.obj",
+		"assets/cloths/cloth0/cloth.obj",
+		"assets/standard/sphere.obj",
+	};
+
+	bool ok = true;
+	std::cout << std::format("{:<45} {:>14} {:>14} {:>8} {:>8}\n", "Scene", "ACMR", "ATVR", "plain ms", "opt ms");
+	for( auto& file : files ) {
+		auto plain = Run(file, false);
+		auto optimized = Run(file, true);
+		bool same = !plain.m_triangles.empty() && plain.m_triangles == optimized.m_triangles;
+		auto& time = optimized.m_time;
+		float limit = vve::MeshOptimizer::c_overdrawThreshold;	//overdraw ordering may cost this much of the cache efficiency
+		bool better = time.m_acmrAfter <= time.m_acmrBefore * limit && time.m_atvrAfter <= time.m_atvrBefore * limit;
+		std::cout << std::format("{:<45} {:6.3f}->{:6.3f} {:6.3f}->{:6.3f} {:8.2f} {:8.2f} {}\n", file.string(), time.m_acmrBefore, time.m_acmrAfter,
+			time.m_atvrBefore, time.m_atvrAfter, plain.m_time.m_ms, time.m_ms, same && better ? "ok" : (same ? "FAILED (cache)" : "FAILED (triangles)"));
+		ok = ok && same && better;
+	}
+	return Report("Mesh optimizer", ok);
+}
+
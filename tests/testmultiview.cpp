@@ -0,0 +1,177 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Render views with the forward renderer. A grid of cubes is rendered twice into a split screen. The first
+ * time both halves show the main camera, they share one frustum and must be identical and have the same statistics.
+ * The second time the right half shows a camera looking away from the scene, and a disabled view covers the whole
+ * window. The left half must be the same as the first time, the right half must be empty and nothing may be drawn
+ * for the disabled view. Needs a Vulkan device, e.g. lavapipe.
+ */
+
+
+/**
+ * @brief Result of rendering the views once
+ */
+struct RenderResult {
+	SwapchainImage m_image;
+	std::vector<vve::RenderView::Stats> m_stats;	//statistics of the views in the order they were added
+};
+
+
+/**
+ * @brief Creates the cubes and the views, renders a few frames and reads back the swapchain image
+ */
+class MultiviewTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the MultiviewTest class
+	 * @param engine Reference to the engine
+	 * @param away Show a camera looking away from the scene in the right half and add a disabled view, otherwise
+	 * the right half shows the main camera
+	 */
+	MultiviewTest( vve::Engine& engine, bool away ) : EngineTest(engine, "Multiview Test"), m_away{away} {};
+
+	inline static const std::string cube_obj  { "assets/test/crate0/cube.obj" };
+	inline static const std::string cube_mesh { "assets/test/crate0/cube.obj/cube" };
+	inline static const int c_rows = 15;
+	inline static const real_t c_spacing = 3.0f;
+
+	/**
+	 * @brief Rotation of a node looking from a position to a target, z is up
+	 */
+	static auto LookAt(vec3_t eye, vec3_t target) -> vve::Rotation {
+		return vve::Rotation{ mat3_t{ glm::inverse(glm::lookAt(eye, target, vec3_t{0.0f, 0.0f, 1.0f})) } };
+	}
+
+	void Load() override {
+		m_engine.LoadScene( vve::Filename{cube_obj} );
+		std::vector<vve::Engine::ObjectInfo> objects;
+		for( int y = 0; y < c_rows; ++y ) {
+			for( int x = 0; x < c_rows; ++x ) {
+				objects.push_back( {
+					.m_meshName = vve::MeshName{cube_mesh},
+					.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {0.2f + 0.8f * x / c_rows, 0.2f + 0.8f * y / c_rows, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+					.m_position = vve::Position{ vec3_t{ (x - c_rows / 2) * c_spacing, (y - c_rows / 2) * c_spacing, 0.5f } }
+				} );
+			}
+		}
+		m_engine.CreateObjects(vve::ParentHandle{}, objects);
+
+		auto [handle, camera, parent] = *m_registry.GetView<vecs::Handle, vve::Camera&, vve::ParentHandle>().begin();
+		m_registry.Get<vve::Position&>(parent)() = vec3_t{ 0.0f, -30.0f, 10.0f };
+
+		m_viewHandles.push_back( m_views.AddView("Left", vve::ObjectHandle{}, vec4_t{0.0f, 0.0f, 0.5f, 1.0f}) );
+		if( !m_away ) {
+			m_viewHandles.push_back( m_views.AddView("Right", vve::ObjectHandle{}, vec4_t{0.5f, 0.0f, 0.5f, 1.0f}) );
+			return;
+		}
+		auto root = m_engine.GetRootSceneNode();
+		vec3_t eye{ 0.0f, -60.0f, 8.0f };	//behind the main camera, looking away from the cubes and the lights
+		auto awayNode = m_engine.CreateSceneNode(vve::Name{"Away Camera"}, vve::ParentHandle{root}, vve::Position{eye}, LookAt(eye, vec3_t{0.0f, -200.0f, 8.0f}));
+		m_viewHandles.push_back( m_views.AddView("Away", awayNode, vec4_t{0.5f, 0.0f, 0.5f, 1.0f}) );
+		m_viewHandles.push_back( m_views.AddView("Disabled", vve::ObjectHandle{}, vec4_t{0.0f, 0.0f, 1.0f, 1.0f}, vve::Camera{}, true) );
+		m_views.SetEnabled(m_viewHandles.back(), false);
+	}
+
+	bool Frame(size_t frame) override {
+		if( frame + 1 < c_renderFrames ) return true;
+		m_result.m_image = ReadSwapchain(m_registry);
+		for( auto handle : m_viewHandles ) {
+			m_result.m_stats.push_back( m_registry.Get<vve::RenderView&>(handle)().m_stats );
+		}
+		return false;
+	}
+
+	RenderResult m_result{};
+
+private:
+	bool m_away;
+	vve::RenderViews m_views{ "Render Views", m_engine };
+	std::vector<vecs::Handle> m_viewHandles;
+};
+
+
+/**
+ * @brief Copy columns of an image
+ * @param image The image
+ * @param x First column
+ * @param width Number of columns
+ * @return The columns as image
+ */
+auto Columns(const SwapchainImage& image, uint32_t x, uint32_t width) -> SwapchainImage {
+	SwapchainImage columns{ {}, width, image.m_height };
+	for( uint32_t y = 0; y < image.m_height; ++y ) {
+		auto row = image.m_pixels.begin() + 4 * ((size_t)y * image.m_width + x);
+		columns.m_pixels.insert(columns.m_pixels.end(), row, row + 4 * width);
+	}
+	return columns;
+}
+
+
+/**
+ * @brief Check if all pixels of an image have the same color, alpha is ignored
+ * @param image The image
+ * @return True if the image has one color
+ */
+auto Uniform(const SwapchainImage& image) -> bool {
+	for( size_t i = 0; i < image.m_pixels.size(); ++i ) {
+		if( i % 4 != 3 && image.m_pixels[i] != image.m_pixels[i % 4] ) return false;
+	}
+	return true;
+}
+
+
+/**
+ * @brief Print the statistics of a view
+ */
+void Print(const std::string& name, const vve::RenderView::Stats& stats) {
+	std::cout << std::format("{}: visible {}/{}, draw calls {}, triangles {}\n", name, stats.m_visible, stats.m_objects, stats.m_drawCalls, stats.m_triangles);
+}
+
+
+/**
+ * @brief Usage: testmultiview
+ */
+int main(int argc, char* argv[]) {
+	auto forward = vve::RendererType::RENDERER_TYPE_FORWARD;
+	auto same = RunTest<MultiviewTest>("Multiview", forward, false);
+	auto away = RunTest<MultiviewTest>("Multiview", forward, true);
+
+	auto& image = same.m_image;
+	if( image.m_pixels.empty() || away.m_image.m_pixels.size() != image.m_pixels.size() || image.m_width % 2 != 0 ) {
+		std::cout << std::format("Multiview: FAILED (no image or odd width {})\n", image.m_width);
+		return 1;
+	}
+	if( same.m_stats.size() != 2 || away.m_stats.size() != 3 ) {
+		std::cout << "Multiview: FAILED (views are missing)\n";
+		return 1;
+	}
+	uint32_t half = image.m_width / 2;
+	auto left = Columns(image, 0, half), right = Columns(image, half, half), awayLeft = Columns(away.m_image, 0, half);
+	auto halves = CompareImages(left, right);
+	auto lefts = CompareImages(left, awayLeft);
+
+	Print("Left", same.m_stats[0]);
+	Print("Right", same.m_stats[1]);
+	Print("Away", away.m_stats[1]);
+	Print("Disabled", away.m_stats[2]);
+	std::cout << std::format("Image {}x{}: halves {} of {} channels differ, left with and without the away view {} differ\n",
+		image.m_width, image.m_height, halves.m_differing, halves.m_channels, lefts.m_differing);
+
+	auto& main = same.m_stats[0];
+	bool drawn = main.m_objects >= MultiviewTest::c_rows * MultiviewTest::c_rows && main.m_visible > 0 && main.m_drawCalls > 0 && main.m_triangles > 0;
+	bool shared = same.m_stats[1].m_visible == main.m_visible && same.m_stats[1].m_drawCalls == main.m_drawCalls
+		&& same.m_stats[1].m_triangles == main.m_triangles && halves.m_channels > 0 && halves.m_differing == 0 && !Uniform(left);
+	bool empty = away.m_stats[1].m_objects == main.m_objects && away.m_stats[1].m_visible == 0 && away.m_stats[1].m_drawCalls == 0
+		&& Uniform(Columns(away.m_image, half, half));
+	bool disabled = away.m_stats[2].m_objects == 0 && away.m_stats[2].m_drawCalls == 0 && lefts.m_channels > 0 && lefts.m_differing == 0;
+	return Report("Multiview", drawn && shared && empty && disabled);
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <deque>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Runs the full engine loop with the null renderer, no window, Vulkan device or GPU is needed. Game logic
+ * moves objects and regularly destroys and creates some of them, with a fixed time step. The simulation is run
+ * twice, both runs must end with the same object transforms and renderer statistics.
+ */
+class Simulation : public vve::System {
+
+public:
+	Simulation( vve::Engine& engine, size_t frames ) : vve::System("Simulation", engine ), m_frames{frames} {
+		m_engine.RegisterCallbacks( {
+			{this,      0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this,      0, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+			{this, -10000, "RECORD_NEXT_FRAME", [this](Message& message){ return OnRecordNextFrame(message);} },
+			{this,      0, "FRAME_END", [this](Message& message){ return OnFrameEnd(message);} }
+		} );
+	};
+
+	~Simulation() {};
+
+	inline static const std::string sphere_obj  { "assets/standard/sphere.obj" };
+	inline static const std::string sphere_mesh { "assets/standard/sphere.obj/sphere" };
+	inline static const size_t c_objects = 300;
+	inline static const size_t c_respawn = 10;		//objects destroyed and created every second
+
+	/**
+	 * @brief Describe the object with an ordinal, the description only depends on the ordinal
+	 */
+	static auto Info(size_t ordinal) -> vve::Engine::ObjectInfo {
+		float x = (float)(ordinal % 20) * 2.0f - 20.0f, y = (float)(ordinal / 20 % 20) * 2.0f - 20.0f;
+		return {
+			.m_meshName = vve::MeshName{sphere_mesh},
+			.m_color = vvh::Color{ {0.0f, 0.0f, 0.0f, 1.0f}, {(ordinal % 7) / 7.0f, (ordinal % 5) / 5.0f, 0.5f, 1.0f}, {0.0f, 0.0f, 0.0f, 1.0f} },
+			.m_position = vve::Position{ vec3_t{ x, y, 0.5f } },
+			.m_scale = vve::Scale{ vec3_t{0.01f} }
+		};
+	}
+
+	void Spawn(size_t count) {
+		std::vector<vve::Engine::ObjectInfo> infos;
+		for( size_t i = 0; i < count; ++i ) { infos.push_back(Info(m_spawned + i)); }
+		auto handles = m_engine.CreateObjects(vve::ParentHandle{}, infos);
+		for( size_t i = 0; i < count; ++i ) { m_live.push_back({ handles[i], m_spawned++, vec3_t{infos[i].m_position()} }); }
+	}
+
+	bool OnLoadLevel( Message message ) {
+		m_engine.LoadScene( vve::Filename{sphere_obj} );
+		Spawn(c_objects);
+		return false;
+	};
+
+	bool OnUpdate( Message message ) {
+		m_time += message.GetDt();
+		for( auto& object : m_live ) {
+			double phase = m_time * (0.5 + (object.m_ordinal % 10) * 0.1);
+			auto position = m_registry.Get<vve::Position&>(object.m_handle);
+			position() = object.m_base + vec3_t{ (real_t)std::cos(phase), (real_t)std::sin(phase), 0.0f };
+		}
+		if( m_frame > 0 && m_frame % 60 == 0 ) {
+			for( size_t i = 0; i < c_respawn; ++i ) {
+				m_engine.DestroyObject(m_live.front().m_handle);
+				m_live.pop_front();
+			}
+			Spawn(c_respawn);
+		}
+		return false;
+	}
+
+	bool OnRecordNextFrame(Message message) {
+		ImGui::Begin("Simulation");		//ImGui works with the null renderer, nothing is drawn
+		ImGui::Text("Frame %zu, objects %zu", m_frame, m_live.size());
+		ImGui::End();
+		return false;
+	}
+
+	bool OnFrameEnd(Message message) {
+		if( ++m_frame < m_frames ) return false;
+		for( auto& object : m_live ) {
+			auto LtoW = m_registry.Get<vve::LocalToWorldMatrix&>(object.m_handle);
+			for( int i = 0; i < 4; ++i ) {
+				for( int j = 0; j < 4; ++j ) { m_hash = m_hash * 31 + std::hash<real_t>{}(LtoW()[i][j]); }
+			}
+		}
+		m_engine.Stop();
+		return false;
+	}
+
+	struct Object {
+		vecs::Handle m_handle;
+		size_t m_ordinal;
+		vec3_t m_base;
+	};
+
+	std::deque<Object> m_live;
+	size_t m_frames;
+	size_t m_frame{0};
+	size_t m_spawned{0};
+	double m_time{0.0};
+	size_t m_hash{0};
+};
+
+
+struct Result {
+	size_t m_hash;
+	vve::RendererNull::Stats m_stats;
+	double m_msPerFrame;
+};
+
+
+/**
+ * @brief Run the simulation once
+ * @param frames Number of frames
+ * @return Hash of the final transforms, renderer statistics and time per frame
+ */
+auto Run(size_t frames) -> Result {
+	vve::Engine engine("Null Renderer", vve::RendererType::RENDERER_TYPE_NULL);
+	engine.SetFixedTimestep(1.0 / 60.0);
+	Simulation simulation{engine, frames};
+
+	auto start = std::chrono::high_resolution_clock::now();
+	engine.Run();
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	auto renderer = dynamic_cast<vve::RendererNull*>(engine.GetSystem(engine.m_rendererNullName));
+	return { simulation.m_hash, renderer->GetStats(), ms / frames };
+}
+
+
+/**
+ * @brief Usage: testnullrenderer [frames]
+ */
+int main(int argc, char* argv[]) {
+	size_t frames = argc > 1 ? std::stoull(argv[1]) : 600;
+
+	auto first = Run(frames);
+	auto second = Run(frames);
+	auto& stats = first.m_stats;
+	std::cout << std::format("{} frames, {:.3f} ms per frame: meshes {}, objects {}, draw calls {}, triangles {}, buffer bytes {}\n",
+		stats.m_frames, first.m_msPerFrame, stats.m_meshes, stats.m_objects, stats.m_drawCalls, stats.m_triangles, stats.m_bufferBytes);
+
+	bool ok = first.m_hash == second.m_hash && stats.m_frames == frames && second.m_stats.m_frames == frames
+		&& stats.m_objects == second.m_stats.m_objects && stats.m_drawCalls == second.m_stats.m_drawCalls
+		&& stats.m_objects >= Simulation::c_objects;		//the default level adds a few objects
+	std::cout << std::format("Deterministic run: {}\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
+
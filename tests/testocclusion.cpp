@@ -0,0 +1,224 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <random>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Correctness of the software occlusion buffer. Runs on the CPU only, no window or GPU is created. Two walls
+ * with a gap between them stand in front of the camera. A known set of boxes hidden behind the walls must be culled,
+ * and a known set of boxes in front of the walls, in the gap, above them, or partly behind an edge must be kept.
+ * Then many random boxes are tested, and no box that has a corner visible outside the walls or in front of them may
+ * be culled. Every test is done on the calling thread and with a job pool, both must give the same result.
+ */
+
+
+/**
+ * @brief Unit cube mesh centered at the origin
+ */
+struct CubeMesh {
+	std::vector<glm::vec3> m_positions{
+		{-0.5f, -0.5f, -0.5f}, { 0.5f, -0.5f, -0.5f}, { 0.5f,  0.5f, -0.5f}, {-0.5f,  0.5f, -0.5f},
+		{-0.5f, -0.5f,  0.5f}, { 0.5f, -0.5f,  0.5f}, { 0.5f,  0.5f,  0.5f}, {-0.5f,  0.5f,  0.5f} };
+	std::vector<uint32_t> m_indices{
+		0, 2, 1, 0, 3, 2,  4, 5, 6, 4, 6, 7,  0, 1, 5, 0, 5, 4,
+		2, 3, 7, 2, 7, 6,  0, 4, 7, 0, 7, 3,  1, 2, 6, 1, 6, 5 };
+	vve::BoundingBox m_bounds{ vec3_t{-0.5f}, vec3_t{0.5f} };
+};
+
+
+auto Transform(vec3_t position, vec3_t scale) -> mat4_t {
+	return glm::scale(glm::translate(mat4_t{1.0f}, position), scale);
+}
+
+
+/**
+ * @brief Screen rectangle and nearest depth of a wall, in the pixel space of the occlusion buffer
+ */
+struct WallRect {
+	glm::vec2 m_lo{ std::numeric_limits<float>::max() };
+	glm::vec2 m_hi{ std::numeric_limits<float>::lowest() };
+	float m_minDepth{ std::numeric_limits<float>::max() };
+};
+
+
+class OcclusionTest {
+
+public:
+	OcclusionTest() {
+		mat4_t proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+		mat4_t view = glm::lookAt(vec3_t{0.0f, 0.0f, 0.0f}, vec3_t{0.0f, 0.0f, -1.0f}, vec3_t{0.0f, 1.0f, 0.0f});
+		m_viewProj = proj * view;
+
+		//two walls from x=-13 to -3 and from 3 to 13, 20 high, the gap between them is 6 wide
+		for( float x : {-8.0f, 8.0f} ) {
+			m_walls.push_back( { m_viewProj * Transform({x, 0.0f, -30.0f}, {10.0f, 20.0f, 0.5f}), &m_cube.m_positions, &m_cube.m_indices } );
+		}
+		for( auto& wall : m_walls ) {
+			WallRect rect;
+			for( auto& p : m_cube.m_positions ) {
+				glm::vec3 s = Project(wall.m_modelViewProj, p);
+				rect.m_lo = glm::min(rect.m_lo, glm::vec2{s});
+				rect.m_hi = glm::max(rect.m_hi, glm::vec2{s});
+				rect.m_minDepth = std::min(rect.m_minDepth, s.z);
+			}
+			m_wallRects.push_back(rect);
+		}
+	}
+
+	/**
+	 * @brief Boxes completely hidden behind one of the walls
+	 */
+	auto OccludedBoxes() -> std::vector<vve::OcclusionBuffer::TestBox> {
+		std::vector<vve::OcclusionBuffer::TestBox> boxes;
+		for( float z : {-45.0f, -60.0f, -90.0f} ) {
+			float s = z / -30.0f;		//the walls cover x from 3s to 13s and y from -10s to 10s at this depth
+			for( float x : {-8.0f * s, 8.0f * s} ) {
+				for( float y : {-5.0f * s, 0.0f, 5.0f * s} ) { boxes.push_back(Box({x, y, z}, 1.0f)); }
+			}
+		}
+		boxes.push_back(Box({-8.0f, 0.0f, -32.0f}, 1.0f));	//right behind a wall
+		return boxes;
+	}
+
+	/**
+	 * @brief Boxes that are at least partly visible
+	 */
+	auto VisibleBoxes() -> std::vector<vve::OcclusionBuffer::TestBox> {
+		std::vector<vve::OcclusionBuffer::TestBox> boxes;
+		for( float x : {-8.0f, 8.0f} ) {
+			for( float y : {-5.0f, 0.0f, 5.0f} ) { boxes.push_back(Box({x, y, -20.0f}, 1.0f)); }	//in front of the walls
+		}
+		for( float y : {-6.0f, 0.0f, 6.0f} ) { boxes.push_back(Box({0.0f, y, -60.0f}, 1.0f)); }	//seen through the gap
+		boxes.push_back(Box({-16.0f, 30.0f, -60.0f}, 1.0f));	//above a wall
+		boxes.push_back(Box({ 16.0f, 30.0f, -60.0f}, 1.0f));
+		boxes.push_back(Box({ 40.0f, 0.0f, -60.0f}, 1.0f));		//beside a wall
+		boxes.push_back(Box({ 6.0f, 0.0f, -60.0f}, 2.0f));		//half behind the edge of the right wall
+		boxes.push_back(Box({-6.0f, 0.0f, -60.0f}, 2.0f));		//half behind the edge of the left wall
+		boxes.push_back(Box({ 8.0f, 0.0f, -30.0f}, 1.0f));		//sticks out of the front of a wall
+		boxes.push_back(Box({ 0.0f, 0.0f, 0.0f}, 1.0f));		//around the camera, crosses the near plane
+		return boxes;
+	}
+
+	/**
+	 * @brief Random boxes in front of the camera, with a few thousand behind the walls
+	 */
+	auto RandomBoxes(size_t count) -> std::vector<vve::OcclusionBuffer::TestBox> {
+		std::default_random_engine rnd{ 12345 };
+		std::uniform_real_distribution<float> unif{ -1.0f, 1.0f };
+		std::vector<vve::OcclusionBuffer::TestBox> boxes(count);
+		for( auto& box : boxes ) {
+			float z = -5.0f - (unif(rnd) + 1.0f) * 100.0f;
+			box = Box({unif(rnd) * -z * 0.8f, unif(rnd) * -z * 0.5f, z}, 0.5f + (unif(rnd) + 1.0f) * 2.0f);
+		}
+		return boxes;
+	}
+
+	/**
+	 * @brief Check if a corner of a box can be seen, i.e. is on the screen and outside of the walls or in front of them
+	 * @param box The box
+	 * @return True if the box is certainly visible
+	 */
+	auto HasVisibleCorner(const vve::OcclusionBuffer::TestBox& box) -> bool {
+		const float margin = 1.0f;	//pixels
+		for( auto& p : m_cube.m_positions ) {
+			if( (box.m_modelViewProj * vec4_t{p, 1.0f}).w < 0.1f ) continue;
+			glm::vec3 s = Project(box.m_modelViewProj, p);
+			if( s.x < margin || s.y < margin || s.x > c_width - margin || s.y > c_height - margin ) continue;
+			bool hidden = std::ranges::any_of(m_wallRects, [&](auto& wall) {
+				return s.x > wall.m_lo.x - margin && s.x < wall.m_hi.x + margin && s.y > wall.m_lo.y - margin
+					&& s.y < wall.m_hi.y + margin && s.z > wall.m_minDepth;
+			});
+			if( !hidden ) return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Rasterize the walls and test boxes
+	 * @param jobPool Threads, nullptr for the calling thread
+	 * @param boxes The boxes
+	 * @return Visibility per box
+	 */
+	auto Test(vve::JobPool* jobPool, std::span<const vve::OcclusionBuffer::TestBox> boxes) -> std::vector<uint8_t> {
+		vve::OcclusionBuffer buffer{ c_width, c_height, jobPool };
+		buffer.Clear();
+		buffer.Rasterize(m_walls);
+		std::vector<uint8_t> visible(boxes.size());
+		buffer.Test(boxes, visible);
+		return visible;
+	}
+
+	static const uint32_t c_width = 320;
+	static const uint32_t c_height = 192;
+
+private:
+	auto Box(vec3_t position, float size) -> vve::OcclusionBuffer::TestBox {
+		return { m_viewProj * Transform(position, vec3_t{size}), m_cube.m_bounds };
+	}
+
+	/**
+	 * @brief Project a point to the pixel space of the buffer
+	 * @return Pixel x, pixel y and depth
+	 */
+	static auto Project(const mat4_t& modelViewProj, const glm::vec3& p) -> glm::vec3 {
+		glm::vec4 c{ modelViewProj * vec4_t{p, 1.0f} };
+		return { (c.x / c.w * 0.5f + 0.5f) * c_width, (c.y / c.w * 0.5f + 0.5f) * c_height, c.z / c.w };
+	}
+
+	CubeMesh m_cube;
+	mat4_t m_viewProj;
+	std::vector<vve::OcclusionBuffer::OccluderMesh> m_walls;
+	std::vector<WallRect> m_wallRects;
+};
+
+
+/**
+ * @brief Usage: testocclusion [number of random boxes]
+ */
+int main(int argc, char* argv[]) {
+	size_t numBoxes = argc > 1 ? std::stoull(argv[1]) : 20000;
+
+	OcclusionTest test;
+	auto occluded = test.OccludedBoxes();
+	auto visible = test.VisibleBoxes();
+	auto random = test.RandomBoxes(numBoxes);
+	vve::JobPool jobPool{ std::max(2u, std::thread::hardware_concurrency()) };
+	bool ok = true;
+
+	for( vve::JobPool* pool : {(vve::JobPool*)nullptr, &jobPool} ) {
+		std::string threads = pool ? "job pool" : "one thread";
+		auto occludedResult = test.Test(pool, occluded);
+		auto visibleResult = test.Test(pool, visible);
+		size_t kept = std::count(occludedResult.begin(), occludedResult.end(), 1);
+		size_t culled = std::count(visibleResult.begin(), visibleResult.end(), 0);
+		for( size_t i = 0; i < visibleResult.size(); ++i ) {
+			if( !visibleResult[i] ) std::cout << std::format("FAILED: visible box {} culled\n", i);
+		}
+
+		auto randomResult = test.Test(pool, random);
+		size_t randomCulled = 0, wrong = 0;
+		for( size_t i = 0; i < random.size(); ++i ) {
+			if( randomResult[i] ) continue;
+			++randomCulled;
+			if( test.HasVisibleCorner(random[i]) ) ++wrong;
+		}
+		bool passed = kept == 0 && culled == 0 && wrong == 0 && randomCulled > 0;
+		std::cout << std::format("{}: {} of {} hidden boxes culled, {} of {} visible boxes culled, {} of {} random boxes culled, {} of them visible: {}\n",
+			threads, occluded.size() - kept, occluded.size(), culled, visible.size(), randomCulled, random.size(), wrong, passed ? "ok" : "FAILED");
+		ok = ok && passed;
+
+		if( pool ) {
+			bool same = randomResult == test.Test(nullptr, random);
+			if( !same ) std::cout << "FAILED: the job pool gives a different result than one thread\n";
+			ok = ok && same;
+		}
+	}
+
+	std::cout << std::format("Occlusion culling: {}\n", ok ? "passed" : "FAILED");
+	return ok ? 0 : 1;
+}
+
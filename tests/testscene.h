@@ -0,0 +1,90 @@
+#pragma once
+
+#include <fstream>
+#include <filesystem>
+#include <numbers>
+#include <cmath>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief Generated scenes for the loading tests and the incremental loading example
+ */
+
+
+/**
+ * @brief Write an OBJ file with a grid of spheres, each sphere is its own object and mesh. With a texture size
+ * the spheres get texture coordinates, and a material and a PPM texture with the same stem are written next to it.
+ * @param file Path of the file
+ * @param objects Number of spheres
+ * @param segments Segments of a sphere around its axis, it has half as many rings
+ * @param texSize Edge length of the texture in pixels, 0 for no texture
+ */
+inline void WriteScene(const std::filesystem::path& file, size_t objects, int segments, int texSize = 0) {
+	auto stem = file.stem().string();
+	if( texSize > 0 ) {
+		std::ofstream mtl(file.parent_path() / (stem + ".mtl"));
+		mtl << "newmtl " << stem << "\nKd 1 1 1\nmap_Kd " << stem << ".ppm\n";
+
+		std::ofstream ppm(file.parent_path() / (stem + ".ppm"), std::ios::binary);
+		ppm << "P6\n" << texSize << " " << texSize << "\n255\n";
+		for( int y = 0; y < texSize; ++y ) {
+			for( int x = 0; x < texSize; ++x ) {
+				char rgb[3] = { (char)(x * 255 / texSize), (char)(y * 255 / texSize), (char)(((x / 32 + y / 32) % 2) * 255) };
+				ppm.write(rgb, 3);
+			}
+		}
+	}
+
+	std::ofstream out(file);
+	if( texSize > 0 ) out << "mtllib " << stem << ".mtl\n";
+	auto corner = [&](size_t i) {
+		if( texSize > 0 ) out << i << "/" << i << "/" << i;
+		else out << i << "//" << i;
+	};
+	auto face = [&](size_t a, size_t b, size_t c) {
+		out << "f ";
+		corner(a); out << " ";
+		corner(b); out << " ";
+		corner(c); out << "\n";
+	};
+	int rings = segments / 2;
+	size_t rows = (size_t)std::ceil(std::sqrt((double)objects));
+	size_t base = 1;
+	for( size_t o = 0; o < objects; ++o ) {
+		float cx = 3.0f * (float)(o % rows) - 1.5f * rows, cy = 3.0f * (float)(o / rows) - 1.5f * rows;
+		out << "o sphere" << o << "\n";
+		if( texSize > 0 ) out << "usemtl " << stem << "\n";
+		for( int r = 0; r <= rings; ++r ) {
+			float theta = std::numbers::pi_v<float> * r / rings;
+			for( int s = 0; s <= segments; ++s ) {
+				float phi = 2.0f * std::numbers::pi_v<float> * s / segments;
+				float x = std::sin(theta) * std::cos(phi), y = std::sin(theta) * std::sin(phi), z = std::cos(theta);
+				out << "v " << cx + x << " " << cy + y << " " << 1.0f + z << "\nvn " << x << " " << y << " " << z << "\n";
+				if( texSize > 0 ) out << "vt " << (float)s / segments << " " << (float)r / rings << "\n";
+			}
+		}
+		for( int r = 0; r < rings; ++r ) {
+			for( int s = 0; s < segments; ++s ) {
+				size_t a = base + r * (segments + 1) + s, b = a + segments + 1;
+				face(a, b, b + 1);
+				face(a, b + 1, a + 1);
+			}
+		}
+		base += (rings + 1) * (segments + 1);
+	}
+}
+
+/**
+ * @brief Count the nodes below a node
+ * @param registry The registry
+ * @param handle The node
+ * @return Number of descendants
+ */
+inline auto CountNodes(vecs::Registry& registry, vecs::Handle handle) -> size_t {
+	size_t count = 0;
+	if( !registry.Has<vve::Children>(handle) ) return count;
+	for( auto child : registry.Get<vve::Children&>(handle)() ) { count += 1 + CountNodes(registry, child); }
+	return count;
+}
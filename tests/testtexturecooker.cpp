@@ -0,0 +1,206 @@
+#include <iostream>
+#include <fstream>
+#include <utility>
+#include <format>
+#include <string>
+#include <numbers>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Offline texture cooker. Generated images are cooked for every usage, written and read back, each decoded
+ * mip level is compared against the CPU reference mip, the sizes of the files are checked, and the asset manager
+ * must load the cooked file instead of the image. Runs on the CPU only.
+ */
+
+
+/**
+ * @brief Generate a test image
+ * @param usage The usage, decides the content
+ * @param width Width of the image
+ * @param height Height of the image
+ * @param alpha Add an alpha gradient to color images
+ * @return The pixels, 8 bit RGBA
+ */
+auto Generate(vve::TextureUsage usage, uint32_t width, uint32_t height, bool alpha) -> std::vector<uint8_t> {
+	std::vector<uint8_t> pixels((size_t)width * height * 4);
+	for( uint32_t y = 0; y < height; ++y ) {
+		for( uint32_t x = 0; x < width; ++x ) {
+			uint8_t* p = &pixels[4 * ((size_t)y * width + x)];
+			float u = (float)x / width, v = (float)y / height;
+			float wave = 0.5f + 0.5f * std::sin(2.0f * std::numbers::pi_v<float> * (3.0f * u + 2.0f * v));
+			if( usage == vve::TextureUsage::TEXTURE_USAGE_NORMAL ) {
+				float nx = 0.4f * std::cos(6.0f * std::numbers::pi_v<float> * u), ny = 0.4f * std::sin(4.0f * std::numbers::pi_v<float> * v);
+				float nz = std::sqrt(std::max(0.0f, 1.0f - nx * nx - ny * ny));
+				p[0] = (uint8_t)std::lround((nx * 0.5f + 0.5f) * 255.0f);
+				p[1] = (uint8_t)std::lround((ny * 0.5f + 0.5f) * 255.0f);
+				p[2] = (uint8_t)std::lround((nz * 0.5f + 0.5f) * 255.0f);
+				p[3] = 255;
+			} else {
+				p[0] = (uint8_t)std::lround(255.0f * (0.2f + 0.6f * wave));
+				p[1] = (uint8_t)std::lround(255.0f * (0.1f + 0.5f * wave));
+				p[2] = (uint8_t)std::lround(255.0f * (0.3f + 0.2f * v));
+				p[3] = alpha ? (uint8_t)std::lround(255.0f * u) : 255;
+			}
+		}
+	}
+	return pixels;
+}
+
+/**
+ * @brief Peak signal to noise ratio of two images over some channels
+ * @param a First image, 8 bit RGBA
+ * @param b Second image, 8 bit RGBA
+ * @param channels Number of channels compared, starting with red
+ * @return The PSNR in dB, 100 if the images are equal
+ */
+auto Psnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, uint32_t channels) -> double {
+	double error = 0.0;
+	for( size_t i = 0; i < a.size() / 4; ++i ) {
+		for( uint32_t k = 0; k < channels; ++k ) error += std::pow((double)a[4 * i + k] - b[4 * i + k], 2.0);
+	}
+	error /= (double)(a.size() / 4 * channels);
+	return error == 0.0 ? 100.0 : 10.0 * std::log10(255.0 * 255.0 / error);
+}
+
+
+/**
+ * @brief A test case: one generated image cooked with some options
+ */
+struct Case {
+	std::string m_name;
+	vve::CookOptions m_options;
+	bool m_alpha;
+	VkFormat m_format;				//expected format
+	uint32_t m_channels;			//channels stored by the format
+	double m_minPsnr;				//of level 0, smaller levels may be worse
+};
+
+
+/**
+ * @brief Cook, write, read and decode one case
+ * @param c The case
+ * @param directory Directory of the KTX2 files
+ * @return true if the case passed
+ */
+auto Run(const Case& c, const std::filesystem::path& directory) -> bool {
+	const uint32_t width = 300, height = 200;
+	auto pixels = Generate(c.m_options.m_usage, width, height, c.m_alpha);
+	auto reference = vve::TextureCooker::GenerateMips(pixels.data(), width, height, c.m_options.m_usage);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	auto cooked = vve::TextureCooker::Cook(pixels.data(), width, height, c.m_options);
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	auto file = directory / (c.m_name + vve::TextureCooker::c_extension);
+	bool written = vve::TextureCooker::WriteKtx2(file, cooked);
+	auto read = vve::TextureCooker::ReadKtx2(file);
+	bool same = read.has_value() && read->m_format == cooked.m_format && read->m_levels == cooked.m_levels;
+
+	size_t bytes = 0, raw = 0;
+	double psnr0 = 0.0, psnrMin = 100.0;
+	bool levels = cooked.m_levels.size() == reference.size() && reference.size() == 9;	//300x200 down to 1x1
+	for( uint32_t level = 0; level < cooked.m_levels.size() && levels; ++level ) {
+		bytes += cooked.m_levels[level].size();
+		raw += reference[level].m_pixels.size();
+		auto decoded = vve::TextureCooker::Decode(cooked, level);
+		levels = decoded.size() == reference[level].m_pixels.size();
+		double psnr = levels ? Psnr(decoded, reference[level].m_pixels, c.m_channels) : 0.0;
+		if( level == 0 ) psnr0 = psnr;
+		psnrMin = std::min(psnrMin, psnr);
+	}
+
+	bool ok = written && same && levels && cooked.m_format == c.m_format && psnr0 >= c.m_minPsnr && psnrMin >= 20.0;
+	std::cout << std::format("{:<14} format {:3} levels {} {:7} bytes ({:.1f}:1) {:6.2f} ms, PSNR level 0 {:5.1f} dB, worst {:5.1f} dB: {}\n",
+		c.m_name, (int)cooked.m_format, cooked.m_levels.size(), bytes, (double)raw / std::max(bytes, (size_t)1), ms, psnr0, psnrMin, ok ? "ok" : "FAILED");
+	return ok;
+}
+
+
+/**
+ * @brief The mips of a black and white checker board must average in linear light for color, and in the stored
+ * values for linear data
+ * @return true if the averages are right
+ */
+auto CheckFiltering() -> bool {
+	std::vector<uint8_t> checker(2 * 2 * 4, 255);
+	for( int i : { 0, 3 } ) { checker[4 * i] = checker[4 * i + 1] = checker[4 * i + 2] = 0; }
+	auto color = vve::TextureCooker::GenerateMips(checker.data(), 2, 2, vve::TextureUsage::TEXTURE_USAGE_COLOR);
+	auto linear = vve::TextureCooker::GenerateMips(checker.data(), 2, 2, vve::TextureUsage::TEXTURE_USAGE_LINEAR);
+	bool ok = color.size() == 2 && color[1].m_pixels[0] == 188 && linear.size() == 2 && linear[1].m_pixels[0] == 128;
+	std::cout << std::format("Checker board mip: sRGB {}, linear {}: {}\n", color[1].m_pixels[0], linear[1].m_pixels[0], ok ? "ok" : "FAILED");
+	return ok;
+}
+
+
+/**
+ * @brief Texture loaded by the asset manager
+ */
+struct CookedResult {
+	VkFormat m_format{VK_FORMAT_UNDEFINED};
+	uint32_t m_mipLevels{0};
+};
+
+
+/**
+ * @brief Asks the asset manager for a texture whose cooked file exists and checks that the cooked file was loaded
+ */
+class CookedLoadTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the CookedLoadTest class
+	 * @param engine Reference to the engine
+	 * @param file The image file, its cooked file exists
+	 */
+	CookedLoadTest( vve::Engine& engine, std::filesystem::path file ) : EngineTest(engine, "Cooked Load Test"), m_file{file} {};
+
+	bool Frame(size_t frame) override {
+		auto tHandle = vve::TextureHandle{ m_registry.Insert(vve::Name{m_file.string()}) };
+		m_engine.SendMsg( MsgTextureCreate{tHandle, this} );
+		if( m_registry.Has<vvh::Image>(tHandle) ) {
+			auto& image = m_registry.Get<vvh::Image&>(tHandle)();
+			m_result.m_format = image.m_format;
+			m_result.m_mipLevels = image.m_mipLevels;
+		}
+		return false;
+	}
+
+	CookedResult m_result{};
+
+private:
+	std::filesystem::path m_file;
+};
+
+
+int main() {
+	auto directory = std::filesystem::temp_directory_path() / "vve-texture-cooker";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directories(directory);
+
+	using enum vve::TextureUsage;
+	std::vector<Case> cases = {
+		{ "color",        { TEXTURE_USAGE_COLOR },        false, VK_FORMAT_BC1_RGB_SRGB_BLOCK,  3, 35.0 },
+		{ "color-alpha",  { TEXTURE_USAGE_COLOR },        true,  VK_FORMAT_BC3_SRGB_BLOCK,      4, 35.0 },
+		{ "color-hq",     { TEXTURE_USAGE_COLOR, true },  true,  VK_FORMAT_BC7_SRGB_BLOCK,      4, 35.0 },
+		{ "linear",       { TEXTURE_USAGE_LINEAR },       false, VK_FORMAT_BC1_RGB_UNORM_BLOCK, 3, 35.0 },
+		{ "normal",       { TEXTURE_USAGE_NORMAL },       false, VK_FORMAT_BC5_UNORM_BLOCK,     2, 40.0 },
+		{ "mask",         { TEXTURE_USAGE_MASK },         false, VK_FORMAT_BC4_UNORM_BLOCK,     1, 40.0 },
+	};
+	bool ok = CheckFiltering();
+	for( auto& c : cases ) { ok = Run(c, directory) && ok; }
+
+	// the asset manager must prefer the cooked file next to an image
+	auto image = directory / "brick_albedo.png";
+	auto pixels = Generate(TEXTURE_USAGE_COLOR, 300, 200, false);
+	stbi_write_png(image.string().c_str(), 300, 200, 4, pixels.data(), 300 * 4);
+	bool cooked = vve::TextureCooker::CookFile(image, vve::TextureCooker::CookedPath(image), { vve::TextureCooker::GuessUsage(image) });
+
+	auto result = RunTest<CookedLoadTest>("Texture Cooker", vve::RendererType::RENDERER_TYPE_NULL, image);
+	bool loaded = cooked && result.m_format == VK_FORMAT_BC1_RGB_SRGB_BLOCK && result.m_mipLevels == 9;
+	std::cout << std::format("Asset manager loaded {}: format {}, {} levels: {}\n", image.string(), (int)result.m_format, result.m_mipLevels, loaded ? "ok" : "FAILED");
+	return Report("Texture cooker", ok && loaded);
+}
+
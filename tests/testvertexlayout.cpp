@@ -0,0 +1,127 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Separate versus interleaved vertex streams. Bundled models are rendered with the forward and with the
+ * deferred renderer, each twice, with one vertex buffer binding per attribute stream and with a single interleaved
+ * stream, and the swapchain images are compared. The images must be identical, all meshes of the interleaved run
+ * must be interleaved, and both layouts must need the same vertex memory. Needs a Vulkan device, e.g. lavapipe.
+ */
+
+
+/**
+ * @brief Result of rendering the scene once
+ */
+struct RenderResult {
+	SwapchainImage m_image;
+	size_t m_vertexBytes{0};		//size of the vertex buffers of the models
+	size_t m_interleaved{0};		//meshes of the models with an interleaved stream
+	size_t m_meshes{0};				//meshes of the models
+};
+
+
+/**
+ * @brief Loads the models, renders a few frames and reads back the swapchain image
+ */
+class LayoutTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the LayoutTest class
+	 * @param engine Reference to the engine
+	 * @param files The model files
+	 * @param interleave Interleave the vertex streams of the imported meshes
+	 */
+	LayoutTest( vve::Engine& engine, std::vector<std::filesystem::path> files, bool interleave )
+		: EngineTest(engine, "Vertex Layout Test", -1000), m_files{files}, m_interleave{interleave} {};	//load before the default level
+
+	void Load() override {
+		Assets()->SetVertexInterleaving(m_interleave);
+		for( size_t i = 0; i < m_files.size(); ++i ) {
+			m_engine.CreateScene(vve::Name{std::format("Model{}", i)}, vve::ParentHandle{}, vve::Filename{m_files[i].string()},
+				aiProcess_Triangulate, vve::Position{ vec3_t{ 2.5f * i, 0.0f, 0.0f } });
+		}
+	}
+
+	bool Frame(size_t frame) override {
+		if( frame + 1 < c_renderFrames ) return true;
+		m_result.m_image = ReadSwapchain(m_registry);
+
+		for( auto [handle, name, mesh] : m_registry.GetView<vecs::Handle, vve::Name, vvh::Mesh&>() ) {
+			bool model = std::ranges::any_of(m_files, [&](auto& file) { return name().starts_with(file.string()); });
+			if( !model ) continue;	//meshes of the default level
+			m_result.m_vertexBytes += (size_t)mesh().m_verticesData.getSize();
+			if( mesh().m_verticesData.m_interleaved ) ++m_result.m_interleaved;
+			++m_result.m_meshes;
+		}
+		return false;
+	}
+
+	RenderResult m_result{};
+
+private:
+	std::vector<std::filesystem::path> m_files;
+	bool m_interleave;
+};
+
+
+/**
+ * @brief Render the scene once in a new engine
+ * @param files The model files
+ * @param type The renderer
+ * @param interleave Interleave the vertex streams of the imported meshes
+ * @return The image and the meshes
+ */
+auto Run(std::vector<std::filesystem::path> files, vve::RendererType type, bool interleave) -> RenderResult {
+	return RunTest<LayoutTest>("Vertex Layout", type, files, interleave);
+}
+
+
+/**
+ * @brief Render with both layouts and compare
+ * @param files The model files
+ * @param type The renderer
+ * @param name Name of the renderer for the output
+ * @return True if the images are identical and the meshes have the expected layout
+ */
+auto Compare(std::vector<std::filesystem::path> files, vve::RendererType type, const std::string& name) -> bool {
+	auto separate = Run(files, type, false);
+	auto interleaved = Run(files, type, true);
+	auto diff = CompareImages(separate.m_image, interleaved.m_image);
+	if( diff.m_channels == 0 ) {
+		std::cout << std::format("{}: FAILED (no image)\n", name);
+		return false;
+	}
+
+	bool ok = diff.m_differing == 0 && separate.m_interleaved == 0 && interleaved.m_meshes > 0 && interleaved.m_interleaved == interleaved.m_meshes
+		&& separate.m_vertexBytes == interleaved.m_vertexBytes;
+	std::cout << std::format("{} image {}x{}: {} channels differ, {} of {} meshes interleaved, {} and {} vertex bytes: {}\n", name,
+		separate.m_image.m_width, separate.m_image.m_height, diff.m_differing, interleaved.m_interleaved, interleaved.m_meshes, separate.m_vertexBytes,
+		interleaved.m_vertexBytes, ok ? "ok" : "FAILED");
+	return ok;
+}
+
+
+/**
+ * @brief Usage: testvertexlayout [model files...], e.g. testvertexlayout assets/test/Fireplace/Fireplace.gltf
+ * Without model files a few small bundled models are used.
+ */
+int main(int argc, char* argv[]) {
+	std::vector<std::filesystem::path> files{ argv + 1, argv + argc };
+	if( files.empty() ) files = {
+		"assets/viking_room/viking_room.obj",
+		"assets/standard/sphere.obj",
+		"assets/cloths/cloth0/cloth.obj",
+	};
+
+	bool ok = Compare(files, vve::RendererType::RENDERER_TYPE_FORWARD, "Forward");
+	ok = Compare(files, vve::RendererType::RENDERER_TYPE_DEFERRED, "Deferred") && ok;
+	return Report("Vertex layout", ok);
+}
+
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <optional>
+#include "VHInclude.h"
+#include "VEInclude.h"
+#include "testharness.h"
+
+
+/**
+ * @brief Quantized vertex formats. The default level and a model are rendered with the forward renderer twice,
+ * with float and with quantized vertex buffers, and the swapchain images are compared. The quantized vertex buffers
+ * must be much smaller, and the images must not differ by more than a threshold. Then both are rendered again with
+ * the deferred renderer, which only updates the object buffers of changed objects, and with level of detail selection
+ * switching all objects to a coarser level. The levels must keep the quantization bounds of their mesh, and the
+ * images must again not differ by more than the threshold. Needs a Vulkan device, e.g. lavapipe.
+ */
+
+
+/**
+ * @brief Result of rendering the scene once
+ */
+struct RenderResult {
+	SwapchainImage m_image;
+	size_t m_vertexBytes{0};		//size of all vertex buffers
+	size_t m_coarse{0};				//objects drawn with a coarser level of detail
+	bool m_boundsOk{true};			//all levels of detail have the dequantization of their mesh
+};
+
+
+/**
+ * @brief Loads the model, renders a few frames and reads back the swapchain image
+ */
+class QuantizationTest : public EngineTest {
+
+public:
+	/**
+	 * @brief Constructor for the QuantizationTest class
+	 * @param engine Reference to the engine
+	 * @param file The model file
+	 * @param quantize Quantize the vertex buffers
+	 * @param lod Switch all objects with levels of detail to the coarsest level
+	 */
+	QuantizationTest( vve::Engine& engine, std::filesystem::path file, bool quantize, bool lod )
+		: EngineTest(engine, "Vertex Quantization Test", -1000), m_file{file}, m_quantize{quantize} {	//load before the default level
+		if( lod ) m_levels.emplace("Level of Detail", engine, std::vector<real_t>{10.0, 10.0, 10.0});	//thresholds above any projected size
+	};
+
+	void Load() override {
+		Assets()->SetVertexQuantization(m_quantize);
+		m_engine.CreateScene(vve::Name{"Model"}, vve::ParentHandle{}, vve::Filename{m_file.string()}, aiProcess_Triangulate);
+	}
+
+	bool Frame(size_t frame) override {
+		if( frame + 1 < c_renderFrames ) return true;
+		m_result.m_image = ReadSwapchain(m_registry);
+
+		for( auto [handle, mesh] : m_registry.GetView<vecs::Handle, vvh::Mesh&>() ) {
+			m_result.m_vertexBytes += (size_t)mesh().m_verticesData.getSize();
+		}
+		for( auto [handle, lods] : m_registry.GetView<vecs::Handle, vve::MeshLods&>() ) {
+			auto dequantization = m_registry.Get<vvh::Mesh&>(handle)().m_verticesData.getDequantization();
+			for( auto& level : lods().m_levels ) {
+				auto& data = m_registry.Get<vvh::Mesh&>(level())().m_verticesData;
+				if( data.m_quantized && data.getDequantization() != dequantization ) m_result.m_boundsOk = false;
+			}
+		}
+		for( auto [handle, state] : m_registry.GetView<vecs::Handle, vve::LodState&>() ) {
+			if( state().m_level > 0 ) ++m_result.m_coarse;
+		}
+		return false;
+	}
+
+	RenderResult m_result{};
+
+private:
+	std::filesystem::path m_file;
+	bool m_quantize;
+	std::optional<vve::LevelOfDetail> m_levels;
+};
+
+
+/**
+ * @brief Render the scene once in a new engine
+ * @param file The model file
+ * @param quantize Quantize the vertex buffers
+ * @param type The renderer
+ * @param lod Switch all objects with levels of detail to the coarsest level
+ * @return The image and vertex memory
+ */
+auto Run(std::filesystem::path file, bool quantize, vve::RendererType type, bool lod) -> RenderResult {
+	return RunTest<QuantizationTest>("Vertex Quantization", type, file, quantize, lod);
+}
+
+
+/**
+ * @brief Compare the images rendered with float and with quantized vertex buffers
+ * @param plain Rendered with float vertex buffers
+ * @param quantized Rendered with quantized vertex buffers
+ * @param name Name of the comparison for the output
+ * @return True if the images are close enough and the quantized vertex buffers are small enough
+ */
+auto Compare(const RenderResult& plain, const RenderResult& quantized, const std::string& name) -> bool {
+	const double c_minPsnr = 35.0;		//dB, over all color channels
+	const double c_maxMeanError = 1.0;	//mean absolute difference of a channel, out of 255
+	const double c_maxSizeRatio = 0.6;	//quantized vertex buffers must be at least this much smaller
+
+	auto diff = CompareImages(plain.m_image, quantized.m_image);
+	if( diff.m_channels == 0 ) {
+		std::cout << std::format("{}: FAILED (no image)\n", name);
+		return false;
+	}
+	double ratio = plain.m_vertexBytes > 0 ? (double)quantized.m_vertexBytes / plain.m_vertexBytes : 1.0;
+
+	bool ok = diff.m_psnr >= c_minPsnr && diff.m_meanError <= c_maxMeanError && ratio <= c_maxSizeRatio && quantized.m_boundsOk;
+	std::cout << std::format("{} image {}x{}: PSNR {:.2f} dB, mean error {:.4f}, {} of {} channels differ\n",
+		name, plain.m_image.m_width, plain.m_image.m_height, diff.m_psnr, diff.m_meanError, diff.m_differing, diff.m_channels);
+	std::cout << std::format("{} vertex buffers: {} bytes float, {} bytes quantized, {:.1f}%\n",
+		name, plain.m_vertexBytes, quantized.m_vertexBytes, 100.0 * ratio);
+	Report(name, ok);
+	return ok;
+}
+
+
+/**
+ * @brief Usage: testvertexquantization [model file], e.g. testvertexquantization assets/test/Fireplace/Fireplace.gltf
+ */
+int main(int argc, char* argv[]) {
+	std::filesystem::path file = argc > 1 ? argv[1] : "assets/viking_room/viking_room.obj";
+	auto forward = vve::RendererType::RENDERER_TYPE_FORWARD;
+	auto deferred = vve::RendererType::RENDERER_TYPE_DEFERRED;
+
+	bool ok = Compare(Run(file, false, forward, false), Run(file, true, forward, false), "Vertex quantization");
+
+	auto lodPlain = Run(file, false, deferred, true);
+	auto lodQuantized = Run(file, true, deferred, true);
+	std::cout << std::format("Level of detail: {} objects drawn with a coarser level\n", lodQuantized.m_coarse);
+	ok = Compare(lodPlain, lodQuantized, "Vertex quantization with level of detail") && ok && lodQuantized.m_coarse > 0;
+	return ok ? 0 : 1;
+}
+
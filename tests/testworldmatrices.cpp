@@ -0,0 +1,124 @@
+#include <iostream>
+#include <utility>
+#include <format>
+#include <string>
+#include <set>
+#include "VHInclude.h"
+#include "VEInclude.h"
+
+
+/**
+ * @brief World matrices written with SetWorldMatrices. Runs with the null renderer, no window or GPU is needed. The
+ * camera, a light with a child, and a node together with its child are moved with one SetWorldMatrices call. In the
+ * same frame their world matrices must be the written ones, the child of the light must follow, OBJECT_CHANGED must
+ * be sent for all of them, and the view matrix of the camera must be updated. Then SetTransforms must hand the light
+ * back to its position.
+ */
+class WorldMatricesTest : public vve::System {
+
+public:
+	WorldMatricesTest( vve::Engine& engine ) : vve::System("World Matrices Test", engine ) {
+		m_engine.RegisterCallbacks( {
+			{this,    0, "LOAD_LEVEL", [this](Message& message){ return OnLoadLevel(message);} },
+			{this,    0, "UPDATE", [this](Message& message){ return OnUpdate(message);} },
+			{this,    0, "OBJECT_CHANGED", [this](Message& message){ return OnObjectChanged(message);} },
+			{this,    0, "FRAME_END", [this](Message& message){ return OnFrameEnd(message);} }
+		} );
+	};
+
+	~WorldMatricesTest() {};
+
+	bool OnLoadLevel( Message message ) {
+		auto root = m_engine.GetRootSceneNode();
+		m_light = m_engine.CreateSceneNode(vve::Name{"Light"}, vve::ParentHandle{root}, vve::Position{vec3_t{0.0f, 0.0f, 5.0f}});
+		m_registry.Put(m_light, vve::PointLight{vvh::LightParams{
+			glm::vec3(1.0f, 1.0f, 1.0f), glm::vec4(0.0f, 1.0f, 10.0, 0.1f), glm::vec3(1.0f, 0.01f, 0.005f) }});
+		m_lightChild = m_engine.CreateSceneNode(vve::Name{"Light Child"}, vve::ParentHandle{m_light}, vve::Position{vec3_t{0.0f, 0.0f, 1.0f}});
+		m_arm = m_engine.CreateSceneNode(vve::Name{"Arm"}, vve::ParentHandle{root}, vve::Position{vec3_t{-2.0f, 0.0f, 0.0f}});
+		m_hand = m_engine.CreateSceneNode(vve::Name{"Hand"}, vve::ParentHandle{m_arm}, vve::Position{vec3_t{0.0f, 1.0f, 0.0f}});
+		m_camera = std::get<0>(*m_registry.GetView<vecs::Handle, vve::Camera&>().begin());
+		return false;
+	}
+
+	bool OnUpdate( Message message ) {
+		m_changed.clear();
+		if( m_frame == 1 ) {
+			m_engine.SetWorldMatrices( std::vector<vve::Engine::WorldMatrixInfo>{
+				{ vve::ObjectHandle{m_camera}, c_camera },
+				{ vve::ObjectHandle{m_light}, c_light },
+				{ vve::ObjectHandle{m_arm}, c_arm },
+				{ vve::ObjectHandle{m_hand}, c_hand }	//the parent was written before in the same call
+			});
+		}
+		if( m_frame == 2 ) {
+			m_engine.SetTransforms( std::vector<vve::Engine::TransformInfo>{
+				{ vve::ObjectHandle{m_light}, vec3_t{7.0f, 0.0f, 0.0f}, quat_t{1.0f, 0.0f, 0.0f, 0.0f} }
+			});
+		}
+		return false;
+	}
+
+	bool OnObjectChanged( Message message ) {
+		m_changed.insert(message.template GetData<MsgObjectChanged>().m_object().GetValue());
+		return false;
+	}
+
+	bool OnFrameEnd( Message message ) {
+		if( m_frame == 1 ) {
+			auto childLtoP = m_registry.Get<vve::LocalToParentMatrix&>(m_lightChild);
+			Check(Near(World(m_camera), c_camera), "camera world matrix");
+			Check(Near(m_registry.Get<vve::ViewMatrix&>(m_camera)(), glm::inverse(c_camera)), "camera view matrix");
+			Check(Near(World(m_light), c_light), "light world matrix");
+			Check(Near(World(m_lightChild), c_light * childLtoP()), "world matrix of the child of the light");
+			Check(Near(World(m_arm), c_arm) && Near(World(m_hand), c_hand), "node and child written in the same call");
+			std::vector<std::pair<vecs::Handle, std::string>> written{ {m_camera, "camera"}, {m_light, "light"}, 
+				{m_lightChild, "child of the light"}, {m_arm, "node"}, {m_hand, "child of the node"} };
+			for( auto& [handle, name] : written ) {
+				Check(m_changed.contains(handle.GetValue()), std::format("OBJECT_CHANGED for the {}", name));
+			}
+		}
+		if( m_frame == 2 ) {
+			Check(Near(World(m_light), glm::translate(mat4_t{1.0f}, vec3_t{7.0f, 0.0f, 0.0f})), "light placed by SetTransforms");
+			Check(m_changed.contains(m_light.GetValue()), "OBJECT_CHANGED for the light placed by SetTransforms");
+			m_engine.Stop();
+		}
+		++m_frame;
+		return false;
+	}
+
+	size_t m_failures{0};
+
+private:
+	inline static const mat4_t c_camera = glm::inverse(glm::lookAt(vec3_t{10.0f, -5.0f, 4.0f}, vec3_t{0.0f}, vec3_t{0.0f, 0.0f, 1.0f}));
+	inline static const mat4_t c_light = glm::translate(mat4_t{1.0f}, vec3_t{3.0f, 4.0f, 5.0f}) * glm::rotate(mat4_t{1.0f}, 0.5f, vec3_t{0.0f, 0.0f, 1.0f});
+	inline static const mat4_t c_arm = glm::translate(mat4_t{1.0f}, vec3_t{1.0f, 2.0f, 0.0f}) * glm::rotate(mat4_t{1.0f}, 1.0f, vec3_t{1.0f, 0.0f, 0.0f});
+	inline static const mat4_t c_hand = glm::translate(mat4_t{1.0f}, vec3_t{-3.0f, 0.0f, 2.0f});
+
+	auto World(vecs::Handle handle) -> mat4_t { return m_registry.Get<vve::LocalToWorldMatrix&>(handle)(); }
+
+	static auto Near(const mat4_t& a, const mat4_t& b) -> bool {
+		for( int i = 0; i < 4; ++i ) {
+			for( int j = 0; j < 4; ++j ) { if( std::abs(a[i][j] - b[i][j]) > 1e-4f ) return false; }
+		}
+		return true;
+	}
+
+	void Check(bool ok, const std::string& what) {
+		if( ok ) return;
+		std::cout << "FAILED: " << what << "\n";
+		++m_failures;
+	}
+
+	vecs::Handle m_camera{}, m_light{}, m_lightChild{}, m_arm{}, m_hand{};
+	std::set<size_t> m_changed;		//objects with OBJECT_CHANGED in the current frame
+	size_t m_frame{0};
+};
+
+
+int main() {
+	vve::Engine engine("World Matrices", vve::RendererType::RENDERER_TYPE_NULL);
+	WorldMatricesTest test{engine};
+	engine.Run();
+	std::cout << std::format("World matrices: {}\n", test.m_failures == 0 ? "passed" : "FAILED");
+	return test.m_failures == 0 ? 0 : 1;
+}